@@ -0,0 +1,94 @@
+/*
+ * Checksum benchmark for the Checksum engine.
+ *
+ * For each algorithm and block size it prints the throughput (GiB/sec) of:
+ * - bitwise : the bit by bit loop used by the CRC callbacks (8 shifts per byte).
+ * - table   : the slice-by-8 tables (simple loops for LRC, XOR and Fletcher-16).
+ * - hw      : the engine selected for the running CPU (SSE4.2 crc32 for CRC32C, PCLMULQDQ
+ *             folding for CRC32), only printed when it is not the table engine.
+ *
+ * usage: Serialink-bench-checksum [blockSize ...]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+#include <time.h>
+#include "checksum.hpp"
+
+static volatile unsigned int sink = 0;
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static unsigned int calculateBitwise(CHECKSUM_TYPE type, const unsigned char *data, size_t sz){
+    unsigned int crc = 0;
+    unsigned int poly = 0;
+    bool isReflected = true;
+    switch (type){
+        case CHECKSUM_TYPE_CRC16_CCITT: crc = 0xFFFF; poly = 0x1021; isReflected = false; break;
+        case CHECKSUM_TYPE_CRC16_XMODEM: crc = 0x0000; poly = 0x1021; isReflected = false; break;
+        case CHECKSUM_TYPE_CRC16_MODBUS: crc = 0xFFFF; poly = 0xA001; break;
+        case CHECKSUM_TYPE_CRC32: crc = 0xFFFFFFFF; poly = 0xEDB88320; break;
+        case CHECKSUM_TYPE_CRC32C: crc = 0xFFFFFFFF; poly = 0x82F63B78; break;
+        default: return Checksum::calculate(CHECKSUM_ENGINE_TABLE, type, data, sz);
+    }
+    for (size_t i = 0; i < sz; i++){
+        if (isReflected){
+            crc ^= data[i];
+            for (int j = 0; j < 8; j++) crc = (crc & 1) ? ((crc >> 1) ^ poly) : (crc >> 1);
+        }
+        else {
+            crc ^= static_cast<unsigned int>(data[i]) << 8;
+            for (int j = 0; j < 8; j++) crc = ((crc & 0x8000) ? ((crc << 1) ^ poly) : (crc << 1)) & 0xFFFF;
+        }
+    }
+    if (type == CHECKSUM_TYPE_CRC32 || type == CHECKSUM_TYPE_CRC32C) crc = ~crc;
+    return crc;
+}
+
+static double measure(int mode, CHECKSUM_TYPE type, const std::vector <unsigned char> &data, size_t blockSize){
+    size_t repeat = 0;
+    size_t offset = 0;
+    double tStart = getTimeSeconds();
+    double elapsed = 0.0;
+    do {
+        for (offset = 0; offset + blockSize <= data.size(); offset += blockSize){
+            if (mode == 0) sink = calculateBitwise(type, data.data() + offset, blockSize);
+            else if (mode == 1) sink = Checksum::calculate(CHECKSUM_ENGINE_TABLE, type, data.data() + offset, blockSize);
+            else sink = Checksum::calculate(type, data.data() + offset, blockSize);
+            repeat++;
+        }
+        elapsed = getTimeSeconds() - tStart;
+    } while (elapsed < 0.3);
+    return static_cast<double>(blockSize) * static_cast<double>(repeat) / elapsed / 1073741824.0;
+}
+
+int main(int argc, char **argv){
+    const char *names[] = {"crc16-ccitt", "crc16-modbus", "crc16-xmodem", "crc32", "crc32c", "lrc", "xor", "fletcher16"};
+    std::vector <size_t> blockSizes;
+    std::vector <unsigned char> data(1048576);
+    CHECKSUM_TYPE type = CHECKSUM_TYPE_CRC16_CCITT;
+    for (int i = 1; i < argc; i++) blockSizes.push_back(static_cast<size_t>(atol(argv[i])));
+    if (blockSizes.empty()) blockSizes = {64, 4096};
+    srand(1);
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<unsigned char>(rand() & 0xFF);
+    std::cout << std::setw(14) << "checksum" << std::setw(8) << "block" << std::setw(12) << "bitwise"
+              << std::setw(12) << "table" << std::setw(12) << "hw" << "  (GiB/sec)" << std::endl;
+    for (int t = 0; t < 8; t++){
+        type = static_cast<CHECKSUM_TYPE>(t);
+        for (auto blockSize : blockSizes){
+            std::cout << std::setw(14) << names[t] << std::setw(8) << blockSize << std::fixed << std::setprecision(2)
+                      << std::setw(12) << measure(0, type, data, blockSize)
+                      << std::setw(12) << measure(1, type, data, blockSize);
+            if (Checksum::getEngine(type) != CHECKSUM_ENGINE_TABLE) std::cout << std::setw(12) << measure(2, type, data, blockSize);
+            else std::cout << std::setw(12) << "-";
+            std::cout << std::endl;
+        }
+    }
+    return 0;
+}
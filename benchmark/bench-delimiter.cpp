@@ -0,0 +1,153 @@
+/*
+ * Delimiter search benchmark for Serial::readStartBytes.
+ *
+ * Part 1 searches a start sequence placed after several MiB of noise, in memory, with:
+ * - memcmp : the previous search (memcmp at every offset).
+ * - scalar : memchr on the first byte, then memcmp.
+ * - sse2   : first and last byte compare on 16 bytes.
+ * - avx2   : first and last byte compare on 32 bytes.
+ * Two kinds of noise are used: random bytes, and a noise made of the first byte of the start
+ * sequence (every offset is a candidate for memchr).
+ *
+ * Part 2 streams the same random noise followed by the start sequence through a pty pair and
+ * measures readStartBytes (the receive buffer is 64 KiB, so the noise is discarded on the way).
+ *
+ * usage: Serialink-bench-delimiter [noiseMiB]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include "byte-search.hpp"
+#include "virtuser.hpp"
+
+typedef struct _BenchWriter {
+    Serial *serial;
+    const std::vector <unsigned char> *data;
+} BenchWriter;
+
+static const unsigned char startBytes[] = {0xAA, 0x55, 0x01, 0x7E};
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static double getCpuSeconds(){
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+}
+
+static bool findMemcmp(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz, size_t &position){
+    if (sz < patternSz) return false;
+    for (size_t i = 0; i <= sz - patternSz; i++){
+        if (memcmp(buffer + i, pattern, patternSz) == 0){
+            position = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::vector <unsigned char> createNoise(size_t sz, bool isRandom){
+    std::vector <unsigned char> noise(sz, startBytes[0]);
+    if (isRandom){
+        srand(1);
+        for (size_t i = 0; i < sz; i++){
+            noise[i] = static_cast<unsigned char>(rand() & 0xFF);
+            if (noise[i] == startBytes[0]) noise[i] = 0x00;
+        }
+    }
+    noise.insert(noise.end(), startBytes, startBytes + sizeof(startBytes));
+    return noise;
+}
+
+static void runSearch(const char *noiseName, const std::vector <unsigned char> &data){
+    const char *names[] = {"memcmp", "scalar", "sse2", "avx2"};
+    BYTE_SEARCH_ENGINE engines[] = {BYTE_SEARCH_ENGINE_SCALAR, BYTE_SEARCH_ENGINE_SCALAR, BYTE_SEARCH_ENGINE_SSE2, BYTE_SEARCH_ENGINE_AVX2};
+    size_t position = 0;
+    size_t repeat = 0;
+    double tStart = 0.0;
+    double elapsed = 0.0;
+    for (int i = 0; i < 4; i++){
+        if (i == 3 && ByteSearch::getEngine() != BYTE_SEARCH_ENGINE_AVX2) continue;
+        repeat = 0;
+        tStart = getTimeSeconds();
+        do {
+            if (i == 0) findMemcmp(data.data(), data.size(), startBytes, sizeof(startBytes), position);
+            else ByteSearch::find(engines[i], data.data(), data.size(), startBytes, sizeof(startBytes), position);
+            repeat++;
+            elapsed = getTimeSeconds() - tStart;
+        } while (elapsed < 0.5);
+        if (position != data.size() - sizeof(startBytes)){
+            std::cerr << names[i] << ": wrong position " << position << std::endl;
+        }
+        std::cout << std::setw(10) << noiseName << std::setw(10) << names[i]
+                  << std::setw(16) << std::fixed << std::setprecision(2)
+                  << (static_cast<double>(data.size()) * static_cast<double>(repeat) / elapsed / 1073741824.0)
+                  << std::endl;
+    }
+}
+
+static void *writerThread(void *param){
+    BenchWriter *writer = (BenchWriter *) param;
+    size_t sent = 0;
+    size_t sz = 0;
+    while (sent < writer->data->size()){
+        sz = writer->data->size() - sent;
+        if (sz > 4096) sz = 4096;
+        if (writer->serial->writeData(writer->data->data() + sent, sz) != 0) break;
+        sent += sz;
+    }
+    return nullptr;
+}
+
+static void runStream(const std::vector <unsigned char> &data){
+    VirtualSerial reader(B115200, 10, 0);
+    Serial slave(reader.getVirtualPortName(), B115200, 10);
+    BenchWriter writer;
+    pthread_t thread;
+    int ret = 0;
+    double tStart = 0.0;
+    double cpuStart = 0.0;
+    double elapsed = 0.0;
+    double cpu = 0.0;
+    if (slave.openPort() != 0){
+        std::cerr << "failed to open " << reader.getVirtualPortName() << std::endl;
+        return;
+    }
+    writer.serial = &slave;
+    writer.data = &data;
+    tStart = getTimeSeconds();
+    cpuStart = getCpuSeconds();
+    pthread_create(&thread, nullptr, writerThread, &writer);
+    ret = reader.readStartBytes(startBytes, sizeof(startBytes));
+    elapsed = getTimeSeconds() - tStart;
+    cpu = getCpuSeconds() - cpuStart;
+    pthread_join(thread, nullptr);
+    slave.closePort();
+    std::cout << "readStartBytes: ret " << ret << ", " << data.size() << " bytes in "
+              << std::fixed << std::setprecision(3) << elapsed << " s ("
+              << std::setprecision(0) << (static_cast<double>(data.size()) / elapsed) << " bytes/sec, cpu "
+              << std::setprecision(3) << cpu << " s)" << std::endl;
+}
+
+int main(int argc, char **argv){
+    size_t noiseSize = 8 * 1048576;
+    if (argc > 1) noiseSize = static_cast<size_t>(atoi(argv[1])) * 1048576;
+    std::vector <unsigned char> randomNoise = createNoise(noiseSize, true);
+    std::vector <unsigned char> firstByteNoise = createNoise(noiseSize, false);
+    std::cout << std::setw(10) << "noise" << std::setw(10) << "engine" << std::setw(16) << "GiB/sec" << std::endl;
+    runSearch("random", randomNoise);
+    runSearch("firstbyte", firstByteNoise);
+    runStream(randomNoise);
+    return 0;
+}
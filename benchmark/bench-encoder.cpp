@@ -0,0 +1,127 @@
+/*
+ * Frame encoder benchmark.
+ *
+ * Encodes the request frame of examples/framed-serial-protocol (start bytes, command, 3 data bytes,
+ * crc16 XMODEM and stop bytes) and prints the frames/sec of:
+ * - copy    : the previous ProtocolFormat::buildCommand, which copies the DataFrame list, sets the fields,
+ *             copies the checksum range and concatenates all fields for every frame.
+ * - setData : the fields of one DataFrame list are set, the checksum is calculated field by field and the
+ *             frame is collected with getAllData into a reused buffer (as Serialink::writeFramedData).
+ * - encoder : FrameEncoder::setField and FrameEncoder::encode on the pre-rendered frame.
+ * - batch   : the same, with 64 frames appended to one batch buffer (one write per 64 frames).
+ *
+ * usage: Serialink-bench-encoder [totalFrames]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+#include <time.h>
+#include "frame-encoder.hpp"
+
+static volatile size_t sink = 0;
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static std::vector <unsigned char> buildByCopy(DataFrame &format, const unsigned char *data, size_t sz){
+    unsigned char cmd = 0x35;
+    DataFrame reqFrame(DataFrame::FRAME_TYPE_START_BYTES, format.getDataAsVector());
+    reqFrame += *(format.getNext());
+    reqFrame[DataFrame::FRAME_TYPE_COMMAND]->setData(&cmd, 1);
+    reqFrame[DataFrame::FRAME_TYPE_DATA]->setData(data, sz);
+    std::vector <unsigned char> crcData = reqFrame.getSpecificDataAsVector(reqFrame[DataFrame::FRAME_TYPE_START_BYTES], reqFrame[DataFrame::FRAME_TYPE_DATA]);
+    unsigned int crc = Checksum::calculate(CHECKSUM_TYPE_CRC16_XMODEM, crcData.data(), crcData.size());
+    unsigned char checksum[2] = {static_cast<unsigned char>(crc & 0xFF), static_cast<unsigned char>(crc >> 8)};
+    reqFrame[DataFrame::FRAME_TYPE_VALIDATOR]->setData(checksum, 2);
+    return reqFrame.getAllDataAsVector();
+}
+
+static size_t buildBySetData(DataFrame &format, const unsigned char *data, size_t sz, std::vector <unsigned char> &field, std::vector <unsigned char> &frame){
+    unsigned char cmd = 0x35;
+    unsigned int state = Checksum::init(CHECKSUM_TYPE_CRC16_XMODEM);
+    DataFrame *tmp = &format;
+    format[DataFrame::FRAME_TYPE_COMMAND]->setData(&cmd, 1);
+    format[DataFrame::FRAME_TYPE_DATA]->setData(data, sz);
+    while (tmp != nullptr && tmp->getType() != DataFrame::FRAME_TYPE_VALIDATOR){
+        tmp->getData(field);
+        state = Checksum::update(CHECKSUM_TYPE_CRC16_XMODEM, state, field.data(), field.size());
+        tmp = tmp->getNext();
+    }
+    state = Checksum::finish(CHECKSUM_TYPE_CRC16_XMODEM, state);
+    unsigned char checksum[2] = {static_cast<unsigned char>(state & 0xFF), static_cast<unsigned char>(state >> 8)};
+    format[DataFrame::FRAME_TYPE_VALIDATOR]->setData(checksum, 2);
+    format.getAllData(frame);
+    return frame.size();
+}
+
+int main(int argc, char **argv){
+    const char *names[] = {"copy", "setData", "encoder", "batch"};
+    size_t totalFrames = 1000000;
+    unsigned char data[3] = {0x00, 0x00, 0x00};
+    double elapsed[4];
+    double tStart = 0.0;
+    std::vector <unsigned char> field;
+    std::vector <unsigned char> frame;
+    if (argc > 1) totalFrames = static_cast<size_t>(atol(argv[1]));
+    DataFrame format(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame crcBytes(DataFrame::FRAME_TYPE_VALIDATOR, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    format += cmdBytes + dataBytes + crcBytes + stopBytes;
+    FrameEncoder encoder(format);
+    encoder.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE);
+    encoder.setField(DataFrame::FRAME_TYPE_COMMAND, (const unsigned char *) "\x35", 1);
+    encoder.setField(DataFrame::FRAME_TYPE_DATA, data, 3);
+    if (buildByCopy(format, data, 3) != std::vector <unsigned char>(encoder.encode().begin(), encoder.encode().end())){
+        std::cout << "encoded frames do not match" << std::endl;
+        return 1;
+    }
+
+    tStart = getTimeSeconds();
+    for (size_t i = 0; i < totalFrames; i++){
+        data[0] = static_cast<unsigned char>(i);
+        sink = buildByCopy(format, data, 3).size();
+    }
+    elapsed[0] = getTimeSeconds() - tStart;
+
+    tStart = getTimeSeconds();
+    for (size_t i = 0; i < totalFrames; i++){
+        data[0] = static_cast<unsigned char>(i);
+        sink = buildBySetData(format, data, 3, field, frame);
+    }
+    elapsed[1] = getTimeSeconds() - tStart;
+
+    tStart = getTimeSeconds();
+    for (size_t i = 0; i < totalFrames; i++){
+        data[0] = static_cast<unsigned char>(i);
+        encoder.setField(DataFrame::FRAME_TYPE_DATA, data, 3);
+        sink = encoder.encode().size();
+    }
+    elapsed[2] = getTimeSeconds() - tStart;
+
+    tStart = getTimeSeconds();
+    for (size_t i = 0; i < totalFrames; i++){
+        data[0] = static_cast<unsigned char>(i);
+        encoder.setField(DataFrame::FRAME_TYPE_DATA, data, 3);
+        encoder.appendToBatch();
+        if ((i & 63) == 63){
+            sink = encoder.getBatch().size();
+            encoder.clearBatch();
+        }
+    }
+    elapsed[3] = getTimeSeconds() - tStart;
+
+    std::cout << std::setw(10) << "mode" << std::setw(16) << "frames/sec" << std::setw(10) << "speedup" << std::endl;
+    for (int i = 0; i < 4; i++){
+        std::cout << std::setw(10) << names[i]
+                  << std::setw(16) << std::fixed << std::setprecision(0) << static_cast<double>(totalFrames) / elapsed[i]
+                  << std::setw(9) << std::setprecision(2) << elapsed[0] / elapsed[i] << "x" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,490 @@
+/*
+ * Framed data parser benchmark for Serialink::readFramedData.
+ *
+ * The frames are written straight into the receive buffer, so the benchmark measures the
+ * parser only (no syscall). Two formats are used:
+ * - fixed      : start bytes, command, content length, 16 data bytes, 2 validator bytes, stop bytes.
+ * - until-stop : start bytes, command, data without size (read until the stop bytes), stop bytes.
+ * For each format it prints the frames/sec of the compiled field table (Serialink) and of the
+ * previous implementation, which walked the DataFrame list and copied the reference bytes of
+ * every frame with getReference.
+ *
+ * Then 4 KiB block-transfer frames (start bytes, command, 4096 data bytes, CRC16, stop bytes) are
+ * validated with a post-execution callback that copies the frame with getSpecificBufferAsVector and
+ * calculates the CRC after the fact, and with Serialink::setChecksum, which updates the CRC while
+ * the fields are parsed.
+ *
+ * Then the same fixed, until-stop and block formats are parsed by Serialink (DataFrame formats,
+ * with setChecksum for the block format) and by FramedSerial (layouts described at compile time).
+ *
+ * Finally a noisy stream of fixed frames with a CRC16 is parsed, where every 4th frame has lost
+ * 6 bytes and therefore swallows the beginning of the next frame. It prints the valid frames found
+ * and the frames/sec when the whole rejected frame is discarded (the previous behaviour) and with
+ * the resynchronisation at the next start bytes inside the rejected frame.
+ *
+ * The fixed frames are also read in bursts of 64 frames, with a readFramedData loop that copies each
+ * frame out of the receive buffer (getBufferAsVector) and with Serialink::readFrames into an arena.
+ *
+ * usage: Serialink-bench-frames [totalFrames]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include "serialink.hpp"
+#include "frame-layout.hpp"
+
+class BenchLink : public Serialink {
+  public:
+    using Serialink::operator=;
+
+    size_t feed(const std::vector <unsigned char> &data){
+        return this->rxBuffer.write(data.data(), data.size());
+    }
+
+    size_t getFreeSpace(){
+        return this->rxBuffer.getFreeSpace();
+    }
+};
+
+class DroppingLink : public BenchLink {
+  public:
+    using Serialink::operator=;
+
+    int readFramedData(){
+        int ret = Serialink::readFramedData();
+        /* the previous behaviour, all bytes of a rejected frame are discarded */
+        if (ret == 4) this->releaseData();
+        return ret;
+    }
+};
+
+class LegacyLink : public Serial {
+  private:
+    bool isFormatValid;
+    DataFrame *frameFormat;
+  public:
+    LegacyLink(DataFrame *format){
+        this->usb = nullptr;
+        this->isFormatValid = true;
+        this->frameFormat = format;
+    }
+
+    size_t feed(const std::vector <unsigned char> &data){
+        return this->rxBuffer.write(data.data(), data.size());
+    }
+
+    size_t getFreeSpace(){
+        return this->rxBuffer.getFreeSpace();
+    }
+
+    int readFramedData(){
+        if (this->frameFormat == nullptr) return 3;
+        DataFrame *tmp = this->frameFormat;
+        std::vector <unsigned char> vecUC;
+        int ret = 0;
+        size_t frameOffset = 0;
+        size_t frameSize = 0;
+        void (*callback)(DataFrame &, void *) = nullptr;
+        this->isFormatValid = true;
+        this->retainData = false;
+        this->isInputExhausted = false;
+        this->releaseData();
+        while (tmp != nullptr){
+            if (tmp->getExecuteFunction() != nullptr){
+                callback = (void (*)(DataFrame &, void *))tmp->getExecuteFunction();
+                callback(*tmp, tmp->getExecuteFunctionParam());
+            }
+            if (tmp->getType() == DataFrame::FRAME_TYPE_START_BYTES && tmp->getReference(vecUC) > 0){
+                if (this->readStartBytes(vecUC.data(), vecUC.size())){
+                    ret = 2;
+                    break;
+                }
+            }
+            else if (tmp->getType() == DataFrame::FRAME_TYPE_STOP_BYTES && tmp->getReference(vecUC) > 0){
+                if (this->readStopBytes(vecUC.data(), vecUC.size())){
+                    ret = 2;
+                    break;
+                }
+            }
+            else if (tmp->getType() == DataFrame::FRAME_TYPE_CONTENT_LENGTH ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_COMMAND ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_SN ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_RFU ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_BLOCK_NUMBER ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_DATA ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_DATA_1 ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_DATA_2 ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_DATA_3 ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_DATA_4 ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_DATA_5 ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_DATA_6 ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_DATA_7 ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_DATA_8 ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_DATA_9 ||
+                     tmp->getType() == DataFrame::FRAME_TYPE_VALIDATOR
+            ){
+                if (tmp->getSize() > 0){
+                    if (this->readNBytes(tmp->getSize()) == 0){
+                        if (this->dataSize > 0){
+                            tmp->setData(this->rxBuffer.getData() + this->dataOffset, this->dataSize);
+                        }
+                        else {
+                            ret = 2;
+                            break;
+                        }
+                    }
+                    else if (this->isPollMode){
+                        ret = 2;
+                        break;
+                    }
+                }
+                else if (tmp->getNext() != nullptr) {
+                    if (tmp->getNext()->getType() == DataFrame::FRAME_TYPE_STOP_BYTES &&
+                        tmp->getNext()->getReference(vecUC) > 0
+                    ){
+                        if (this->readUntilStopBytes(vecUC.data(), vecUC.size()) == 0){
+                            if (this->dataSize > 0){
+                                size_t sz = this->dataSize - vecUC.size();
+                                tmp->setData(this->rxBuffer.getData() + this->dataOffset, sz);
+                                if (tmp->getPostExecuteFunction() != nullptr){
+                                    callback = (void (*)(DataFrame &, void *))tmp->getPostExecuteFunction();
+                                    callback(*tmp, tmp->getPostExecuteFunctionParam());
+                                }
+                                tmp = tmp->getNext();
+                                if (tmp->getExecuteFunction() != nullptr){
+                                    callback = (void (*)(DataFrame &, void *))tmp->getExecuteFunction();
+                                    callback(*tmp, tmp->getExecuteFunctionParam());
+                                }
+                            }
+                        }
+                        else {
+                            ret = 2;
+                            break;
+                        }
+                    }
+                    else {
+                        ret = 4;
+                        break;
+                    }
+                }
+                else {
+                    ret = 4;
+                    break;
+                }
+            }
+            else {
+                ret = 4;
+                break;
+            }
+            if (tmp->getPostExecuteFunction() != nullptr){
+                callback = (void (*)(DataFrame &, void *))tmp->getPostExecuteFunction();
+                callback(*tmp, tmp->getPostExecuteFunctionParam());
+            }
+            if (this->isFormatValid == false){
+                ret = 4;
+                break;
+            }
+            if (this->retainData == false){
+                frameOffset = this->dataOffset;
+                this->retainData = true;
+            }
+            tmp = tmp->getNext();
+            this->releaseData();
+        }
+        this->retainData = false;
+        if (ret == 0){
+            frameSize = this->dataOffset - frameOffset;
+        }
+        else if (tmp != nullptr){
+            frameSize = this->dataOffset + this->dataSize - frameOffset;
+        }
+        this->rxBuffer.consume(frameOffset);
+        this->dataOffset = 0;
+        this->dataSize = frameSize;
+        return ret;
+    }
+};
+
+template <class Layout>
+class BenchLayout : public FramedSerial <Layout> {
+  public:
+    size_t feed(const std::vector <unsigned char> &data){
+        return this->rxBuffer.write(data.data(), data.size());
+    }
+
+    size_t getFreeSpace(){
+        return this->rxBuffer.getFreeSpace();
+    }
+
+    int readFramedData(){
+        return this->readFrame();
+    }
+};
+
+typedef FrameLayout::StartBytes <0xAA, 0x55> BenchStart;
+typedef FrameLayout::Data <FrameLayout::Fixed <4096> > BenchBlock;
+typedef FrameLayout::Frame <
+    BenchStart,
+    FrameLayout::Cmd <1>,
+    FrameLayout::ContentLength <1>,
+    FrameLayout::Data <FrameLayout::Fixed <16> >,
+    FrameLayout::Field <DataFrame::FRAME_TYPE_VALIDATOR, FrameLayout::Fixed <2> >,
+    FrameLayout::StopBytes <'\r', '\n'>
+> BenchFixedLayout;
+typedef FrameLayout::Frame <
+    BenchStart,
+    FrameLayout::Cmd <1>,
+    FrameLayout::Data <FrameLayout::UntilStop>,
+    FrameLayout::StopBytes <'\r', '\n'>
+> BenchTextLayout;
+typedef FrameLayout::Frame <
+    BenchStart,
+    FrameLayout::Cmd <1>,
+    BenchBlock,
+    FrameLayout::Crc <CHECKSUM_TYPE_CRC16_CCITT, BenchStart, BenchBlock, SERIALINK_ENDIAN_BIG>,
+    FrameLayout::StopBytes <'\r', '\n'>
+> BenchBlockLayout;
+
+static void validateCallback(DataFrame &frame, void *ptr){
+    BenchLink *link = (BenchLink *) ptr;
+    unsigned char received[2];
+    std::vector <unsigned char> data = link->getSpecificBufferAsVector(DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA);
+    unsigned int crc = Checksum::calculate(CHECKSUM_TYPE_CRC16_CCITT, data.data(), data.size());
+    frame.getData(received, 2);
+    if (received[0] != ((crc >> 8) & 0xFF) || received[1] != (crc & 0xFF)) link->trigInvDataIndicator();
+}
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static std::vector <unsigned char> createBatch(const std::vector <unsigned char> &frame, size_t capacity, size_t &count){
+    std::vector <unsigned char> batch;
+    count = capacity / frame.size();
+    for (size_t i = 0; i < count; i++){
+        batch.insert(batch.end(), frame.begin(), frame.end());
+    }
+    return batch;
+}
+
+template <typename T>
+static double runParser(T &link, const std::vector <unsigned char> &frame, size_t total){
+    size_t count = 0;
+    size_t parsed = 0;
+    size_t i = 0;
+    double tStart = 0.0;
+    std::vector <unsigned char> batch = createBatch(frame, link.getFreeSpace() - frame.size(), count);
+    tStart = getTimeSeconds();
+    while (parsed < total){
+        link.feed(batch);
+        for (i = 0; i < count; i++){
+            if (link.readFramedData() != 0){
+                std::cerr << "parse error after " << (parsed + i) << " frames" << std::endl;
+                return 0.0;
+            }
+        }
+        parsed += count;
+    }
+    return static_cast<double>(parsed) / (getTimeSeconds() - tStart);
+}
+
+static void runBenchmark(const std::string &name, const DataFrame &format, const std::vector <unsigned char> &frame, size_t total){
+    BenchLink link;
+    double compiled = 0.0;
+    double legacy = 0.0;
+    link = format;
+    LegacyLink legacyLink(link.getFormat());
+    legacy = runParser(legacyLink, frame, total);
+    compiled = runParser(link, frame, total);
+    std::cout << std::setw(12) << name
+              << std::setw(8) << frame.size()
+              << std::setw(16) << std::fixed << std::setprecision(0) << legacy
+              << std::setw(16) << compiled
+              << std::setw(10) << std::setprecision(2) << (legacy > 0.0 ? compiled / legacy : 0.0)
+              << std::endl;
+}
+
+static void runValidatorBenchmark(const DataFrame &format, const std::vector <unsigned char> &frame, size_t total){
+    BenchLink callbackLink;
+    BenchLink checksumLink;
+    double callback = 0.0;
+    double incremental = 0.0;
+    callbackLink = format;
+    callbackLink[DataFrame::FRAME_TYPE_VALIDATOR]->setPostExecuteFunction((const void *) &validateCallback, &callbackLink);
+    checksumLink = format;
+    checksumLink.setChecksum(CHECKSUM_TYPE_CRC16_CCITT, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_BIG);
+    callback = runParser(callbackLink, frame, total);
+    incremental = runParser(checksumLink, frame, total);
+    std::cout << std::setw(12) << "block-crc16"
+              << std::setw(8) << frame.size()
+              << std::setw(16) << std::fixed << std::setprecision(0) << callback
+              << std::setw(16) << incremental
+              << std::setw(10) << std::setprecision(2) << (callback > 0.0 ? incremental / callback : 0.0)
+              << std::endl;
+}
+
+template <class Layout>
+static void runLayoutBenchmark(const std::string &name, const DataFrame &format, const std::vector <unsigned char> &frame, size_t total, bool isChecksum){
+    BenchLink link;
+    BenchLayout <Layout> layout;
+    double runtime = 0.0;
+    double compileTime = 0.0;
+    link = format;
+    if (isChecksum){
+        link.setChecksum(CHECKSUM_TYPE_CRC16_CCITT, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_BIG);
+    }
+    runtime = runParser(link, frame, total);
+    compileTime = runParser(layout, frame, total);
+    std::cout << std::setw(12) << name
+              << std::setw(8) << frame.size()
+              << std::setw(16) << std::fixed << std::setprecision(0) << runtime
+              << std::setw(16) << compileTime
+              << std::setw(10) << std::setprecision(2) << (runtime > 0.0 ? compileTime / runtime : 0.0)
+              << std::endl;
+}
+
+template <typename T>
+static double runNoisyParser(T &link, const std::vector <unsigned char> &frame, size_t total, size_t &valid){
+    size_t count = 0;
+    size_t parsed = 0;
+    int ret = 0;
+    double tStart = 0.0;
+    std::vector <unsigned char> group;
+    std::vector <unsigned char> batch;
+    /* every 4th frame loses 6 data bytes */
+    group.insert(group.end(), frame.begin(), frame.begin() + 8);
+    group.insert(group.end(), frame.begin() + 14, frame.end());
+    for (int i = 0; i < 3; i++) group.insert(group.end(), frame.begin(), frame.end());
+    batch = createBatch(group, link.getFreeSpace() - group.size(), count);
+    valid = 0;
+    tStart = getTimeSeconds();
+    while (parsed < total){
+        link.feed(batch);
+        do {
+            ret = link.readFramedData();
+            if (ret == 0) valid++;
+        } while (ret == 0 || ret == 4);
+        parsed += count * 4;
+    }
+    return static_cast<double>(valid) / (getTimeSeconds() - tStart);
+}
+
+static void runResyncBenchmark(const DataFrame &format, const std::vector <unsigned char> &frame, size_t total){
+    DroppingLink droppingLink;
+    BenchLink resyncLink;
+    size_t dropped = 0;
+    size_t resynced = 0;
+    double dropping = 0.0;
+    double resync = 0.0;
+    droppingLink = format;
+    droppingLink.setChecksum(CHECKSUM_TYPE_CRC16_CCITT, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_BIG);
+    resyncLink = format;
+    resyncLink.setChecksum(CHECKSUM_TYPE_CRC16_CCITT, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_BIG);
+    dropping = runNoisyParser(droppingLink, frame, total, dropped);
+    resync = runNoisyParser(resyncLink, frame, total, resynced);
+    std::cout << std::setw(12) << "dropping"
+              << std::setw(16) << dropped
+              << std::setw(16) << std::fixed << std::setprecision(0) << dropping
+              << std::setw(10) << std::setprecision(2) << 1.0 << std::endl;
+    std::cout << std::setw(12) << "resync"
+              << std::setw(16) << resynced
+              << std::setw(16) << std::fixed << std::setprecision(0) << resync
+              << std::setw(10) << std::setprecision(2) << (dropping > 0.0 ? resync / dropping : 0.0) << std::endl;
+}
+
+static void runBurstBenchmark(const DataFrame &format, const std::vector <unsigned char> &frame, size_t total){
+    BenchLink link;
+    SerialinkFrameArena arena;
+    std::vector <std::vector <unsigned char> > frames;
+    size_t count = 0;
+    size_t parsed = 0;
+    size_t i = 0;
+    double tStart = 0.0;
+    double loop = 0.0;
+    double burst = 0.0;
+    link = format;
+    std::vector <unsigned char> batch = createBatch(frame, 64 * frame.size(), count);
+    tStart = getTimeSeconds();
+    for (parsed = 0; parsed < total; parsed += count){
+        link.feed(batch);
+        frames.clear();
+        for (i = 0; i < count && link.readFramedData() == 0; i++){
+            frames.push_back(link.getBufferAsVector());
+        }
+    }
+    loop = static_cast<double>(parsed) / (getTimeSeconds() - tStart);
+    tStart = getTimeSeconds();
+    for (parsed = 0; parsed < total; parsed += count){
+        link.feed(batch);
+        if (link.readFrames(count, 0, arena) != 0 || arena.frames.size() != count){
+            std::cerr << "burst error after " << parsed << " frames" << std::endl;
+            return;
+        }
+    }
+    burst = static_cast<double>(parsed) / (getTimeSeconds() - tStart);
+    std::cout << std::setw(12) << "fixed"
+              << std::setw(8) << frame.size()
+              << std::setw(16) << std::fixed << std::setprecision(0) << loop
+              << std::setw(16) << burst
+              << std::setw(10) << std::setprecision(2) << (loop > 0.0 ? burst / loop : 0.0)
+              << std::endl;
+}
+
+int main(int argc, char **argv){
+    size_t total = 4000000;
+    if (argc > 1) total = static_cast<size_t>(atol(argv[1]));
+
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "\xAA\x55");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, 16);
+    DataFrame validatorBytes(DataFrame::FRAME_TYPE_VALIDATOR, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "\r\n");
+    DataFrame textBytes(DataFrame::FRAME_TYPE_DATA);
+
+    std::vector <unsigned char> fixedFrame = {0xAA, 0x55, 0x01, 0x10};
+    for (unsigned char i = 0; i < 16; i++) fixedFrame.push_back(static_cast<unsigned char>('a' + i));
+    fixedFrame.insert(fixedFrame.end(), {0x12, 0x34, '\r', '\n'});
+    std::vector <unsigned char> textFrame = {0xAA, 0x55, 0x02};
+    for (unsigned char i = 0; i < 24; i++) textFrame.push_back(static_cast<unsigned char>('A' + i));
+    textFrame.insert(textFrame.end(), {'\r', '\n'});
+
+    std::cout << std::setw(12) << "format" << std::setw(8) << "bytes" << std::setw(16) << "legacy f/s"
+              << std::setw(16) << "compiled f/s" << std::setw(10) << "speedup" << std::endl;
+    runBenchmark("fixed", startBytes + cmdBytes + lengthBytes + dataBytes + validatorBytes + stopBytes, fixedFrame, total);
+    runBenchmark("until-stop", startBytes + cmdBytes + textBytes + stopBytes, textFrame, total);
+
+    DataFrame blockBytes(DataFrame::FRAME_TYPE_DATA, 4096);
+    std::vector <unsigned char> blockFrame = {0xAA, 0x55, 0x03};
+    for (size_t i = 0; i < 4096; i++) blockFrame.push_back(static_cast<unsigned char>(i * 7));
+    unsigned int crc = Checksum::calculate(CHECKSUM_TYPE_CRC16_CCITT, blockFrame.data(), blockFrame.size());
+    blockFrame.insert(blockFrame.end(), {static_cast<unsigned char>(crc >> 8), static_cast<unsigned char>(crc & 0xFF), '\r', '\n'});
+    std::cout << std::endl << std::setw(12) << "format" << std::setw(8) << "bytes" << std::setw(16) << "callback f/s"
+              << std::setw(16) << "running f/s" << std::setw(10) << "speedup" << std::endl;
+    runValidatorBenchmark(startBytes + cmdBytes + blockBytes + validatorBytes + stopBytes, blockFrame, total / 20);
+
+    std::cout << std::endl << std::setw(12) << "format" << std::setw(8) << "bytes" << std::setw(16) << "Serialink f/s"
+              << std::setw(16) << "layout f/s" << std::setw(10) << "speedup" << std::endl;
+    runLayoutBenchmark<BenchFixedLayout>("fixed", startBytes + cmdBytes + lengthBytes + dataBytes + validatorBytes + stopBytes, fixedFrame, total, false);
+    runLayoutBenchmark<BenchTextLayout>("until-stop", startBytes + cmdBytes + textBytes + stopBytes, textFrame, total, false);
+    runLayoutBenchmark<BenchBlockLayout>("block-crc16", startBytes + cmdBytes + blockBytes + validatorBytes + stopBytes, blockFrame, total / 20, true);
+
+    std::vector <unsigned char> noisyFrame(fixedFrame.begin(), fixedFrame.end() - 4);
+    crc = Checksum::calculate(CHECKSUM_TYPE_CRC16_CCITT, noisyFrame.data(), noisyFrame.size());
+    noisyFrame.insert(noisyFrame.end(), {static_cast<unsigned char>(crc >> 8), static_cast<unsigned char>(crc & 0xFF), '\r', '\n'});
+    std::cout << std::endl << std::setw(12) << "noisy" << std::setw(16) << "valid frames"
+              << std::setw(16) << "valid f/s" << std::setw(10) << "speedup" << std::endl;
+    runResyncBenchmark(startBytes + cmdBytes + lengthBytes + dataBytes + validatorBytes + stopBytes, noisyFrame, total);
+
+    std::cout << std::endl << std::setw(12) << "burst" << std::setw(8) << "bytes" << std::setw(16) << "loop f/s"
+              << std::setw(16) << "readFrames f/s" << std::setw(10) << "speedup" << std::endl;
+    runBurstBenchmark(startBytes + cmdBytes + lengthBytes + dataBytes + validatorBytes + stopBytes, fixedFrame, total);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * read/write syscalls versus io_uring backend benchmark.
+ *
+ * A writer thread streams data into the slave side of a VirtualSerial pty, while the
+ * master side is drained with Serial::readData. Both ends use the same I/O backend
+ * (Serial::setIOBackend). For each backend, this program prints the throughput
+ * (bytes/sec) and the CPU time per byte of the whole process (getrusage, including
+ * the io_uring worker threads).
+ *
+ * usage: Serialink-bench-io-uring [totalMiB] [readChunkSize]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include "virtuser.hpp"
+
+typedef struct _BenchWriter {
+    Serial *serial;
+    size_t total;
+} BenchWriter;
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static double getCpuSeconds(const struct rusage &usage){
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+}
+
+static void *writerThread(void *param){
+    BenchWriter *writer = (BenchWriter *) param;
+    std::vector <unsigned char> block(4096);
+    size_t sent = 0;
+    size_t sz = 0;
+    for (size_t i = 0; i < block.size(); i++) block[i] = static_cast<unsigned char>(i);
+    while (sent < writer->total){
+        sz = (writer->total - sent < block.size() ? writer->total - sent : block.size());
+        if (writer->serial->writeData(block.data(), sz) != 0) break;
+        sent += sz;
+    }
+    return nullptr;
+}
+
+static void runBenchmark(IO_BACKEND backend, size_t chunkSize, size_t total){
+    VirtualSerial reader(B115200, 10, 0);
+    Serial slave(reader.getVirtualPortName(), B115200, 10);
+    BenchWriter writer;
+    pthread_t thread;
+    struct rusage usageStart, usageEnd;
+    size_t received = 0;
+    double tStart = 0.0;
+    double elapsed = 0.0;
+    double cpu = 0.0;
+    if (reader.setIOBackend(backend) == false || slave.setIOBackend(backend) == false){
+        std::cout << std::setw(10) << "io_uring" << "  not supported by the running kernel" << std::endl;
+        return;
+    }
+    reader.setReadChunkSize(chunkSize);
+    if (slave.openPort() != 0){
+        std::cerr << "failed to open " << reader.getVirtualPortName() << std::endl;
+        return;
+    }
+    writer.serial = &slave;
+    writer.total = total;
+    getrusage(RUSAGE_SELF, &usageStart);
+    tStart = getTimeSeconds();
+    pthread_create(&thread, nullptr, writerThread, &writer);
+    while (received < total){
+        if (reader.readData() != 0) break;
+        received += reader.getDataSize();
+    }
+    pthread_join(thread, nullptr);
+    elapsed = getTimeSeconds() - tStart;
+    getrusage(RUSAGE_SELF, &usageEnd);
+    slave.closePort();
+    cpu = getCpuSeconds(usageEnd) - getCpuSeconds(usageStart);
+    std::cout << std::setw(10) << (backend == IO_BACKEND_IO_URING ? "io_uring" : "syscall")
+              << std::setw(16) << std::fixed << std::setprecision(0) << (static_cast<double>(received) / elapsed)
+              << std::setw(12) << std::setprecision(3) << cpu
+              << std::setw(14) << std::setprecision(2) << (cpu * 1000000000.0 / static_cast<double>(received))
+              << std::setw(12) << received
+              << std::endl;
+}
+
+int main(int argc, char **argv){
+    size_t total = 64 * 1048576;
+    size_t chunkSize = 4096;
+    if (argc > 1) total = static_cast<size_t>(atoi(argv[1])) * 1048576;
+    if (argc > 2) chunkSize = static_cast<size_t>(atoi(argv[2]));
+    std::cout << std::setw(10) << "backend" << std::setw(16) << "bytes/sec" << std::setw(12) << "cpu(s)" << std::setw(14) << "cpu ns/byte" << std::setw(12) << "bytes" << std::endl;
+    runBenchmark(IO_BACKEND_SYSCALL, chunkSize, total);
+    runBenchmark(IO_BACKEND_IO_URING, chunkSize, total);
+    return 0;
+}
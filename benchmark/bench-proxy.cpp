@@ -0,0 +1,217 @@
+/*
+ * Full-duplex forwarding benchmark for VirtualSerialProxy.
+ *
+ * A "device" VirtualSerial pty plays the physical port and an application Serial is connected
+ * to the pty of the proxy. Both ends stream data at the same time, then each end sends small
+ * messages one by one to measure the one-way latency of each direction. The proxy (epoll
+ * based) is compared with the previous forwarding loop (select, one direction per wakeup,
+ * blocking readData with a 10 ms keep-alive), which is reproduced here as the reference.
+ *
+ * usage: Serialink-bench-proxy [totalMiB] [latencySamples]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/select.h>
+#include "virtual-proxy.hpp"
+
+typedef struct _BenchStream {
+    Serial *writer;
+    Serial *reader;
+    size_t total;
+    size_t received;
+    double elapsed;
+} BenchStream;
+
+typedef struct _BenchLegacyProxy {
+    Serial *dev;
+    VirtualSerial *pty;
+    volatile bool isRunning;
+} BenchLegacyProxy;
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static void *writerThread(void *param){
+    BenchStream *stream = (BenchStream *) param;
+    std::vector <unsigned char> block(1024, 0x5A);
+    size_t sent = 0;
+    size_t sz = 0;
+    while (sent < stream->total){
+        sz = (stream->total - sent < block.size() ? stream->total - sent : block.size());
+        if (stream->writer->writeData(block.data(), sz) != 0) break;
+        sent += sz;
+    }
+    return nullptr;
+}
+
+static void *readerThread(void *param){
+    BenchStream *stream = (BenchStream *) param;
+    double tStart = getTimeSeconds();
+    stream->received = 0;
+    while (stream->received < stream->total){
+        if (stream->reader->readData() != 0) break;
+        stream->received += stream->reader->getDataSize();
+    }
+    stream->elapsed = getTimeSeconds() - tStart;
+    return nullptr;
+}
+
+static void legacyPassThrough(Serial &src, Serial &dest){
+    if (src.readData() == 0){
+        dest.writeData(src.getBufferAsVector());
+    }
+}
+
+static void *legacyProxyThread(void *param){
+    BenchLegacyProxy *proxy = (BenchLegacyProxy *) param;
+    fd_set readfds;
+    int max = 0;
+    struct timeval tv;
+    int devFd = proxy->dev->getFileDescriptor();
+    int ptyFd = proxy->pty->getFileDescriptor();
+    max = (devFd > ptyFd ? devFd : ptyFd);
+    while (proxy->isRunning){
+        tv.tv_sec = 0;
+        tv.tv_usec = 100000;
+        FD_ZERO(&readfds);
+        FD_SET(devFd, &readfds);
+        FD_SET(ptyFd, &readfds);
+        if (select(max + 1, &readfds, NULL, NULL, &tv) > 0){
+            if (FD_ISSET(devFd, &readfds)){
+                legacyPassThrough(*(proxy->dev), *(proxy->pty));
+            }
+            else if (FD_ISSET(ptyFd, &readfds)){
+                legacyPassThrough(*(proxy->pty), *(proxy->dev));
+            }
+        }
+    }
+    return nullptr;
+}
+
+static void *proxyThread(void *param){
+    VirtualSerialProxy *proxy = (VirtualSerialProxy *) param;
+    proxy->begin();
+    return nullptr;
+}
+
+static void measureLatency(Serial &writer, Serial &reader, size_t samples, double &avgUs, double &maxUs){
+    double total = 0.0;
+    double sample = 0.0;
+    size_t count = 0;
+    maxUs = 0.0;
+    for (size_t i = 0; i < samples; i++){
+        double tStart = getTimeSeconds();
+        if (writer.writeData((const unsigned char *) "latency!", 8) != 0) break;
+        if (reader.readNBytes(8) != 0) break;
+        sample = (getTimeSeconds() - tStart) * 1000000.0;
+        total += sample;
+        if (sample > maxUs) maxUs = sample;
+        count++;
+    }
+    avgUs = (count > 0 ? total / static_cast<double>(count) : 0.0);
+}
+
+static void runBenchmark(bool useLegacy, size_t total, size_t samples){
+    VirtualSerial device(B115200, 10, 0);
+    VirtualSerialProxy proxy(device.getVirtualPortName().c_str(), B115200);
+    BenchLegacyProxy legacy;
+    VirtualSerial *legacyPty = nullptr;
+    Serial *legacyDev = nullptr;
+    Serial client;
+    pthread_t thread;
+    pthread_t threads[4];
+    BenchStream streams[2];
+    double latencyAvg[2], latencyMax[2];
+    std::string clientPort;
+    if (useLegacy){
+        legacyPty = new VirtualSerial(B115200, 10, 10);
+        legacyDev = new Serial(device.getVirtualPortName(), B115200, 10, 10);
+        legacyPty->setPort(legacyPty->getVirtualPortName());
+        legacyDev->openPort();
+        legacy.dev = legacyDev;
+        legacy.pty = legacyPty;
+        legacy.isRunning = true;
+        clientPort = legacyPty->getVirtualPortName();
+        pthread_create(&thread, nullptr, legacyProxyThread, &legacy);
+    }
+    else {
+        clientPort = proxy.getVirtualPortName();
+        pthread_create(&thread, nullptr, proxyThread, &proxy);
+    }
+    usleep(100000);
+    client.setPort(clientPort);
+    client.setBaudrate(B115200);
+    client.setTimeout(10);
+    if (client.openPort() != 0){
+        std::cerr << "failed to open " << clientPort << std::endl;
+    }
+    /* full-duplex throughput: device -> app and app -> device at the same time */
+    streams[0].writer = &device;
+    streams[0].reader = &client;
+    streams[1].writer = &client;
+    streams[1].reader = &device;
+    for (size_t i = 0; i < 2; i++){
+        streams[i].total = total;
+        streams[i].received = 0;
+        streams[i].elapsed = 0.0;
+        pthread_create(&threads[i * 2], nullptr, readerThread, &streams[i]);
+        pthread_create(&threads[i * 2 + 1], nullptr, writerThread, &streams[i]);
+    }
+    for (size_t i = 0; i < 4; i++){
+        pthread_join(threads[i], nullptr);
+    }
+    /* one-way latency of each direction */
+    measureLatency(device, client, samples, latencyAvg[0], latencyMax[0]);
+    measureLatency(client, device, samples, latencyAvg[1], latencyMax[1]);
+    if (useLegacy){
+        legacy.isRunning = false;
+        pthread_join(thread, nullptr);
+        delete legacyDev;
+        delete legacyPty;
+    }
+    else {
+        proxy.stop();
+        pthread_join(thread, nullptr);
+    }
+    for (size_t i = 0; i < 2; i++){
+        std::cout << std::setw(8) << (useLegacy ? "select" : "epoll")
+                  << std::setw(16) << (i == 0 ? "device->app" : "app->device")
+                  << std::setw(16) << std::fixed << std::setprecision(0) << (static_cast<double>(streams[i].received) / streams[i].elapsed)
+                  << std::setw(14) << std::setprecision(1) << latencyAvg[i]
+                  << std::setw(14) << latencyMax[i]
+                  << std::setw(12) << streams[i].received
+                  << std::endl;
+    }
+    if (useLegacy == false){
+        for (size_t i = 0; i < 2; i++){
+            VirtualSerialProxyStats stats = proxy.getStats(i == 0 ? PROXY_DIRECTION_DEVICE_TO_PTY : PROXY_DIRECTION_PTY_TO_DEVICE);
+            std::cout << std::setw(24) << (i == 0 ? "proxy device->pty" : "proxy pty->device")
+                      << "  bytes=" << stats.bytes
+                      << " chunks=" << stats.chunks
+                      << " avgForwardUs=" << std::setprecision(2) << (stats.chunks > 0 ? static_cast<double>(stats.totalLatencyUs) / static_cast<double>(stats.chunks) : 0.0)
+                      << " maxForwardUs=" << stats.maxLatencyUs
+                      << std::endl;
+        }
+    }
+}
+
+int main(int argc, char **argv){
+    size_t total = 8 * 1048576;
+    size_t samples = 200;
+    if (argc > 1) total = static_cast<size_t>(atoi(argv[1])) * 1048576;
+    if (argc > 2) samples = static_cast<size_t>(atoi(argv[2]));
+    std::cout << std::setw(8) << "mode" << std::setw(16) << "direction" << std::setw(16) << "bytes/sec" << std::setw(14) << "avg lat(us)" << std::setw(14) << "max lat(us)" << std::setw(12) << "bytes" << std::endl;
+    runBenchmark(true, total, samples);
+    runBenchmark(false, total, samples);
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * Thread-per-port versus SerialReactor benchmark.
+ *
+ * This program creates N VirtualSerial pty pairs (256 by default). A few writer threads
+ * stream fixed-size messages into the slave side of every pty, while the master sides are
+ * drained either by one blocking reader thread per port (Serial::readData) or by a single
+ * SerialReactor thread (epoll). For each mode it prints the elapsed time, the throughput,
+ * the CPU time and the number of context switches of the whole process (getrusage).
+ * The writer threads are identical in both modes.
+ *
+ * usage: Serialink-bench-reactor [ports] [messagesPerPort] [messageSize]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include "serial-reactor.hpp"
+#include "virtuser.hpp"
+
+#define BENCH_WRITER_THREADS 4
+
+typedef struct _BenchContext {
+    std::vector <VirtualSerial *> masters;
+    std::vector <Serial *> slaves;
+    std::vector <size_t> received;
+    size_t messages;
+    size_t messageSize;
+    size_t expected;
+    size_t completed;
+    SerialReactor *reactor;
+} BenchContext;
+
+typedef struct _BenchWriter {
+    BenchContext *ctx;
+    size_t index;
+} BenchWriter;
+
+typedef struct _BenchReader {
+    BenchContext *ctx;
+    size_t index;
+} BenchReader;
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static double getCpuSeconds(const struct rusage &usage){
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+}
+
+static void *writerThread(void *param){
+    BenchWriter *writer = (BenchWriter *) param;
+    BenchContext *ctx = writer->ctx;
+    std::vector <unsigned char> message(ctx->messageSize, 0x55);
+    for (size_t i = 0; i < ctx->messages; i++){
+        for (size_t j = writer->index; j < ctx->slaves.size(); j += BENCH_WRITER_THREADS){
+            ctx->slaves[j]->writeData(message.data(), message.size());
+        }
+    }
+    return nullptr;
+}
+
+static void *readerThread(void *param){
+    BenchReader *reader = (BenchReader *) param;
+    BenchContext *ctx = reader->ctx;
+    VirtualSerial *master = ctx->masters[reader->index];
+    while (ctx->received[reader->index] < ctx->expected){
+        if (master->readData() != 0) break;
+        ctx->received[reader->index] += master->getDataSize();
+    }
+    return nullptr;
+}
+
+static void reactorCallback(Serial &serial, const unsigned char *data, size_t sz, void *param){
+    BenchReader *reader = (BenchReader *) param;
+    BenchContext *ctx = reader->ctx;
+    size_t before = ctx->received[reader->index];
+    (void) serial;
+    (void) data;
+    ctx->received[reader->index] += sz;
+    if (before < ctx->expected && ctx->received[reader->index] >= ctx->expected){
+        ctx->completed++;
+        if (ctx->completed == ctx->masters.size()) ctx->reactor->stop();
+    }
+}
+
+static void *reactorThread(void *param){
+    BenchContext *ctx = (BenchContext *) param;
+    ctx->reactor->begin();
+    return nullptr;
+}
+
+static void runBenchmark(BenchContext &ctx, bool useReactor){
+    std::vector <pthread_t> readers;
+    std::vector <BenchReader> readerParams(ctx.masters.size());
+    pthread_t writers[BENCH_WRITER_THREADS];
+    BenchWriter writerParams[BENCH_WRITER_THREADS];
+    struct rusage usageStart, usageEnd;
+    size_t total = 0;
+    SerialReactor reactor;
+    ctx.reactor = &reactor;
+    ctx.completed = 0;
+    ctx.received.assign(ctx.masters.size(), 0);
+    for (size_t i = 0; i < ctx.masters.size(); i++){
+        readerParams[i].ctx = &ctx;
+        readerParams[i].index = i;
+        if (useReactor) reactor.addPort(ctx.masters[i], &reactorCallback, &readerParams[i]);
+    }
+    getrusage(RUSAGE_SELF, &usageStart);
+    double tStart = getTimeSeconds();
+    if (useReactor){
+        readers.resize(1);
+        pthread_create(&readers[0], nullptr, reactorThread, &ctx);
+    }
+    else {
+        readers.resize(ctx.masters.size());
+        for (size_t i = 0; i < ctx.masters.size(); i++){
+            pthread_create(&readers[i], nullptr, readerThread, &readerParams[i]);
+        }
+    }
+    for (size_t i = 0; i < BENCH_WRITER_THREADS; i++){
+        writerParams[i].ctx = &ctx;
+        writerParams[i].index = i;
+        pthread_create(&writers[i], nullptr, writerThread, &writerParams[i]);
+    }
+    for (size_t i = 0; i < BENCH_WRITER_THREADS; i++){
+        pthread_join(writers[i], nullptr);
+    }
+    for (size_t i = 0; i < readers.size(); i++){
+        pthread_join(readers[i], nullptr);
+    }
+    double elapsed = getTimeSeconds() - tStart;
+    getrusage(RUSAGE_SELF, &usageEnd);
+    for (size_t i = 0; i < ctx.masters.size(); i++){
+        total += ctx.received[i];
+        if (useReactor) reactor.removePort(ctx.masters[i]);
+    }
+    std::cout << std::setw(10) << (useReactor ? "reactor" : "threads")
+              << std::setw(9) << readers.size()
+              << std::setw(12) << std::fixed << std::setprecision(3) << elapsed
+              << std::setw(16) << std::setprecision(0) << (static_cast<double>(total) / elapsed)
+              << std::setw(12) << std::setprecision(3) << (getCpuSeconds(usageEnd) - getCpuSeconds(usageStart))
+              << std::setw(14) << ((usageEnd.ru_nvcsw + usageEnd.ru_nivcsw) - (usageStart.ru_nvcsw + usageStart.ru_nivcsw))
+              << std::setw(12) << total
+              << std::endl;
+}
+
+int main(int argc, char **argv){
+    BenchContext ctx;
+    size_t ports = 256;
+    ctx.messages = 200;
+    ctx.messageSize = 64;
+    if (argc > 1) ports = static_cast<size_t>(atoi(argv[1]));
+    if (argc > 2) ctx.messages = static_cast<size_t>(atoi(argv[2]));
+    if (argc > 3) ctx.messageSize = static_cast<size_t>(atoi(argv[3]));
+    ctx.expected = ctx.messages * ctx.messageSize;
+    /* VirtualSerial reports every created pty, keep the benchmark output readable */
+    std::streambuf *coutBuffer = std::cout.rdbuf(nullptr);
+    std::streambuf *cerrBuffer = std::cerr.rdbuf(nullptr);
+    for (size_t i = 0; i < ports; i++){
+        VirtualSerial *master = new VirtualSerial(B115200, 10, 0);
+        Serial *slave = new Serial(master->getVirtualPortName(), B115200, 10);
+        slave->openPort();
+        ctx.masters.push_back(master);
+        ctx.slaves.push_back(slave);
+    }
+    std::cout.rdbuf(coutBuffer);
+    std::cerr.rdbuf(cerrBuffer);
+    std::cout.clear();
+    std::cerr.clear();
+    std::cout << std::setw(10) << "mode" << std::setw(9) << "readers" << std::setw(12) << "elapsed(s)" << std::setw(16) << "bytes/sec"
+              << std::setw(12) << "cpu(s)" << std::setw(14) << "ctx-switches" << std::setw(12) << "bytes" << std::endl;
+    runBenchmark(ctx, false);
+    runBenchmark(ctx, true);
+    for (size_t i = 0; i < ports; i++){
+        delete ctx.slaves[i];
+        delete ctx.masters[i];
+    }
+    return 0;
+}
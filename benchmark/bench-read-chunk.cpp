@@ -0,0 +1,111 @@
+/*
+ * Read throughput benchmark for the Serial receive path.
+ *
+ * A writer thread streams data into the slave side of a VirtualSerial pty, while the
+ * master side is drained with Serial::readData using different read chunk sizes.
+ * For each chunk size, this program prints the throughput (bytes/sec) and the number
+ * of read syscalls per MiB (taken from /proc/self/io).
+ *
+ * A chunk size of 1024 bytes matches the fixed stack buffer used by the previous
+ * receive path, so it can be used as the "before" reference.
+ *
+ * usage: Serialink-bench-read [totalMiB] [chunkSize ...]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "virtuser.hpp"
+
+typedef struct _BenchWriter {
+    Serial *serial;
+    size_t total;
+} BenchWriter;
+
+static unsigned long long getReadSyscalls(){
+    unsigned long long result = 0;
+    char line[128];
+    FILE *file = fopen("/proc/self/io", "r");
+    if (file == nullptr) return 0;
+    while (fgets(line, sizeof(line), file) != nullptr){
+        if (strncmp(line, "syscr:", 6) == 0){
+            result = strtoull(line + 6, nullptr, 10);
+            break;
+        }
+    }
+    fclose(file);
+    return result;
+}
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static void *writerThread(void *param){
+    BenchWriter *writer = (BenchWriter *) param;
+    std::vector <unsigned char> block(4096);
+    size_t sent = 0;
+    size_t sz = 0;
+    for (size_t i = 0; i < block.size(); i++) block[i] = static_cast<unsigned char>(i);
+    while (sent < writer->total){
+        sz = (writer->total - sent < block.size() ? writer->total - sent : block.size());
+        if (writer->serial->writeData(block.data(), sz) != 0) break;
+        sent += sz;
+    }
+    return nullptr;
+}
+
+static void runBenchmark(size_t chunkSize, size_t total){
+    VirtualSerial reader(B115200, 10, 0);
+    Serial slave(reader.getVirtualPortName(), B115200, 10);
+    BenchWriter writer;
+    pthread_t thread;
+    size_t received = 0;
+    unsigned long long syscr = 0;
+    double tStart = 0.0;
+    double elapsed = 0.0;
+    reader.setReadChunkSize(chunkSize);
+    if (slave.openPort() != 0){
+        std::cerr << "failed to open " << reader.getVirtualPortName() << std::endl;
+        return;
+    }
+    writer.serial = &slave;
+    writer.total = total;
+    syscr = getReadSyscalls();
+    tStart = getTimeSeconds();
+    pthread_create(&thread, nullptr, writerThread, &writer);
+    while (received < total){
+        if (reader.readData() != 0) break;
+        received += reader.getDataSize();
+    }
+    elapsed = getTimeSeconds() - tStart;
+    syscr = getReadSyscalls() - syscr;
+    pthread_join(thread, nullptr);
+    slave.closePort();
+    std::cout << std::setw(10) << chunkSize
+              << std::setw(16) << std::fixed << std::setprecision(0) << (static_cast<double>(received) / elapsed)
+              << std::setw(16) << std::setprecision(1) << (static_cast<double>(syscr) * 1048576.0 / static_cast<double>(received))
+              << std::setw(12) << received
+              << std::endl;
+}
+
+int main(int argc, char **argv){
+    size_t total = 64 * 1048576;
+    std::vector <size_t> chunkSizes;
+    if (argc > 1) total = static_cast<size_t>(atoi(argv[1])) * 1048576;
+    for (int i = 2; i < argc; i++) chunkSizes.push_back(static_cast<size_t>(atoi(argv[i])));
+    if (chunkSizes.empty()) chunkSizes = {1024, 4096, 16384, 65536};
+    std::cout << std::setw(10) << "chunk" << std::setw(16) << "bytes/sec" << std::setw(16) << "syscalls/MiB" << std::setw(12) << "bytes" << std::endl;
+    for (auto chunkSize : chunkSizes){
+        runBenchmark(chunkSize, total);
+    }
+    return 0;
+}
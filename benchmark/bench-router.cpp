@@ -0,0 +1,132 @@
+/*
+ * Command dispatch benchmark for CommandRouter.
+ *
+ * A writer thread on the master side of a VirtualSerial pty pair sends 2000 (default) frames
+ * (0x02, command, 5 data bytes, 0x03) with 4 different commands. The host dispatches them with
+ * CommandRouter to handlers that wait 500 us (default), as a handler that writes to a file or a
+ * socket would. The frames are handled in the reader thread (no worker pool), by a pool of 4
+ * workers, and by the same pool in ordered mode. The time until the reader has received all
+ * frames, the elapsed time until all frames are handled, the handled frames/sec, the dropped
+ * frames and the average/maximum handler latency are printed for each mode.
+ *
+ * usage: Serialink-bench-router [totalFrames] [handlerUs]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "command-router.hpp"
+#include "virtuser.hpp"
+
+#define BENCH_FRAME_SIZE 8
+#define BENCH_BATCH_FRAMES 64
+
+typedef struct _BenchWriter {
+    VirtualSerial *master;
+    size_t total;
+} BenchWriter;
+
+typedef struct _BenchMode {
+    const char *name;
+    size_t workers;
+    bool isOrdered;
+} BenchMode;
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static void *writerThread(void *param){
+    BenchWriter *writer = (BenchWriter *) param;
+    std::vector <unsigned char> batch;
+    unsigned char frame[BENCH_FRAME_SIZE] = {0x02, 0x00, 'd', 'a', 't', 'a', '.', 0x03};
+    for (size_t i = 0; i < writer->total;){
+        batch.clear();
+        for (size_t j = 0; j < BENCH_BATCH_FRAMES && i < writer->total; j++, i++){
+            frame[1] = static_cast<unsigned char>(0x10 + (i % 4));
+            batch.insert(batch.end(), frame, frame + BENCH_FRAME_SIZE);
+        }
+        writer->master->writeData(batch);
+    }
+    return NULL;
+}
+
+static void handlerWithDelay(CommandRouter &router, const CommandRouterFrame &frame, void *param){
+    (void) router;
+    (void) frame;
+    usleep(*((unsigned int *) param));
+}
+
+int main(int argc, char **argv){
+    size_t total = 2000;
+    unsigned int handlerUs = 500;
+    BenchMode modes[] = {{"reader", 0, false}, {"pool", 4, false}, {"ordered", 4, true}};
+    BenchWriter writer;
+    CommandRouterStats stats;
+    pthread_t thread;
+    double tStart = 0.0;
+    double readElapsed = 0.0;
+    double elapsed = 0.0;
+    double inlineRate = 0.0;
+    double rate = 0.0;
+    if (argc > 1) total = static_cast<size_t>(atol(argv[1]));
+    if (argc > 2) handlerUs = static_cast<unsigned int>(atol(argv[2]));
+
+    VirtualSerial master(B115200, 1, 1);
+    Serialink slave;
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "\x02");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, 5);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "\x03");
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(std::chrono::milliseconds(5));
+    slave.setKeepAlive(5);
+    slave = startBytes + cmdBytes + dataBytes + stopBytes;
+    if (slave.openPort() != 0){
+        std::cerr << "failed to open " << master.getVirtualPortName() << std::endl;
+        return 1;
+    }
+    writer.master = &master;
+    writer.total = total;
+
+    std::cout << std::setw(10) << "mode" << std::setw(10) << "frames" << std::setw(10) << "dropped"
+              << std::setw(10) << "read(s)" << std::setw(12) << "elapsed(s)" << std::setw(12) << "frames/sec" << std::setw(12) << "avg(us)"
+              << std::setw(12) << "max(us)" << std::setw(10) << "speedup" << std::endl;
+    for (BenchMode &mode : modes){
+        CommandRouter router(slave);
+        for (unsigned int command = 0x10; command < 0x14; command++){
+            router.setHandler(command, (const void *) &handlerWithDelay, &handlerUs);
+        }
+        if (mode.workers > 0) router.start(mode.workers, total, mode.isOrdered);
+        tStart = getTimeSeconds();
+        pthread_create(&thread, NULL, &writerThread, &writer);
+        while (router.getStats().frames < total){
+            if (router.dispatch(BENCH_BATCH_FRAMES) == 2 && getTimeSeconds() - tStart > 30.0) break;
+        }
+        readElapsed = getTimeSeconds() - tStart;
+        router.stop();
+        elapsed = getTimeSeconds() - tStart;
+        pthread_join(thread, NULL);
+        stats = router.getStats();
+        rate = static_cast<double>(stats.frames - stats.dropped) / elapsed;
+        if (mode.workers == 0) inlineRate = rate;
+        std::cout << std::setw(10) << mode.name
+                  << std::setw(10) << stats.frames
+                  << std::setw(10) << stats.dropped
+                  << std::setw(10) << std::fixed << std::setprecision(3) << readElapsed
+                  << std::setw(12) << elapsed
+                  << std::setw(12) << std::setprecision(1) << rate
+                  << std::setw(12) << (stats.frames > stats.dropped ? static_cast<double>(stats.totalLatencyUs) / static_cast<double>(stats.frames - stats.dropped) : 0.0)
+                  << std::setw(12) << stats.maxLatencyUs
+                  << std::setw(9) << std::setprecision(2) << (inlineRate > 0.0 ? rate / inlineRate : 0.0) << "x"
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * splice passthrough versus callback passthrough benchmark for VirtualSerialProxy.
+ *
+ * A "device" VirtualSerial pty plays the physical port and an application Serial is connected
+ * to the pty of the proxy. The device streams data to the application through the proxy in
+ * three modes:
+ * - callback : Pass Through function of examples/main-proxy.cpp (readData, getBufferAsVector,
+ *              writeData), without printing the data.
+ * - reactor  : no Pass Through function, the received bytes are queued by the proxy loop.
+ * - splice   : setSpliceMode(true), the bytes are moved with splice through a pipe.
+ * For each mode it prints the throughput and the CPU time used by the proxy thread
+ * (getrusage RUSAGE_THREAD).
+ *
+ * usage: Serialink-bench-splice [totalMiB]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include "virtual-proxy.hpp"
+
+typedef enum _BENCH_MODE {
+    BENCH_MODE_CALLBACK = 0,
+    BENCH_MODE_REACTOR,
+    BENCH_MODE_SPLICE
+} BENCH_MODE;
+
+typedef struct _BenchProxy {
+    VirtualSerialProxy *proxy;
+    double cpu;
+} BenchProxy;
+
+typedef struct _BenchWriter {
+    Serial *serial;
+    size_t total;
+} BenchWriter;
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static double getCpuSeconds(const struct rusage &usage){
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+}
+
+static void passthroughFunc(Serial &src, Serial &dest, void *param){
+    std::vector <unsigned char> data;
+    (void) param;
+    if (src.readData() == 0){
+        data = src.getBufferAsVector();
+        dest.writeData(data);
+    }
+}
+
+static void *proxyThread(void *param){
+    BenchProxy *bench = (BenchProxy *) param;
+    struct rusage usageStart, usageEnd;
+    getrusage(RUSAGE_THREAD, &usageStart);
+    bench->proxy->begin();
+    getrusage(RUSAGE_THREAD, &usageEnd);
+    bench->cpu = getCpuSeconds(usageEnd) - getCpuSeconds(usageStart);
+    return nullptr;
+}
+
+static void *writerThread(void *param){
+    BenchWriter *writer = (BenchWriter *) param;
+    std::vector <unsigned char> block(4096, 0x5A);
+    size_t sent = 0;
+    size_t sz = 0;
+    while (sent < writer->total){
+        sz = (writer->total - sent < block.size() ? writer->total - sent : block.size());
+        if (writer->serial->writeData(block.data(), sz) != 0) break;
+        sent += sz;
+    }
+    return nullptr;
+}
+
+static void runBenchmark(BENCH_MODE mode, size_t total){
+    VirtualSerial device(B115200, 10, 0);
+    VirtualSerialProxy proxy(device.getVirtualPortName().c_str(), B115200);
+    Serial client;
+    BenchProxy bench;
+    BenchWriter writer;
+    pthread_t thread, writerTid;
+    size_t received = 0;
+    double tStart = 0.0;
+    double elapsed = 0.0;
+    if (mode == BENCH_MODE_CALLBACK) proxy.setPassThrough(&passthroughFunc, nullptr);
+    if (mode == BENCH_MODE_SPLICE) proxy.setSpliceMode(true);
+    bench.proxy = &proxy;
+    bench.cpu = 0.0;
+    pthread_create(&thread, nullptr, proxyThread, &bench);
+    usleep(100000);
+    client.setPort(proxy.getVirtualPortName());
+    client.setBaudrate(B115200);
+    client.setTimeout(10);
+    if (client.openPort() != 0){
+        std::cerr << "failed to open " << proxy.getVirtualPortName() << std::endl;
+    }
+    client.setReadChunkSize(65536);
+    writer.serial = &device;
+    writer.total = total;
+    tStart = getTimeSeconds();
+    pthread_create(&writerTid, nullptr, writerThread, &writer);
+    while (received < total){
+        if (client.readData() != 0) break;
+        received += client.getDataSize();
+    }
+    elapsed = getTimeSeconds() - tStart;
+    pthread_join(writerTid, nullptr);
+    proxy.stop();
+    pthread_join(thread, nullptr);
+    std::cout << std::setw(10) << (mode == BENCH_MODE_CALLBACK ? "callback" : (mode == BENCH_MODE_REACTOR ? "reactor" : "splice"))
+              << std::setw(16) << std::fixed << std::setprecision(0) << (static_cast<double>(received) / elapsed)
+              << std::setw(14) << std::setprecision(3) << bench.cpu
+              << std::setw(14) << std::setprecision(2) << (bench.cpu * 1000000000.0 / static_cast<double>(received))
+              << std::setw(12) << received
+              << std::endl;
+}
+
+int main(int argc, char **argv){
+    size_t total = 32 * 1048576;
+    if (argc > 1) total = static_cast<size_t>(atoi(argv[1])) * 1048576;
+    std::cout << std::setw(10) << "mode" << std::setw(16) << "bytes/sec" << std::setw(14) << "proxy cpu(s)" << std::setw(14) << "cpu ns/byte" << std::setw(12) << "bytes" << std::endl;
+    runBenchmark(BENCH_MODE_CALLBACK, total);
+    runBenchmark(BENCH_MODE_REACTOR, total);
+    runBenchmark(BENCH_MODE_SPLICE, total);
+    return 0;
+}
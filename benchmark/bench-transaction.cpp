@@ -0,0 +1,146 @@
+/*
+ * Pipelined transaction benchmark for TransactionManager.
+ *
+ * A device thread on the master side of a VirtualSerial pty pair answers each request frame
+ * (0x02, SN, 5 data bytes, 0x03) with a response frame carrying the same SN after a fixed
+ * latency (10 ms by default). The responses are sent one after another at the byte time of
+ * 115200 baud (a pty has no baud rate, so the device waits for it). The host sends the requests
+ * with TransactionManager and window sizes of 1 (stop-and-wait), 2, 4, 8 and 16, and prints the
+ * completed requests/sec of each window.
+ *
+ * usage: Serialink-bench-transaction [requests] [latencyMs]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "transaction-manager.hpp"
+#include "virtuser.hpp"
+
+#define BENCH_FRAME_SIZE 8
+
+typedef struct _BenchDevice {
+    VirtualSerial *master;
+    double latency;
+    volatile bool isRunning;
+} BenchDevice;
+
+typedef struct _BenchResult {
+    size_t completed;
+    size_t failed;
+} BenchResult;
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static void *deviceThread(void *param){
+    BenchDevice *device = (BenchDevice *) param;
+    std::vector <unsigned char> received;
+    std::vector <unsigned char> chunk;
+    std::deque <std::pair <double, unsigned char> > responses;
+    unsigned char response[BENCH_FRAME_SIZE] = {0x02, 0x00, 'r', 'e', 's', 'p', '!', 0x03};
+    /* 10 bits per byte at 115200 baud */
+    const double frameTime = BENCH_FRAME_SIZE * 10.0 / 115200.0;
+    double lastSent = 0.0;
+    double now = 0.0;
+    size_t i = 0;
+    while (device->isRunning){
+        if (device->master->readData() == 0 && device->master->getBuffer(chunk) > 0){
+            received.insert(received.end(), chunk.begin(), chunk.end());
+        }
+        now = getTimeSeconds();
+        for (i = 0; i + BENCH_FRAME_SIZE <= received.size(); i += BENCH_FRAME_SIZE){
+            /* the request is received after its last byte, the response is sent after the device latency */
+            responses.push_back(std::pair <double, unsigned char>(now + device->latency, received[i + 1]));
+        }
+        received.erase(received.begin(), received.begin() + i);
+        while (responses.empty() == false && responses.front().first <= now && lastSent + frameTime <= now){
+            response[1] = responses.front().second;
+            device->master->writeData(response, BENCH_FRAME_SIZE);
+            responses.pop_front();
+            lastSent = now;
+        }
+    }
+    return NULL;
+}
+
+static void transactionDone(TransactionManager &manager, int ret, Serialink &link, void *param){
+    BenchResult *result = (BenchResult *) param;
+    (void) manager;
+    (void) link;
+    if (ret == 0) result->completed++;
+    else result->failed++;
+}
+
+int main(int argc, char **argv){
+    size_t total = 200;
+    size_t windows[] = {1, 2, 4, 8, 16};
+    size_t submitted = 0;
+    double latencyMs = 10.0;
+    double tStart = 0.0;
+    double elapsed = 0.0;
+    double stopAndWait = 0.0;
+    BenchDevice device;
+    BenchResult result;
+    pthread_t thread;
+    unsigned char request[BENCH_FRAME_SIZE] = {0x02, 0x00, 'r', 'e', 'q', '.', '.', 0x03};
+    if (argc > 1) total = static_cast<size_t>(atol(argv[1]));
+    if (argc > 2) latencyMs = atof(argv[2]);
+
+    VirtualSerial master(B115200, 1, 1);
+    master.setTimeout(std::chrono::milliseconds(1));
+    Serialink slave;
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "\x02");
+    DataFrame snBytes(DataFrame::FRAME_TYPE_SN, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, 5);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "\x03");
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(std::chrono::milliseconds(5));
+    slave.setKeepAlive(5);
+    slave = startBytes + snBytes + dataBytes + stopBytes;
+    if (slave.openPort() != 0){
+        std::cerr << "failed to open " << master.getVirtualPortName() << std::endl;
+        return 1;
+    }
+    device.master = &master;
+    device.latency = latencyMs / 1000.0;
+    device.isRunning = true;
+    pthread_create(&thread, NULL, &deviceThread, &device);
+
+    TransactionManager manager(slave);
+    std::cout << std::setw(8) << "window" << std::setw(12) << "requests" << std::setw(10) << "failed"
+              << std::setw(12) << "req/sec" << std::setw(10) << "speedup" << std::endl;
+    for (size_t window : windows){
+        manager.setWindow(window);
+        result.completed = 0;
+        result.failed = 0;
+        tStart = getTimeSeconds();
+        for (submitted = 0; submitted < total || manager.getPendingCount() > 0;){
+            while (submitted < total && manager.getPendingCount() < window){
+                request[1] = static_cast<unsigned char>(submitted);
+                manager.submit(ByteView(request, BENCH_FRAME_SIZE), ByteView(request + 1, 1), 1000, (const void *) &transactionDone, &result);
+                submitted++;
+            }
+            manager.process();
+        }
+        elapsed = getTimeSeconds() - tStart;
+        if (window == 1) stopAndWait = static_cast<double>(result.completed) / elapsed;
+        std::cout << std::setw(8) << window
+                  << std::setw(12) << result.completed
+                  << std::setw(10) << result.failed
+                  << std::setw(12) << std::fixed << std::setprecision(1) << static_cast<double>(result.completed) / elapsed
+                  << std::setw(9) << std::setprecision(2) << (stopAndWait > 0.0 ? static_cast<double>(result.completed) / elapsed / stopAndWait : 0.0) << "x"
+                  << std::endl;
+    }
+    device.isRunning = false;
+    pthread_join(thread, NULL);
+    return 0;
+}
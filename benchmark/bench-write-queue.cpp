@@ -0,0 +1,155 @@
+/*
+ * Asynchronous write benchmark for SerialWriteQueue.
+ *
+ * A device thread on the master side of a VirtualSerial pty pair reads the data at the byte
+ * time of 460800 baud (a pty has no baud rate, so the device paces itself and the pty buffer
+ * fills up as on a real port). 4 (default) application threads each write 500 messages of 64
+ * bytes (more than the pty buffer holds), first with Serial::writeData, then with
+ * SerialWriteQueue::writeData. The average and maximum time spent in a write call, the number
+ * of writes refused at the high watermark, and the time until the device has received all
+ * bytes are printed.
+ *
+ * usage: Serialink-bench-write-queue [threads] [messagesPerThread]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "serial-write-queue.hpp"
+#include "virtuser.hpp"
+
+#define BENCH_MESSAGE_SIZE 64
+
+typedef struct _BenchDevice {
+    VirtualSerial *master;
+    size_t expected;
+    size_t received;
+} BenchDevice;
+
+typedef struct _BenchWriter {
+    Serial *serial;
+    SerialWriteQueue *queue;
+    size_t messages;
+    unsigned long long totalUs;
+    unsigned long long maxUs;
+    size_t refused;
+} BenchWriter;
+
+static double getTimeSeconds(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+static void *deviceThread(void *param){
+    BenchDevice *device = (BenchDevice *) param;
+    std::vector <unsigned char> chunk;
+    double tStart = getTimeSeconds();
+    double wait = 0.0;
+    while (device->received < device->expected){
+        if (device->master->readData() != 0) break;
+        device->received += device->master->getBuffer(chunk);
+        /* 10 bits per byte at 460800 baud */
+        wait = static_cast<double>(device->received) * 10.0 / 460800.0 - (getTimeSeconds() - tStart);
+        if (wait > 0.0) usleep(static_cast<useconds_t>(wait * 1000000.0));
+    }
+    return NULL;
+}
+
+static void *writerThread(void *param){
+    BenchWriter *writer = (BenchWriter *) param;
+    unsigned char message[BENCH_MESSAGE_SIZE];
+    unsigned long long elapsedUs = 0;
+    double tCall = 0.0;
+    memset(message, 'm', BENCH_MESSAGE_SIZE);
+    for (size_t i = 0; i < writer->messages; i++){
+        tCall = getTimeSeconds();
+        if (writer->queue == nullptr){
+            writer->serial->writeData(message, BENCH_MESSAGE_SIZE);
+        }
+        else {
+            while (writer->queue->writeData(message, BENCH_MESSAGE_SIZE, nullptr, nullptr) == 2){
+                writer->refused++;
+                usleep(1000);
+            }
+        }
+        elapsedUs = static_cast<unsigned long long>((getTimeSeconds() - tCall) * 1000000.0);
+        writer->totalUs += elapsedUs;
+        if (elapsedUs > writer->maxUs) writer->maxUs = elapsedUs;
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv){
+    size_t threads = 4;
+    size_t messages = 500;
+    const char *modes[] = {"writeData", "queue"};
+    double tStart = 0.0;
+    double elapsed = 0.0;
+    unsigned long long totalUs = 0;
+    unsigned long long maxUs = 0;
+    size_t refused = 0;
+    BenchDevice device;
+    pthread_t deviceId;
+    if (argc > 1) threads = static_cast<size_t>(atol(argv[1]));
+    if (argc > 2) messages = static_cast<size_t>(atol(argv[2]));
+    std::vector <BenchWriter> writers(threads);
+    std::vector <pthread_t> writerIds(threads);
+
+    VirtualSerial master(B115200, 10, 1);
+    master.setTimeout(std::chrono::milliseconds(100));
+    Serial slave;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(10);
+    if (slave.openPort() != 0){
+        std::cerr << "failed to open " << master.getVirtualPortName() << std::endl;
+        return 1;
+    }
+    SerialWriteQueue queue(slave);
+
+    std::cout << std::setw(10) << "mode" << std::setw(10) << "writes" << std::setw(14) << "avg call(us)"
+              << std::setw(14) << "max call(us)" << std::setw(10) << "refused" << std::setw(12) << "elapsed(s)" << std::endl;
+    for (size_t mode = 0; mode < 2; mode++){
+        if (mode == 1) queue.start();
+        device.master = &master;
+        device.expected = threads * messages * BENCH_MESSAGE_SIZE;
+        device.received = 0;
+        pthread_create(&deviceId, NULL, &deviceThread, &device);
+        tStart = getTimeSeconds();
+        for (size_t i = 0; i < threads; i++){
+            writers[i].serial = &slave;
+            writers[i].queue = (mode == 1 ? &queue : nullptr);
+            writers[i].messages = messages;
+            writers[i].totalUs = 0;
+            writers[i].maxUs = 0;
+            writers[i].refused = 0;
+            pthread_create(&writerIds[i], NULL, &writerThread, &writers[i]);
+        }
+        totalUs = 0;
+        maxUs = 0;
+        refused = 0;
+        for (size_t i = 0; i < threads; i++){
+            pthread_join(writerIds[i], NULL);
+            totalUs += writers[i].totalUs;
+            if (writers[i].maxUs > maxUs) maxUs = writers[i].maxUs;
+            refused += writers[i].refused;
+        }
+        pthread_join(deviceId, NULL);
+        elapsed = getTimeSeconds() - tStart;
+        if (mode == 1) queue.stop();
+        std::cout << std::setw(10) << modes[mode]
+                  << std::setw(10) << threads * messages
+                  << std::setw(14) << std::fixed << std::setprecision(1) << static_cast<double>(totalUs) / static_cast<double>(threads * messages)
+                  << std::setw(14) << maxUs
+                  << std::setw(10) << refused
+                  << std::setw(12) << std::setprecision(3) << elapsed
+                  << std::endl;
+    }
+    return 0;
+}
@@ -46,11 +46,13 @@
 #define __RQX_FORMAT_HPP__
 
 #include "serialink.hpp"
+#include "frame-encoder.hpp"
 #include <vector>
 
 class ProtocolFormat {
   private:
     DataFrame *frameProtocol;
+    FrameEncoder encoder;
 
   public:
     /**
@@ -72,49 +74,27 @@ class ProtocolFormat {
      */
     ~ProtocolFormat();
 
-    /**
-     * @brief Sets the length of the main data on protocol.
-     *
-     * This setter function configures the length of main data part of protocol or data frame format.
-     * Setup this method as post execution function on specific frame (part of protocol or data frame format).
-     * If there is a failure while get the target frame from main object, the method will throw a
-     * runtime_error signal which you can retrieve in the try exception mechanism.
-     *
-     * @param frame frames that are currently being processed.
-     * @param ref reference pointer (pointer of main object).
-     */
-    static void setDataLength(DataFrame &frame, void *ref);
-
-    /**
-     * @brief Data validator.
-     *
-     * This method functions to validate data using the validator method specified by the protocol.
-     * Setup this method as post execution function on specific frame (part of protocol or data frame format).
-     * If there is a failure while get the specific data, the method will throw a runtime_error signal which
-     * you can retrieve in the try exception mechanism.
-     *
-     * @param frame frames that are currently being processed.
-     * @param ref reference pointer (pointer of main object).
-     */
-    static void validate(DataFrame &frame, void *ref);
-
     /**
      * @brief Framed data builder.
      *
      * This method functions is responsible to build framed data that ready to be send/write to serial devices. 
+     * The frame is encoded in place in the buffer of the encoder, so the returned view is valid until the next call.
      *
      * @param data The main data of protocol.
+     * @return A view of the framed data.
      */
-    std::vector <unsigned char> buildCommand(const unsigned char *data, size_t sz);
+    ByteView buildCommand(const unsigned char *data, size_t sz);
 
     /**
      * @brief Overloading method of framed data builder.
      *
      * This method functions is responsible to build framed data that ready to be send/write to serial devices. 
+     * The frame is encoded in place in the buffer of the encoder, so the returned view is valid until the next call.
      *
      * @param data The main data of protocol.
+     * @return A view of the framed data.
      */
-    std::vector <unsigned char> buildCommand(const std::vector <unsigned char> &data);
+    ByteView buildCommand(const std::vector <unsigned char> &data);
 
     /**
      * @brief Display Hex data.
@@ -24,7 +24,6 @@
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
-#include "validator.hpp"
 #include "data-formating.hpp"
 
 /**
@@ -53,20 +52,29 @@ ProtocolFormat::ProtocolFormat(Serialink &obj){
   this->frameProtocol = new DataFrame(DataFrame::FRAME_TYPE_START_BYTES, "1234");
   if (this->frameProtocol == nullptr) throw std::runtime_error(std::string(__func__) + ": failed to allocate memory!");
   DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
-  /* Setup the handler function to determine the data length of DataFrame::FRAME_TYPE_DATA.
-   * This function is called after all data from DataFrame::FRAME_TYPE_COMMAND is received.
-   */
-  cmdBytes.setPostExecuteFunction((const void *) &(ProtocolFormat::setDataLength), (void *) &obj);
   DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
   DataFrame crcValidatorBytes(DataFrame::FRAME_TYPE_VALIDATOR, 2);
-  /* Setup the handler function to validate Data by using crc16 validation.
-   * This function is called after all data from DataFrame::FRAME_TYPE_VALIDATOR is received.
-   */
-  crcValidatorBytes.setPostExecuteFunction((const void *) &(ProtocolFormat::validate), (void *) &obj);
   DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
   /* Setup Frame Format to Serialink com */
   *(this->frameProtocol) += cmdBytes + dataBytes + crcValidatorBytes + stopBytes;
   obj = *(this->frameProtocol);
+  /* Setup the data length of DataFrame::FRAME_TYPE_DATA based on DataFrame::FRAME_TYPE_COMMAND.
+   * The rest of the frame is received at once after the command, and any other command makes the data invalid.
+   */
+  if (obj.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_COMMAND, {{0x35, 3}, {0x36, 2}}, 1, SERIALINK_ENDIAN_BIG) != 0){
+    throw std::runtime_error(std::string(__func__) + ": failed to bind data length!");
+  }
+  /* Setup the crc16 (XMODEM) validation of the data from DataFrame::FRAME_TYPE_START_BYTES until DataFrame::FRAME_TYPE_DATA.
+   * A frame with an invalid crc is reported as invalid data by __readFramedData__.
+   */
+  if (obj.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE) != 0){
+    throw std::runtime_error(std::string(__func__) + ": failed to setup crc validation!");
+  }
+  /* Render the request frame once, with the same crc16 (XMODEM) validation */
+  this->encoder = *(this->frameProtocol);
+  if (this->encoder.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE) != 0){
+    throw std::runtime_error(std::string(__func__) + ": failed to setup crc of the request frame!");
+  }
 }
 
 /**
@@ -79,117 +87,39 @@ ProtocolFormat::~ProtocolFormat(){
   if (this->frameProtocol != nullptr) delete this->frameProtocol;
 }
 
-/**
- * @brief Sets the length of the main data on protocol.
- *
- * This setter function configures the length of main data part of protocol or data frame format.
- * Setup this method as post execution function on specific frame (part of protocol or data frame format).
- * If there is a failure while get the target frame from main object, the method will throw a
- * runtime_error signal which you can retrieve in the try exception mechanism.
- *
- * @param frame frames that are currently being processed.
- * @param ref reference pointer (pointer of main object).
- */
-void ProtocolFormat::setDataLength(DataFrame &frame, void *ref){
-  int data = 0;
-  /* Get Serialink object form function param */
-  Serialink *tmp = (Serialink *) ref;
-  /* Get DataFrame target */
-  DataFrame *target = (*tmp)[DataFrame::FRAME_TYPE_DATA];
-  if (target == nullptr) return;
-  frame.getData((unsigned char *) &data, 1);
-  if (data == 0x35){
-    /* setup 3 as data size of DataFrame::FRAME_TYPE_DATA */
-    target->setSize(3);
-  }
-  else if (data == 0x36){
-    /* setup 3 as data size of DataFrame::FRAME_TYPE_DATA */
-    target->setSize(2);
-  }
-  else {
-    /* invalid value found -> trigger stop flag to __readFramedData__ method */
-    tmp->trigInvDataIndicator();
-  }
-}
-
-/**
- * @brief Data validator.
- *
- * This method functions to validate data using the validator method specified by the protocol.
- * Setup this method as post execution function on specific frame (part of protocol or data frame format).
- * If there is a failure while get the specific data, the method will throw a runtime_error signal which
- * you can retrieve in the try exception mechanism.
- *
- * @param frame frames that are currently being processed.
- * @param ref reference pointer (pointer of main object).
- */
-void ProtocolFormat::validate(DataFrame &frame, void *ref){
-  /* Get Serialink object form function param */
-  Serialink *obj = (Serialink *) ref;
-  /* prepare validator */
-  Validator validator(Validator::VALIDATOR_TYPE_CRC16);
-  unsigned short init = 0x0000;
-  unsigned short poly = 0x1021;
-  validator.setInitialValue((const unsigned char *) &init, 2);
-  validator.setPoly((const unsigned char *) &poly, 2);
-  /* Validate Format */
-  if (validator.validate(frame.getDataAsVector().data(), obj->getFormat(), DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA) == false){
-    /* invalid crc -> trigger stop flag to __readFramedData__ method */
-    obj->trigInvDataIndicator();
-    std::cout << __func__ << ": data invalid!" << std::endl;
-    std::cout << __func__ << ": received checksum: ";
-    ProtocolFormat::displayData(frame.getDataAsVector());
-    std::cout << __func__ << ": calc. checksum   : ";
-    ProtocolFormat::displayData(validator.getChecksum(obj->getFormat(), DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA));
-  }
-}
-
 /**
  * @brief Framed data builder.
  *
  * This method functions is responsible to build framed data that ready to be send/write to serial devices. 
+ * The frame is encoded in place in the buffer of the encoder, so the returned view is valid until the next call.
  *
  * @param data The main data of protocol.
+ * @return A view of the framed data.
  */
-std::vector <unsigned char> ProtocolFormat::buildCommand(const unsigned char *data, size_t sz){
+ByteView ProtocolFormat::buildCommand(const unsigned char *data, size_t sz){
   unsigned char cmd = 0x36;
   if (sz == 3) cmd = 0x35;
-  /* Initialize Frame */
-  DataFrame *tmp = nullptr;
-  DataFrame reqFrame(DataFrame::FRAME_TYPE_START_BYTES, this->frameProtocol->getDataAsVector());
-  reqFrame += *(this->frameProtocol->getNext());
-  /* Set data length */
-  tmp = reqFrame[DataFrame::FRAME_TYPE_COMMAND];
-  if (tmp == nullptr) throw std::runtime_error(std::string(__func__) + ": failed to access command frame!");
-  tmp->setData(&cmd, 1);
-  /* Set data */
-  tmp = reqFrame[DataFrame::FRAME_TYPE_DATA];
-  if (tmp == nullptr) throw std::runtime_error(std::string(__func__) + ": failed to access data frame!");
-  tmp->setData(data, sz);
-  /* Prepare validator */
-  Validator validator(Validator::VALIDATOR_TYPE_CRC16);
-  unsigned short init = 0x0000;
-  unsigned short poly = 0x1021;
-  validator.setInitialValue((const unsigned char *) &init, 2);
-  validator.setPoly((const unsigned char *) &poly, 2);
-  /* Get Checksum */
-  std::vector <unsigned char> checksum = validator.getChecksum(reqFrame, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA);
-  /* Sets Checksum */
-  tmp = reqFrame[DataFrame::FRAME_TYPE_VALIDATOR];
-  if (tmp == nullptr) throw std::runtime_error(std::string(__func__) + ": failed to access checksum frame!");
-  tmp->setData(checksum);
-  std::vector <unsigned char> result = reqFrame.getAllDataAsVector();
-  return result;
+  /* Only the command and the data are written, the start bytes, the stop bytes and the frame buffer are reused */
+  if (this->encoder.setField(DataFrame::FRAME_TYPE_COMMAND, &cmd, 1) != 0){
+    throw std::runtime_error(std::string(__func__) + ": failed to set command frame!");
+  }
+  if (this->encoder.setField(DataFrame::FRAME_TYPE_DATA, data, sz) != 0){
+    throw std::runtime_error(std::string(__func__) + ": failed to set data frame!");
+  }
+  /* The crc16 (XMODEM, little endian) is calculated while encoding */
+  return this->encoder.encode();
 }
 
 /**
  * @brief Overloading method of framed data builder.
  *
  * This method functions is responsible to build framed data that ready to be send/write to serial devices. 
+ * The frame is encoded in place in the buffer of the encoder, so the returned view is valid until the next call.
  *
  * @param data The main data of protocol.
+ * @return A view of the framed data.
  */
-std::vector <unsigned char> ProtocolFormat::buildCommand(const std::vector <unsigned char> &data){
+ByteView ProtocolFormat::buildCommand(const std::vector <unsigned char> &data){
   return this->buildCommand(data.data(), data.size());
 }
 
@@ -24,12 +24,18 @@ void passthroughFunc(Serial &src, Serial &dest, void *param){
 }
 
 int main(int argc, char **argv){
-    if (argc != 2){
-        std::cout << "cmd: " << argv[0] << " <physicalPort>" << std::endl;
+    if (argc != 2 && !(argc == 3 && strcmp(argv[2], "--splice") == 0)){
+        std::cout << "cmd: " << argv[0] << " <physicalPort> [--splice]" << std::endl;
         exit(0);
     }
     VirtualSerialProxy proxy(argv[1], B115200);
-    proxy.setPassThrough(&passthroughFunc, nullptr);
+    if (argc == 3){
+        /* forward without printing the data, the bytes are never copied to user space */
+        proxy.setSpliceMode(true);
+    }
+    else {
+        proxy.setPassThrough(&passthroughFunc, nullptr);
+    }
     proxy.begin();
     return 0;
 }
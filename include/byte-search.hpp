@@ -0,0 +1,164 @@
+/*
+ * $Id: byte-search.hpp,v 1.0.0 2025/01/17 09:31:52 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Delimiter search for the receive buffer.
+ *
+ * This file contains the `ByteSearch` class, which finds a byte sequence (start bytes or stop bytes) in
+ * a block of received data. The candidates are found by comparing the first and the last byte of the
+ * sequence on 32 bytes (AVX2) or 16 bytes (SSE2) at once, so only the positions where both bytes match
+ * are checked with `memcmp`. A block without the first byte is skipped with `memchr`, which is faster on random
+ * noise. The implementation is selected once at runtime from the CPU features. On other CPUs, only `memchr`
+ * (to jump to the next occurrence of the first byte) and `memcmp` are used.
+ *
+ * This file also contains the `ByteSearchSet` class, which finds the first occurrence of any sequence of a set
+ * (for example the start bytes of several protocols on the same port) in one pass. A 256-bit map of the first bytes
+ * of all sequences is used as a prefilter, so only the sequences that begin with the current byte are compared.
+ *
+ * @version 1.0.0
+ * @date 2025-01-17
+ * @author Jaya Wikrama
+ */
+
+#ifndef __BYTE_SEARCH_HPP__
+#define __BYTE_SEARCH_HPP__
+
+#include <vector>
+#include <stddef.h>
+
+typedef enum _BYTE_SEARCH_ENGINE {
+    BYTE_SEARCH_ENGINE_SCALAR = 0,
+    BYTE_SEARCH_ENGINE_SSE2,
+    BYTE_SEARCH_ENGINE_AVX2
+} BYTE_SEARCH_ENGINE;
+
+class ByteSearch {
+  public:
+    /**
+     * @brief Finds the first occurrence of a byte sequence.
+     *
+     * @param buffer The data to be searched.
+     * @param sz The size of the data.
+     * @param pattern The byte sequence.
+     * @param patternSz The size of the byte sequence.
+     * @param[out] position The offset of the first occurrence (only set if it is found).
+     * @return `true` if the byte sequence is found.
+     * @return `false` if the byte sequence is not found (or it is empty).
+     */
+    static bool find(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz, size_t &position);
+
+    /**
+     * @brief Finds the first occurrence of a byte sequence with a specific engine.
+     *
+     * This method is used by the tests and the benchmark to compare the engines. If the engine is not supported by the CPU,
+     * the scalar engine is used.
+     *
+     * @param engine The search engine.
+     * @param buffer The data to be searched.
+     * @param sz The size of the data.
+     * @param pattern The byte sequence.
+     * @param patternSz The size of the byte sequence.
+     * @param[out] position The offset of the first occurrence (only set if it is found).
+     * @return `true` if the byte sequence is found.
+     * @return `false` if the byte sequence is not found (or it is empty).
+     */
+    static bool find(BYTE_SEARCH_ENGINE engine, const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz, size_t &position);
+
+    /**
+     * @brief Gets the engine selected for the running CPU.
+     *
+     * @return The engine used by `ByteSearch::find`.
+     */
+    static BYTE_SEARCH_ENGINE getEngine();
+};
+
+class ByteSearchSet {
+  private:
+    std::vector <std::vector <unsigned char> > patterns;
+    std::vector <std::vector <size_t> > candidates;
+    unsigned long long firstBytes[4];
+  public:
+    /**
+     * @brief Default constructor.
+     *
+     * Creates an empty set.
+     */
+    ByteSearchSet();
+
+    /**
+     * @brief Adds a byte sequence to the set.
+     *
+     * @param pattern The byte sequence.
+     * @param sz The size of the byte sequence.
+     * @return The index of the byte sequence in the set.
+     */
+    size_t add(const unsigned char *pattern, size_t sz);
+
+    /**
+     * @brief Overloaded method of __add__.
+     *
+     * @param pattern The byte sequence.
+     * @return The index of the byte sequence in the set.
+     */
+    size_t add(const std::vector <unsigned char> &pattern);
+
+    /**
+     * @brief Removes all byte sequences.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of byte sequences.
+     *
+     * @return The number of byte sequences in the set.
+     */
+    size_t getCount() const;
+
+    /**
+     * @brief Gets a byte sequence of the set.
+     *
+     * @param index The index of the byte sequence.
+     * @return The byte sequence.
+     */
+    const std::vector <unsigned char> &get(size_t index) const;
+
+    /**
+     * @brief Finds the first occurrence of any byte sequence of the set.
+     *
+     * The data is scanned once. If several sequences match at the same offset, the one with the lowest index is selected.
+     * If no sequence is found but a sequence may still match at an offset where the data ends before its last byte, `checked`
+     * stops at that offset, so the caller can wait for more bytes and search again from there.
+     *
+     * @param buffer The data to be searched.
+     * @param sz The size of the data.
+     * @param[out] position The offset of the first occurrence (only set if it is found).
+     * @param[out] index The index of the matched byte sequence (only set if it is found).
+     * @param[out] checked The number of leading bytes where no sequence of the set can begin.
+     * @return `true` if a byte sequence is found.
+     * @return `false` if no byte sequence is found.
+     */
+    bool find(const unsigned char *buffer, size_t sz, size_t &position, size_t &index, size_t &checked) const;
+};
+
+#endif
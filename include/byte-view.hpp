@@ -0,0 +1,80 @@
+/*
+ * $Id: byte-view.hpp,v 1.0.0 2025/01/19 10:05:12 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Non-owning view of a contiguous block of bytes.
+ *
+ * This file contains `ByteView`, which is returned by the view accessors of `Serial` and `Serialink`
+ * (for example `Serial::getBufferAsView`) and accepted by `Serial::writeData`. A view only holds a pointer
+ * and a size, so received data can be inspected and sent back without copying it into a `std::vector`.
+ *
+ * A view that points into the receive buffer is valid until the next read operation on the same port.
+ *
+ * When built as C++20, `ByteView` is `std::span <const unsigned char>`. Otherwise a minimal class with the
+ * same member functions (`data`, `size`, `empty`, `begin`, `end` and `operator[]`) is provided, so the code
+ * that uses a view is the same for both.
+ *
+ * @version 1.0.0
+ * @date 2025-01-19
+ * @author Jaya Wikrama
+ */
+
+#ifndef __BYTE_VIEW_HPP__
+#define __BYTE_VIEW_HPP__
+
+#include <stddef.h>
+
+#if __cplusplus >= 202002L
+#include <span>
+
+typedef std::span <const unsigned char> ByteView;
+#else
+class ByteView {
+  private:
+    const unsigned char *ptr;
+    size_t sz;
+  public:
+    /**
+     * @brief Default constructor, creates an empty view.
+     */
+    ByteView() : ptr(nullptr), sz(0) {}
+
+    /**
+     * @brief Creates a view of `sz` bytes starting at `ptr`.
+     *
+     * @param ptr The first byte.
+     * @param sz The number of bytes.
+     */
+    ByteView(const unsigned char *ptr, size_t sz) : ptr(ptr), sz(sz) {}
+
+    const unsigned char *data() const { return this->ptr; }
+    size_t size() const { return this->sz; }
+    bool empty() const { return this->sz == 0; }
+    const unsigned char *begin() const { return this->ptr; }
+    const unsigned char *end() const { return this->ptr + this->sz; }
+    const unsigned char &operator[](size_t idx) const { return this->ptr[idx]; }
+};
+#endif
+
+#endif
@@ -0,0 +1,162 @@
+/*
+ * $Id: checksum.hpp,v 1.0.0 2025/01/18 10:12:05 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Checksum engine for validator frames.
+ *
+ * This file contains the `Checksum` class, which calculates the checksums that are commonly used in framed serial protocols:
+ * CRC16 (CCITT, Modbus and XMODEM), CRC32, CRC32C, LRC, XOR and Fletcher-16. The CRCs are calculated with slice-by-8 tables
+ * (8 bytes per step). On x86 CPUs with SSE4.2, CRC32C uses the `crc32` instruction, and on CPUs with PCLMULQDQ, CRC32 folds
+ * 64 bytes per step with carry-less multiplications. The implementation is selected once at runtime from the CPU features.
+ *
+ * A checksum can also be calculated block by block with `Checksum::init`, `Checksum::update` and `Checksum::finish`. `Serialink` uses
+ * this to update the checksum of the validator frames set up with `Serialink::setChecksum` while the frame is received.
+ *
+ * @version 1.0.0
+ * @date 2025-01-18
+ * @author Jaya Wikrama
+ */
+
+#ifndef __CHECKSUM_HPP__
+#define __CHECKSUM_HPP__
+
+#include <stddef.h>
+
+typedef enum _CHECKSUM_TYPE {
+    CHECKSUM_TYPE_CRC16_CCITT = 0,
+    CHECKSUM_TYPE_CRC16_MODBUS,
+    CHECKSUM_TYPE_CRC16_XMODEM,
+    CHECKSUM_TYPE_CRC32,
+    CHECKSUM_TYPE_CRC32C,
+    CHECKSUM_TYPE_LRC,
+    CHECKSUM_TYPE_XOR,
+    CHECKSUM_TYPE_FLETCHER16
+} CHECKSUM_TYPE;
+
+typedef enum _CHECKSUM_ENGINE {
+    CHECKSUM_ENGINE_TABLE = 0,
+    CHECKSUM_ENGINE_SSE42,
+    CHECKSUM_ENGINE_PCLMUL
+} CHECKSUM_ENGINE;
+
+class Checksum {
+  public:
+    /**
+     * @brief Calculates a checksum.
+     *
+     * The parameters of the algorithms are:
+     * - CRC16 CCITT: polynomial 0x1021, initial value 0xFFFF, not reflected.
+     * - CRC16 Modbus: polynomial 0x8005, initial value 0xFFFF, reflected.
+     * - CRC16 XMODEM: polynomial 0x1021, initial value 0x0000, not reflected.
+     * - CRC32: polynomial 0x04C11DB7, initial value and final xor 0xFFFFFFFF, reflected.
+     * - CRC32C: polynomial 0x1EDC6F41, initial value and final xor 0xFFFFFFFF, reflected.
+     * - LRC: two's complement of the 8-bit sum.
+     * - XOR: xor of all bytes.
+     * - Fletcher-16: modulo 255 sums, the second sum in the high byte.
+     *
+     * @param type The checksum algorithm.
+     * @param data The data.
+     * @param sz The size of the data.
+     * @return The checksum.
+     */
+    static unsigned int calculate(CHECKSUM_TYPE type, const unsigned char *data, size_t sz);
+
+    /**
+     * @brief Calculates a checksum with a specific engine.
+     *
+     * This method is used by the tests and the benchmark to compare the engines. If the engine is not supported by the CPU or
+     * by the algorithm, the table engine is used.
+     *
+     * @param engine The checksum engine.
+     * @param type The checksum algorithm.
+     * @param data The data.
+     * @param sz The size of the data.
+     * @return The checksum.
+     */
+    static unsigned int calculate(CHECKSUM_ENGINE engine, CHECKSUM_TYPE type, const unsigned char *data, size_t sz);
+
+    /**
+     * @brief Gets the initial state of a running checksum.
+     *
+     * A checksum can be calculated over several blocks of data (for example the fields of a frame, while they are received) with
+     * `Checksum::init`, `Checksum::update` for each block and `Checksum::finish`. The result is the same as `Checksum::calculate` over
+     * the concatenated blocks.
+     *
+     * @param type The checksum algorithm.
+     * @return The initial state.
+     */
+    static unsigned int init(CHECKSUM_TYPE type);
+
+    /**
+     * @brief Updates a running checksum with a block of data.
+     *
+     * @param type The checksum algorithm.
+     * @param state The current state (from `Checksum::init` or a previous update).
+     * @param data The data.
+     * @param sz The size of the data.
+     * @return The new state.
+     */
+    static unsigned int update(CHECKSUM_TYPE type, unsigned int state, const unsigned char *data, size_t sz);
+
+    /**
+     * @brief Updates a running checksum with a block of data and a specific engine.
+     *
+     * If the engine is not supported by the CPU or by the algorithm, the table engine is used.
+     *
+     * @param engine The checksum engine.
+     * @param type The checksum algorithm.
+     * @param state The current state (from `Checksum::init` or a previous update).
+     * @param data The data.
+     * @param sz The size of the data.
+     * @return The new state.
+     */
+    static unsigned int update(CHECKSUM_ENGINE engine, CHECKSUM_TYPE type, unsigned int state, const unsigned char *data, size_t sz);
+
+    /**
+     * @brief Gets the checksum of a running checksum.
+     *
+     * @param type The checksum algorithm.
+     * @param state The state after the last update.
+     * @return The checksum.
+     */
+    static unsigned int finish(CHECKSUM_TYPE type, unsigned int state);
+
+    /**
+     * @brief Gets the size of a checksum.
+     *
+     * @param type The checksum algorithm.
+     * @return The size of the checksum in bytes.
+     */
+    static size_t getSize(CHECKSUM_TYPE type);
+
+    /**
+     * @brief Gets the engine selected for an algorithm on the running CPU.
+     *
+     * @param type The checksum algorithm.
+     * @return The engine used by `Checksum::calculate`.
+     */
+    static CHECKSUM_ENGINE getEngine(CHECKSUM_TYPE type);
+};
+
+#endif
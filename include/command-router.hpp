@@ -0,0 +1,256 @@
+/*
+ * $Id: command-router.hpp,v 1.0.0 2025/01/23 14:12:37 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Command-keyed dispatch of received frames.
+ *
+ * This file contains the `CommandRouter` class. The router reads the frames of one `Serialink` port and calls the handler
+ * registered for the value of the command field (`DataFrame::FRAME_TYPE_COMMAND` by default) of each frame. The handlers of
+ * the commands from 0 to 255 are stored in a flat table, larger commands are looked up in a map.
+ *
+ * Without workers, the handlers are called by `CommandRouter::dispatch` in the reader thread. When a worker pool is started
+ * with `CommandRouter::start`, each frame is copied into a bounded queue and the handlers are called by the workers, so a
+ * slow handler does not stop the reader. In ordered mode, the frames of the port are handled one at a time, in the order
+ * they are received. The router keeps the rate and the handler latency of each command.
+ *
+ * @version 1.0.0
+ * @date 2025-01-23
+ * @author Jaya Wikrama
+ */
+
+#ifndef __COMMAND_ROUTER_HPP__
+#define __COMMAND_ROUTER_HPP__
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <time.h>
+#include <pthread.h>
+#include "serialink.hpp"
+
+typedef struct _CommandRouterFrame {
+    unsigned int command;
+    bool hasCommand;
+    size_t format;
+    std::vector <unsigned char> data;
+    std::vector <SerialinkFieldDescriptor> fields;
+    struct timespec tsReceived;
+} CommandRouterFrame;
+
+typedef struct _CommandRouterStats {
+    unsigned long long frames;
+    unsigned long long dropped;
+    unsigned long long totalLatencyUs;
+    unsigned long long maxLatencyUs;
+    double elapsedSec;
+} CommandRouterStats;
+
+typedef struct _CommandRouterEntry {
+    const void *func;
+    void *param;
+    CommandRouterStats stats;
+} CommandRouterEntry;
+
+class CommandRouter {
+  private:
+    Serialink *link;
+    DataFrame::FRAME_TYPE_t commandType;
+    SERIALINK_ENDIAN commandEndian;
+    CommandRouterEntry table[256];
+    std::map <unsigned int, CommandRouterEntry> entries;
+    CommandRouterEntry defaultEntry;
+    CommandRouterStats totalStats;
+    struct timespec tsStart;
+    SerialinkFrameArena arena;
+    std::deque <CommandRouterFrame> queue;
+    size_t queueLimit;
+    std::vector <pthread_t> workers;
+    size_t busyWorkers;
+    bool isOrdered;
+    bool isRunning;
+    pthread_mutex_t mtx;
+    pthread_cond_t cond;
+
+    /**
+     * @brief Gets the entry of a command.
+     *
+     * The caller must hold the `mtx` lock.
+     *
+     * @param command The command value.
+     * @param create `true` to create the entry of a command larger than 255 if it does not exist.
+     * @return The entry (or `nullptr` if it does not exist).
+     */
+    CommandRouterEntry *getEntry(unsigned int command, bool create);
+
+    /**
+     * @brief Finds a field in a frame format.
+     *
+     * @param format The index of the frame format.
+     * @param type The frame type of the field (the first field with this type).
+     * @param count The number of fields of the received frame.
+     * @param[out] idx The index of the field.
+     * @return `true` if the field is found.
+     */
+    bool findField(size_t format, DataFrame::FRAME_TYPE_t type, size_t count, size_t &idx);
+
+    /**
+     * @brief Calls the handler of a frame and updates the statistics of its command.
+     *
+     * @param frame The received frame.
+     */
+    void handle(const CommandRouterFrame &frame);
+
+    /**
+     * @brief The routine of the worker threads.
+     *
+     * @param param The pointer of the `CommandRouter` object.
+     * @return Always `nullptr`.
+     */
+    static void *workerRoutine(void *param);
+  public:
+    /**
+     * @brief Custom constructor.
+     *
+     * Creates a router for a port. The frame format of the port must be set up before `CommandRouter::dispatch` is called.
+     * The command field is the first `DataFrame::FRAME_TYPE_COMMAND` field, read in big endian.
+     *
+     * @param link The port (not owned by the router, it must stay valid while the router is used).
+     */
+    CommandRouter(Serialink &link);
+
+    /**
+     * @brief Destructor.
+     *
+     * Stops the worker pool (the queued frames are handled first).
+     */
+    ~CommandRouter();
+
+    /**
+     * @brief Sets the field that holds the command.
+     *
+     * @param type The frame type of the command field (the first field with this type).
+     * @param endian The byte order of the command value (a field larger than 4 bytes keeps its last 4 bytes in big endian, or
+     *        its first 4 bytes in little endian).
+     */
+    void setCommandField(DataFrame::FRAME_TYPE_t type, SERIALINK_ENDIAN endian);
+
+    /**
+     * @brief Registers the handler of a command.
+     *
+     * The handler prototype is `void handler(CommandRouter &router, const CommandRouterFrame &frame, void *param)`. The frame
+     * holds a copy of the frame bytes and the location of each field in `frame.data` (see `CommandRouter::getField`). With a
+     * worker pool, the handler must be thread safe unless the ordered mode is used.
+     *
+     * @param command The command value.
+     * @param func The handler function (or `nullptr` to remove the handler).
+     * @param param The parameter of the handler function.
+     * @return 0 on success.
+     */
+    int setHandler(unsigned int command, const void *func, void *param);
+
+    /**
+     * @brief Registers the handler of the frames whose command has no handler, or that have no command field.
+     *
+     * A frame without command field has `hasCommand` set to `false` and is only counted in the statistics of all frames.
+     *
+     * @param func The handler function (or `nullptr` to drop these frames).
+     * @param param The parameter of the handler function.
+     */
+    void setDefaultHandler(const void *func, void *param);
+
+    /**
+     * @brief Starts the worker pool.
+     *
+     * @param workers The number of worker threads.
+     * @param queueLimit The maximum number of frames waiting for a worker. A frame received when the queue is full is dropped
+     *        and counted in the statistics of its command, so the reader never waits for the handlers.
+     * @param isOrdered `true` to handle the frames one at a time in the order they are received.
+     * @return 0 on success.
+     * @return 4 if a parameter is zero or the pool is already running.
+     */
+    int start(size_t workers, size_t queueLimit, bool isOrdered);
+
+    /**
+     * @brief Stops the worker pool.
+     *
+     * The frames in the queue are handled before the workers exit. After this call, the handlers are called by
+     * `CommandRouter::dispatch` again.
+     */
+    void stop();
+
+    /**
+     * @brief Reads a burst of frames and dispatches them.
+     *
+     * The frames are read with `Serialink::readFrames`. Each frame is handled at once (without worker pool) or queued for
+     * the workers.
+     *
+     * @param max The maximum number of frames of the burst.
+     * @return 0 if at least one frame is received.
+     * @return 1 if the port is not open.
+     * @return 2 if a timeout occurs.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if only invalid frames are received.
+     */
+    int dispatch(size_t max);
+
+    /**
+     * @brief Gets the data of a field of a routed frame.
+     *
+     * @param frame The frame given to the handler.
+     * @param type The frame type of the field (the first field with this type).
+     * @return A view of the field data (empty if the field is not found). The view is valid while the frame is valid.
+     */
+    ByteView getField(const CommandRouterFrame &frame, DataFrame::FRAME_TYPE_t type);
+
+    /**
+     * @brief Gets the number of frames waiting for a worker.
+     *
+     * @return The number of queued frames.
+     */
+    size_t getQueuedCount();
+
+    /**
+     * @brief Gets the statistics of a command.
+     *
+     * The rate of the command is `frames / elapsedSec`. The latency is the time spent in the handler.
+     *
+     * @param command The command value.
+     * @return The statistics since the last reset. A command larger than 255 is only counted while it has a handler.
+     */
+    CommandRouterStats getStats(unsigned int command);
+
+    /**
+     * @brief Gets the statistics of all frames, including the frames without handler.
+     *
+     * @return The statistics since the last reset.
+     */
+    CommandRouterStats getStats();
+
+    /**
+     * @brief Resets the statistics of all commands.
+     */
+    void resetStats();
+};
+
+#endif
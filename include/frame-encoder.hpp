@@ -0,0 +1,234 @@
+/*
+ * $Id: frame-encoder.hpp,v 1.0.0 2025/01/21 09:27:45 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Encoder for framed data with a pre-rendered frame template.
+ *
+ * This file contains the `FrameEncoder` class. The encoder is built from the same `DataFrame` chain as `Serialink`.
+ * When the frame format is assigned, the whole frame is rendered once into a buffer: the start and stop bytes, and the
+ * data that is already set in the content frames (for example a constant command). For each frame to send, only the
+ * fields that change are written with `FrameEncoder::setField`, in place in the same buffer, and `FrameEncoder::encode`
+ * calculates the checksums. No `DataFrame` is copied and no buffer is allocated once the frame has reached its largest size.
+ *
+ * A content frame without size (read until the stop bytes or with a size bound to a length frame) can be set to any size.
+ * The bytes after it are moved in the buffer. A length frame bound with `FrameEncoder::bindLength` is updated with the new size. Several encoded frames can be collected with `FrameEncoder::appendToBatch`
+ * and sent with one write.
+ *
+ * @version 1.0.0
+ * @date 2025-01-21
+ * @author Jaya Wikrama
+ */
+
+#ifndef __FRAME_ENCODER_HPP__
+#define __FRAME_ENCODER_HPP__
+
+#include <vector>
+#include <stddef.h>
+#include "serialink.hpp"
+
+typedef struct _FrameEncoderField {
+    DataFrame::FRAME_TYPE_t type;
+    size_t offset;
+    size_t size;
+    bool isResizable;
+} FrameEncoderField;
+
+typedef struct _FrameEncoderLength {
+    size_t targetField;
+    size_t sourceField;
+    size_t width;
+    SERIALINK_ENDIAN endian;
+    long long offset;
+    unsigned long long scale;
+} FrameEncoderLength;
+
+typedef struct _FrameEncoderChecksum {
+    CHECKSUM_TYPE type;
+    SERIALINK_ENDIAN endian;
+    size_t beginField;
+    size_t endField;
+    size_t validatorField;
+} FrameEncoderChecksum;
+
+class FrameEncoder {
+  private:
+    std::vector <FrameEncoderField> fields;
+    std::vector <FrameEncoderChecksum> checksums;
+    std::vector <FrameEncoderLength> lengths;
+    std::vector <unsigned char> frame;
+    std::vector <unsigned char> batch;
+
+    /**
+     * @brief Finds a field of the frame format.
+     *
+     * @param type The frame type of the field.
+     * @param occurrence The occurrence of the field (0 for the first field with this type).
+     * @param[out] idx The index of the field.
+     * @return `true` if the field is found.
+     */
+    bool findField(DataFrame::FRAME_TYPE_t type, int occurrence, size_t &idx) const;
+
+    /**
+     * @brief Writes the data of a field into the frame buffer.
+     *
+     * @param idx The index of the field.
+     * @param data The field data.
+     * @param sz The size of the field data.
+     * @return 0 on success.
+     * @return 4 if the size of a fixed-size field does not match, or it cannot be encoded by a bound length field.
+     */
+    int writeField(size_t idx, const unsigned char *data, size_t sz);
+
+    /**
+     * @brief Writes the length of a resized field into its length fields.
+     *
+     * @param idx The index of the resized field.
+     * @param sz The new size of the field.
+     * @param isDryRun `true` to only check that the size can be encoded.
+     * @return `true` if the size can be encoded by every length field bound to the field.
+     */
+    bool updateLengths(size_t idx, size_t sz, bool isDryRun);
+  public:
+    /**
+     * @brief Default constructor.
+     *
+     * Creates an encoder without frame format. The frame format must be set with the assignment operator.
+     */
+    FrameEncoder();
+
+    /**
+     * @brief Custom constructor.
+     *
+     * Creates an encoder and renders the frame format.
+     *
+     * @param format The first frame of the frame format.
+     */
+    FrameEncoder(const DataFrame &format);
+
+    /**
+     * @brief Sets up the checksum of the frames.
+     *
+     * The checksum is calculated from the first byte of `begin` to the last byte of `end` and written into the
+     * `DataFrame::FRAME_TYPE_VALIDATOR` field by `FrameEncoder::encode`. This is the counterpart of `Serialink::setChecksum`.
+     *
+     * @param type The checksum algorithm.
+     * @param begin The frame type of the first field of the checksum.
+     * @param end The frame type of the last field of the checksum.
+     * @param endian The byte order of the checksum in the validator field.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the fields are not found, are not in order, or the validator size does not match the checksum size.
+     */
+    int setChecksum(CHECKSUM_TYPE type, DataFrame::FRAME_TYPE_t begin, DataFrame::FRAME_TYPE_t end, SERIALINK_ENDIAN endian);
+
+    /**
+     * @brief Binds the size of a field to the value of another field.
+     *
+     * This is the counterpart of `Serialink::bindLength`. Each time the target field is resized with `FrameEncoder::setField`,
+     * `(size - offset) / scale` is written into the first `width` bytes of the source field, so the receiver finds the length
+     * that matches the data. The value is written once when the binding is added.
+     *
+     * @param target The frame type of the field whose size is declared (a field without fixed size).
+     * @param source The frame type of the field that holds the length (a fixed-size field before the target).
+     * @param width The number of bytes of the length (1 to 8, not larger than the size of the source field).
+     * @param endian The byte order of the length.
+     * @param offset The value added to the scaled length.
+     * @param scale The multiplier of the length (not 0).
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the fields are not found or the binding is invalid.
+     */
+    int bindLength(DataFrame::FRAME_TYPE_t target, DataFrame::FRAME_TYPE_t source, size_t width, SERIALINK_ENDIAN endian, long long offset, unsigned long long scale);
+
+    /**
+     * @brief Sets the data of a field.
+     *
+     * The data is written in place in the rendered frame. A fixed-size field must be set with exactly its size.
+     *
+     * @param type The frame type of the field (the first field with this type).
+     * @param data The field data.
+     * @param sz The size of the field data.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the field is not found, the size does not match a fixed-size field, or it cannot be encoded by a bound length field.
+     */
+    int setField(DataFrame::FRAME_TYPE_t type, const unsigned char *data, size_t sz);
+
+    /**
+     * @brief Overloaded method of __setField__ for a frame format with duplicate frame types.
+     *
+     * @param params The frame type and the occurrence of the field (0 for the first field with this type).
+     * @param data The field data.
+     * @param sz The size of the field data.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the field is not found, the size does not match a fixed-size field, or it cannot be encoded by a bound length field.
+     */
+    int setField(std::pair <DataFrame::FRAME_TYPE_t, int> params, const unsigned char *data, size_t sz);
+
+    /**
+     * @brief Overloaded method of __setField__ with input as `ByteView`.
+     *
+     * @param type The frame type of the field (the first field with this type).
+     * @param data The field data.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the field is not found, the size does not match a fixed-size field, or it cannot be encoded by a bound length field.
+     */
+    int setField(DataFrame::FRAME_TYPE_t type, ByteView data);
+
+    /**
+     * @brief Encodes the frame.
+     *
+     * The checksums are calculated and written into their validator fields.
+     *
+     * @return A view of the encoded frame (empty if the frame format is not set up). The view is valid until the next call to
+     *         `FrameEncoder::setField` or the assignment operator.
+     */
+    ByteView encode();
+
+    /**
+     * @brief Encodes the frame and appends it to the batch buffer.
+     *
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     */
+    int appendToBatch();
+
+    /**
+     * @brief Retrieves the frames that have been appended to the batch buffer, to be sent with one write.
+     *
+     * @return A view of the batch buffer (valid until the next call to `FrameEncoder::appendToBatch` or `FrameEncoder::clearBatch`).
+     */
+    ByteView getBatch();
+
+    /**
+     * @brief Clears the batch buffer (its allocation is kept for the next batch).
+     */
+    void clearBatch();
+
+    FrameEncoder& operator=(const DataFrame &obj);
+};
+
+#endif
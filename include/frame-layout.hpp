@@ -0,0 +1,655 @@
+/*
+ * $Id: frame-layout.hpp,v 1.0.0 2025/01/20 08:41:27 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Frame formats that are described at compile time.
+ *
+ * This file contains a header-only alternative to the `DataFrame` frame formats of `Serialink` for protocols whose
+ * layout is fixed when the application is built. The layout is a type made of the field types of the `FrameLayout`
+ * namespace:
+ *
+ * ```cpp
+ * using namespace FrameLayout;
+ * typedef Frame <
+ *     StartBytes <'1', '2', '3', '4'>,
+ *     Cmd <1>,
+ *     Data <LenTable <Cmd <1>, LenEntry <0x35, 3>, LenEntry <0x36, 2> > >,
+ *     Crc <CHECKSUM_TYPE_CRC16_XMODEM, StartBytes <'1', '2', '3', '4'>, Data <LenTable <...> > >,
+ *     StopBytes <'9', '0', '-', '='>
+ * > Protocol;
+ * FramedSerial <Protocol> port("/dev/ttyUSB0", B115200, 10);
+ * ```
+ *
+ * `FramedSerial` reads the frames with the read operations of `Serial`, and the compiler generates the parser of the
+ * layout: there are no frame nodes to walk, no callbacks, and the size of each field, the number of bytes that can be
+ * received at once, and the location of the length and checksum fields are constants. The received fields are accessed
+ * with `FramedSerial::get`, which returns a view into the receive buffer. The same layout is used to encode frames
+ * (`FramedSerial::set` and `FramedSerial::writeFrame`), where the length fields and the checksums are filled in.
+ *
+ * Frame formats that are only known at runtime still use `Serialink` and `DataFrame`.
+ *
+ * @version 1.0.0
+ * @date 2025-01-20
+ * @author Jaya Wikrama
+ */
+
+#ifndef __FRAME_LAYOUT_HPP__
+#define __FRAME_LAYOUT_HPP__
+
+#include <vector>
+#include <string.h>
+#include <stddef.h>
+#include "serialink.hpp"
+
+namespace FrameLayout {
+    /**
+     * @brief Size policy of a field with a fixed number of bytes.
+     */
+    template <size_t N> struct Fixed {};
+
+    /**
+     * @brief Size policy of a field that is read until the stop bytes (the next field must be `StopBytes`).
+     */
+    struct UntilStop {};
+
+    /**
+     * @brief Size policy of a field whose size is declared by a previous field.
+     *
+     * The bytes of `Source` are decoded as an unsigned integer (`value`) and the size is `value * Scale + Offset`.
+     */
+    template <class Source, SERIALINK_ENDIAN Endian = SERIALINK_ENDIAN_BIG, long long Offset = 0, unsigned long long Scale = 1> struct LenFrom {};
+
+    /**
+     * @brief Entry of a `LenTable`: a field with the value `Value` declares a size of `Length` bytes.
+     */
+    template <unsigned long long Value, size_t Length> struct LenEntry {};
+
+    /**
+     * @brief Size policy of a field whose size is looked up with the value of a previous field (for example a command code).
+     *
+     * The bytes of `Source` are decoded as a big endian unsigned integer. A value that is not in the table makes the frame invalid.
+     */
+    template <class Source, class... Entries> struct LenTable {};
+
+    /**
+     * @brief Start bytes field.
+     */
+    template <unsigned char... Bytes> struct StartBytes {
+        static_assert(sizeof...(Bytes) > 0, "start bytes must not be empty");
+        static const unsigned char bytes[sizeof...(Bytes)];
+    };
+
+    template <unsigned char... Bytes> const unsigned char StartBytes<Bytes...>::bytes[sizeof...(Bytes)] = {Bytes...};
+
+    /**
+     * @brief Stop bytes field.
+     */
+    template <unsigned char... Bytes> struct StopBytes {
+        static_assert(sizeof...(Bytes) > 0, "stop bytes must not be empty");
+        static const unsigned char bytes[sizeof...(Bytes)];
+    };
+
+    template <unsigned char... Bytes> const unsigned char StopBytes<Bytes...>::bytes[sizeof...(Bytes)] = {Bytes...};
+
+    /**
+     * @brief Content field.
+     *
+     * @tparam Type The frame type of the field (as in `DataFrame`).
+     * @tparam Size The size policy (`Fixed`, `UntilStop`, `LenFrom` or `LenTable`).
+     */
+    template <DataFrame::FRAME_TYPE_t Type, class Size> struct Field {};
+
+    template <size_t N> using ContentLength = Field <DataFrame::FRAME_TYPE_CONTENT_LENGTH, Fixed <N> >;
+    template <size_t N> using Cmd = Field <DataFrame::FRAME_TYPE_COMMAND, Fixed <N> >;
+    template <size_t N> using Sn = Field <DataFrame::FRAME_TYPE_SN, Fixed <N> >;
+    template <size_t N> using Rfu = Field <DataFrame::FRAME_TYPE_RFU, Fixed <N> >;
+    template <size_t N> using BlockNumber = Field <DataFrame::FRAME_TYPE_BLOCK_NUMBER, Fixed <N> >;
+    template <class Size> using Data = Field <DataFrame::FRAME_TYPE_DATA, Size>;
+
+    /**
+     * @brief Checksum field, calculated with `Checksum` from the first byte of `Begin` to the last byte of `End`.
+     */
+    template <CHECKSUM_TYPE Type, class Begin, class End, SERIALINK_ENDIAN Endian = SERIALINK_ENDIAN_BIG> struct Crc {};
+
+    /**
+     * @brief Frame layout, made of the fields in order of transmission. The first field must be `StartBytes`.
+     */
+    template <class... Fields> struct Frame {};
+
+    constexpr size_t getChecksumSize(CHECKSUM_TYPE type){
+        return (type == CHECKSUM_TYPE_CRC32 || type == CHECKSUM_TYPE_CRC32C) ? 4 :
+               ((type == CHECKSUM_TYPE_LRC || type == CHECKSUM_TYPE_XOR) ? 1 : 2);
+    }
+
+    /**
+     * @brief Compile-time properties of a field: its size (0 if it is only known while parsing) and its kind.
+     */
+    template <class F> struct FieldTraits {
+        static const size_t size = 0;
+        static const bool isStart = false;
+        static const bool isStop = false;
+        static const bool isFixed = false;
+        static const bool isUntilStop = false;
+    };
+
+    template <unsigned char... Bytes> struct FieldTraits <StartBytes <Bytes...> > {
+        static const size_t size = sizeof...(Bytes);
+        static const bool isStart = true;
+        static const bool isStop = false;
+        static const bool isFixed = false;
+        static const bool isUntilStop = false;
+    };
+
+    template <unsigned char... Bytes> struct FieldTraits <StopBytes <Bytes...> > {
+        static const size_t size = sizeof...(Bytes);
+        static const bool isStart = false;
+        static const bool isStop = true;
+        static const bool isFixed = true;
+        static const bool isUntilStop = false;
+    };
+
+    template <DataFrame::FRAME_TYPE_t Type, size_t N> struct FieldTraits <Field <Type, Fixed <N> > > {
+        static const size_t size = N;
+        static const bool isStart = false;
+        static const bool isStop = false;
+        static const bool isFixed = true;
+        static const bool isUntilStop = false;
+    };
+
+    template <DataFrame::FRAME_TYPE_t Type> struct FieldTraits <Field <Type, UntilStop> > {
+        static const size_t size = 0;
+        static const bool isStart = false;
+        static const bool isStop = false;
+        static const bool isFixed = false;
+        static const bool isUntilStop = true;
+    };
+
+    template <CHECKSUM_TYPE Type, class Begin, class End, SERIALINK_ENDIAN Endian> struct FieldTraits <Crc <Type, Begin, End, Endian> > {
+        static const size_t size = getChecksumSize(Type);
+        static const bool isStart = false;
+        static const bool isStop = false;
+        static const bool isFixed = true;
+        static const bool isUntilStop = false;
+    };
+
+    template <size_t I, class... Fields> struct FieldAt;
+
+    template <class F, class... Rest> struct FieldAt <0, F, Rest...> {
+        typedef F type;
+    };
+
+    template <size_t I, class F, class... Rest> struct FieldAt <I, F, Rest...> {
+        typedef typename FieldAt <I - 1, Rest...>::type type;
+    };
+
+    /**
+     * @brief Position of the first field of type `T` (the number of fields if it is not found).
+     */
+    template <class T, class... Fields> struct FieldIndex {
+        static const size_t value = 0;
+    };
+
+    template <class T, class... Rest> struct FieldIndex <T, T, Rest...> {
+        static const size_t value = 0;
+    };
+
+    template <class T, class F, class... Rest> struct FieldIndex <T, F, Rest...> {
+        static const size_t value = 1 + FieldIndex <T, Rest...>::value;
+    };
+
+    /**
+     * @brief Whether the field at `I` is a stop bytes field that is already received with the previous field (`UntilStop`).
+     */
+    template <size_t I, class... Fields> struct IsReceivedWithPrevious {
+        static const bool value = FieldTraits <typename FieldAt <I - 1, Fields...>::type>::isUntilStop;
+    };
+
+    template <class... Fields> struct IsReceivedWithPrevious <0, Fields...> {
+        static const bool value = false;
+    };
+
+    /**
+     * @brief Whether the size of the field at `I` is known before it is received.
+     */
+    template <size_t I, bool isEnd, class... Fields> struct IsFixedAtImpl {
+        static const bool value = FieldTraits <typename FieldAt <I, Fields...>::type>::isFixed && !IsReceivedWithPrevious <I, Fields...>::value;
+    };
+
+    template <size_t I, class... Fields> struct IsFixedAtImpl <I, true, Fields...> {
+        static const bool value = false;
+    };
+
+    template <size_t I, class... Fields> struct IsFixedAt : IsFixedAtImpl <I, (I >= sizeof...(Fields)), Fields...> {};
+
+    /**
+     * @brief Number of bytes of the fields of known size from `I` until a field of unknown size.
+     */
+    template <size_t I, bool isEnd, class... Fields> struct KnownSizeImpl;
+
+    template <size_t I, class... Fields> struct KnownSize : KnownSizeImpl <I, (I >= sizeof...(Fields)), Fields...> {};
+
+    template <size_t I, class... Fields> struct KnownSizeImpl <I, true, Fields...> {
+        static const size_t value = 0;
+    };
+
+    template <size_t I, class... Fields> struct KnownSizeImpl <I, false, Fields...> {
+        static const size_t value = IsFixedAt <I, Fields...>::value ?
+            FieldTraits <typename FieldAt <I, Fields...>::type>::size + KnownSize <I + 1, Fields...>::value : 0;
+    };
+
+    /**
+     * @brief Number of bytes that are received at once before the field at `I` (0 if the field is received alone).
+     *
+     * The first field of a run of fields of known size receives the whole run.
+     */
+    template <size_t I, class... Fields> struct PrefetchSize {
+        static const size_t value = (IsFixedAt <I, Fields...>::value && !IsFixedAt <I - 1, Fields...>::value &&
+                                     KnownSize <I, Fields...>::value > FieldTraits <typename FieldAt <I, Fields...>::type>::size) ?
+                                    KnownSize <I, Fields...>::value : 0;
+    };
+
+    template <class... Fields> struct PrefetchSize <0, Fields...> {
+        static const size_t value = 0;
+    };
+
+    template <class... Entries> struct LenLookup;
+
+    template <> struct LenLookup <> {
+        static bool find(unsigned long long value, size_t &length){
+            (void) value;
+            (void) length;
+            return false;
+        }
+    };
+
+    template <unsigned long long Value, size_t Length, class... Rest> struct LenLookup <LenEntry <Value, Length>, Rest...> {
+        static bool find(unsigned long long value, size_t &length){
+            if (value == Value){
+                length = Length;
+                return true;
+            }
+            return LenLookup <Rest...>::find(value, length);
+        }
+    };
+
+    inline unsigned long long decodeValue(const unsigned char *data, size_t width, SERIALINK_ENDIAN endian){
+        unsigned long long value = 0;
+        for (size_t i = 0; i < width; i++){
+            value = (value << 8) | data[endian == SERIALINK_ENDIAN_BIG ? i : width - 1 - i];
+        }
+        return value;
+    }
+
+    inline void encodeValue(unsigned long long value, size_t width, SERIALINK_ENDIAN endian, unsigned char *data){
+        for (size_t i = 0; i < width; i++){
+            data[endian == SERIALINK_ENDIAN_BIG ? width - 1 - i : i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+}
+
+template <class Layout> class FramedSerial;
+
+/**
+ * @brief Serial port that reads and writes frames of a layout that is described at compile time.
+ *
+ * @tparam Fields The fields of the `FrameLayout::Frame`.
+ */
+template <class... Fields> class FramedSerial <FrameLayout::Frame <Fields...> > : public Serial {
+  private:
+    static const size_t fieldCount = sizeof...(Fields);
+    static_assert(sizeof...(Fields) > 0, "the frame layout must not be empty");
+    static_assert(FrameLayout::FieldTraits <typename FrameLayout::FieldAt <0, Fields...>::type>::isStart, "the frame layout must begin with start bytes");
+
+    template <size_t I> struct Index {};
+
+    size_t fieldOffsets[sizeof...(Fields)] = {};
+    size_t fieldSizes[sizeof...(Fields)] = {};
+    size_t frameOffset = 0;
+    size_t fieldIndex = 0;
+    bool isFrameReceived = false;
+    std::vector <unsigned char> payloads[sizeof...(Fields)];
+    size_t txOffsets[sizeof...(Fields)] = {};
+    std::vector <unsigned char> txBuffer;
+
+    template <class F> static constexpr size_t indexOf(){
+        return FrameLayout::FieldIndex <F, Fields...>::value;
+    }
+
+    /**
+     * @brief Stores the location of a received field and moves the data buffer after it.
+     */
+    int acceptField(size_t idx, size_t sz){
+        this->fieldOffsets[idx] = this->dataOffset;
+        this->fieldSizes[idx] = sz;
+        if (this->retainData == false){
+            /* keep the received frame bytes in the receive buffer until the frame is complete */
+            this->frameOffset = this->dataOffset;
+            this->retainData = true;
+        }
+        this->releaseData();
+        return 0;
+    }
+
+    int readSized(size_t idx, size_t sz){
+        if (sz > 0 && (this->readNBytes(sz) || this->dataSize != sz)) return 2;
+        return this->acceptField(idx, sz);
+    }
+
+    template <size_t I, unsigned char... Bytes> int readField(FrameLayout::StartBytes <Bytes...> *, Index <I>){
+        if (this->readStartBytes(FrameLayout::StartBytes <Bytes...>::bytes, sizeof...(Bytes))) return 2;
+        return this->acceptField(I, this->dataSize);
+    }
+
+    template <size_t I, unsigned char... Bytes> int readField(FrameLayout::StopBytes <Bytes...> *, Index <I>){
+        /* already received with the previous field */
+        if (FrameLayout::IsReceivedWithPrevious <I, Fields...>::value) return 0;
+        if (this->readStopBytes(FrameLayout::StopBytes <Bytes...>::bytes, sizeof...(Bytes))) return 2;
+        return this->acceptField(I, this->dataSize);
+    }
+
+    template <size_t I, DataFrame::FRAME_TYPE_t Type, size_t N> int readField(FrameLayout::Field <Type, FrameLayout::Fixed <N> > *, Index <I>){
+        return this->readSized(I, N);
+    }
+
+    template <size_t I, DataFrame::FRAME_TYPE_t Type> int readField(FrameLayout::Field <Type, FrameLayout::UntilStop> *, Index <I>){
+        typedef typename FrameLayout::FieldAt <(I + 1 < fieldCount ? I + 1 : 0), Fields...>::type Stop;
+        static_assert(I + 1 < fieldCount && FrameLayout::FieldTraits <Stop>::isStop, "a field read until the stop bytes must be followed by StopBytes");
+        const size_t stopSize = FrameLayout::FieldTraits <Stop>::size;
+        if (this->readUntilStopBytes(Stop::bytes, stopSize) || this->dataSize < stopSize) return 2;
+        this->fieldOffsets[I + 1] = this->dataOffset + this->dataSize - stopSize;
+        this->fieldSizes[I + 1] = stopSize;
+        return this->acceptField(I, this->dataSize - stopSize);
+    }
+
+    template <size_t I, DataFrame::FRAME_TYPE_t Type, class Source, SERIALINK_ENDIAN Endian, long long Offset, unsigned long long Scale>
+    int readField(FrameLayout::Field <Type, FrameLayout::LenFrom <Source, Endian, Offset, Scale> > *, Index <I>){
+        const size_t source = indexOf<Source>();
+        const size_t width = FrameLayout::FieldTraits <Source>::size;
+        static_assert(indexOf<Source>() < I, "the length field must be received before the field it declares");
+        static_assert(FrameLayout::FieldTraits <Source>::isFixed && FrameLayout::FieldTraits <Source>::size > 0 &&
+                      FrameLayout::FieldTraits <Source>::size <= 8, "the length field must have a fixed size of 1 to 8 bytes");
+        static_assert(Scale > 0, "the length scale must not be 0");
+        size_t capacity = this->rxBuffer.getCapacity();
+        unsigned long long value = FrameLayout::decodeValue(this->rxBuffer.getData() + this->fieldOffsets[source], width, Endian);
+        if (value > capacity / Scale) return 4;
+        long long length = static_cast<long long>(value * Scale) + Offset;
+        if (length < 0 || static_cast<unsigned long long>(length) > capacity) return 4;
+        return this->readSized(I, static_cast<size_t>(length));
+    }
+
+    template <size_t I, DataFrame::FRAME_TYPE_t Type, class Source, class... Entries>
+    int readField(FrameLayout::Field <Type, FrameLayout::LenTable <Source, Entries...> > *, Index <I>){
+        const size_t source = indexOf<Source>();
+        const size_t width = FrameLayout::FieldTraits <Source>::size;
+        static_assert(indexOf<Source>() < I, "the length field must be received before the field it declares");
+        static_assert(FrameLayout::FieldTraits <Source>::isFixed && FrameLayout::FieldTraits <Source>::size > 0 &&
+                      FrameLayout::FieldTraits <Source>::size <= 8, "the length field must have a fixed size of 1 to 8 bytes");
+        size_t length = 0;
+        unsigned long long value = FrameLayout::decodeValue(this->rxBuffer.getData() + this->fieldOffsets[source], width, SERIALINK_ENDIAN_BIG);
+        if (FrameLayout::LenLookup <Entries...>::find(value, length) == false) return 4;
+        return this->readSized(I, length);
+    }
+
+    template <size_t I, CHECKSUM_TYPE Type, class Begin, class End, SERIALINK_ENDIAN Endian>
+    int readField(FrameLayout::Crc <Type, Begin, End, Endian> *, Index <I>){
+        const size_t begin = indexOf<Begin>();
+        const size_t end = indexOf<End>();
+        const size_t sz = FrameLayout::getChecksumSize(Type);
+        static_assert(indexOf<Begin>() <= indexOf<End>() && indexOf<End>() < I, "the checksum must follow the fields it covers");
+        unsigned char expected[4];
+        if (this->readNBytes(sz) || this->dataSize != sz) return 2;
+        const unsigned char *frame = this->rxBuffer.getData();
+        /* the covered fields are contiguous in the receive buffer */
+        FrameLayout::encodeValue(
+            Checksum::calculate(Type, frame + this->fieldOffsets[begin], this->fieldOffsets[end] + this->fieldSizes[end] - this->fieldOffsets[begin]),
+            sz, Endian, expected
+        );
+        if (memcmp(expected, frame + this->dataOffset, sz) != 0) return 4;
+        return this->acceptField(I, sz);
+    }
+
+    template <size_t I> int readFields(Index <I>){
+        typedef typename FrameLayout::FieldAt <I, Fields...>::type F;
+        const size_t prefetchSize = FrameLayout::PrefetchSize <I, Fields...>::value;
+        int ret = 0;
+        this->fieldIndex = I;
+        if (prefetchSize > 0){
+            /* the size of the next fields is known, receive them with one read */
+            if (this->readNBytes(prefetchSize)) return 2;
+            this->dataSize = 0;
+        }
+        ret = this->readField(static_cast<F *>(nullptr), Index <I>());
+        if (ret != 0) return ret;
+        return this->readFields(Index <I + 1>());
+    }
+
+    int readFields(Index <sizeof...(Fields)>){
+        this->fieldIndex = fieldCount;
+        return 0;
+    }
+
+    int appendPayload(size_t idx){
+        this->txBuffer.insert(this->txBuffer.end(), this->payloads[idx].begin(), this->payloads[idx].end());
+        return 0;
+    }
+
+    template <size_t I, unsigned char... Bytes> int encodeField(FrameLayout::StartBytes <Bytes...> *, Index <I>){
+        this->txBuffer.insert(this->txBuffer.end(), FrameLayout::StartBytes <Bytes...>::bytes, FrameLayout::StartBytes <Bytes...>::bytes + sizeof...(Bytes));
+        return 0;
+    }
+
+    template <size_t I, unsigned char... Bytes> int encodeField(FrameLayout::StopBytes <Bytes...> *, Index <I>){
+        this->txBuffer.insert(this->txBuffer.end(), FrameLayout::StopBytes <Bytes...>::bytes, FrameLayout::StopBytes <Bytes...>::bytes + sizeof...(Bytes));
+        return 0;
+    }
+
+    template <size_t I, DataFrame::FRAME_TYPE_t Type, size_t N> int encodeField(FrameLayout::Field <Type, FrameLayout::Fixed <N> > *, Index <I>){
+        if (this->payloads[I].empty()){
+            /* not set, or filled in by a following field (length) */
+            this->txBuffer.insert(this->txBuffer.end(), N, 0x00);
+            return 0;
+        }
+        if (this->payloads[I].size() != N) return 4;
+        return this->appendPayload(I);
+    }
+
+    template <size_t I, DataFrame::FRAME_TYPE_t Type> int encodeField(FrameLayout::Field <Type, FrameLayout::UntilStop> *, Index <I>){
+        return this->appendPayload(I);
+    }
+
+    template <size_t I, DataFrame::FRAME_TYPE_t Type, class Source, SERIALINK_ENDIAN Endian, long long Offset, unsigned long long Scale>
+    int encodeField(FrameLayout::Field <Type, FrameLayout::LenFrom <Source, Endian, Offset, Scale> > *, Index <I>){
+        const size_t source = indexOf<Source>();
+        long long length = static_cast<long long>(this->payloads[I].size()) - Offset;
+        if (length < 0 || static_cast<unsigned long long>(length) % Scale != 0) return 4;
+        FrameLayout::encodeValue(static_cast<unsigned long long>(length) / Scale, FrameLayout::FieldTraits <Source>::size, Endian, this->txBuffer.data() + this->txOffsets[source]);
+        return this->appendPayload(I);
+    }
+
+    template <size_t I, DataFrame::FRAME_TYPE_t Type, class Source, class... Entries>
+    int encodeField(FrameLayout::Field <Type, FrameLayout::LenTable <Source, Entries...> > *, Index <I>){
+        const size_t source = indexOf<Source>();
+        size_t length = 0;
+        unsigned long long value = FrameLayout::decodeValue(this->txBuffer.data() + this->txOffsets[source], FrameLayout::FieldTraits <Source>::size, SERIALINK_ENDIAN_BIG);
+        if (FrameLayout::LenLookup <Entries...>::find(value, length) == false || length != this->payloads[I].size()) return 4;
+        return this->appendPayload(I);
+    }
+
+    template <size_t I, CHECKSUM_TYPE Type, class Begin, class End, SERIALINK_ENDIAN Endian>
+    int encodeField(FrameLayout::Crc <Type, Begin, End, Endian> *, Index <I>){
+        const size_t begin = indexOf<Begin>();
+        const size_t end = indexOf<End>() + 1;
+        const size_t sz = FrameLayout::getChecksumSize(Type);
+        size_t endOffset = (end == I ? this->txBuffer.size() : this->txOffsets[end]);
+        unsigned int value = Checksum::calculate(Type, this->txBuffer.data() + this->txOffsets[begin], endOffset - this->txOffsets[begin]);
+        this->txBuffer.resize(this->txBuffer.size() + sz);
+        FrameLayout::encodeValue(value, sz, Endian, this->txBuffer.data() + this->txBuffer.size() - sz);
+        return 0;
+    }
+
+    template <size_t I> int encodeFields(Index <I>){
+        typedef typename FrameLayout::FieldAt <I, Fields...>::type F;
+        int ret = 0;
+        this->txOffsets[I] = this->txBuffer.size();
+        ret = this->encodeField(static_cast<F *>(nullptr), Index <I>());
+        if (ret != 0) return ret;
+        return this->encodeFields(Index <I + 1>());
+    }
+
+    int encodeFields(Index <sizeof...(Fields)>){
+        return 0;
+    }
+  public:
+    using Serial::Serial;
+
+    FramedSerial(){
+    }
+
+    /**
+     * @brief Performs serial data read operations with the frame layout.
+     *
+     * The received frame can be retrieved using the `__Serial::getBuffer__` method, and its fields with `FramedSerial::get`.
+     *
+     * @return 0 on success.
+     * @return 1 if the port is not open.
+     * @return 2 if a timeout occurs.
+     * @return 4 if the frame data format is invalid (a length that is not valid or a wrong checksum).
+     */
+    int readFrame(){
+        static const bool isStop[] = {FrameLayout::FieldTraits <Fields>::isStop...};
+        int ret = 0;
+        size_t frameSize = 0;
+        this->isFrameReceived = false;
+        this->retainData = false;
+        this->isInputExhausted = false;
+        this->frameOffset = 0;
+        this->releaseData();
+        ret = this->readFields(Index <0>());
+        this->retainData = false;
+        if (ret != 0 && this->isInputExhausted){
+            /* the frame is not complete yet (SerialReactor), keep all received bytes for the next attempt */
+            this->dataOffset = 0;
+            this->dataSize = 0;
+            return 2;
+        }
+        if (ret == 0){
+            frameSize = this->dataOffset - this->frameOffset;
+            for (size_t i = 0; i < fieldCount; i++){
+                this->fieldOffsets[i] -= this->frameOffset;
+            }
+            this->isFrameReceived = true;
+        }
+        else if (ret != 4 && this->fieldIndex > 0 && isStop[this->fieldIndex]){
+            /* keep the bytes after the first frame byte as remaining data, so they can be checked as the next frame */
+            frameSize = this->dataOffset - this->frameOffset;
+            if (frameSize > 1){
+                frameSize = 1;
+            }
+            else {
+                this->frameOffset += frameSize;
+                frameSize = 0;
+            }
+        }
+        else {
+            frameSize = this->dataOffset + this->dataSize - this->frameOffset;
+        }
+        this->rxBuffer.consume(this->frameOffset);
+        this->dataOffset = 0;
+        this->dataSize = frameSize;
+        return ret;
+    }
+
+    /**
+     * @brief Retrieves a view of one field of the last received frame.
+     *
+     * The view points into the receive buffer and is valid until the next read operation.
+     *
+     * @tparam F The field type (the first field of this type in the layout).
+     * @return A view of the field data, or an empty view if no frame has been received.
+     */
+    template <class F> ByteView get(){
+        static_assert(indexOf<F>() < fieldCount, "the field is not part of the frame layout");
+        if (this->isFrameReceived == false) return ByteView();
+        return ByteView(this->rxBuffer.getData() + this->fieldOffsets[indexOf<F>()], this->fieldSizes[indexOf<F>()]);
+    }
+
+    /**
+     * @brief Sets the data of a content field for `FramedSerial::writeFrame`.
+     *
+     * A fixed-size field that is not set is sent as zeros. A field that declares the length of another field (`LenFrom`)
+     * does not need to be set, and the checksums are calculated by `FramedSerial::writeFrame`.
+     *
+     * @tparam F The field type (the first field of this type in the layout).
+     * @param data The field data.
+     * @param sz The size of the field data.
+     */
+    template <class F> void set(const unsigned char *data, size_t sz){
+        static_assert(indexOf<F>() < fieldCount, "the field is not part of the frame layout");
+        this->payloads[indexOf<F>()].assign(data, data + sz);
+    }
+
+    /**
+     * @brief Overloaded method of __set__ with input as `ByteView`.
+     *
+     * @tparam F The field type (the first field of this type in the layout).
+     * @param data The field data.
+     */
+    template <class F> void set(ByteView data){
+        this->set<F>(data.data(), data.size());
+    }
+
+    /**
+     * @brief Encodes a frame from the field data without writing it.
+     *
+     * The encoded frame is kept in a buffer that is reused by the next frame.
+     *
+     * @param[out] frame A view of the encoded frame (valid until the next call to `encodeFrame` or `writeFrame`).
+     * @return 0 on success.
+     * @return 4 if a field has an invalid size (a fixed-size field or a size that cannot be declared by the length field).
+     */
+    int encodeFrame(ByteView &frame){
+        int ret = 0;
+        this->txBuffer.clear();
+        ret = this->encodeFields(Index <0>());
+        frame = ByteView(this->txBuffer.data(), this->txBuffer.size());
+        return ret;
+    }
+
+    /**
+     * @brief Performs serial data write operations with the frame layout.
+     *
+     * @return 0 on success.
+     * @return 1 if the port is not open.
+     * @return 2 if the data write operation fails.
+     * @return 4 if a field has an invalid size (see `FramedSerial::encodeFrame`).
+     */
+    int writeFrame(){
+        ByteView frame;
+        int ret = this->encodeFrame(frame);
+        if (ret != 0) return ret;
+        return this->writeData(frame);
+    }
+};
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ * $Id: frame-parser.hpp,v 1.0.0 2025/01/15 14:02:37 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Push based (incremental) parser for framed data.
+ *
+ * This file contains the `FrameParser` class. The parser is built from the same `DataFrame` chain as
+ * `Serialink`, but it does not own a port: the received bytes are handed to the parser with
+ * `FrameParser::feed`, in chunks of any size (for example from a capture file, an `epoll` loop or
+ * a USB transfer completion). The parsing state is kept between calls, and each completed or rejected
+ * frame is delivered to a callback, so reading and parsing can be done by different parts of an
+ * application.
+ *
+ * The fields are checked with the same rules as `Serialink::readFramedData` (start and stop bytes, fixed-size fields, data until
+ * the stop bytes, execute and post-execution functions). After a rejected frame, the parser looks for the next frame from the second
+ * byte of the rejected one.
+ *
+ * The length and checksum bindings (`Serialink::bindLength` and `Serialink::setChecksum`) belong to a `Serialink` object, not to the
+ * `DataFrame` chain, so they are not applied by the parser: a size declared by another field must be set from a post-execution
+ * function (see `FrameParser::trigInvDataIndicator`), and the checksum of a completed frame must be checked in the frame callback.
+ *
+ * @note A `FrameParser` object is not thread safe. The callback must not call `FrameParser::feed` of the
+ *       same object.
+ *
+ * @version 1.0.0
+ * @date 2025-01-15
+ * @author Jaya Wikrama
+ */
+
+#ifndef __FRAME_PARSER_HPP__
+#define __FRAME_PARSER_HPP__
+
+#include <vector>
+#include <stddef.h>
+#include "ring-buffer.hpp"
+#include "serialink.hpp"
+
+class FrameParser {
+  private:
+    DataFrame *frameFormat;
+    std::vector <SerialinkField> fieldTable;
+    std::vector <unsigned char> fieldReferences;
+    RingBuffer buffer;
+    size_t fieldIndex;
+    size_t frameOffset;
+    size_t fieldOffset;
+    size_t scanOffset;
+    bool isFieldStarted;
+    bool isFormatValid;
+    const void *callbackFunc;
+    void *callbackParam;
+
+    /**
+     * @brief Parses the buffered bytes until more bytes are needed.
+     *
+     * Each completed or rejected frame is delivered to the callback.
+     */
+    void parse();
+
+    /**
+     * @brief Rejects the current frame.
+     *
+     * The callback is called with status `4` and the bytes from the first frame byte to `end`. The parser then restarts
+     * from the second byte of the rejected frame.
+     *
+     * @param end The offset (from the oldest buffered byte) of the end of the rejected bytes.
+     */
+    void rejectFrame(size_t end);
+
+    /**
+     * @brief Calls the frame callback.
+     *
+     * @param status `0` for a valid frame, `4` for an invalid frame.
+     * @param frame The frame bytes.
+     * @param sz The number of frame bytes.
+     */
+    void emitFrame(int status, const unsigned char *frame, size_t sz);
+
+    /**
+     * @brief Clears the parsing state (the buffered bytes are kept).
+     */
+    void resetState();
+  public:
+    /**
+     * @brief Default constructor.
+     *
+     * Creates a parser without frame format. The frame format must be set with the assignment operator.
+     */
+    FrameParser();
+
+    /**
+     * @brief Custom constructor.
+     *
+     * Creates a parser with a copy of the frame format.
+     *
+     * @param format The first frame of the frame format.
+     */
+    FrameParser(const DataFrame &format);
+
+    /**
+     * @brief Destructor.
+     *
+     * Releases the frame format.
+     */
+    ~FrameParser();
+
+    /**
+     * @brief Sets the frame callback.
+     *
+     * The callback is called once for each completed frame (status `0`) and each rejected frame (status `4`), with the bytes of
+     * the frame. The frame bytes are valid until the callback returns. The data of each field of a completed frame can be accessed with
+     * `FrameParser::getFormat` or the `[]` operator.
+     *
+     * @param func The callback function.
+     * @param param The parameter of the callback function.
+     */
+    void setCallback(void (*func)(FrameParser &, int, const unsigned char *, size_t, void *), void *param);
+
+    /**
+     * @brief Sets the capacity of the parser buffer.
+     *
+     * This is the maximum frame size. A frame that does not fit in the buffer is rejected. Any buffered data is discarded.
+     * The default capacity is 65536 bytes.
+     *
+     * @param capacity The capacity of the buffer in bytes.
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * @brief Retrieves the memory address of the frame format.
+     *
+     * @return The memory address of the frame format (or `nullptr` if it is not set up).
+     */
+    DataFrame *getFormat();
+
+    /**
+     * @brief Marks the current frame as invalid.
+     *
+     * This function can be called from the post-execution function of a `DataFrame` to reject the frame that is being parsed.
+     */
+    void trigInvDataIndicator();
+
+    /**
+     * @brief Hands received bytes to the parser.
+     *
+     * The bytes are parsed immediately. Each frame that is completed or rejected by these bytes is delivered to the callback
+     * before this method returns. The bytes of an incomplete frame are kept for the next call.
+     *
+     * @param data The received bytes.
+     * @param sz The number of received bytes.
+     * @return `0` if successful.
+     * @return `3` if the frame format is not set up.
+     */
+    int feed(const unsigned char *data, size_t sz);
+
+    /**
+     * @brief Overloaded method of __feed__.
+     *
+     * @param data The received bytes.
+     * @return `0` if successful.
+     * @return `3` if the frame format is not set up.
+     */
+    int feed(const std::vector <unsigned char> &data);
+
+    /**
+     * @brief Gets the number of buffered bytes that do not belong to a completed frame yet.
+     *
+     * @return The number of pending bytes.
+     */
+    size_t getPendingSize();
+
+    /**
+     * @brief Discards the buffered bytes and the parsing state.
+     */
+    void reset();
+
+    FrameParser& operator=(const DataFrame &obj);
+
+    DataFrame* operator[](DataFrame::FRAME_TYPE_t type);
+};
+
+#endif
@@ -0,0 +1,182 @@
+/*
+ * $Id: io-uring.hpp,v 1.0.0 2025/01/13 08:47:19 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Minimal io_uring wrapper for serial reads and writes.
+ *
+ * This file contains the `IoUring` class, a small wrapper around the raw `io_uring_setup`,
+ * `io_uring_enter` and `io_uring_register` syscalls (no liburing dependency). It is used by
+ * the `Serial` class as an optional I/O backend. Each instance serves one file descriptor,
+ * which is registered as a fixed file, and optionally one registered buffer (the receive
+ * buffer of the port), so reads into that buffer are submitted as `IORING_OP_READ_FIXED`.
+ *
+ * Operations are synchronous from the caller point of view: each call submits one request and
+ * waits for its completion with a single `io_uring_enter` syscall.
+ *
+ * @note This backend is only available on Linux 5.6 or newer. Use `IoUring::isSupported` to check
+ *       whether the running kernel allows io_uring.
+ *
+ * @version 1.0.0
+ * @date 2025-01-13
+ * @author Jaya Wikrama
+ */
+
+#ifndef __IO_URING_HPP__
+#define __IO_URING_HPP__
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <linux/io_uring.h>
+
+class IoUring {
+  private:
+    int ringFd;
+    void *sqRing;
+    size_t sqRingSize;
+    void *cqRing;
+    size_t cqRingSize;
+    struct io_uring_sqe *sqes;
+    size_t sqesSize;
+    unsigned int *sqTail;
+    unsigned int *sqMask;
+    unsigned int *sqArray;
+    unsigned int *cqHead;
+    unsigned int *cqTail;
+    unsigned int *cqMask;
+    struct io_uring_cqe *cqes;
+    bool isFileRegistered;
+    unsigned char *bufferAddress;
+    size_t bufferSize;
+
+    /**
+     * @brief Submits one request and waits for its completion.
+     *
+     * @param opcode The io_uring operation code.
+     * @param buffer The data buffer.
+     * @param sz The size of the data buffer.
+     * @return The result of the operation (number of bytes), or `-1` with `errno` set if the operation fails.
+     */
+    ssize_t submit(unsigned char opcode, const void *buffer, size_t sz);
+
+    /**
+     * @brief Checks whether the running kernel supports the operations used by this class.
+     *
+     * `IORING_OP_READ` and `IORING_OP_WRITE` are only available since Linux 5.6, while io_uring itself exists since 5.1.
+     * The operations are queried with `IORING_REGISTER_PROBE` (also available since 5.6).
+     *
+     * @return `true` if `IORING_OP_READ`, `IORING_OP_READ_FIXED` and `IORING_OP_WRITE` are supported.
+     */
+    bool probeOperations();
+
+    /**
+     * @brief Unmaps the queues and closes the io_uring instance.
+     */
+    void closeRing();
+  public:
+    /**
+     * @brief Custom constructor.
+     *
+     * Creates an io_uring instance and maps its submission and completion queues. The instance is not ready if the
+     * running kernel does not support the read and write operations.
+     *
+     * @param entries The number of submission queue entries.
+     */
+    IoUring(unsigned int entries);
+
+    /**
+     * @brief Destructor.
+     *
+     * Unregisters the file and the buffer, unmaps the queues and closes the io_uring instance.
+     */
+    ~IoUring();
+
+    /**
+     * @brief Checks whether io_uring is supported by the running kernel.
+     *
+     * @return `true` if an io_uring instance can be created and supports the read and write operations.
+     */
+    static bool isSupported();
+
+    /**
+     * @brief Checks whether the instance has been created successfully.
+     *
+     * @return `true` if the instance is ready to use.
+     */
+    bool isReady();
+
+    /**
+     * @brief Registers the file descriptor as a fixed file.
+     *
+     * Any previously registered file is unregistered first.
+     *
+     * @param fd The file descriptor.
+     * @return `0` if successful.
+     * @return `1` if the registration fails.
+     */
+    int registerFile(int fd);
+
+    /**
+     * @brief Unregisters the fixed file.
+     */
+    void unregisterFile();
+
+    /**
+     * @brief Registers a buffer for `IORING_OP_READ_FIXED` operations.
+     *
+     * Any previously registered buffer is unregistered first.
+     *
+     * @param buffer The buffer address.
+     * @param sz The buffer size.
+     * @return `0` if successful.
+     * @return `1` if the registration fails.
+     */
+    int registerBuffer(unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Unregisters the registered buffer.
+     */
+    void unregisterBuffer();
+
+    /**
+     * @brief Reads data from the registered file.
+     *
+     * If the destination is inside the registered buffer, the read is submitted as `IORING_OP_READ_FIXED`.
+     *
+     * @param buffer The destination buffer.
+     * @param sz The maximum number of bytes to read.
+     * @return The number of bytes read, or `-1` with `errno` set if the operation fails.
+     */
+    ssize_t read(unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Writes data to the registered file.
+     *
+     * @param buffer Data to be written.
+     * @param sz Size of the data to be written.
+     * @return The number of bytes written, or `-1` with `errno` set if the operation fails.
+     */
+    ssize_t write(const unsigned char *buffer, size_t sz);
+};
+
+#endif
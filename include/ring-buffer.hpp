@@ -0,0 +1,170 @@
+/*
+ * $Id: ring-buffer.hpp,v 1.0.0 2025/01/06 09:12:40 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Fixed-capacity receive buffer for serial data.
+ *
+ * This file contains the receive buffer used by the `Serial` class. The buffer has a fixed capacity that
+ * is allocated once, a write cursor (where the next received bytes are stored) and a consume cursor (the
+ * oldest byte that has not been released yet). Both cursors move forward only and wrap back to the
+ * beginning of the storage, so received data is never shuffled between containers.
+ *
+ * Unlike a classic ring buffer, the readable region is always kept contiguous. When the write cursor
+ * reaches the end of the storage, only the unconsumed bytes are moved to the front. This allows the read
+ * operations to search delimiters with `memcmp` and to hand out plain pointers to the received data.
+ *
+ * @version 1.0.0
+ * @date 2025-01-06
+ * @author Jaya Wikrama
+ */
+
+#ifndef __RING_BUFFER_HPP__
+#define __RING_BUFFER_HPP__
+
+#include <vector>
+#include <stddef.h>
+
+class RingBuffer {
+  private:
+    std::vector <unsigned char> storage;
+    size_t head;
+    size_t tail;
+  public:
+    /**
+     * @brief Default constructor.
+     *
+     * This constructor allocates the buffer storage with the default capacity (65536 bytes).
+     */
+    RingBuffer();
+
+    /**
+     * @brief Custom constructor.
+     *
+     * This constructor allocates the buffer storage with a specific capacity.
+     *
+     * @param capacity The capacity of the buffer in bytes.
+     */
+    RingBuffer(size_t capacity);
+
+    /**
+     * @brief Destructor.
+     *
+     * This destructor is responsible for releasing the buffer storage.
+     */
+    ~RingBuffer();
+
+    /**
+     * @brief Sets the capacity of the buffer.
+     *
+     * This setter function re-allocates the buffer storage. Any data stored in the buffer is discarded.
+     *
+     * @param capacity The capacity of the buffer in bytes.
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * @brief Gets the capacity of the buffer.
+     *
+     * @return The capacity of the buffer in bytes.
+     */
+    size_t getCapacity();
+
+    /**
+     * @brief Gets the number of unconsumed bytes.
+     *
+     * @return The number of bytes between the consume cursor and the write cursor.
+     */
+    size_t getSize();
+
+    /**
+     * @brief Gets the number of bytes that can still be written.
+     *
+     * @return The free space of the buffer in bytes (including the space that can be recovered by moving the unconsumed bytes to the front).
+     */
+    size_t getFreeSpace();
+
+    /**
+     * @brief Gets the unconsumed data.
+     *
+     * This getter function returns the address of the oldest unconsumed byte. The unconsumed bytes are stored contiguously
+     * and the returned pointer is valid until the next `prepareWrite`, `write`, `setCapacity` or `clear` call.
+     *
+     * @return The address of the oldest unconsumed byte.
+     */
+    const unsigned char *getData();
+
+    /**
+     * @brief Gets the buffer storage.
+     *
+     * This getter function returns the address of the first byte of the storage (not the oldest unconsumed byte). The address is
+     * stable until the next `setCapacity` call, so the storage can be registered for kernel-side direct writes.
+     *
+     * @return The address of the buffer storage.
+     */
+    unsigned char *getStorage();
+
+    /**
+     * @brief Prepares the buffer for a direct write operation.
+     *
+     * This function returns the address where the next received bytes can be stored directly (for example by the `read` syscall).
+     * If the write cursor has reached the end of the storage, the unconsumed bytes are moved to the front first.
+     * The written bytes must be committed with the `commitWrite` method.
+     *
+     * @param[out] available The number of bytes that can be stored at the returned address.
+     * @return The address of the write cursor.
+     */
+    unsigned char *prepareWrite(size_t &available);
+
+    /**
+     * @brief Commits the bytes stored by a direct write operation.
+     *
+     * @param sz The number of bytes that have been stored at the address returned by the `prepareWrite` method.
+     */
+    void commitWrite(size_t sz);
+
+    /**
+     * @brief Writes data into the buffer.
+     *
+     * @param data Data to be written.
+     * @param sz Size of the data to be written.
+     * @return The number of bytes written (less than `sz` if the buffer is full).
+     */
+    size_t write(const unsigned char *data, size_t sz);
+
+    /**
+     * @brief Consumes the oldest bytes.
+     *
+     * This function moves the consume cursor forward. The consumed bytes are no longer accessible.
+     *
+     * @param sz The number of bytes to be consumed.
+     */
+    void consume(size_t sz);
+
+    /**
+     * @brief Discards all data stored in the buffer.
+     */
+    void clear();
+};
+
+#endif
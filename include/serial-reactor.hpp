@@ -0,0 +1,269 @@
+/*
+ * $Id: serial-reactor.hpp,v 1.0.0 2025/01/09 10:21:05 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Event driven I/O for many serial ports from a single thread.
+ *
+ * This file contains the `SerialReactor` class. The reactor registers many `Serial` or `Serialink`
+ * objects, switches their file descriptors to non-blocking mode and drives all reads and writes
+ * through one `epoll` loop. Received bytes are stored directly in the receive buffer of each port.
+ * The user is notified with a data callback (for `Serial`) or a completed-frame callback (for
+ * `Serialink`), so N ports no longer need N blocking threads.
+ *
+ * Writes are queued per port with `SerialReactor::writeData`. The queue is flushed by the reactor
+ * thread when the port becomes writable.
+ *
+ * @note A port that is registered to a reactor must only be read by the reactor thread. The keep-alive
+ *       and timeout settings of the port are not used while it is registered. A registered object must
+ *       be removed with `SerialReactor::removePort` before it is destroyed.
+ *
+ * @version 1.0.0
+ * @date 2025-01-09
+ * @author Jaya Wikrama
+ */
+
+#ifndef __SERIAL_REACTOR_HPP__
+#define __SERIAL_REACTOR_HPP__
+
+#include <vector>
+#include <map>
+#include <pthread.h>
+#include "serialink.hpp"
+
+typedef struct _SerialReactorPort {
+    Serial *serial;
+    Serialink *serialink;
+    const void *callback;
+    void *param;
+    const void *drainCallback;
+    void *drainParam;
+    std::vector <unsigned char> txQueue;
+    size_t txOffset;
+    bool isWaitingOutput;
+    bool isRemoved; // set by removePort, read with the __atomic builtins outside of the lock
+} SerialReactorPort;
+
+class SerialReactor {
+  private:
+    int epollFd;
+    int eventFd;
+    bool isRunning;
+    pthread_mutex_t mtx;
+    std::map <Serial *, SerialReactorPort *> ports;
+    std::vector <SerialReactorPort *> removedPorts;
+
+    /**
+     * @brief Registers a port to the epoll set.
+     *
+     * @param serial The pointer of the `Serial` object (must be opened).
+     * @param serialink The pointer of the `Serialink` object (or `nullptr` for raw data ports).
+     * @param func The pointer of the callback function.
+     * @param param The parameter of the callback function.
+     * @return `0` if successful.
+     * @return `1` if the port is not open (or it is a USB device without a file descriptor).
+     * @return `2` if the port is already registered.
+     * @return `3` if the `epoll` operation fails.
+     */
+    int addPort(Serial *serial, Serialink *serialink, const void *func, void *param);
+
+    /**
+     * @brief Reads all available bytes of a port into its receive buffer.
+     *
+     * @param port The registered port.
+     * @return The number of bytes received.
+     */
+    size_t receivePort(SerialReactorPort *port);
+
+    /**
+     * @brief Delivers the received data (or completed frames) of a port to the registered callback.
+     *
+     * @param port The registered port.
+     */
+    void dispatchPort(SerialReactorPort *port);
+
+    /**
+     * @brief Writes the queued data of a port until the queue is empty or the port would block.
+     *
+     * The caller must hold the `mtx` lock.
+     *
+     * @param port The registered port.
+     * @return `0` if the queue has been written completely.
+     * @return `1` if the port would block (the rest of the queue is kept).
+     * @return `2` if the data write operation fails (the queue is discarded).
+     */
+    int flushPort(SerialReactorPort *port);
+
+    /**
+     * @brief Updates the epoll events of a port (`EPOLLIN` only or `EPOLLIN | EPOLLOUT`).
+     *
+     * The caller must hold the `mtx` lock.
+     *
+     * @param port The registered port.
+     * @param waitOutput `true` to wait until the port is writable.
+     */
+    void updatePortEvents(SerialReactorPort *port, bool waitOutput);
+  public:
+    /**
+     * @brief Default constructor.
+     *
+     * Creates the `epoll` instance and the wake-up event of the reactor.
+     */
+    SerialReactor();
+
+    /**
+     * @brief Destructor.
+     *
+     * Releases the `epoll` instance and all registered port entries. The registered `Serial` objects are not closed.
+     */
+    ~SerialReactor();
+
+    /**
+     * @brief Registers a `Serial` port that delivers raw data.
+     *
+     * The port must be opened before it is registered. Its file descriptor is switched to non-blocking mode.
+     * Each time new bytes arrive, the callback is called with all received bytes. The bytes are also available with `Serial::getBuffer`.
+     *
+     * @param serial The pointer of the `Serial` object.
+     * @param func The callback function.
+     * @param param The parameter of the callback function.
+     * @return `0` if successful.
+     * @return `1` if the port is not open (or it is a USB device without a file descriptor).
+     * @return `2` if the port is already registered.
+     * @return `3` if the `epoll` operation fails.
+     */
+    int addPort(Serial *serial, void (*func)(Serial &, const unsigned char *, size_t, void *), void *param);
+
+    /**
+     * @brief Registers a `Serialink` port that delivers completed frames.
+     *
+     * The port must be opened and its frame format must be configured before it is registered. Its file descriptor is switched to
+     * non-blocking mode. The callback is called once for each completed frame, with the same return code as `Serialink::readFramedData`
+     * (`0` for a valid frame or `4` for an invalid frame). The frame data can be accessed with `Serial::getBuffer` or `Serialink::getFormat`.
+     *
+     * @param serialink The pointer of the `Serialink` object.
+     * @param func The callback function.
+     * @param param The parameter of the callback function.
+     * @return `0` if successful.
+     * @return `1` if the port is not open (or it is a USB device without a file descriptor).
+     * @return `2` if the port is already registered.
+     * @return `3` if the `epoll` operation fails.
+     */
+    int addPort(Serialink *serialink, void (*func)(Serialink &, int, void *), void *param);
+
+    /**
+     * @brief Unregisters a port.
+     *
+     * The file descriptor is switched back to blocking mode and any data still queued for writing is discarded.
+     * This method can be called from a callback.
+     *
+     * @param serial The pointer of the registered object.
+     * @return `0` if successful.
+     * @return `1` if the port is not registered.
+     */
+    int removePort(Serial *serial);
+
+    /**
+     * @brief Gets the number of registered ports.
+     *
+     * @return The number of registered ports.
+     */
+    size_t getPortCount();
+
+    /**
+     * @brief Queues data to be written to a registered port.
+     *
+     * If nothing is queued for the port, the data is written immediately (as much as the port accepts without blocking).
+     * The rest is written by the reactor thread when the port becomes writable. This method is thread safe.
+     *
+     * @param serial The pointer of the registered object.
+     * @param buffer Data to be written.
+     * @param sz Size of the data to be written.
+     * @return `0` if successful.
+     * @return `1` if the port is not registered.
+     * @return `2` if the data write operation fails.
+     */
+    int writeData(Serial *serial, const unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Gets the number of bytes that are queued for a registered port.
+     *
+     * This method is thread safe.
+     *
+     * @param serial The pointer of the registered object.
+     * @return The number of bytes that have not been written yet (`0` if the port is not registered).
+     */
+    size_t getQueuedSize(Serial *serial);
+
+    /**
+     * @brief Sets the drain callback of a registered port.
+     *
+     * The callback is called by the reactor thread each time the write queue of the port has been flushed completely after the port
+     * has been waiting for output space. It can be used to feed the next data into the port without keeping a long queue.
+     *
+     * @param serial The pointer of the registered object.
+     * @param func The callback function (or `nullptr` to remove it).
+     * @param param The parameter of the callback function.
+     * @return `0` if successful.
+     * @return `1` if the port is not registered.
+     */
+    int setDrainCallback(Serial *serial, void (*func)(Serial &, void *), void *param);
+
+    /**
+     * @brief Method overloading of `writeData` with input as `std::vector <unsigned char>`.
+     *
+     * @param serial The pointer of the registered object.
+     * @param buffer Data to be written.
+     * @return `0` if successful.
+     * @return `1` if the port is not registered.
+     * @return `2` if the data write operation fails.
+     */
+    int writeData(Serial *serial, const std::vector <unsigned char> &buffer);
+
+    /**
+     * @brief Waits for I/O events and processes them once.
+     *
+     * @param timeoutMs The maximum waiting time in milliseconds (`-1` waits forever).
+     * @return The number of processed events (or `-1` if the `epoll` operation fails).
+     */
+    int runOnce(int timeoutMs);
+
+    /**
+     * @brief Runs the reactor loop.
+     *
+     * This method processes I/O events until the `stop` method is called (from a callback or another thread).
+     *
+     * @return `true` if the loop has been stopped by the `stop` method.
+     * @return `false` if the reactor could not be initialized.
+     */
+    bool begin();
+
+    /**
+     * @brief Stops the reactor loop.
+     *
+     * This method is thread safe. The `begin` method returns after the current events have been processed.
+     */
+    void stop();
+};
+
+#endif
@@ -0,0 +1,231 @@
+/*
+ * $Id: serial-write-queue.hpp,v 1.0.0 2025/01/24 09:52:18 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Asynchronous write queue of a serial port.
+ *
+ * This file contains the `SerialWriteQueue` class. `Serial::writeData` returns when all bytes have been written, which takes the
+ * whole transmit time of the data at a low baud rate. With a write queue, the data of each call is copied into a lock-free queue
+ * (several threads can write at the same time) and written by the writer thread of the queue, so the calling thread returns at
+ * once. The writer thread takes all queued writes and sends them with one `Serial::writeData` call, then calls the completion
+ * callback of each write.
+ *
+ * The queue has a high and a low watermark. When the queued bytes reach the high watermark, new writes are refused until the
+ * writer thread has brought the queue down to the low watermark, and the drain callback is called.
+ *
+ * A port registered to a `SerialReactor` is drained by the reactor thread instead (see `SerialReactor::writeData`).
+ *
+ * @version 1.0.0
+ * @date 2025-01-24
+ * @author Jaya Wikrama
+ */
+
+#ifndef __SERIAL_WRITE_QUEUE_HPP__
+#define __SERIAL_WRITE_QUEUE_HPP__
+
+#include <vector>
+#include <pthread.h>
+#include "serial.hpp"
+
+typedef struct _SerialWriteRequest {
+    struct _SerialWriteRequest *next;
+    std::vector <unsigned char> data;
+    const void *callbackFunc;
+    void *callbackParam;
+} SerialWriteRequest;
+
+class SerialWriteQueue {
+  private:
+    Serial *serial;
+    SerialWriteRequest stub;
+    SerialWriteRequest *head;
+    SerialWriteRequest *tail;
+    size_t queuedBytes;
+    size_t unfinishedBytes;
+    size_t highWatermark;
+    size_t lowWatermark;
+    size_t maxBatchSize;
+    bool isThrottled;
+    bool isWaiting;
+    bool isRunning;
+    const void *drainFunc;
+    void *drainParam;
+    std::vector <unsigned char> batch;
+    std::vector <SerialWriteRequest *> completed;
+    pthread_t thread;
+    pthread_mutex_t mtx;
+    pthread_cond_t cond;
+    pthread_cond_t drainCond;
+
+    /**
+     * @brief Appends a request to the queue.
+     *
+     * This function can be called by several threads at the same time. It does not take a lock.
+     *
+     * @param request The request.
+     */
+    void push(SerialWriteRequest *request);
+
+    /**
+     * @brief Takes the oldest request of the queue.
+     *
+     * This function must only be called by the writer thread.
+     *
+     * @return The request (or `nullptr` if the queue is empty, or the oldest request is still being appended).
+     */
+    SerialWriteRequest *pop();
+
+    /**
+     * @brief Calls the callback of a request and releases the request.
+     *
+     * @param request The request (already taken from the queue).
+     * @param ret The return value of `Serial::writeData` (or `1` if the request has not been written).
+     */
+    void complete(SerialWriteRequest *request, int ret);
+
+    /**
+     * @brief Writes the queued requests until the queue is empty.
+     *
+     * @return `true` if at least one request has been written.
+     */
+    bool writeQueued();
+
+    /**
+     * @brief The routine of the writer thread.
+     *
+     * @param param The pointer of the `SerialWriteQueue` object.
+     * @return Always `nullptr`.
+     */
+    static void *writerRoutine(void *param);
+  public:
+    /**
+     * @brief Custom constructor.
+     *
+     * Creates a write queue for a port. The high watermark is 64 KiB and the low watermark is 16 KiB.
+     *
+     * @param serial The port (not owned by the queue, it must stay valid while the queue is used).
+     */
+    SerialWriteQueue(Serial &serial);
+
+    /**
+     * @brief Destructor.
+     *
+     * Stops the writer thread (the queued data is written first). The callback of a write that is still being queued by another
+     * thread is called with `1`.
+     */
+    ~SerialWriteQueue();
+
+    /**
+     * @brief Sets the watermarks of the queue.
+     *
+     * @param high The number of queued bytes from which the new writes are refused.
+     * @param low The number of queued bytes from which the writes are accepted again (it is limited to `high`).
+     */
+    void setWatermarks(size_t high, size_t low);
+
+    /**
+     * @brief Sets the drain callback.
+     *
+     * The callback is called by the writer thread when the queue has reached the high watermark and has been written down to the
+     * low watermark. The callback prototype is `void callback(SerialWriteQueue &queue, void *param)`.
+     *
+     * @param func The callback function (or `nullptr` to remove it).
+     * @param param The parameter of the callback function.
+     */
+    void setDrainCallback(const void *func, void *param);
+
+    /**
+     * @brief Starts the writer thread.
+     *
+     * @return 0 on success.
+     * @return 4 if the writer thread is already running or cannot be created.
+     */
+    int start();
+
+    /**
+     * @brief Stops the writer thread.
+     *
+     * The queued data is written before the thread exits.
+     */
+    void stop();
+
+    /**
+     * @brief Queues data to be written.
+     *
+     * The data is copied and the function returns without waiting for the port. The callback is called by the writer thread
+     * after the data has been written, with the return value of `Serial::writeData`. The callback prototype is
+     * `void callback(SerialWriteQueue &queue, int ret, void *param)`. This method is thread safe.
+     *
+     * @param buffer Data to be written.
+     * @param sz Size of the data to be written.
+     * @param func The callback function (or `nullptr`).
+     * @param param The parameter of the callback function.
+     * @return 0 if the data is queued.
+     * @return 1 if the writer thread is not running.
+     * @return 2 if the queue is above its watermark (the data is not queued).
+     * @return 4 if the data is empty.
+     */
+    int writeData(const unsigned char *buffer, size_t sz, const void *func, void *param);
+
+    /**
+     * @brief Method overloading of `writeData` with input as `ByteView`.
+     *
+     * @param buffer Data to be written.
+     * @param func The callback function (or `nullptr`).
+     * @param param The parameter of the callback function.
+     * @return 0 if the data is queued.
+     * @return 1 if the writer thread is not running.
+     * @return 2 if the queue is above its watermark (the data is not queued).
+     * @return 4 if the data is empty.
+     */
+    int writeData(ByteView buffer, const void *func, void *param);
+
+    /**
+     * @brief Method overloading of `writeData` without callback.
+     *
+     * @param buffer Data to be written.
+     * @return 0 if the data is queued.
+     * @return 1 if the writer thread is not running.
+     * @return 2 if the queue is above its watermark (the data is not queued).
+     * @return 4 if the data is empty.
+     */
+    int writeData(ByteView buffer);
+
+    /**
+     * @brief Waits until the queued data has been written and the callbacks of the written data have been called.
+     *
+     * @return 0 if the queue is empty.
+     * @return 1 if the writer thread is not running (and the queue is not empty).
+     */
+    int flush();
+
+    /**
+     * @brief Gets the number of bytes that have not been written yet.
+     *
+     * @return The number of queued bytes.
+     */
+    size_t getQueuedSize();
+};
+
+#endif
@@ -53,12 +53,17 @@
 #define __SERIAL_BASIC_HPP__
 
 #include "usb-serial.hpp"
+#include "ring-buffer.hpp"
+#include "byte-search.hpp"
+#include "byte-view.hpp"
 #include <vector>
+#include <chrono>
 #if defined(PLATFORM_POSIX) || defined(__linux__)
 #include <pthread.h>
 #include <fcntl.h>
 #include <termios.h>
 #include <sys/ioctl.h>
+#include "io-uring.hpp"
 #else
 #undef bytes
 #include <windows.h>
@@ -107,6 +112,14 @@ typedef enum _speed_t {
 #endif
 #include <string>
 
+class SerialReactor;
+class VirtualSerialProxy;
+
+typedef enum _IO_BACKEND {
+  IO_BACKEND_SYSCALL = 0,
+  IO_BACKEND_IO_URING
+} IO_BACKEND;
+
 class Serial {
   private:
 #if defined(PLATFORM_POSIX) || defined(__linux__)
@@ -116,14 +129,28 @@ class Serial {
 #endif
     speed_t baud;
     unsigned int timeout;
+    long long timeoutUs;
     unsigned int keepAliveMs;
+    size_t readChunkSize;
+    IO_BACKEND ioBackend;
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    IoUring *rxUring;
+    IoUring *txUring;
+#endif
     std::string port;
     pthread_mutex_t mtx;
     pthread_mutex_t wmtx;
+    const void *writeFunc;
+    void *writeParam;
   protected:
     USBSerial *usb;
-    std::vector <unsigned char> data;
-    std::vector <unsigned char> remainingData;
+    RingBuffer rxBuffer;
+    size_t dataOffset;
+    size_t dataSize;
+    bool retainData;
+    bool isPollMode;
+    bool isInputExhausted;
+    bool isResyncPending;
     /**
      * @brief Sets the file descriptor.
      *
@@ -146,6 +173,86 @@ class Serial {
      * @return false if the configuration fails.
      */
     bool setupAttributes();
+
+    /**
+     * @brief Receives serial data into the receive buffer.
+     *
+     * This function reads data from the serial port directly into the receive buffer, after the data that is already stored there.
+     *
+     * @param sz The number of bytes to receive. A value of `0` means that the read operation is unlimited (up to the `keepAliveMs` timeout).
+     * @param received The number of bytes that are already available for the caller. If it is greater than `0`, the function only waits for the `keepAliveMs` interval before reading.
+     * @return `0` if there are bytes available for the caller (`received` plus the received bytes).
+     * @return `1` if the port is not open.
+     * @return `2` if a timeout occurs.
+     */
+    int receiveData(size_t sz, size_t received);
+
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    /**
+     * @brief Waits until input bytes are available.
+     *
+     * This function waits for incoming bytes with `ppoll` on the file descriptor until a deadline measured on the monotonic clock.
+     * The wait is event driven, so it returns as soon as the first byte arrives. The caller must hold the `mtx` lock.
+     *
+     * @param timeoutUs The maximum waiting time in microseconds.
+     * @return `true` if there are bytes available in the serial buffer.
+     * @return `false` if the waiting time has elapsed (or an error occurs).
+     */
+    bool waitInputBytes(long long timeoutUs);
+
+    /**
+     * @brief Waits until the output buffer has free space.
+     *
+     * This function waits with `poll` until the file descriptor is writable. The maximum waiting time is the read timeout of the port.
+     * The caller must hold the `wmtx` lock.
+     *
+     * @return `true` if the file descriptor is writable.
+     * @return `false` if the waiting time has elapsed (or an error occurs).
+     */
+    bool waitOutputSpace();
+
+    /**
+     * @brief Sets up the selected I/O backend for the current file descriptor.
+     *
+     * This function (re-)registers the file descriptor and the receive buffer to the io_uring instances when the io_uring backend is selected.
+     * If the kernel does not support the io_uring read and write operations (Linux 5.6 or newer is required) or the registration fails,
+     * the instances are released and the port falls back to the `read`/`write` syscalls. The caller must hold both
+     * the `mtx` and the `wmtx` locks.
+     *
+     * @return `true` if the selected backend is active.
+     * @return `false` if the port falls back to the `read`/`write` syscalls.
+     */
+    bool setupIOBackend();
+#endif
+
+    /**
+     * @brief Limits the read timeout.
+     *
+     * The waiting time for the first byte is reduced to `timeoutUs` if the current timeout is longer, so a caller with its own
+     * deadline (see `Serialink::readFrames`) does not wait past it.
+     *
+     * @param timeoutUs The maximum waiting time in microseconds.
+     * @return The previous timeout setting, to be passed to `restoreTimeout`.
+     */
+    long long limitTimeout(long long timeoutUs);
+
+    /**
+     * @brief Restores the read timeout saved by `limitTimeout`.
+     *
+     * @param timeoutUs The value returned by `limitTimeout`.
+     */
+    void restoreTimeout(long long timeoutUs);
+
+    /**
+     * @brief Sets the poll mode flag and returns the previous one.
+     *
+     * Unlike `setPollMode`, the file descriptor is not changed. With the flag set, the read operations only parse the bytes that
+     * have already been received.
+     *
+     * @param isPollMode The new value of the flag.
+     * @return The previous value of the flag.
+     */
+    bool exchangePollMode(bool isPollMode);
   public:
     /**
      * @brief Default constructor.
@@ -269,6 +376,18 @@ class Serial {
      */
     void setTimeout(unsigned int timeout);
 
+    /**
+     * @brief Sets the communication timeout with microsecond resolution.
+     *
+     * This setter function configures the read timeout as a `std::chrono` duration (e.g. `std::chrono::milliseconds(5)`).
+     * In this mode, the port is configured with `VMIN = 0` and `VTIME = 0`, and the waiting time for the first byte is handled by `ppoll`
+     * with a monotonic deadline. Calling `setTimeout(unsigned int)` switches back to the `VTIME` based timeout (100 milliseconds units).
+     * The `VTIME` setting is applied when the port is opened.
+     *
+     * @param timeout The timeout duration.
+     */
+    void setTimeout(std::chrono::microseconds timeout);
+
     /**
      * @brief Sets the keep-alive interval for communication.
      *
@@ -305,6 +424,16 @@ class Serial {
      */
     unsigned int getTimeout();
 
+    /**
+     * @brief Gets the communication timeout as a duration.
+     *
+     * This getter function retrieves the read timeout as a `std::chrono` duration. If the timeout is configured in units of 100 milliseconds,
+     * the value is converted to microseconds.
+     *
+     * @return The timeout duration in microseconds.
+     */
+    std::chrono::microseconds getTimeoutDuration();
+
     /**
      * @brief Gets the keep-alive interval for communication.
      *
@@ -314,6 +443,65 @@ class Serial {
      */
     unsigned int getKeepAlive();
 
+    /**
+     * @brief Sets the size of the receive buffer.
+     *
+     * This setter function re-allocates the receive buffer. All received data that has not been read (including the remaining data) is discarded.
+     *
+     * @param sz The size of the receive buffer in bytes (default: 65536).
+     */
+    void setReceiveBufferSize(size_t sz);
+
+    /**
+     * @brief Gets the size of the receive buffer.
+     *
+     * This getter function retrieves the capacity of the receive buffer.
+     *
+     * @return The size of the receive buffer in bytes.
+     */
+    size_t getReceiveBufferSize();
+
+    /**
+     * @brief Sets the maximum number of bytes requested by a single read operation.
+     *
+     * This setter function configures how many bytes are requested from the serial port on each `read` syscall. The bytes are read directly
+     * into the receive buffer. A larger chunk (e.g. the whole tty buffer of 4096 bytes or more) reduces the number of syscalls for bulk transfers.
+     *
+     * @param sz The read chunk size in bytes (default: 4096). A value of `0` is ignored.
+     */
+    void setReadChunkSize(size_t sz);
+
+    /**
+     * @brief Gets the maximum number of bytes requested by a single read operation.
+     *
+     * This getter function retrieves the configured read chunk size.
+     *
+     * @return The read chunk size in bytes.
+     */
+    size_t getReadChunkSize();
+
+    /**
+     * @brief Sets the I/O backend used for reads and writes.
+     *
+     * This setter function selects how the serial data is transferred. With `IO_BACKEND_IO_URING`, reads and writes are submitted through `io_uring`
+     * with a fixed file descriptor, and reads are stored directly into the registered receive buffer. If the kernel lacks io_uring support
+     * (or the registration fails), the port keeps using the `read`/`write` syscalls. The backend can be changed at any time, before or after `openPort`.
+     *
+     * @param backend The I/O backend (default: `IO_BACKEND_SYSCALL`).
+     * @return `true` if the backend is selected.
+     * @return `false` if the backend is not supported (the `read`/`write` syscalls are used).
+     */
+    bool setIOBackend(IO_BACKEND backend);
+
+    /**
+     * @brief Gets the I/O backend used for reads and writes.
+     *
+     * This getter function retrieves the active I/O backend.
+     *
+     * @return The active I/O backend.
+     */
+    IO_BACKEND getIOBackend();
+
     /**
      * @brief Gets the file descriptor.
      *
@@ -434,6 +622,23 @@ class Serial {
      */
     int readStartBytes(const std::string startBytes);
 
+    /**
+     * @brief Reads serial data until one of several start bytes is found.
+     *
+     * This overloaded function is used when a port carries several protocols with different start bytes. All start bytes
+     * are searched in one pass over the received data (see `ByteSearchSet::find`), and the first one found in the stream is
+     * returned. Any serial data read before the start bytes are found is automatically discarded. The matched start bytes can be
+     * accessed using the `Serial::getBuffer` method.
+     *
+     * @param startBytes The set of start bytes to be detected.
+     * @param[out] index The index (in `startBytes`) of the start bytes that have been found.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if a timeout occurs.
+     * @return `3` if the set is empty.
+     */
+    int readStartBytes(const ByteSearchSet &startBytes, size_t &index);
+
     /**
      * @brief Performs a serial data read operation until the specified stop bytes are detected.
      *
@@ -589,6 +794,16 @@ class Serial {
      */
     std::vector <unsigned char> getBufferAsVector();
 
+    /**
+     * @brief Retrieves the read data buffer as a view.
+     *
+     * This method returns a view of all the data that has been successfully read by the `read` method, without copying it.
+     * The view points into the receive buffer and is valid until the next read operation.
+     *
+     * @return A `ByteView` of the serial data that has been successfully read.
+     */
+    ByteView getBufferAsView();
+
     /**
      * @brief Retrieves the number of bytes in the remaining buffer.
      *
@@ -628,6 +843,16 @@ class Serial {
      */
     std::vector <unsigned char> getRemainingBufferAsVector();
 
+    /**
+     * @brief Retrieves remaining serial data that has been successfully read but is outside the main data buffer, returning it as a view.
+     *
+     * This method returns a view of all remaining serial data without copying it. The view points into the receive buffer
+     * and is valid until the next read operation.
+     *
+     * @return A `ByteView` of the remaining serial data that has been successfully read.
+     */
+    ByteView getRemainingBufferAsView();
+
     /**
      * @brief Performs the operation of writing serial data.
      *
@@ -663,7 +888,7 @@ class Serial {
      * @return 1 if the port is not open.
      * @return 2 if the data write operation fails.
      */
-    int writeData(const std::vector <unsigned char> buffer);
+    int writeData(const std::vector <unsigned char> &buffer);
 
     /**
      * @brief Method overloading of `writeData` with input as `std::string`.
@@ -675,7 +900,95 @@ class Serial {
      * @return 1 if the port is not open.
      * @return 2 if the data write operation fails.
      */
-    int writeData(const std::string buffer);
+    int writeData(const std::string &buffer);
+
+    /**
+     * @brief Method overloading of `writeData` with input as `ByteView`.
+     *
+     * This method writes the specified data to the serial port. This overload allows a view (for example a view of the
+     * received data) to be written without copying it.
+     *
+     * @param buffer Data to be written.
+     * @return 0 if the operation is successful.
+     * @return 1 if the port is not open.
+     * @return 2 if the data write operation fails.
+     */
+    int writeData(ByteView buffer);
+
+    /**
+     * @brief Releases the data buffer.
+     *
+     * This function moves the data buffer out of the readable region. If `retainData` is `true`, the released bytes are kept in the receive buffer
+     * (the consume cursor is not moved), so the caller can still access all bytes that have been read since the flag was set.
+     * A pending resync of a rejected frame (see `Serialink::readFramedData`) is cancelled, because the bytes have been read.
+     */
+    void releaseData();
+
+    /**
+     * @brief Returns the data buffer to the receive buffer.
+     *
+     * The next read operation returns the same bytes again (in poll mode, without waiting for the port).
+     */
+    void unreadData();
+
+    /**
+     * @brief Sets a function that takes over the write operations of the port.
+     *
+     * Every `writeData` call is handed to the function instead of being written to the port. `VirtualSerialProxy` uses it to queue
+     * the writes of a Pass Through function into its `SerialReactor`, so the reactor thread never waits for a full port. The function
+     * prototype is `int handler(Serial &serial, const unsigned char *buffer, size_t sz, void *param)`, and its return value is
+     * returned by `writeData`.
+     *
+     * @param func The handler function (or `nullptr` to write to the port again).
+     * @param param The parameter of the handler function.
+     */
+    void setWriteHandler(const void *func, void *param);
+
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    /**
+     * @brief Switches the port to (or from) poll mode.
+     *
+     * In poll mode, the file descriptor is non-blocking and the receive buffer is filled by `loadReceivedData` (called by the `SerialReactor`
+     * that polls the port), so the read operations never wait for the port.
+     *
+     * @param isPollMode `true` to enable the poll mode.
+     * @return `0` if successful.
+     * @return `1` if the port is not open (or it is a USB device without a file descriptor).
+     */
+    int setPollMode(bool isPollMode);
+
+    /**
+     * @brief Loads the bytes available on the file descriptor into the receive buffer.
+     *
+     * This function reads without waiting (the port must be in poll mode). If the receive buffer is full, the buffered bytes are dropped first,
+     * because a frame larger than the receive buffer can never be completed.
+     *
+     * @return The number of loaded bytes.
+     */
+    size_t loadReceivedData();
+
+    /**
+     * @brief Writes data as far as the port accepts it without blocking.
+     *
+     * The port must be in poll mode. The `wmtx` lock is held during the write, so the data is not interleaved with another write.
+     *
+     * @param buffer Data to be written.
+     * @param sz Size of the data to be written.
+     * @param written The number of bytes that have been written.
+     * @return `0` if all data has been written.
+     * @return `1` if the port would block (only `written` bytes have been written).
+     * @return `2` if the data write operation fails.
+     */
+    int writeAvailableData(const unsigned char *buffer, size_t sz, size_t &written);
+
+    /**
+     * @brief Checks whether the last read operation in poll mode has used up the loaded bytes.
+     *
+     * @return `true` if the read operation has found no more bytes in the receive buffer.
+     * @return `false` otherwise.
+     */
+    bool isInputBytesExhausted();
+#endif
 
     /**
      * @brief Closes the serial communication port.
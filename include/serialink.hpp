@@ -37,15 +37,221 @@
 #ifndef __SERIALLINK_HPP__
 #define __SERIALLINK_HPP__
 
+#include <map>
 #include "serial.hpp"
+#include "checksum.hpp"
 #include "data-frame.hpp"
 #include "validator.hpp"
 
+typedef enum _SERIALINK_FIELD_KIND {
+    SERIALINK_FIELD_INVALID = 0,
+    SERIALINK_FIELD_START_BYTES,
+    SERIALINK_FIELD_STOP_BYTES,
+    SERIALINK_FIELD_CONTENT
+} SERIALINK_FIELD_KIND;
+
+typedef enum _SERIALINK_ENDIAN {
+    SERIALINK_ENDIAN_BIG = 0,
+    SERIALINK_ENDIAN_LITTLE
+} SERIALINK_ENDIAN;
+
+typedef struct _SerialinkField {
+    DataFrame *frame;
+    SERIALINK_FIELD_KIND kind;
+    size_t referenceOffset;
+    size_t referenceSize;
+    bool isStopBytesNext;
+    size_t lengthBinding;
+    bool isLengthTarget;
+    size_t checksumBinding;
+    size_t bufferOffset;
+    size_t bufferSize;
+} SerialinkField;
+
+typedef struct _SerialinkLength {
+    DataFrame *source;
+    DataFrame *target;
+    size_t width;
+    SERIALINK_ENDIAN endian;
+    long long offset;
+    unsigned long long scale;
+    std::map <unsigned long long, size_t> table;
+} SerialinkLength;
+
+typedef struct _SerialinkChecksum {
+    DataFrame *validator;
+    DataFrame *begin;
+    DataFrame *end;
+    CHECKSUM_TYPE type;
+    SERIALINK_ENDIAN endian;
+    size_t beginField;
+    size_t endField;
+    unsigned int state;
+} SerialinkChecksum;
+
+typedef struct _SerialinkFormat {
+    DataFrame *frame;
+    std::vector <SerialinkField> fieldTable;
+    std::vector <unsigned char> fieldReferences;
+    std::vector <SerialinkLength> lengths;
+    std::vector <SerialinkChecksum> checksums;
+    std::vector <std::vector <size_t> > typeIndex;
+} SerialinkFormat;
+
+typedef struct _SerialinkHandle {
+    size_t format;
+    size_t field;
+    size_t generation;
+} SerialinkHandle;
+
+typedef struct _SerialinkResyncStats {
+    unsigned long long invalidFrames;
+    unsigned long long incompleteFrames;
+    unsigned long long resyncs;
+    unsigned long long discardedBytes;
+} SerialinkResyncStats;
+
+typedef struct _SerialinkFieldDescriptor {
+    size_t offset;
+    size_t size;
+} SerialinkFieldDescriptor;
+
+typedef struct _SerialinkFrameDescriptor {
+    size_t format;
+    size_t offset;
+    size_t size;
+    size_t firstField;
+    size_t fieldCount;
+} SerialinkFrameDescriptor;
+
+typedef struct _SerialinkFrameArena {
+    std::vector <unsigned char> data;
+    std::vector <SerialinkFrameDescriptor> frames;
+    std::vector <SerialinkFieldDescriptor> fields;
+} SerialinkFrameArena;
+
 class Serialink : public Serial {
   private:
     bool isFormatValid;
     DataFrame *frameFormat;
+    std::vector <SerialinkFormat> formats;
+    size_t formatIndex;
+    size_t formatGeneration;
+    ByteSearchSet startBytesSet;
+    bool isFrameReceived;
+    size_t resyncSize;
+    SerialinkResyncStats resyncStats;
+
+    /**
+     * @brief Compiles all frame formats of this object into their field tables.
+     *
+     * The length bindings and the checksums of each format are attached to their fields. If there are several frame formats,
+     * the start bytes of all of them are also collected into `startBytesSet`.
+     */
+    void compileFormat();
+
+    /**
+     * @brief Gets the compiled frame format that is used by `frameFormat`.
+     *
+     * The format is compiled again first if it has been extended through `getFormat()`.
+     *
+     * @return The frame format (or `nullptr` if the frame format is not set up).
+     */
+    SerialinkFormat *getCurrentFormat();
+
+    /**
+     * @brief Creates a copy of a frame format.
+     *
+     * @param obj The first frame of the frame format.
+     * @return The first frame of the copy.
+     */
+    static DataFrame *createFormat(const DataFrame &obj);
+
+    /**
+     * @brief Stores a length binding in the frame format that contains both frames.
+     *
+     * @param binding The length binding.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the binding is invalid.
+     */
+    int addLengthBinding(const SerialinkLength &binding);
+
+    /**
+     * @brief Sets the size of the target frame of a length binding.
+     *
+     * @param binding The length binding.
+     * @param data The received bytes of the source frame.
+     * @return `true` if the size has been set.
+     * @return `false` if the value is not valid (not found in the lookup table or out of range).
+     */
+    bool applyLengthBinding(const SerialinkLength &binding, const unsigned char *data);
+
+    /**
+     * @brief Gets the number of bytes that can be read at once after a field.
+     *
+     * The sizes of the following fields are summed until a field with an unknown size (data read until the stop bytes, start
+     * bytes) or a field with an execute function (which may change its own size). A field with a post-execution function
+     * is the last one that is summed, because the function may change the size of the next fields.
+     *
+     * @param format The frame format.
+     * @param idx The index of the last field that has been read.
+     * @return The number of bytes of the following fields.
+     */
+    static size_t getKnownSize(const SerialinkFormat &format, size_t idx);
+
+    /**
+     * @brief Updates the running checksums of a frame format with the received bytes of a field.
+     *
+     * The running checksum is restarted at its begin field and updated until its end field. At the validator field, the result is compared
+     * with the received checksum, so the frame data is not read again.
+     *
+     * @param format The frame format.
+     * @param idx The index of the field.
+     * @param data The received bytes of the field.
+     * @param sz The number of received bytes.
+     * @return `true` if the field is not a validator or the checksum is valid.
+     * @return `false` if the checksum is not valid.
+     */
+    static bool updateChecksums(SerialinkFormat &format, size_t idx, const unsigned char *data, size_t sz);
+
+    /**
+     * @brief Converts a checksum into the bytes of a validator frame.
+     *
+     * @param checksum The checksum setup.
+     * @param value The checksum.
+     * @param[out] buffer The checksum bytes (at least 4 bytes).
+     * @return The number of checksum bytes.
+     */
+    static size_t encodeChecksum(const SerialinkChecksum &checksum, unsigned int value, unsigned char *buffer);
+
+    /**
+     * @brief Finds the next start bytes candidate in the receive buffer after a rejected frame.
+     *
+     * The received bytes from `begin` are searched once for the start bytes of the frame formats. If no start bytes are found,
+     * the last bytes that may be the beginning of the start bytes are kept.
+     *
+     * @param begin The offset (from the oldest buffered byte) where the search begins.
+     * @param[out] isFound `true` if the start bytes are found.
+     * @return The offset of the next candidate (the bytes before it can be discarded).
+     */
+    size_t findResyncOffset(size_t begin, bool &isFound);
   public:
+    /**
+     * @brief Compiles a frame format into a field table.
+     *
+     * This function walks the `format` list once and stores, for each frame, the field kind (start bytes, stop bytes,
+     * content or invalid), the location of its reference bytes in `fieldReferences` and whether the next frame is a stop bytes
+     * frame. The type and the reference bytes of a `DataFrame` cannot change after it is created, so the parser does not
+     * need to inspect them again. The field size and the callbacks are still read from the frame while parsing, because they
+     * can be changed by the callbacks (for example a length field that sets the size of the data field).
+     *
+     * @param format The first frame of the frame format.
+     * @param[out] fieldTable The compiled field table.
+     * @param[out] fieldReferences The reference bytes of all fields.
+     */
+    static void compileFormat(DataFrame *format, std::vector <SerialinkField> &fieldTable, std::vector <unsigned char> &fieldReferences);
+
     /**
     * @brief Default constructor.
     *
@@ -72,12 +278,177 @@ class Serialink : public Serial {
     /**
      * @brief Retrieves the memory address of the frame format.
      *
-     * This function returns the address of the `frameFormat` data member.
+     * This function returns the address of the `frameFormat` data member. If several frame formats are set up (see `Serialink::addFormat`),
+     * this is the format of the last frame that has been read (the first format until then).
      *
      * @return The memory address of the `frameFormat`.
      */
     DataFrame *getFormat();
 
+    /**
+     * @brief Overloaded method of __getFormat__.
+     *
+     * @param index The index of the frame format (`0` for the format set with the assignment operator).
+     * @return The memory address of the frame format (or `nullptr` if the index is out of range).
+     */
+    DataFrame *getFormat(size_t index);
+
+    /**
+     * @brief Adds an alternative frame format.
+     *
+     * This function is used when a port carries several protocols. The new format and the format set with the assignment operator
+     * must begin with start bytes. `readFramedData` then searches the start bytes of all formats in one pass and reads the rest of
+     * the frame with the format whose start bytes are found first in the stream. If several formats have the same start bytes, the
+     * one with the lowest index is used.
+     *
+     * @param obj The first frame of the frame format.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up (the assignment operator must be used first).
+     * @return 4 if one of the formats does not begin with start bytes.
+     */
+    int addFormat(const DataFrame &obj);
+
+    /**
+     * @brief Binds the size of a frame to the value of another frame.
+     *
+     * This function replaces a post-execution function that calls `DataFrame::setSize`. When the source frame has been
+     * received, its first `width` bytes are decoded as an unsigned integer (`value`) and the size of the target frame is set to
+     * `value * scale + offset`. The rest of the frame (until a frame of unknown size) is then received with one read. A
+     * value that gives a negative size or a size larger than the receive buffer makes the frame invalid. A size of 0 gives
+     * an empty target frame.
+     *
+     * Both frames must belong to the same frame format (see `Serialink::getFormat`), and the source frame must have a fixed size and
+     * come before the target frame. The bindings are removed when the frame format is replaced with the assignment operator.
+     *
+     * @param target The frame whose size is set.
+     * @param source The frame that holds the length.
+     * @param width The number of bytes of the length (1 to 8, not larger than the size of the source frame).
+     * @param endian The byte order of the length.
+     * @param offset The value added to the scaled length.
+     * @param scale The multiplier of the length.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the binding is invalid.
+     */
+    int bindLength(DataFrame *target, DataFrame *source, size_t width, SERIALINK_ENDIAN endian, long long offset, unsigned long long scale);
+
+    /**
+     * @brief Overloaded method of __bindLength__ with frame types.
+     *
+     * The frames are the first frames of the specific types in the frame format returned by `Serialink::getFormat`.
+     *
+     * @param target The type of the frame whose size is set.
+     * @param source The type of the frame that holds the length.
+     * @param width The number of bytes of the length (1 to 8, not larger than the size of the source frame).
+     * @param endian The byte order of the length.
+     * @param offset The value added to the scaled length.
+     * @param scale The multiplier of the length.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the binding is invalid.
+     */
+    int bindLength(DataFrame::FRAME_TYPE_t target, DataFrame::FRAME_TYPE_t source, size_t width, SERIALINK_ENDIAN endian, long long offset, unsigned long long scale);
+
+    /**
+     * @brief Binds the size of a frame to a lookup table.
+     *
+     * The first `width` bytes of the source frame (for example a command) are decoded as an unsigned integer and the size of the target
+     * frame is taken from the table. A value that is not in the table makes the frame invalid.
+     *
+     * @param target The frame whose size is set.
+     * @param source The frame that holds the key.
+     * @param table The size of the target frame for each key.
+     * @param width The number of bytes of the key (1 to 8, not larger than the size of the source frame).
+     * @param endian The byte order of the key.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the binding is invalid.
+     */
+    int bindLength(DataFrame *target, DataFrame *source, const std::map <unsigned long long, size_t> &table, size_t width, SERIALINK_ENDIAN endian);
+
+    /**
+     * @brief Overloaded method of __bindLength__ with frame types and a lookup table.
+     *
+     * @param target The type of the frame whose size is set.
+     * @param source The type of the frame that holds the key.
+     * @param table The size of the target frame for each key.
+     * @param width The number of bytes of the key (1 to 8, not larger than the size of the source frame).
+     * @param endian The byte order of the key.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the binding is invalid.
+     */
+    int bindLength(DataFrame::FRAME_TYPE_t target, DataFrame::FRAME_TYPE_t source, const std::map <unsigned long long, size_t> &table, size_t width, SERIALINK_ENDIAN endian);
+
+    /**
+     * @brief Sets up the checksum of a validator frame.
+     *
+     * This function replaces a post-execution function that calculates a checksum. The checksum of the received bytes from the begin frame
+     * to the end frame (inclusive) is updated with `Checksum` as each frame is received, and compared with the validator bytes when the validator
+     * frame has been received, so the frame data is not read again. A different checksum makes the frame invalid (`readFramedData` returns 4).
+     * `writeFramedData` fills the validator frame with the checksum of the frame data.
+     *
+     * All frames must belong to the same frame format (see `Serialink::getFormat`), the begin frame must not come after the end frame,
+     * the end frame must come before the validator frame, and the size of the validator frame must be the size of the checksum.
+     * The setup is removed when the frame format is replaced with the assignment operator.
+     *
+     * @param validator The validator frame.
+     * @param type The checksum algorithm.
+     * @param begin The first frame of the checked data.
+     * @param end The last frame of the checked data.
+     * @param endian The byte order of the checksum in the validator frame.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the setup is invalid.
+     */
+    int setChecksum(DataFrame *validator, CHECKSUM_TYPE type, DataFrame *begin, DataFrame *end, SERIALINK_ENDIAN endian);
+
+    /**
+     * @brief Overloaded method of __setChecksum__ with frame types.
+     *
+     * The validator frame is the first `DataFrame::FRAME_TYPE_VALIDATOR` frame, and the begin and end frames are the first frames of
+     * the specific types in the frame format returned by `Serialink::getFormat`.
+     *
+     * @param type The checksum algorithm.
+     * @param begin The type of the first frame of the checked data.
+     * @param end The type of the last frame of the checked data.
+     * @param endian The byte order of the checksum in the validator frame.
+     * @return 0 on success.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if the setup is invalid.
+     */
+    int setChecksum(CHECKSUM_TYPE type, DataFrame::FRAME_TYPE_t begin, DataFrame::FRAME_TYPE_t end, SERIALINK_ENDIAN endian);
+
+    /**
+     * @brief Gets the number of frame formats.
+     *
+     * @return The number of frame formats.
+     */
+    size_t getFormatCount();
+
+    /**
+     * @brief Gets the index of the frame format of the last frame that has been read.
+     *
+     * @return The index of the frame format (see `Serialink::getFormat(size_t)`).
+     */
+    size_t getFormatIndex();
+
+    /**
+     * @brief Gets the resynchronisation counters.
+     *
+     * The counters are updated by `Serialink::readFramedData` when a frame is rejected (return code 4) or is not completed
+     * before the timeout. The next read restarts at the next start bytes found in the rejected bytes, so a valid frame that
+     * begins inside a damaged frame is not lost.
+     *
+     * @return The resynchronisation counters.
+     */
+    SerialinkResyncStats getResyncStats();
+
+    /**
+     * @brief Resets the resynchronisation counters.
+     */
+    void resetResyncStats();
+
     /**
      * @brief Stops reading framed serial data.
      *
@@ -91,7 +462,10 @@ class Serialink : public Serial {
      * @brief Performs serial data read operations with a custom frame format.
      *
      * This function executes serial data reading operations using a specific frame format.
-     * The read serial data can be retrieved using the `__Serial::getBuffer__` method.
+     * The read serial data can be retrieved using the `__Serial::getBuffer__` method. If several frame formats
+     * are set up, the format is selected by the start bytes that are found first (see `Serialink::addFormat`).
+     * After an invalid or incomplete frame, the next read continues from the next start bytes found after the first
+     * byte of that frame (see `Serialink::getResyncStats`).
      *
      * @return 0 on success.
      * @return 1 if the port is not open.
@@ -101,10 +475,36 @@ class Serialink : public Serial {
      */
     int readFramedData();
 
+    /**
+     * @brief Reads a burst of frames.
+     *
+     * The first frame is read as with `Serialink::readFramedData` (waiting for the data with the port timeout). The next
+     * frames are parsed only from the bytes that have already been received, so the burst ends without waiting for a timeout
+     * when the received bytes are exhausted. A frame that is not complete yet is kept for the next read, and invalid frames are
+     * skipped (see `Serialink::getResyncStats`).
+     *
+     * The frames are delivered into `arena`, which is cleared first but keeps its allocation, so a burst does not allocate once
+     * the arena has grown to the burst size. The bytes of the frames are stored one after another in `arena.data`. For each
+     * frame, `arena.frames` holds the index of its frame format, its location in `arena.data` and the range of its fields in
+     * `arena.fields`, which holds the location of each field in `arena.data`.
+     *
+     * @param max The maximum number of frames.
+     * @param deadlineMs The maximum time for the burst in milliseconds (0 for no limit). It limits the wait for the first frame and
+     *        it is checked after each frame.
+     * @param[out] arena The received frames.
+     * @return 0 if at least one frame is received.
+     * @return 1 if the port is not open.
+     * @return 2 if a timeout occurs before the first frame.
+     * @return 3 if the frame format is not set up.
+     * @return 4 if only invalid frames are received (or `max` is 0).
+     */
+    int readFrames(size_t max, unsigned int deadlineMs, SerialinkFrameArena &arena);
+
     /**
      * @brief Performs serial data write operations with a custom frame format.
      *
-     * This function executes serial data write operations using a specific frame format.
+     * This function executes serial data write operations using a specific frame format. The validator frames set up with
+     * `Serialink::setChecksum` are filled with the checksum of the frame data before writing.
      *
      * @return 0 on success.
      * @return 1 if the port is not open.
@@ -139,6 +539,109 @@ class Serialink : public Serial {
      */
     std::vector <unsigned char> getSpecificBufferAsVector(const DataFrame *begin, const DataFrame *end);
 
+    /**
+     * @brief Retrieves a view of the received frame data within a specified range.
+     *
+     * This method returns a view of the bytes of the last frame received by `Serialink::readFramedData`, from the first
+     * byte of `begin` to the last byte of `end`, without copying them. The view points into the receive buffer and is
+     * valid until the next read operation. This version is suitable for data with unique Frame Formats in each frame
+     * (no duplicate Frame Types).
+     *
+     * @param begin Reference to the starting point of the view.
+     * @param end Reference to the ending point of the view.
+     * @return A view of the data, or an empty view if no frame has been received or the range is not part of the received frame.
+     */
+    ByteView getSpecificBufferAsView(DataFrame::FRAME_TYPE_t begin, DataFrame::FRAME_TYPE_t end);
+
+    /**
+     * @brief Overloaded method of __getSpecificBufferAsView__.
+     *
+     * This method performs the same operation as the other overload but is designed to handle cases where duplicate
+     * Frame Formats exist within the Framed Data.
+     *
+     * @param begin Pointer to the starting point of the view.
+     * @param end Pointer to the ending point of the view.
+     * @return A view of the data, or an empty view if no frame has been received or the range is not part of the received frame.
+     */
+    ByteView getSpecificBufferAsView(const DataFrame *begin, const DataFrame *end);
+
+    /**
+     * @brief Retrieves a view of one field of the received frame.
+     *
+     * This is the zero-copy counterpart of `DataFrame::getDataAsVector` for received frames. The view points into the
+     * receive buffer and is valid until the next read operation.
+     *
+     * @param type The frame type of the field (the first field with this type).
+     * @return A view of the field data, or an empty view if no frame has been received or the field is not part of the received frame.
+     */
+    ByteView getFieldAsView(DataFrame::FRAME_TYPE_t type);
+
+    /**
+     * @brief Overloaded method of __getFieldAsView__.
+     *
+     * This method is designed to handle cases where duplicate Frame Formats exist within the Framed Data.
+     *
+     * @param frame Pointer to the field.
+     * @return A view of the field data, or an empty view if no frame has been received or the field is not part of the received frame.
+     */
+    ByteView getFieldAsView(const DataFrame *frame);
+
+    /**
+     * @brief Overloaded method of __getFieldAsView__ with a field handle.
+     *
+     * @param handle The handle of the field (see `Serialink::getHandle`).
+     * @return A view of the field data, or an empty view if no frame has been received or the field is not part of the received frame.
+     */
+    ByteView getFieldAsView(SerialinkHandle handle);
+
+    /**
+     * @brief Gets a handle of a field.
+     *
+     * A handle is the position of a field in its frame format. It stays valid when frames are appended with `operator+=` or
+     * `Serialink::addFormat`, and becomes invalid when the frame format is replaced with the assignment operator. Callbacks can
+     * look a field up once, store the handle and access the field with `Serialink::getField` or `Serialink::getFieldAsView`
+     * without walking the frame format for every frame.
+     *
+     * @param type The frame type of the field (the first field with this type in the current frame format).
+     * @return The handle (`field` is 0 if the field is not found).
+     */
+    SerialinkHandle getHandle(DataFrame::FRAME_TYPE_t type);
+
+    /**
+     * @brief Overloaded method of __getHandle__ for a frame format with duplicate frame types.
+     *
+     * @param params The frame type and the occurrence of the field (0 for the first field with this type).
+     * @return The handle (`field` is 0 if the field is not found).
+     */
+    SerialinkHandle getHandle(std::pair <DataFrame::FRAME_TYPE_t, int> params);
+
+    /**
+     * @brief Overloaded method of __getHandle__ for a field of any frame format.
+     *
+     * @param frame Pointer to the field (see `Serialink::getFormat`).
+     * @return The handle (`field` is 0 if the field is not found).
+     */
+    SerialinkHandle getHandle(const DataFrame *frame);
+
+    /**
+     * @brief Overloaded method of __getHandle__ for a field of a specific frame format.
+     *
+     * This is used for the frames of a burst (see `Serialink::readFrames`), which may belong to any frame format.
+     *
+     * @param format The index of the frame format (see `Serialink::getFormat(size_t)`).
+     * @param type The frame type of the field (the first field with this type in the frame format).
+     * @return The handle (`field` is 0 if the field is not found).
+     */
+    SerialinkHandle getHandle(size_t format, DataFrame::FRAME_TYPE_t type);
+
+    /**
+     * @brief Gets a field with its handle.
+     *
+     * @param handle The handle of the field (see `Serialink::getHandle`).
+     * @return The field (or `nullptr` if the handle is not valid).
+     */
+    DataFrame *getField(SerialinkHandle handle);
+
     Serialink& operator=(const DataFrame &obj);
 
     Serialink& operator+=(const DataFrame &obj);
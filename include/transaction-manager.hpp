@@ -0,0 +1,164 @@
+/*
+ * $Id: transaction-manager.hpp,v 1.0.0 2025/01/22 10:41:06 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Pipelined request/response transactions over a framed serial port.
+ *
+ * This file contains the `TransactionManager` class. A device that matches its responses to the requests with a sequence
+ * number (`DataFrame::FRAME_TYPE_SN`) can have several requests outstanding. The manager keeps a window of requests in flight
+ * on one `Serialink` port, so the device latency is paid once for the whole window instead of once per request. Each response
+ * is matched to its request by the key field, and each request has a deadline.
+ *
+ * The manager does not start a thread. The requests are written by `TransactionManager::submit` (or queued when the window is
+ * full) and the responses are read by `TransactionManager::process`, which calls the callback of each completed transaction.
+ *
+ * @version 1.0.0
+ * @date 2025-01-22
+ * @author Jaya Wikrama
+ */
+
+#ifndef __TRANSACTION_MANAGER_HPP__
+#define __TRANSACTION_MANAGER_HPP__
+
+#include <vector>
+#include <deque>
+#include <time.h>
+#include "serialink.hpp"
+
+typedef struct _SerialinkTransaction {
+    std::vector <unsigned char> request;
+    std::vector <unsigned char> key;
+    struct timespec deadline;
+    const void *callbackFunc;
+    void *callbackParam;
+} SerialinkTransaction;
+
+class TransactionManager {
+  private:
+    Serialink *link;
+    DataFrame::FRAME_TYPE_t keyType;
+    size_t window;
+    std::deque <SerialinkTransaction> queue;
+    std::vector <SerialinkTransaction> inFlight;
+
+    /**
+     * @brief Writes the queued requests while the window is not full.
+     *
+     * A request whose deadline has passed in the queue is completed with status `2`, and a request that cannot be written is
+     * completed with the status of `Serial::writeData`.
+     */
+    void sendQueued();
+
+    /**
+     * @brief Completes the requests in flight whose deadline has passed with status `2`.
+     */
+    void expire();
+
+    /**
+     * @brief Calls the callback of a completed transaction.
+     *
+     * @param transaction The transaction (already removed from the queue or the window).
+     * @param ret The status of the transaction.
+     */
+    void complete(const SerialinkTransaction &transaction, int ret);
+  public:
+    /**
+     * @brief Custom constructor.
+     *
+     * Creates a transaction manager for a port. The frame format of the port must be set up with the format of the responses.
+     * The key field is `DataFrame::FRAME_TYPE_SN` and the window is 4 requests.
+     *
+     * @param link The port (not owned by the manager, it must stay valid while the manager is used).
+     */
+    TransactionManager(Serialink &link);
+
+    /**
+     * @brief Sets the field of the responses that identifies the request.
+     *
+     * @param type The frame type of the key field (the first field with this type).
+     */
+    void setKeyField(DataFrame::FRAME_TYPE_t type);
+
+    /**
+     * @brief Sets the maximum number of requests in flight.
+     *
+     * @param window The number of requests (a window of 1 is the stop-and-wait mode).
+     */
+    void setWindow(size_t window);
+
+    /**
+     * @brief Submits a request.
+     *
+     * The request is written at once if the window is not full, otherwise it is queued. The callback is called by
+     * `TransactionManager::process` with:
+     * - `0` when the response is received. The fields of the response can be read from the port (for example with
+     *   `Serialink::getFieldAsView`) inside the callback.
+     * - `2` when the deadline passes before the response is received.
+     * - `1` or `2` when the queued request cannot be written.
+     *
+     * The callback prototype is `void callback(TransactionManager &manager, int ret, Serialink &link, void *param)`. A new request
+     * can be submitted from the callback.
+     *
+     * @param request The encoded request frame (for example from `FrameEncoder::encode`).
+     * @param key The value of the key field of the expected response.
+     * @param timeoutMs The time limit of the transaction in milliseconds, counted from the submission.
+     * @param func The callback function.
+     * @param param The parameter of the callback function.
+     * @return 0 on success.
+     * @return 1 if the port is not open.
+     * @return 2 if the request cannot be written.
+     * @return 4 if the request or the key is empty.
+     */
+    int submit(ByteView request, ByteView key, unsigned int timeoutMs, const void *func, void *param);
+
+    /**
+     * @brief Reads one response and completes the transactions.
+     *
+     * The expired transactions are completed, the queued requests are written while the window is not full, and one frame is
+     * read with `Serialink::readFramedData` (waiting at most the port timeout). A response that does not match any request in
+     * flight is ignored.
+     *
+     * @return 0 if a frame is received.
+     * @return 2 if a timeout occurs.
+     * @return 3 if there is no pending transaction.
+     * @return 4 if the received frame is invalid.
+     */
+    int process();
+
+    /**
+     * @brief Gets the number of requests that have been written and wait for their response.
+     *
+     * @return The number of requests in flight.
+     */
+    size_t getInFlightCount();
+
+    /**
+     * @brief Gets the number of pending transactions (in flight and queued).
+     *
+     * @return The number of pending transactions.
+     */
+    size_t getPendingCount();
+};
+
+#endif
@@ -46,6 +46,21 @@
  * The Virtual Serial Proxy is ideal for scenarios where managing multiple devices and monitoring data
  * flow is essential, offering a more flexible and streamlined approach to serial communication.
  *
+ * Both directions are forwarded by one `SerialReactor` (epoll) loop. When both ports are readable,
+ * both are served in the same wakeup, and received bytes are forwarded as soon as they arrive
+ * (the keep-alive interval is not used while the proxy is running). The throughput and forwarding
+ * latency of each direction are available with `VirtualSerialProxy::getStats`.
+ *
+ * When no Pass Through function is installed, the splice mode (`VirtualSerialProxy::setSpliceMode`) moves
+ * the bytes between the physical port and the pty master with `splice` through an internal pipe per
+ * direction, so the forwarded data is never copied to user space.
+ *
+ * One physical port can be shared by several applications (`VirtualSerialProxy::addClient`). Every client
+ * has its own pty. The data received from the device is broadcast to all clients, each with its own
+ * bounded queue, so a slow reader only loses its own data. The data written by the clients is arbitrated
+ * into the device (`VirtualSerialProxy::setArbitration`): first-come (chunk by chunk), frame-atomic
+ * (complete frames only, in arrival order) or priority (complete frames, highest priority first).
+ *
  *
  * @version 1.0.0
  * @date 2024-09-18
@@ -56,6 +71,45 @@
 #define __VIRTUAL_PROXY_DEVICE_HPP__
 
 #include "virtuser.hpp"
+#include "serial-reactor.hpp"
+#include <deque>
+
+typedef enum _PROXY_DIRECTION {
+  PROXY_DIRECTION_DEVICE_TO_PTY = 0,
+  PROXY_DIRECTION_PTY_TO_DEVICE
+} PROXY_DIRECTION;
+
+typedef enum _PROXY_ARBITRATION {
+  PROXY_ARBITRATION_FIRST_COME = 0,
+  PROXY_ARBITRATION_FRAME_ATOMIC,
+  PROXY_ARBITRATION_PRIORITY
+} PROXY_ARBITRATION;
+
+typedef struct _VirtualSerialProxyStats {
+  unsigned long long bytes;
+  unsigned long long chunks;
+  unsigned long long dropped;
+  unsigned long long totalLatencyUs;
+  unsigned long long maxLatencyUs;
+  double elapsedSec;
+} VirtualSerialProxyStats;
+
+typedef struct _VirtualSerialProxyFrame {
+  unsigned long long sequence;
+  struct timespec tsQueued;
+  std::vector <unsigned char> data;
+} VirtualSerialProxyFrame;
+
+typedef struct _VirtualSerialProxyClient {
+  VirtualSerial *pty;
+  int priority;
+  int holdFd;
+  std::vector <unsigned char> pending;
+  std::deque <VirtualSerialProxyFrame> frames;
+  size_t queuedSize;
+  unsigned long long dropped;
+  bool isResyncing;
+} VirtualSerialProxyClient;
 
 class VirtualSerialProxy {
   private:
@@ -64,8 +118,112 @@ class VirtualSerialProxy {
     std::string symlinkPort;
     VirtualSerial *pty;
     Serial *dev;
+    SerialReactor *reactor;
+    std::vector <VirtualSerialProxyClient *> clients;
+    PROXY_ARBITRATION arbitration;
+    std::vector <unsigned char> frameDelimiter;
+    size_t clientQueueLimit;
+    unsigned long long sequence;
     const void *passthroughFunc;
     void *passthroughParam;
+    bool isSpliceMode;
+    int eventFd;
+    pthread_mutex_t mtx;
+    VirtualSerialProxyStats stats[2];
+    struct timespec tsStart;
+
+    /**
+     * @brief Forwards the received data to the other port.
+     *
+     * This function is the data callback of both ports registered to the reactor. The received data is handed to the Pass Through
+     * function (if any) or queued for the other port without blocking. The statistics of the direction are updated.
+     *
+     * @param src The port where the data has been received.
+     * @param data The received data.
+     * @param sz The size of the received data.
+     * @param param The pointer of the `VirtualSerialProxy` object.
+     */
+    static void forwardData(Serial &src, const unsigned char *data, size_t sz, void *param);
+
+    /**
+     * @brief Updates the statistics of a forwarding direction.
+     *
+     * @param direction The forwarding direction.
+     * @param sz The number of forwarded bytes.
+     * @param latencyUs The forwarding latency in microseconds.
+     */
+    void updateStats(PROXY_DIRECTION direction, size_t sz, unsigned long long latencyUs);
+
+    /**
+     * @brief Creates a client entry.
+     *
+     * @param pty The pty of the client.
+     * @param priority The priority of the client.
+     */
+    void createClient(VirtualSerial *pty, int priority);
+
+    /**
+     * @brief Counts the bytes dropped for a client.
+     *
+     * @param client The client entry.
+     * @param direction The forwarding direction of the dropped bytes.
+     * @param sz The number of dropped bytes.
+     */
+    void dropClientData(VirtualSerialProxyClient *client, PROXY_DIRECTION direction, size_t sz);
+
+    /**
+     * @brief Queues the data written by a client for the device.
+     *
+     * The data is split into units according to the arbitration policy (received chunks or complete frames). When a frame
+     * does not fit within the client queue limit, its bytes are dropped up to the next delimiter.
+     *
+     * @param client The client entry.
+     * @param data The received data.
+     * @param sz The size of the received data.
+     */
+    void queueClientData(VirtualSerialProxyClient *client, const unsigned char *data, size_t sz);
+
+    /**
+     * @brief Writes the queued client units into the device while the device has no pending output.
+     *
+     * The next unit is selected according to the arbitration policy.
+     */
+    void pumpDevice();
+
+    /**
+     * @brief Drain callback of the device port.
+     *
+     * @param serial The device port.
+     * @param param The pointer of the `VirtualSerialProxy` object.
+     */
+    static void drainDevice(Serial &serial, void *param);
+
+    /**
+     * @brief Write handler of both ports while a Pass Through function is used.
+     *
+     * The data written by the Pass Through function is queued into the reactor instead of blocking the proxy loop.
+     *
+     * @param serial The destination port.
+     * @param buffer Data to be written.
+     * @param sz Size of the data to be written.
+     * @param param The pointer of the `VirtualSerialProxy` object.
+     * @return 0 if the data is queued.
+     * @return 1 if the port is not registered.
+     * @return 2 if the data write operation fails.
+     */
+    static int queueWrite(Serial &serial, const unsigned char *buffer, size_t sz, void *param);
+
+    /**
+     * @brief Forwards the data in both directions with `splice`.
+     *
+     * Each direction has its own pipe. The bytes are moved from the source into the pipe and from the pipe into the destination
+     * without being copied to user space. Both file descriptors are switched to non-blocking mode while the loop is running.
+     *
+     * @return `0` if the loop has been stopped by the `stop` method.
+     * @return `1` if a port has been disconnected or an I/O error occurs.
+     * @return `2` if `splice` is not supported for the ports (nothing has been forwarded).
+     */
+    int spliceLoop();
   public:
     /**
      * @brief Default constructor.
@@ -130,7 +288,7 @@ class VirtualSerialProxy {
     /**
      * @brief Sets the baud rate for communication.
      *
-     * This setter function configures the baud rate used for serial communication.
+     * This setter function configures the baud rate used for serial communication, on the device and every client pty.
      *
      * @param baud The baud rate (e.g., `B9600` for 9600 bps).
      */
@@ -139,7 +297,8 @@ class VirtualSerialProxy {
     /**
      * @brief Sets the communication timeout.
      *
-     * This setter function configures the timeout for serial communication. The timeout value is specified in units of 100 milliseconds.
+     * This setter function configures the timeout for serial communication, on the device and every client pty. The timeout value is specified
+     * in units of 100 milliseconds.
      *
      * @param timeout The timeout value (e.g., `10` for a 1-second timeout).
      */
@@ -149,6 +308,7 @@ class VirtualSerialProxy {
      * @brief Sets the keep-alive interval for communication.
      *
      * This setter function configures the maximum wait time for receiving the next byte of serial data after the initial byte has been received. This helps maintain the connection by ensuring timely data reception.
+     * The interval is applied to the device and every client pty.
      *
      * @param keepAliveMs The keep-alive interval in milliseconds.
      */
@@ -172,6 +332,15 @@ class VirtualSerialProxy {
      */
     std::string getSymlinkPort();
 
+    /**
+     * @brief Gets the name of pseudo serial port.
+     *
+     * This getter function retrieves the name of the pseudo serial port (slave) that is used by the application.
+     *
+     * @return The name of pseudo serial port (e.g., "/dev/pts/3").
+     */
+    std::string getVirtualPortName();
+
     /**
      * @brief Gets the baud rate for serial communication.
      *
@@ -203,7 +372,10 @@ class VirtualSerialProxy {
      * @brief Sets the Pass Through function.
      *
      * This method allows you to specify a callback function that will be used for handling data operations
-     * (reading and writing) on the virtual serial poxy. (Mandatory before call the `begin` method).
+     * (reading and writing) on the virtual serial poxy. The function is called from the proxy loop each time the source has received
+     * data, so `Serial::readData` on the source returns the received bytes immediately. If no function is set, the data is forwarded as is.
+     * The function is only used while the proxy has a single client (see `addClient`). Its writes to the destination are queued into
+     * the proxy loop, so `Serial::writeData` returns without waiting for the port.
      *
      * @param func Pass Through function that has 3 parameters. First `Serial &` is source and the second `Serial &` is destination. `void *` is a pointer that will connect directly to `void *param`.
      * @param param Pointer to the parameter for the callback function.
@@ -224,13 +396,139 @@ class VirtualSerialProxy {
      */
     void *getPassThroughParam();
 
+    /**
+     * @brief Adds a client pty.
+     *
+     * This method creates one more pty that shares the physical port (must be called before the `begin` method). The data received from the
+     * device is broadcast to every client. The default client (created by the constructor) has the index `0` and the priority `0`.
+     * The new pty uses the current baud rate, timeout and keep-alive interval, and follows the later changes of these settings.
+     *
+     * @param priority The priority of the client, used by `PROXY_ARBITRATION_PRIORITY` (a higher value is served first).
+     * @return The index of the new client.
+     */
+    size_t addClient(int priority);
+
+    /**
+     * @brief Gets the number of clients.
+     *
+     * @return The number of client ptys.
+     */
+    size_t getClientCount();
+
+    /**
+     * @brief Sets the priority of a client.
+     *
+     * @param index The index of the client.
+     * @param priority The priority of the client (a higher value is served first).
+     */
+    void setClientPriority(size_t index, int priority);
+
+    /**
+     * @brief Gets the name of pseudo serial port of a client.
+     *
+     * @param index The index of the client.
+     * @return The name of pseudo serial port (or an empty string if the index is invalid).
+     */
+    std::string getVirtualPortName(size_t index);
+
+    /**
+     * @brief Gets the number of bytes dropped for a client.
+     *
+     * The bytes are dropped when the queue of the client (in either direction) exceeds the client queue limit.
+     *
+     * @param index The index of the client.
+     * @return The number of dropped bytes.
+     */
+    unsigned long long getDroppedBytes(size_t index);
+
+    /**
+     * @brief Sets the policy used to arbitrate the client writes into the device.
+     *
+     * - `PROXY_ARBITRATION_FIRST_COME`: every received chunk is forwarded in arrival order (chunks of different clients may interleave).
+     * - `PROXY_ARBITRATION_FRAME_ATOMIC`: only complete frames are forwarded, in the order they are completed, so frames never interleave.
+     * - `PROXY_ARBITRATION_PRIORITY`: complete frames are forwarded, the client with the highest priority is served first.
+     *
+     * @param policy The arbitration policy (default: `PROXY_ARBITRATION_FIRST_COME`).
+     */
+    void setArbitration(PROXY_ARBITRATION policy);
+
+    /**
+     * @brief Gets the arbitration policy.
+     *
+     * @return The arbitration policy.
+     */
+    PROXY_ARBITRATION getArbitration();
+
+    /**
+     * @brief Sets the frame delimiter.
+     *
+     * This setter function configures the bytes that end a frame written by a client (e.g. "\r\n"). It is used by the frame-atomic and
+     * priority policies. If no delimiter is set, each received chunk is handled as a complete frame.
+     *
+     * @param delimiter The frame delimiter.
+     */
+    void setFrameDelimiter(const std::vector <unsigned char> &delimiter);
+
+    /**
+     * @brief Sets the maximum number of bytes queued per client.
+     *
+     * This setter function limits the data waiting for a slow client (device to client) and the data of a client waiting for the device
+     * (client to device). The data that exceeds the limit is dropped and counted.
+     *
+     * @param sz The queue limit in bytes (default: 65536).
+     */
+    void setClientQueueLimit(size_t sz);
+
+    /**
+     * @brief Sets the splice mode.
+     *
+     * This setter function enables the zero-copy fast path. When the splice mode is enabled and no Pass Through function is set, the `begin`
+     * method forwards the data with `splice` through an internal pipe instead of reading it into the receive buffers. If the kernel cannot
+     * splice the ports (or the proxy has more than one client), the proxy uses the normal forwarding loop.
+     *
+     * @param enable `true` to enable the splice mode (default: `false`).
+     */
+    void setSpliceMode(bool enable);
+
+    /**
+     * @brief Gets the splice mode.
+     *
+     * @return `true` if the splice mode is enabled.
+     */
+    bool getSpliceMode();
+
+    /**
+     * @brief Gets the statistics of a forwarding direction.
+     *
+     * This getter function retrieves the number of forwarded bytes and chunks, the forwarding latency (from the moment the chunk is received
+     * until it has been written or queued to the destination) and the elapsed time since the proxy has been started (or the statistics have been reset).
+     *
+     * @param direction The forwarding direction.
+     * @return The statistics of the direction.
+     */
+    VirtualSerialProxyStats getStats(PROXY_DIRECTION direction);
+
+    /**
+     * @brief Resets the statistics of both directions.
+     */
+    void resetStats();
+
     /**
      * @brief Method to start the proxy.
      *
-     * @return `false` if the Pass Through function has not been set up or failed to start operation.
-     * @return `true` if the Pass Through function has been successfully executed.
+     * This method forwards the data in both directions until the `stop` method is called.
+     *
+     * @return `false` if failed to start operation.
+     * @return `true` if the proxy has been stopped by the `stop` method.
      */
     bool begin();
+
+    /**
+     * @brief Stops the proxy.
+     *
+     * This method is thread safe. The `begin` method returns after the current events have been processed.
+     */
+    void stop();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,296 @@
+/*
+ * $Id: byte-search.cpp,v 1.0.0 2025/01/17 09:31:52 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <string.h>
+#include "byte-search.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define BYTE_SEARCH_X86
+#endif
+
+static bool findScalar(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz, size_t begin, size_t &position){
+    size_t last = sz - patternSz;
+    const unsigned char *candidate = nullptr;
+    while (begin <= last){
+        candidate = (const unsigned char *) memchr(buffer + begin, pattern[0], last - begin + 1);
+        if (candidate == nullptr) return false;
+        begin = candidate - buffer;
+        if (memcmp(candidate, pattern, patternSz) == 0){
+            position = begin;
+            return true;
+        }
+        begin++;
+    }
+    return false;
+}
+
+#if defined(BYTE_SEARCH_X86) && defined(__SSE2__)
+static bool findSSE2(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz, size_t &position){
+    size_t i = 0;
+    size_t candidate = 0;
+    unsigned int maskFirst = 0;
+    unsigned int mask = 0;
+    const unsigned char *next = nullptr;
+    const __m128i first = _mm_set1_epi8((char) pattern[0]);
+    const __m128i last = _mm_set1_epi8((char) pattern[patternSz - 1]);
+    __m128i blockFirst;
+    __m128i blockLast;
+    while (i + patternSz + 15 <= sz){
+        blockFirst = _mm_loadu_si128((const __m128i *) (buffer + i));
+        maskFirst = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(blockFirst, first));
+        if (maskFirst == 0){
+            /* sparse first byte (random noise), memchr skips faster than the block compare */
+            next = (const unsigned char *) memchr(buffer + i + 16, pattern[0], sz - patternSz + 1 - (i + 16));
+            if (next == nullptr) return false;
+            i = next - buffer;
+            continue;
+        }
+        blockLast = _mm_loadu_si128((const __m128i *) (buffer + i + patternSz - 1));
+        mask = maskFirst & (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(blockLast, last));
+        while (mask != 0){
+            candidate = i + __builtin_ctz(mask);
+            if (memcmp(buffer + candidate, pattern, patternSz) == 0){
+                position = candidate;
+                return true;
+            }
+            mask &= mask - 1;
+        }
+        i += 16;
+    }
+    return findScalar(buffer, sz, pattern, patternSz, i, position);
+}
+#endif
+
+#if defined(BYTE_SEARCH_X86)
+__attribute__((target("avx2")))
+static bool findAVX2(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz, size_t &position){
+    size_t i = 0;
+    size_t candidate = 0;
+    unsigned int maskFirst = 0;
+    unsigned int mask = 0;
+    const unsigned char *next = nullptr;
+    const __m256i first = _mm256_set1_epi8((char) pattern[0]);
+    const __m256i last = _mm256_set1_epi8((char) pattern[patternSz - 1]);
+    __m256i blockFirst;
+    __m256i blockLast;
+    while (i + patternSz + 31 <= sz){
+        blockFirst = _mm256_loadu_si256((const __m256i *) (buffer + i));
+        maskFirst = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(blockFirst, first));
+        if (maskFirst == 0){
+            /* sparse first byte (random noise), memchr skips faster than the block compare */
+            next = (const unsigned char *) memchr(buffer + i + 32, pattern[0], sz - patternSz + 1 - (i + 32));
+            if (next == nullptr) return false;
+            i = next - buffer;
+            continue;
+        }
+        blockLast = _mm256_loadu_si256((const __m256i *) (buffer + i + patternSz - 1));
+        mask = maskFirst & (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(blockLast, last));
+        while (mask != 0){
+            candidate = i + __builtin_ctz(mask);
+            if (memcmp(buffer + candidate, pattern, patternSz) == 0){
+                position = candidate;
+                return true;
+            }
+            mask &= mask - 1;
+        }
+        i += 32;
+    }
+    return findScalar(buffer, sz, pattern, patternSz, i, position);
+}
+#endif
+
+static BYTE_SEARCH_ENGINE selectEngine(){
+#if defined(BYTE_SEARCH_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return BYTE_SEARCH_ENGINE_AVX2;
+#if defined(__SSE2__)
+    return BYTE_SEARCH_ENGINE_SSE2;
+#endif
+#endif
+    return BYTE_SEARCH_ENGINE_SCALAR;
+}
+
+/**
+ * @brief Finds the first occurrence of a byte sequence.
+ *
+ * @param buffer The data to be searched.
+ * @param sz The size of the data.
+ * @param pattern The byte sequence.
+ * @param patternSz The size of the byte sequence.
+ * @param[out] position The offset of the first occurrence (only set if it is found).
+ * @return `true` if the byte sequence is found.
+ * @return `false` if the byte sequence is not found (or it is empty).
+ */
+bool ByteSearch::find(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz, size_t &position){
+    return ByteSearch::find(ByteSearch::getEngine(), buffer, sz, pattern, patternSz, position);
+}
+
+/**
+ * @brief Finds the first occurrence of a byte sequence with a specific engine.
+ *
+ * This method is used by the tests and the benchmark to compare the engines. If the engine is not supported by the CPU,
+ * the scalar engine is used.
+ *
+ * @param engine The search engine.
+ * @param buffer The data to be searched.
+ * @param sz The size of the data.
+ * @param pattern The byte sequence.
+ * @param patternSz The size of the byte sequence.
+ * @param[out] position The offset of the first occurrence (only set if it is found).
+ * @return `true` if the byte sequence is found.
+ * @return `false` if the byte sequence is not found (or it is empty).
+ */
+bool ByteSearch::find(BYTE_SEARCH_ENGINE engine, const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz, size_t &position){
+    if (patternSz == 0 || sz < patternSz) return false;
+#if defined(BYTE_SEARCH_X86)
+    if (engine == BYTE_SEARCH_ENGINE_AVX2 && ByteSearch::getEngine() == BYTE_SEARCH_ENGINE_AVX2){
+        return findAVX2(buffer, sz, pattern, patternSz, position);
+    }
+#if defined(__SSE2__)
+    if (engine == BYTE_SEARCH_ENGINE_SSE2 || engine == BYTE_SEARCH_ENGINE_AVX2){
+        return findSSE2(buffer, sz, pattern, patternSz, position);
+    }
+#endif
+#endif
+    return findScalar(buffer, sz, pattern, patternSz, 0, position);
+}
+
+/**
+ * @brief Gets the engine selected for the running CPU.
+ *
+ * @return The engine used by `ByteSearch::find`.
+ */
+BYTE_SEARCH_ENGINE ByteSearch::getEngine(){
+    static const BYTE_SEARCH_ENGINE engine = selectEngine();
+    return engine;
+}
+
+/**
+ * @brief Default constructor.
+ *
+ * Creates an empty set.
+ */
+ByteSearchSet::ByteSearchSet(){
+    this->clear();
+}
+
+/**
+ * @brief Adds a byte sequence to the set.
+ *
+ * @param pattern The byte sequence.
+ * @param sz The size of the byte sequence.
+ * @return The index of the byte sequence in the set.
+ */
+size_t ByteSearchSet::add(const unsigned char *pattern, size_t sz){
+    size_t index = this->patterns.size();
+    this->patterns.push_back(std::vector <unsigned char>(pattern, pattern + sz));
+    if (sz > 0){
+        this->firstBytes[pattern[0] >> 6] |= (1ULL << (pattern[0] & 0x3F));
+        this->candidates[pattern[0]].push_back(index);
+    }
+    return index;
+}
+
+/**
+ * @brief Overloaded method of __add__.
+ *
+ * @param pattern The byte sequence.
+ * @return The index of the byte sequence in the set.
+ */
+size_t ByteSearchSet::add(const std::vector <unsigned char> &pattern){
+    return this->add(pattern.data(), pattern.size());
+}
+
+/**
+ * @brief Removes all byte sequences.
+ */
+void ByteSearchSet::clear(){
+    this->patterns.clear();
+    this->candidates.assign(256, std::vector <size_t>());
+    memset(this->firstBytes, 0x00, sizeof(this->firstBytes));
+}
+
+/**
+ * @brief Gets the number of byte sequences.
+ *
+ * @return The number of byte sequences in the set.
+ */
+size_t ByteSearchSet::getCount() const {
+    return this->patterns.size();
+}
+
+/**
+ * @brief Gets a byte sequence of the set.
+ *
+ * @param index The index of the byte sequence.
+ * @return The byte sequence.
+ */
+const std::vector <unsigned char> &ByteSearchSet::get(size_t index) const {
+    return this->patterns.at(index);
+}
+
+/**
+ * @brief Finds the first occurrence of any byte sequence of the set.
+ *
+ * The data is scanned once. If several sequences match at the same offset, the one with the lowest index is selected.
+ * If no sequence is found but a sequence may still match at an offset where the data ends before its last byte, `checked`
+ * stops at that offset, so the caller can wait for more bytes and search again from there.
+ *
+ * @param buffer The data to be searched.
+ * @param sz The size of the data.
+ * @param[out] position The offset of the first occurrence (only set if it is found).
+ * @param[out] index The index of the matched byte sequence (only set if it is found).
+ * @param[out] checked The number of leading bytes where no sequence of the set can begin.
+ * @return `true` if a byte sequence is found.
+ * @return `false` if no byte sequence is found.
+ */
+bool ByteSearchSet::find(const unsigned char *buffer, size_t sz, size_t &position, size_t &index, size_t &checked) const {
+    size_t i = 0;
+    size_t available = 0;
+    size_t partial = sz;
+    unsigned char value = 0;
+    const std::vector <unsigned char> *pattern = nullptr;
+    for (i = 0; i < sz; i++){
+        value = buffer[i];
+        if ((this->firstBytes[value >> 6] & (1ULL << (value & 0x3F))) == 0) continue;
+        available = sz - i;
+        for (auto candidate : this->candidates[value]){
+            pattern = &(this->patterns[candidate]);
+            if (available >= pattern->size()){
+                if (memcmp(buffer + i, pattern->data(), pattern->size()) == 0){
+                    position = i;
+                    index = candidate;
+                    checked = (partial < i ? partial : i);
+                    return true;
+                }
+            }
+            else if (partial == sz && memcmp(buffer + i, pattern->data(), available) == 0){
+                /* this sequence may still match when more bytes are received, the other sequences are still searched */
+                partial = i;
+            }
+        }
+    }
+    checked = partial;
+    return false;
+}
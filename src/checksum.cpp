@@ -0,0 +1,477 @@
+/*
+ * $Id: checksum.cpp,v 1.0.0 2025/01/18 10:12:05 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <string.h>
+#include "checksum.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define CHECKSUM_X86
+#endif
+
+typedef struct _ChecksumTables {
+    unsigned int crc16Ccitt[8][256];
+    unsigned int crc16Modbus[8][256];
+    unsigned int crc32[8][256];
+    unsigned int crc32c[8][256];
+} ChecksumTables;
+
+typedef struct _ChecksumFeatures {
+    bool isSSE42;
+    bool isPCLMUL;
+} ChecksumFeatures;
+
+static void createReflectedTable(unsigned int table[8][256], unsigned int poly){
+    unsigned int crc = 0;
+    for (unsigned int i = 0; i < 256; i++){
+        crc = i;
+        for (int j = 0; j < 8; j++){
+            crc = (crc & 1) ? ((crc >> 1) ^ poly) : (crc >> 1);
+        }
+        table[0][i] = crc;
+    }
+    for (unsigned int i = 0; i < 256; i++){
+        for (int k = 1; k < 8; k++){
+            table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+        }
+    }
+}
+
+static void createNormalTable16(unsigned int table[8][256], unsigned int poly){
+    unsigned int crc = 0;
+    for (unsigned int i = 0; i < 256; i++){
+        crc = i << 8;
+        for (int j = 0; j < 8; j++){
+            crc = (crc & 0x8000) ? ((crc << 1) ^ poly) : (crc << 1);
+        }
+        table[0][i] = crc & 0xFFFF;
+    }
+    for (unsigned int i = 0; i < 256; i++){
+        for (int k = 1; k < 8; k++){
+            table[k][i] = ((table[k - 1][i] << 8) & 0xFFFF) ^ table[0][(table[k - 1][i] >> 8) & 0xFF];
+        }
+    }
+}
+
+static const ChecksumTables *createTables(){
+    ChecksumTables *tables = new ChecksumTables;
+    createNormalTable16(tables->crc16Ccitt, 0x1021);
+    createReflectedTable(tables->crc16Modbus, 0xA001);
+    createReflectedTable(tables->crc32, 0xEDB88320);
+    createReflectedTable(tables->crc32c, 0x82F63B78);
+    return tables;
+}
+
+static const ChecksumTables &getTables(){
+    static const ChecksumTables *tables = createTables();
+    return *tables;
+}
+
+static ChecksumFeatures selectFeatures(){
+    ChecksumFeatures features;
+    features.isSSE42 = false;
+    features.isPCLMUL = false;
+#if defined(CHECKSUM_X86)
+    __builtin_cpu_init();
+    features.isSSE42 = __builtin_cpu_supports("sse4.2");
+    features.isPCLMUL = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif
+    return features;
+}
+
+static const ChecksumFeatures &getFeatures(){
+    static const ChecksumFeatures features = selectFeatures();
+    return features;
+}
+
+/* slice-by-8 for reflected CRCs (the state is in the low bits), 8 table lookups per 8 bytes */
+static unsigned int updateReflected(const unsigned int table[8][256], unsigned int crc, const unsigned char *data, size_t sz){
+    unsigned int lo = 0;
+    unsigned int hi = 0;
+    while (sz >= 8){
+        lo = crc ^ (static_cast<unsigned int>(data[0]) |
+                    (static_cast<unsigned int>(data[1]) << 8) |
+                    (static_cast<unsigned int>(data[2]) << 16) |
+                    (static_cast<unsigned int>(data[3]) << 24));
+        hi = static_cast<unsigned int>(data[4]) |
+             (static_cast<unsigned int>(data[5]) << 8) |
+             (static_cast<unsigned int>(data[6]) << 16) |
+             (static_cast<unsigned int>(data[7]) << 24);
+        crc = table[7][lo & 0xFF] ^ table[6][(lo >> 8) & 0xFF] ^ table[5][(lo >> 16) & 0xFF] ^ table[4][lo >> 24] ^
+              table[3][hi & 0xFF] ^ table[2][(hi >> 8) & 0xFF] ^ table[1][(hi >> 16) & 0xFF] ^ table[0][hi >> 24];
+        data += 8;
+        sz -= 8;
+    }
+    while (sz > 0){
+        crc = (crc >> 8) ^ table[0][(crc ^ *data) & 0xFF];
+        data++;
+        sz--;
+    }
+    return crc;
+}
+
+/* slice-by-8 for 16-bit CRCs that are not reflected (the state is mixed with the first 2 bytes of each step) */
+static unsigned int updateNormal16(const unsigned int table[8][256], unsigned int crc, const unsigned char *data, size_t sz){
+    while (sz >= 8){
+        crc = table[7][((crc >> 8) ^ data[0]) & 0xFF] ^ table[6][(crc ^ data[1]) & 0xFF] ^
+              table[5][data[2]] ^ table[4][data[3]] ^ table[3][data[4]] ^ table[2][data[5]] ^
+              table[1][data[6]] ^ table[0][data[7]];
+        data += 8;
+        sz -= 8;
+    }
+    while (sz > 0){
+        crc = ((crc << 8) & 0xFFFF) ^ table[0][((crc >> 8) ^ *data) & 0xFF];
+        data++;
+        sz--;
+    }
+    return crc;
+}
+
+#if defined(CHECKSUM_X86)
+__attribute__((target("sse4.2")))
+static unsigned int updateCrc32cSSE42(unsigned int crc, const unsigned char *data, size_t sz){
+#if defined(__x86_64__)
+    unsigned long long crc64 = crc;
+    unsigned long long value = 0;
+    while (sz >= 8){
+        memcpy(&value, data, 8);
+        crc64 = _mm_crc32_u64(crc64, value);
+        data += 8;
+        sz -= 8;
+    }
+    crc = static_cast<unsigned int>(crc64);
+#endif
+    while (sz > 0){
+        crc = _mm_crc32_u8(crc, *data);
+        data++;
+        sz--;
+    }
+    return crc;
+}
+
+/*
+ * CRC32 with carry-less multiplication (Gopal et al., "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction").
+ * The size must be a multiple of 16 and at least 64. Four 128-bit lanes are folded by 64 bytes per step, then folded into one lane,
+ * reduced to 64 bits and to the 32-bit CRC with a Barrett reduction.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static unsigned int updateCrc32PCLMUL(unsigned int crc, const unsigned char *data, size_t sz){
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000LL, 0x0163cd6124LL);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+    x1 = _mm_loadu_si128((const __m128i *) (data + 0x00));
+    x2 = _mm_loadu_si128((const __m128i *) (data + 0x10));
+    x3 = _mm_loadu_si128((const __m128i *) (data + 0x20));
+    x4 = _mm_loadu_si128((const __m128i *) (data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+    x0 = k1k2;
+    data += 64;
+    sz -= 64;
+    while (sz >= 64){
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *) (data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *) (data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *) (data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *) (data + 0x30)));
+        data += 64;
+        sz -= 64;
+    }
+    /* fold the 4 lanes into one */
+    x0 = k3k4;
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+    while (sz >= 16){
+        x2 = _mm_loadu_si128((const __m128i *) data);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        data += 16;
+        sz -= 16;
+    }
+    /* 128 bits to 64 bits */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x0 = k5k0;
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    /* Barrett reduction to 32 bits */
+    x0 = poly;
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<unsigned int>(_mm_extract_epi32(x1, 1));
+}
+#endif
+
+static unsigned int updateFletcher16(unsigned int state, const unsigned char *data, size_t sz){
+    unsigned int sum1 = state & 0xFF;
+    unsigned int sum2 = (state >> 8) & 0xFF;
+    size_t block = 0;
+    while (sz > 0){
+        /* the sums do not overflow 32 bits within 5802 bytes, so the modulo is done once per block */
+        block = (sz > 5802 ? 5802 : sz);
+        sz -= block;
+        while (block > 0){
+            sum1 += *data;
+            sum2 += sum1;
+            data++;
+            block--;
+        }
+        sum1 %= 255;
+        sum2 %= 255;
+    }
+    return (sum2 << 8) | sum1;
+}
+
+static unsigned int updateXor(unsigned int state, const unsigned char *data, size_t sz){
+    unsigned long long value = 0;
+    unsigned long long result = state;
+    while (sz >= 8){
+        memcpy(&value, data, 8);
+        result ^= value;
+        data += 8;
+        sz -= 8;
+    }
+    result ^= result >> 32;
+    result ^= result >> 16;
+    result ^= result >> 8;
+    while (sz > 0){
+        result ^= *data;
+        data++;
+        sz--;
+    }
+    return static_cast<unsigned int>(result & 0xFF);
+}
+
+static unsigned int updateLrc(unsigned int state, const unsigned char *data, size_t sz){
+    unsigned int sum = state;
+    for (size_t i = 0; i < sz; i++){
+        sum += data[i];
+    }
+    return sum & 0xFF;
+}
+
+/**
+ * @brief Calculates a checksum.
+ *
+ * The parameters of the algorithms are:
+ * - CRC16 CCITT: polynomial 0x1021, initial value 0xFFFF, not reflected.
+ * - CRC16 Modbus: polynomial 0x8005, initial value 0xFFFF, reflected.
+ * - CRC16 XMODEM: polynomial 0x1021, initial value 0x0000, not reflected.
+ * - CRC32: polynomial 0x04C11DB7, initial value and final xor 0xFFFFFFFF, reflected.
+ * - CRC32C: polynomial 0x1EDC6F41, initial value and final xor 0xFFFFFFFF, reflected.
+ * - LRC: two's complement of the 8-bit sum.
+ * - XOR: xor of all bytes.
+ * - Fletcher-16: modulo 255 sums, the second sum in the high byte.
+ *
+ * @param type The checksum algorithm.
+ * @param data The data.
+ * @param sz The size of the data.
+ * @return The checksum.
+ */
+unsigned int Checksum::calculate(CHECKSUM_TYPE type, const unsigned char *data, size_t sz){
+    return Checksum::calculate(Checksum::getEngine(type), type, data, sz);
+}
+
+/**
+ * @brief Calculates a checksum with a specific engine.
+ *
+ * This method is used by the tests and the benchmark to compare the engines. If the engine is not supported by the CPU or
+ * by the algorithm, the table engine is used.
+ *
+ * @param engine The checksum engine.
+ * @param type The checksum algorithm.
+ * @param data The data.
+ * @param sz The size of the data.
+ * @return The checksum.
+ */
+unsigned int Checksum::calculate(CHECKSUM_ENGINE engine, CHECKSUM_TYPE type, const unsigned char *data, size_t sz){
+    return Checksum::finish(type, Checksum::update(engine, type, Checksum::init(type), data, sz));
+}
+
+/**
+ * @brief Gets the initial state of a running checksum.
+ *
+ * A checksum can be calculated over several blocks of data (for example the fields of a frame, while they are received) with
+ * `Checksum::init`, `Checksum::update` for each block and `Checksum::finish`. The result is the same as `Checksum::calculate` over
+ * the concatenated blocks.
+ *
+ * @param type The checksum algorithm.
+ * @return The initial state.
+ */
+unsigned int Checksum::init(CHECKSUM_TYPE type){
+    switch (type){
+        case CHECKSUM_TYPE_CRC16_CCITT:
+        case CHECKSUM_TYPE_CRC16_MODBUS:
+            return 0xFFFF;
+        case CHECKSUM_TYPE_CRC32:
+        case CHECKSUM_TYPE_CRC32C:
+            return 0xFFFFFFFF;
+        default:
+            break;
+    }
+    return 0;
+}
+
+/**
+ * @brief Updates a running checksum with a block of data.
+ *
+ * @param type The checksum algorithm.
+ * @param state The current state (from `Checksum::init` or a previous update).
+ * @param data The data.
+ * @param sz The size of the data.
+ * @return The new state.
+ */
+unsigned int Checksum::update(CHECKSUM_TYPE type, unsigned int state, const unsigned char *data, size_t sz){
+    return Checksum::update(Checksum::getEngine(type), type, state, data, sz);
+}
+
+/**
+ * @brief Updates a running checksum with a block of data and a specific engine.
+ *
+ * If the engine is not supported by the CPU or by the algorithm, the table engine is used.
+ *
+ * @param engine The checksum engine.
+ * @param type The checksum algorithm.
+ * @param state The current state (from `Checksum::init` or a previous update).
+ * @param data The data.
+ * @param sz The size of the data.
+ * @return The new state.
+ */
+unsigned int Checksum::update(CHECKSUM_ENGINE engine, CHECKSUM_TYPE type, unsigned int state, const unsigned char *data, size_t sz){
+    const ChecksumTables &tables = getTables();
+    size_t chunk = 0;
+    switch (type){
+        case CHECKSUM_TYPE_CRC16_CCITT:
+        case CHECKSUM_TYPE_CRC16_XMODEM:
+            return updateNormal16(tables.crc16Ccitt, state, data, sz);
+        case CHECKSUM_TYPE_CRC16_MODBUS:
+            return updateReflected(tables.crc16Modbus, state, data, sz);
+        case CHECKSUM_TYPE_CRC32:
+#if defined(CHECKSUM_X86)
+            if (engine == CHECKSUM_ENGINE_PCLMUL && getFeatures().isPCLMUL && sz >= 64){
+                chunk = sz & ~static_cast<size_t>(15);
+                state = updateCrc32PCLMUL(state, data, chunk);
+                data += chunk;
+                sz -= chunk;
+            }
+#endif
+            return updateReflected(tables.crc32, state, data, sz);
+        case CHECKSUM_TYPE_CRC32C:
+#if defined(CHECKSUM_X86)
+            if (engine == CHECKSUM_ENGINE_SSE42 && getFeatures().isSSE42){
+                return updateCrc32cSSE42(state, data, sz);
+            }
+#endif
+            return updateReflected(tables.crc32c, state, data, sz);
+        case CHECKSUM_TYPE_LRC:
+            return updateLrc(state, data, sz);
+        case CHECKSUM_TYPE_XOR:
+            return updateXor(state, data, sz);
+        case CHECKSUM_TYPE_FLETCHER16:
+            return updateFletcher16(state, data, sz);
+        default:
+            break;
+    }
+    (void) engine;
+    (void) chunk;
+    return state;
+}
+
+/**
+ * @brief Gets the checksum of a running checksum.
+ *
+ * @param type The checksum algorithm.
+ * @param state The state after the last update.
+ * @return The checksum.
+ */
+unsigned int Checksum::finish(CHECKSUM_TYPE type, unsigned int state){
+    switch (type){
+        case CHECKSUM_TYPE_CRC32:
+        case CHECKSUM_TYPE_CRC32C:
+            return ~state;
+        case CHECKSUM_TYPE_LRC:
+            return (0x100 - (state & 0xFF)) & 0xFF;
+        default:
+            break;
+    }
+    return state;
+}
+
+/**
+ * @brief Gets the size of a checksum.
+ *
+ * @param type The checksum algorithm.
+ * @return The size of the checksum in bytes.
+ */
+size_t Checksum::getSize(CHECKSUM_TYPE type){
+    switch (type){
+        case CHECKSUM_TYPE_CRC16_CCITT:
+        case CHECKSUM_TYPE_CRC16_MODBUS:
+        case CHECKSUM_TYPE_CRC16_XMODEM:
+        case CHECKSUM_TYPE_FLETCHER16:
+            return 2;
+        case CHECKSUM_TYPE_CRC32:
+        case CHECKSUM_TYPE_CRC32C:
+            return 4;
+        case CHECKSUM_TYPE_LRC:
+        case CHECKSUM_TYPE_XOR:
+            return 1;
+        default:
+            break;
+    }
+    return 0;
+}
+
+/**
+ * @brief Gets the engine selected for an algorithm on the running CPU.
+ *
+ * @param type The checksum algorithm.
+ * @return The engine used by `Checksum::calculate`.
+ */
+CHECKSUM_ENGINE Checksum::getEngine(CHECKSUM_TYPE type){
+    if (type == CHECKSUM_TYPE_CRC32 && getFeatures().isPCLMUL) return CHECKSUM_ENGINE_PCLMUL;
+    if (type == CHECKSUM_TYPE_CRC32C && getFeatures().isSSE42) return CHECKSUM_ENGINE_SSE42;
+    return CHECKSUM_ENGINE_TABLE;
+}
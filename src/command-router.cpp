@@ -0,0 +1,409 @@
+/*
+ * $Id: command-router.cpp,v 1.0.0 2025/01/23 14:12:37 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include "command-router.hpp"
+
+static unsigned long long getElapsedUs(const struct timespec &tsStart){
+    struct timespec tsNow;
+    clock_gettime(CLOCK_MONOTONIC, &tsNow);
+    return static_cast<unsigned long long>((tsNow.tv_sec - tsStart.tv_sec) * 1000000LL + (tsNow.tv_nsec - tsStart.tv_nsec) / 1000LL);
+}
+
+/**
+ * @brief Custom constructor.
+ *
+ * Creates a router for a port. The frame format of the port must be set up before `CommandRouter::dispatch` is called.
+ * The command field is the first `DataFrame::FRAME_TYPE_COMMAND` field, read in big endian.
+ *
+ * @param link The port (not owned by the router, it must stay valid while the router is used).
+ */
+CommandRouter::CommandRouter(Serialink &link){
+    this->link = &link;
+    this->commandType = DataFrame::FRAME_TYPE_COMMAND;
+    this->commandEndian = SERIALINK_ENDIAN_BIG;
+    memset(this->table, 0x00, sizeof(this->table));
+    memset(&(this->defaultEntry), 0x00, sizeof(this->defaultEntry));
+    this->queueLimit = 0;
+    this->busyWorkers = 0;
+    this->isOrdered = false;
+    this->isRunning = false;
+    pthread_mutex_init(&(this->mtx), NULL);
+    pthread_cond_init(&(this->cond), NULL);
+    this->resetStats();
+}
+
+/**
+ * @brief Destructor.
+ *
+ * Stops the worker pool (the queued frames are handled first).
+ */
+CommandRouter::~CommandRouter(){
+    this->stop();
+    pthread_cond_destroy(&(this->cond));
+    pthread_mutex_destroy(&(this->mtx));
+}
+
+/**
+ * @brief Gets the entry of a command.
+ *
+ * The caller must hold the `mtx` lock.
+ *
+ * @param command The command value.
+ * @param create `true` to create the entry of a command larger than 255 if it does not exist.
+ * @return The entry (or `nullptr` if it does not exist).
+ */
+CommandRouterEntry *CommandRouter::getEntry(unsigned int command, bool create){
+    if (command < 256) return &(this->table[command]);
+    std::map <unsigned int, CommandRouterEntry>::iterator it = this->entries.find(command);
+    if (it != this->entries.end()) return &(it->second);
+    if (create == false) return nullptr;
+    CommandRouterEntry &entry = this->entries[command];
+    memset(&entry, 0x00, sizeof(entry));
+    return &entry;
+}
+
+/**
+ * @brief Finds a field in a frame format.
+ *
+ * @param format The index of the frame format.
+ * @param type The frame type of the field (the first field with this type).
+ * @param count The number of fields of the received frame.
+ * @param[out] idx The index of the field.
+ * @return `true` if the field is found.
+ */
+bool CommandRouter::findField(size_t format, DataFrame::FRAME_TYPE_t type, size_t count, size_t &idx){
+    /* the compiled field table of the format is indexed by type, the frame format is not walked for every frame */
+    SerialinkHandle handle = this->link->getHandle(format, type);
+    if (handle.field == 0 || handle.field > count) return false;
+    idx = handle.field - 1;
+    return true;
+}
+
+/**
+ * @brief Calls the handler of a frame and updates the statistics of its command.
+ *
+ * @param frame The received frame.
+ */
+void CommandRouter::handle(const CommandRouterFrame &frame){
+    const void *func = nullptr;
+    void *param = nullptr;
+    struct timespec tsBegin;
+    unsigned long long latencyUs = 0;
+    CommandRouterEntry *entry = nullptr;
+    pthread_mutex_lock(&(this->mtx));
+    if (frame.hasCommand) entry = this->getEntry(frame.command, false);
+    if (entry != nullptr && entry->func != nullptr){
+        func = entry->func;
+        param = entry->param;
+    }
+    else {
+        func = this->defaultEntry.func;
+        param = this->defaultEntry.param;
+    }
+    if (func == nullptr){
+        if (entry != nullptr) entry->stats.dropped++;
+        this->totalStats.dropped++;
+        pthread_mutex_unlock(&(this->mtx));
+        return;
+    }
+    pthread_mutex_unlock(&(this->mtx));
+    void (*handler)(CommandRouter &, const CommandRouterFrame &, void *) = (void (*)(CommandRouter &, const CommandRouterFrame &, void *))func;
+    clock_gettime(CLOCK_MONOTONIC, &tsBegin);
+    handler(*this, frame, param);
+    latencyUs = getElapsedUs(tsBegin);
+    pthread_mutex_lock(&(this->mtx));
+    /* the handler may have been removed meanwhile, the entry itself is never released */
+    if (frame.hasCommand) entry = this->getEntry(frame.command, false);
+    if (entry != nullptr){
+        entry->stats.totalLatencyUs += latencyUs;
+        entry->stats.maxLatencyUs = std::max(entry->stats.maxLatencyUs, latencyUs);
+    }
+    this->totalStats.totalLatencyUs += latencyUs;
+    this->totalStats.maxLatencyUs = std::max(this->totalStats.maxLatencyUs, latencyUs);
+    pthread_mutex_unlock(&(this->mtx));
+}
+
+/**
+ * @brief The routine of the worker threads.
+ *
+ * @param param The pointer of the `CommandRouter` object.
+ * @return Always `nullptr`.
+ */
+void *CommandRouter::workerRoutine(void *param){
+    CommandRouter *router = (CommandRouter *) param;
+    CommandRouterFrame frame;
+    pthread_mutex_lock(&(router->mtx));
+    while (true){
+        /* in ordered mode, the next frame waits until the frame in progress has been handled */
+        while (router->queue.empty() ? router->isRunning : (router->isOrdered && router->busyWorkers > 0)){
+            pthread_cond_wait(&(router->cond), &(router->mtx));
+        }
+        if (router->queue.empty()) break;
+        std::swap(frame, router->queue.front());
+        router->queue.pop_front();
+        router->busyWorkers++;
+        pthread_mutex_unlock(&(router->mtx));
+        router->handle(frame);
+        pthread_mutex_lock(&(router->mtx));
+        router->busyWorkers--;
+        if (router->isOrdered) pthread_cond_broadcast(&(router->cond));
+    }
+    pthread_mutex_unlock(&(router->mtx));
+    return nullptr;
+}
+
+/**
+ * @brief Sets the field that holds the command.
+ *
+ * @param type The frame type of the command field (the first field with this type).
+ * @param endian The byte order of the command value (a field larger than 4 bytes keeps its last 4 bytes in big endian, or
+ *        its first 4 bytes in little endian).
+ */
+void CommandRouter::setCommandField(DataFrame::FRAME_TYPE_t type, SERIALINK_ENDIAN endian){
+    this->commandType = type;
+    this->commandEndian = endian;
+}
+
+/**
+ * @brief Registers the handler of a command.
+ *
+ * The handler prototype is `void handler(CommandRouter &router, const CommandRouterFrame &frame, void *param)`. The frame
+ * holds a copy of the frame bytes and the location of each field in `frame.data` (see `CommandRouter::getField`). With a
+ * worker pool, the handler must be thread safe unless the ordered mode is used.
+ *
+ * @param command The command value.
+ * @param func The handler function (or `nullptr` to remove the handler).
+ * @param param The parameter of the handler function.
+ * @return 0 on success.
+ */
+int CommandRouter::setHandler(unsigned int command, const void *func, void *param){
+    pthread_mutex_lock(&(this->mtx));
+    CommandRouterEntry *entry = this->getEntry(command, true);
+    entry->func = func;
+    entry->param = param;
+    pthread_mutex_unlock(&(this->mtx));
+    return 0;
+}
+
+/**
+ * @brief Registers the handler of the frames whose command has no handler, or that have no command field.
+ *
+ * A frame without command field has `hasCommand` set to `false` and is only counted in the statistics of all frames.
+ *
+ * @param func The handler function (or `nullptr` to drop these frames).
+ * @param param The parameter of the handler function.
+ */
+void CommandRouter::setDefaultHandler(const void *func, void *param){
+    pthread_mutex_lock(&(this->mtx));
+    this->defaultEntry.func = func;
+    this->defaultEntry.param = param;
+    pthread_mutex_unlock(&(this->mtx));
+}
+
+/**
+ * @brief Starts the worker pool.
+ *
+ * @param workers The number of worker threads.
+ * @param queueLimit The maximum number of frames waiting for a worker. A frame received when the queue is full is dropped
+ *        and counted in the statistics of its command, so the reader never waits for the handlers.
+ * @param isOrdered `true` to handle the frames one at a time in the order they are received.
+ * @return 0 on success.
+ * @return 4 if a parameter is zero or the pool is already running.
+ */
+int CommandRouter::start(size_t workers, size_t queueLimit, bool isOrdered){
+    pthread_t thread;
+    if (workers == 0 || queueLimit == 0 || this->workers.empty() == false) return 4;
+    pthread_mutex_lock(&(this->mtx));
+    this->queueLimit = queueLimit;
+    this->isOrdered = isOrdered;
+    this->isRunning = true;
+    pthread_mutex_unlock(&(this->mtx));
+    for (size_t i = 0; i < workers; i++){
+        if (pthread_create(&thread, NULL, CommandRouter::workerRoutine, (void *) this) != 0) break;
+        this->workers.push_back(thread);
+    }
+    if (this->workers.empty()){
+        pthread_mutex_lock(&(this->mtx));
+        this->isRunning = false;
+        pthread_mutex_unlock(&(this->mtx));
+        return 4;
+    }
+    return 0;
+}
+
+/**
+ * @brief Stops the worker pool.
+ *
+ * The frames in the queue are handled before the workers exit. After this call, the handlers are called by
+ * `CommandRouter::dispatch` again.
+ */
+void CommandRouter::stop(){
+    if (this->workers.empty()) return;
+    pthread_mutex_lock(&(this->mtx));
+    this->isRunning = false;
+    pthread_cond_broadcast(&(this->cond));
+    pthread_mutex_unlock(&(this->mtx));
+    for (size_t i = 0; i < this->workers.size(); i++){
+        pthread_join(this->workers[i], NULL);
+    }
+    this->workers.clear();
+}
+
+/**
+ * @brief Reads a burst of frames and dispatches them.
+ *
+ * The frames are read with `Serialink::readFrames`. Each frame is handled at once (without worker pool) or queued for
+ * the workers.
+ *
+ * @param max The maximum number of frames of the burst.
+ * @return 0 if at least one frame is received.
+ * @return 1 if the port is not open.
+ * @return 2 if a timeout occurs.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if only invalid frames are received.
+ */
+int CommandRouter::dispatch(size_t max){
+    CommandRouterFrame frame;
+    CommandRouterEntry *entry = nullptr;
+    size_t idx = 0;
+    int ret = this->link->readFrames(max, 0, this->arena);
+    if (ret != 0) return ret;
+    for (auto &received : this->arena.frames){
+        const unsigned char *data = this->arena.data.data() + received.offset;
+        frame.format = received.format;
+        frame.data.assign(data, data + received.size);
+        frame.fields.assign(this->arena.fields.begin() + received.firstField, this->arena.fields.begin() + received.firstField + received.fieldCount);
+        for (auto &field : frame.fields){
+            field.offset -= received.offset;
+        }
+        frame.command = 0;
+        frame.hasCommand = this->findField(received.format, this->commandType, received.fieldCount, idx);
+        if (frame.hasCommand){
+            const SerialinkFieldDescriptor &field = frame.fields[idx];
+            for (size_t i = 0; i < field.size; i++){
+                if (this->commandEndian == SERIALINK_ENDIAN_BIG){
+                    frame.command = (frame.command << 8) | frame.data[field.offset + i];
+                }
+                else if (i < sizeof(frame.command)){
+                    frame.command |= static_cast<unsigned int>(frame.data[field.offset + i]) << (8 * i);
+                }
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &(frame.tsReceived));
+        pthread_mutex_lock(&(this->mtx));
+        entry = (frame.hasCommand ? this->getEntry(frame.command, false) : nullptr);
+        if (entry != nullptr) entry->stats.frames++;
+        this->totalStats.frames++;
+        if (this->isRunning == false){
+            pthread_mutex_unlock(&(this->mtx));
+            this->handle(frame);
+            continue;
+        }
+        if (this->queue.size() >= this->queueLimit){
+            /* the reader does not wait for the workers */
+            if (entry != nullptr) entry->stats.dropped++;
+            this->totalStats.dropped++;
+        }
+        else {
+            this->queue.push_back(frame);
+            pthread_cond_signal(&(this->cond));
+        }
+        pthread_mutex_unlock(&(this->mtx));
+    }
+    return 0;
+}
+
+/**
+ * @brief Gets the data of a field of a routed frame.
+ *
+ * @param frame The frame given to the handler.
+ * @param type The frame type of the field (the first field with this type).
+ * @return A view of the field data (empty if the field is not found). The view is valid while the frame is valid.
+ */
+ByteView CommandRouter::getField(const CommandRouterFrame &frame, DataFrame::FRAME_TYPE_t type){
+    size_t idx = 0;
+    if (this->findField(frame.format, type, frame.fields.size(), idx) == false) return ByteView();
+    return ByteView(frame.data.data() + frame.fields[idx].offset, frame.fields[idx].size);
+}
+
+/**
+ * @brief Gets the number of frames waiting for a worker.
+ *
+ * @return The number of queued frames.
+ */
+size_t CommandRouter::getQueuedCount(){
+    pthread_mutex_lock(&(this->mtx));
+    size_t count = this->queue.size();
+    pthread_mutex_unlock(&(this->mtx));
+    return count;
+}
+
+/**
+ * @brief Gets the statistics of a command.
+ *
+ * The rate of the command is `frames / elapsedSec`. The latency is the time spent in the handler.
+ *
+ * @param command The command value.
+ * @return The statistics since the last reset. A command larger than 255 is only counted while it has a handler.
+ */
+CommandRouterStats CommandRouter::getStats(unsigned int command){
+    CommandRouterStats result;
+    memset(&result, 0x00, sizeof(result));
+    pthread_mutex_lock(&(this->mtx));
+    CommandRouterEntry *entry = this->getEntry(command, false);
+    if (entry != nullptr) result = entry->stats;
+    result.elapsedSec = static_cast<double>(getElapsedUs(this->tsStart)) / 1000000.0;
+    pthread_mutex_unlock(&(this->mtx));
+    return result;
+}
+
+/**
+ * @brief Gets the statistics of all frames, including the frames without handler.
+ *
+ * @return The statistics since the last reset.
+ */
+CommandRouterStats CommandRouter::getStats(){
+    pthread_mutex_lock(&(this->mtx));
+    CommandRouterStats result = this->totalStats;
+    result.elapsedSec = static_cast<double>(getElapsedUs(this->tsStart)) / 1000000.0;
+    pthread_mutex_unlock(&(this->mtx));
+    return result;
+}
+
+/**
+ * @brief Resets the statistics of all commands.
+ */
+void CommandRouter::resetStats(){
+    pthread_mutex_lock(&(this->mtx));
+    for (size_t i = 0; i < 256; i++){
+        memset(&(this->table[i].stats), 0x00, sizeof(this->table[i].stats));
+    }
+    for (auto &entry : this->entries){
+        memset(&(entry.second.stats), 0x00, sizeof(entry.second.stats));
+    }
+    memset(&(this->totalStats), 0x00, sizeof(this->totalStats));
+    clock_gettime(CLOCK_MONOTONIC, &(this->tsStart));
+    pthread_mutex_unlock(&(this->mtx));
+}
@@ -0,0 +1,347 @@
+/*
+ * $Id: frame-encoder.cpp,v 1.0.0 2025/01/21 09:27:45 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <string.h>
+#include "frame-encoder.hpp"
+
+/**
+ * @brief Default constructor.
+ *
+ * Creates an encoder without frame format. The frame format must be set with the assignment operator.
+ */
+FrameEncoder::FrameEncoder(){
+}
+
+/**
+ * @brief Custom constructor.
+ *
+ * Creates an encoder and renders the frame format.
+ *
+ * @param format The first frame of the frame format.
+ */
+FrameEncoder::FrameEncoder(const DataFrame &format){
+    *this = format;
+}
+
+/**
+ * @brief Finds a field of the frame format.
+ *
+ * @param type The frame type of the field.
+ * @param occurrence The occurrence of the field (0 for the first field with this type).
+ * @param[out] idx The index of the field.
+ * @return `true` if the field is found.
+ */
+bool FrameEncoder::findField(DataFrame::FRAME_TYPE_t type, int occurrence, size_t &idx) const {
+    for (size_t i = 0; i < this->fields.size(); i++){
+        if (this->fields[i].type != type) continue;
+        if (occurrence == 0){
+            idx = i;
+            return true;
+        }
+        occurrence--;
+    }
+    return false;
+}
+
+/**
+ * @brief Writes the length of a resized field into its length fields.
+ *
+ * @param idx The index of the resized field.
+ * @param sz The new size of the field.
+ * @param isDryRun `true` to only check that the size can be encoded.
+ * @return `true` if the size can be encoded by every length field bound to the field.
+ */
+bool FrameEncoder::updateLengths(size_t idx, size_t sz, bool isDryRun){
+    unsigned long long value = 0;
+    unsigned char *dst = nullptr;
+    long long length = 0;
+    for (auto &binding : this->lengths){
+        if (binding.targetField != idx) continue;
+        length = static_cast<long long>(sz) - binding.offset;
+        if (length < 0 || static_cast<unsigned long long>(length) % binding.scale != 0) return false;
+        value = static_cast<unsigned long long>(length) / binding.scale;
+        if (binding.width < 8 && (value >> (8 * binding.width)) != 0) return false;
+        if (isDryRun) continue;
+        dst = this->frame.data() + this->fields[binding.sourceField].offset;
+        for (size_t i = 0; i < binding.width; i++){
+            if (binding.endian == SERIALINK_ENDIAN_BIG){
+                dst[i] = static_cast<unsigned char>(value >> (8 * (binding.width - 1 - i)));
+            }
+            else {
+                dst[i] = static_cast<unsigned char>(value >> (8 * i));
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the data of a field into the frame buffer.
+ *
+ * @param idx The index of the field.
+ * @param data The field data.
+ * @param sz The size of the field data.
+ * @return 0 on success.
+ * @return 4 if the size of a fixed-size field does not match, or it cannot be encoded by a bound length field.
+ */
+int FrameEncoder::writeField(size_t idx, const unsigned char *data, size_t sz){
+    FrameEncoderField &field = this->fields[idx];
+    if (field.isResizable == false && sz != field.size) return 4;
+    if (this->updateLengths(idx, sz, true) == false) return 4;
+    if (sz > field.size){
+        this->frame.insert(this->frame.begin() + field.offset + field.size, sz - field.size, 0x00);
+    }
+    else if (sz < field.size){
+        this->frame.erase(this->frame.begin() + field.offset + sz, this->frame.begin() + field.offset + field.size);
+    }
+    if (sz != field.size){
+        for (size_t i = idx + 1; i < this->fields.size(); i++){
+            this->fields[i].offset = this->fields[i].offset + sz - field.size;
+        }
+        field.size = sz;
+    }
+    if (sz > 0) memcpy(this->frame.data() + field.offset, data, sz);
+    this->updateLengths(idx, sz, false);
+    return 0;
+}
+
+/**
+ * @brief Sets up the checksum of the frames.
+ *
+ * The checksum is calculated from the first byte of `begin` to the last byte of `end` and written into the
+ * `DataFrame::FRAME_TYPE_VALIDATOR` field by `FrameEncoder::encode`. This is the counterpart of `Serialink::setChecksum`.
+ *
+ * @param type The checksum algorithm.
+ * @param begin The frame type of the first field of the checksum.
+ * @param end The frame type of the last field of the checksum.
+ * @param endian The byte order of the checksum in the validator field.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the fields are not found, are not in order, or the validator size does not match the checksum size.
+ */
+int FrameEncoder::setChecksum(CHECKSUM_TYPE type, DataFrame::FRAME_TYPE_t begin, DataFrame::FRAME_TYPE_t end, SERIALINK_ENDIAN endian){
+    FrameEncoderChecksum checksum;
+    if (this->fields.empty()) return 3;
+    if (this->findField(begin, 0, checksum.beginField) == false) return 4;
+    if (this->findField(end, 0, checksum.endField) == false) return 4;
+    if (this->findField(DataFrame::FRAME_TYPE_VALIDATOR, 0, checksum.validatorField) == false) return 4;
+    if (checksum.beginField > checksum.endField) return 4;
+    if (checksum.validatorField >= checksum.beginField && checksum.validatorField <= checksum.endField) return 4;
+    if (this->fields[checksum.validatorField].isResizable ||
+        this->fields[checksum.validatorField].size != Checksum::getSize(type)
+    ){
+        return 4;
+    }
+    checksum.type = type;
+    checksum.endian = endian;
+    this->checksums.push_back(checksum);
+    return 0;
+}
+
+/**
+ * @brief Binds the size of a field to the value of another field.
+ *
+ * This is the counterpart of `Serialink::bindLength`. Each time the target field is resized with `FrameEncoder::setField`,
+ * `(size - offset) / scale` is written into the first `width` bytes of the source field, so the receiver finds the length
+ * that matches the data. The value is written once when the binding is added.
+ *
+ * @param target The frame type of the field whose size is declared (a field without fixed size).
+ * @param source The frame type of the field that holds the length (a fixed-size field before the target).
+ * @param width The number of bytes of the length (1 to 8, not larger than the size of the source field).
+ * @param endian The byte order of the length.
+ * @param offset The value added to the scaled length.
+ * @param scale The multiplier of the length (not 0).
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the fields are not found or the binding is invalid.
+ */
+int FrameEncoder::bindLength(DataFrame::FRAME_TYPE_t target, DataFrame::FRAME_TYPE_t source, size_t width, SERIALINK_ENDIAN endian, long long offset, unsigned long long scale){
+    FrameEncoderLength binding;
+    if (this->fields.empty()) return 3;
+    if (this->findField(target, 0, binding.targetField) == false) return 4;
+    if (this->findField(source, 0, binding.sourceField) == false) return 4;
+    if (binding.sourceField >= binding.targetField || this->fields[binding.targetField].isResizable == false) return 4;
+    if (this->fields[binding.sourceField].isResizable || width == 0 || width > 8 || width > this->fields[binding.sourceField].size) return 4;
+    if (scale == 0) return 4;
+    binding.width = width;
+    binding.endian = endian;
+    binding.offset = offset;
+    binding.scale = scale;
+    this->lengths.push_back(binding);
+    if (this->updateLengths(binding.targetField, this->fields[binding.targetField].size, false) == false){
+        this->lengths.pop_back();
+        return 4;
+    }
+    return 0;
+}
+
+/**
+ * @brief Sets the data of a field.
+ *
+ * The data is written in place in the rendered frame. A fixed-size field must be set with exactly its size.
+ *
+ * @param type The frame type of the field (the first field with this type).
+ * @param data The field data.
+ * @param sz The size of the field data.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the field is not found, the size does not match a fixed-size field, or it cannot be encoded by a bound length field.
+ */
+int FrameEncoder::setField(DataFrame::FRAME_TYPE_t type, const unsigned char *data, size_t sz){
+    return this->setField(std::pair <DataFrame::FRAME_TYPE_t, int>(type, 0), data, sz);
+}
+
+/**
+ * @brief Overloaded method of __setField__ for a frame format with duplicate frame types.
+ *
+ * @param params The frame type and the occurrence of the field (0 for the first field with this type).
+ * @param data The field data.
+ * @param sz The size of the field data.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the field is not found, the size does not match a fixed-size field, or it cannot be encoded by a bound length field.
+ */
+int FrameEncoder::setField(std::pair <DataFrame::FRAME_TYPE_t, int> params, const unsigned char *data, size_t sz){
+    size_t idx = 0;
+    if (this->fields.empty()) return 3;
+    if (params.first == DataFrame::FRAME_TYPE_START_BYTES || params.first == DataFrame::FRAME_TYPE_STOP_BYTES) return 4;
+    if (this->findField(params.first, params.second, idx) == false) return 4;
+    return this->writeField(idx, data, sz);
+}
+
+/**
+ * @brief Overloaded method of __setField__ with input as `ByteView`.
+ *
+ * @param type The frame type of the field (the first field with this type).
+ * @param data The field data.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the field is not found, the size does not match a fixed-size field, or it cannot be encoded by a bound length field.
+ */
+int FrameEncoder::setField(DataFrame::FRAME_TYPE_t type, ByteView data){
+    return this->setField(type, data.data(), data.size());
+}
+
+/**
+ * @brief Encodes the frame.
+ *
+ * The checksums are calculated and written into their validator fields.
+ *
+ * @return A view of the encoded frame (empty if the frame format is not set up). The view is valid until the next call to
+ *         `FrameEncoder::setField` or the assignment operator.
+ */
+ByteView FrameEncoder::encode(){
+    unsigned int value = 0;
+    size_t begin = 0;
+    size_t sz = 0;
+    unsigned char *validator = nullptr;
+    if (this->fields.empty()) return ByteView();
+    for (auto &checksum : this->checksums){
+        begin = this->fields[checksum.beginField].offset;
+        sz = this->fields[checksum.endField].offset + this->fields[checksum.endField].size - begin;
+        value = Checksum::calculate(checksum.type, this->frame.data() + begin, sz);
+        validator = this->frame.data() + this->fields[checksum.validatorField].offset;
+        sz = this->fields[checksum.validatorField].size;
+        for (size_t i = 0; i < sz; i++){
+            if (checksum.endian == SERIALINK_ENDIAN_BIG){
+                validator[i] = static_cast<unsigned char>(value >> (8 * (sz - 1 - i)));
+            }
+            else {
+                validator[i] = static_cast<unsigned char>(value >> (8 * i));
+            }
+        }
+    }
+    return ByteView(this->frame.data(), this->frame.size());
+}
+
+/**
+ * @brief Encodes the frame and appends it to the batch buffer.
+ *
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ */
+int FrameEncoder::appendToBatch(){
+    ByteView encoded = this->encode();
+    if (encoded.empty()) return 3;
+    this->batch.insert(this->batch.end(), encoded.begin(), encoded.end());
+    return 0;
+}
+
+/**
+ * @brief Retrieves the frames that have been appended to the batch buffer, to be sent with one write.
+ *
+ * @return A view of the batch buffer (valid until the next call to `FrameEncoder::appendToBatch` or `FrameEncoder::clearBatch`).
+ */
+ByteView FrameEncoder::getBatch(){
+    return ByteView(this->batch.data(), this->batch.size());
+}
+
+/**
+ * @brief Clears the batch buffer (its allocation is kept for the next batch).
+ */
+void FrameEncoder::clearBatch(){
+    this->batch.clear();
+}
+
+FrameEncoder& FrameEncoder::operator=(const DataFrame &obj){
+    std::vector <SerialinkField> fieldTable;
+    std::vector <unsigned char> fieldReferences;
+    std::vector <unsigned char> data;
+    FrameEncoderField field;
+    this->fields.clear();
+    this->checksums.clear();
+    this->lengths.clear();
+    this->frame.clear();
+    this->batch.clear();
+    Serialink::compileFormat(const_cast<DataFrame*>(&obj), fieldTable, fieldReferences);
+    for (auto &compiled : fieldTable){
+        field.type = static_cast<DataFrame::FRAME_TYPE_t>(compiled.frame->getType());
+        field.offset = this->frame.size();
+        field.size = 0;
+        field.isResizable = false;
+        if (compiled.kind == SERIALINK_FIELD_START_BYTES || compiled.kind == SERIALINK_FIELD_STOP_BYTES){
+            this->frame.insert(
+                this->frame.end(),
+                fieldReferences.begin() + compiled.referenceOffset,
+                fieldReferences.begin() + compiled.referenceOffset + compiled.referenceSize
+            );
+        }
+        else if (compiled.kind == SERIALINK_FIELD_CONTENT){
+            /* the data that is already set is kept as the constant part of the frame */
+            compiled.frame->getData(data);
+            if (compiled.frame->getSize() > 0){
+                field.size = compiled.frame->getSize();
+                if (data.size() > field.size) data.resize(field.size);
+                this->frame.insert(this->frame.end(), data.begin(), data.end());
+                this->frame.insert(this->frame.end(), field.size - data.size(), 0x00);
+            }
+            else {
+                field.isResizable = true;
+                this->frame.insert(this->frame.end(), data.begin(), data.end());
+            }
+        }
+        field.size = this->frame.size() - field.offset;
+        this->fields.push_back(field);
+    }
+    return *this;
+}
@@ -0,0 +1,367 @@
+/*
+ * $Id: frame-parser.cpp,v 1.0.0 2025/01/15 14:02:37 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <string.h>
+#include "byte-search.hpp"
+#include "frame-parser.hpp"
+
+static bool findBytes(const unsigned char *buffer, size_t begin, size_t available, const unsigned char *pattern, size_t sz, size_t &position){
+    if (begin >= available) return false;
+    if (ByteSearch::find(buffer + begin, available - begin, pattern, sz, position) == false) return false;
+    position += begin;
+    return true;
+}
+
+/**
+ * @brief Default constructor.
+ *
+ * Creates a parser without frame format. The frame format must be set with the assignment operator.
+ */
+FrameParser::FrameParser(){
+    this->frameFormat = nullptr;
+    this->callbackFunc = nullptr;
+    this->callbackParam = nullptr;
+    this->resetState();
+}
+
+/**
+ * @brief Custom constructor.
+ *
+ * Creates a parser with a copy of the frame format.
+ *
+ * @param format The first frame of the frame format.
+ */
+FrameParser::FrameParser(const DataFrame &format){
+    this->frameFormat = nullptr;
+    this->callbackFunc = nullptr;
+    this->callbackParam = nullptr;
+    this->resetState();
+    *this = format;
+}
+
+/**
+ * @brief Destructor.
+ *
+ * Releases the frame format.
+ */
+FrameParser::~FrameParser(){
+    if (this->frameFormat != nullptr){
+        delete this->frameFormat;
+        this->frameFormat = nullptr;
+    }
+}
+
+/**
+ * @brief Clears the parsing state (the buffered bytes are kept).
+ */
+void FrameParser::resetState(){
+    this->fieldIndex = 0;
+    this->frameOffset = 0;
+    this->fieldOffset = 0;
+    this->scanOffset = 0;
+    this->isFieldStarted = false;
+    this->isFormatValid = true;
+}
+
+/**
+ * @brief Sets the frame callback.
+ *
+ * The callback is called once for each completed frame (status `0`) and each rejected frame (status `4`), with the bytes of
+ * the frame. The frame bytes are valid until the callback returns. The data of each field of a completed frame can be accessed with
+ * `FrameParser::getFormat` or the `[]` operator.
+ *
+ * @param func The callback function.
+ * @param param The parameter of the callback function.
+ */
+void FrameParser::setCallback(void (*func)(FrameParser &, int, const unsigned char *, size_t, void *), void *param){
+    this->callbackFunc = (const void *) func;
+    this->callbackParam = param;
+}
+
+/**
+ * @brief Sets the capacity of the parser buffer.
+ *
+ * This is the maximum frame size. A frame that does not fit in the buffer is rejected. Any buffered data is discarded.
+ * The default capacity is 65536 bytes.
+ *
+ * @param capacity The capacity of the buffer in bytes.
+ */
+void FrameParser::setCapacity(size_t capacity){
+    this->buffer.setCapacity(capacity);
+    this->resetState();
+}
+
+/**
+ * @brief Retrieves the memory address of the frame format.
+ *
+ * @return The memory address of the frame format (or `nullptr` if it is not set up).
+ */
+DataFrame *FrameParser::getFormat(){
+    return this->frameFormat;
+}
+
+/**
+ * @brief Marks the current frame as invalid.
+ *
+ * This function can be called from the post-execution function of a `DataFrame` to reject the frame that is being parsed.
+ */
+void FrameParser::trigInvDataIndicator(){
+    this->isFormatValid = false;
+}
+
+/**
+ * @brief Calls the frame callback.
+ *
+ * @param status `0` for a valid frame, `4` for an invalid frame.
+ * @param frame The frame bytes.
+ * @param sz The number of frame bytes.
+ */
+void FrameParser::emitFrame(int status, const unsigned char *frame, size_t sz){
+    void (*callback)(FrameParser &, int, const unsigned char *, size_t, void *) = nullptr;
+    if (this->callbackFunc == nullptr) return;
+    callback = (void (*)(FrameParser &, int, const unsigned char *, size_t, void *)) this->callbackFunc;
+    callback(*this, status, frame, sz, this->callbackParam);
+}
+
+/**
+ * @brief Rejects the current frame.
+ *
+ * The callback is called with status `4` and the bytes from the first frame byte to `end`. The parser then restarts
+ * from the second byte of the rejected frame.
+ *
+ * @param end The offset (from the oldest buffered byte) of the end of the rejected bytes.
+ */
+void FrameParser::rejectFrame(size_t end){
+    if (end > this->buffer.getSize()) end = this->buffer.getSize();
+    if (end < this->frameOffset) end = this->frameOffset;
+    this->emitFrame(4, this->buffer.getData() + this->frameOffset, end - this->frameOffset);
+    this->buffer.consume(this->frameOffset + 1);
+    this->resetState();
+}
+
+/**
+ * @brief Parses the buffered bytes until more bytes are needed.
+ *
+ * Each completed or rejected frame is delivered to the callback.
+ */
+void FrameParser::parse(){
+    const SerialinkField *field = nullptr;
+    const unsigned char *reference = nullptr;
+    const unsigned char *data = nullptr;
+    DataFrame *tmp = nullptr;
+    size_t fieldCount = this->fieldTable.size();
+    size_t available = 0;
+    size_t position = 0;
+    size_t sz = 0;
+    void (*callback)(DataFrame &, void *) = nullptr;
+    while (fieldCount > 0){
+        data = this->buffer.getData();
+        available = this->buffer.getSize();
+        if (this->fieldIndex == 0 && available == 0) return;
+        field = &(this->fieldTable[this->fieldIndex]);
+        tmp = field->frame;
+        if (this->isFieldStarted == false){
+            if (this->fieldIndex == 0){
+                this->frameOffset = this->fieldOffset;
+            }
+            if (this->scanOffset < this->fieldOffset){
+                this->scanOffset = this->fieldOffset;
+            }
+            this->isFieldStarted = true;
+            if (tmp->getExecuteFunction() != nullptr){
+                callback = (void (*)(DataFrame &, void *))tmp->getExecuteFunction();
+                callback(*tmp, tmp->getExecuteFunctionParam());
+            }
+        }
+        reference = this->fieldReferences.data() + field->referenceOffset;
+        if (field->kind == SERIALINK_FIELD_START_BYTES){
+            if (findBytes(data, this->scanOffset, available, reference, field->referenceSize, position) == false){
+                if (available >= field->referenceSize) this->scanOffset = available - field->referenceSize + 1;
+                if (this->fieldIndex == 0 && this->scanOffset > 0){
+                    /* no frame has been started, the bytes that have been checked are not needed anymore */
+                    this->buffer.consume(this->scanOffset);
+                    this->frameOffset = 0;
+                    this->fieldOffset = 0;
+                    this->scanOffset = 0;
+                }
+                return;
+            }
+            if (this->fieldIndex == 0){
+                this->frameOffset = position;
+            }
+            this->fieldOffset = position + field->referenceSize;
+        }
+        else if (field->kind == SERIALINK_FIELD_STOP_BYTES){
+            if (available - this->fieldOffset < field->referenceSize) return;
+            if (memcmp(data + this->fieldOffset, reference, field->referenceSize) != 0){
+                this->rejectFrame(this->fieldOffset + field->referenceSize);
+                continue;
+            }
+            this->fieldOffset += field->referenceSize;
+        }
+        else if (field->kind == SERIALINK_FIELD_CONTENT && tmp->getSize() > 0){
+            sz = tmp->getSize();
+            if (available - this->fieldOffset < sz) return;
+            tmp->setData(data + this->fieldOffset, sz);
+            this->fieldOffset += sz;
+        }
+        else if (field->kind == SERIALINK_FIELD_CONTENT && field->isStopBytesNext){
+            field = &(this->fieldTable[this->fieldIndex + 1]);
+            reference = this->fieldReferences.data() + field->referenceOffset;
+            if (findBytes(data, this->scanOffset, available, reference, field->referenceSize, position) == false){
+                if (available >= field->referenceSize) this->scanOffset = available - field->referenceSize + 1;
+                return;
+            }
+            tmp->setData(data + this->fieldOffset, position - this->fieldOffset);
+            if (tmp->getPostExecuteFunction() != nullptr){
+                callback = (void (*)(DataFrame &, void *))tmp->getPostExecuteFunction();
+                callback(*tmp, tmp->getPostExecuteFunctionParam());
+            }
+            this->fieldIndex++;
+            tmp = field->frame;
+            if (tmp->getExecuteFunction() != nullptr){
+                callback = (void (*)(DataFrame &, void *))tmp->getExecuteFunction();
+                callback(*tmp, tmp->getExecuteFunctionParam());
+            }
+            this->fieldOffset = position + field->referenceSize;
+        }
+        else {
+            this->rejectFrame(this->fieldOffset);
+            continue;
+        }
+        if (tmp->getPostExecuteFunction() != nullptr){
+            callback = (void (*)(DataFrame &, void *))tmp->getPostExecuteFunction();
+            callback(*tmp, tmp->getPostExecuteFunctionParam());
+        }
+        if (this->isFormatValid == false){
+            this->rejectFrame(this->fieldOffset);
+            continue;
+        }
+        this->fieldIndex++;
+        this->isFieldStarted = false;
+        if (this->fieldIndex >= fieldCount){
+            this->emitFrame(0, data + this->frameOffset, this->fieldOffset - this->frameOffset);
+            this->buffer.consume(this->fieldOffset);
+            this->resetState();
+        }
+    }
+}
+
+/**
+ * @brief Hands received bytes to the parser.
+ *
+ * The bytes are parsed immediately. Each frame that is completed or rejected by these bytes is delivered to the callback
+ * before this method returns. The bytes of an incomplete frame are kept for the next call.
+ *
+ * @param data The received bytes.
+ * @param sz The number of received bytes.
+ * @return `0` if successful.
+ * @return `3` if the frame format is not set up.
+ */
+int FrameParser::feed(const unsigned char *data, size_t sz){
+    size_t written = 0;
+    if (this->frameFormat == nullptr) return 3;
+    if (this->fieldTable.empty() ||
+        this->fieldTable.front().frame != this->frameFormat ||
+        this->fieldTable.back().frame->getNext() != nullptr
+    ){
+        /* the format has been extended through getFormat() */
+        Serialink::compileFormat(this->frameFormat, this->fieldTable, this->fieldReferences);
+        this->resetState();
+    }
+    while (sz > 0){
+        written = this->buffer.write(data, sz);
+        data += written;
+        sz -= written;
+        this->parse();
+        if (written == 0 && this->buffer.getFreeSpace() == 0){
+            /* the current frame is larger than the buffer */
+            this->rejectFrame(this->buffer.getSize());
+            this->parse();
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Overloaded method of __feed__.
+ *
+ * @param data The received bytes.
+ * @return `0` if successful.
+ * @return `3` if the frame format is not set up.
+ */
+int FrameParser::feed(const std::vector <unsigned char> &data){
+    return this->feed(data.data(), data.size());
+}
+
+/**
+ * @brief Gets the number of buffered bytes that do not belong to a completed frame yet.
+ *
+ * @return The number of pending bytes.
+ */
+size_t FrameParser::getPendingSize(){
+    return this->buffer.getSize();
+}
+
+/**
+ * @brief Discards the buffered bytes and the parsing state.
+ */
+void FrameParser::reset(){
+    this->buffer.clear();
+    this->resetState();
+}
+
+FrameParser& FrameParser::operator=(const DataFrame &obj){
+    if (this->frameFormat != nullptr){
+        delete this->frameFormat;
+        this->frameFormat = nullptr;
+    }
+    DataFrame &ncObj = const_cast<DataFrame&>(obj);
+    std::vector <unsigned char> ref;
+    ncObj.getReference(ref);
+    this->frameFormat = new DataFrame(
+      static_cast<DataFrame::FRAME_TYPE_t>(ncObj.getType()),
+      ncObj.getSize(),
+      ref.data(),
+      ncObj.getExecuteFunction(),
+      ncObj.getExecuteFunctionParam(),
+      ncObj.getPostExecuteFunction(),
+      ncObj.getPostExecuteFunctionParam()
+    );
+    if (this->frameFormat != nullptr){
+        if (ncObj.getNext() != nullptr)
+            *(this->frameFormat) += *(ncObj.getNext());
+    }
+    Serialink::compileFormat(this->frameFormat, this->fieldTable, this->fieldReferences);
+    this->reset();
+    return *this;
+}
+
+DataFrame* FrameParser::operator[](DataFrame::FRAME_TYPE_t type){
+    DataFrame *tmp = this->frameFormat;
+    while(tmp != nullptr){
+        if(tmp->getType() == type) return tmp;
+        tmp = tmp->getNext();
+    }
+    return nullptr;
+}
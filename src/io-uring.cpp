@@ -0,0 +1,306 @@
+/*
+ * $Id: io-uring.cpp,v 1.0.0 2025/01/13 08:47:19 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include "io-uring.hpp"
+
+/**
+ * @brief Custom constructor.
+ *
+ * Creates an io_uring instance and maps its submission and completion queues. The instance is not ready if the
+ * running kernel does not support the read and write operations.
+ *
+ * @param entries The number of submission queue entries.
+ */
+IoUring::IoUring(unsigned int entries){
+    struct io_uring_params params;
+    unsigned char *sq = nullptr;
+    unsigned char *cq = nullptr;
+    this->sqRing = MAP_FAILED;
+    this->sqRingSize = 0;
+    this->cqRing = MAP_FAILED;
+    this->cqRingSize = 0;
+    this->sqes = (struct io_uring_sqe *) MAP_FAILED;
+    this->sqesSize = 0;
+    this->isFileRegistered = false;
+    this->bufferAddress = nullptr;
+    this->bufferSize = 0;
+    memset(&params, 0, sizeof(params));
+    this->ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (this->ringFd < 0) return;
+    this->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    this->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP){
+        if (this->cqRingSize > this->sqRingSize) this->sqRingSize = this->cqRingSize;
+        this->cqRingSize = this->sqRingSize;
+    }
+    this->sqRing = mmap(NULL, this->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd, IORING_OFF_SQ_RING);
+    if (this->sqRing == MAP_FAILED){
+        close(this->ringFd);
+        this->ringFd = -1;
+        return;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP){
+        this->cqRing = this->sqRing;
+    }
+    else {
+        this->cqRing = mmap(NULL, this->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd, IORING_OFF_CQ_RING);
+        if (this->cqRing == MAP_FAILED){
+            munmap(this->sqRing, this->sqRingSize);
+            this->sqRing = MAP_FAILED;
+            close(this->ringFd);
+            this->ringFd = -1;
+            return;
+        }
+    }
+    this->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    this->sqes = (struct io_uring_sqe *) mmap(NULL, this->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd, IORING_OFF_SQES);
+    if (this->sqes == MAP_FAILED){
+        if (this->cqRing != this->sqRing) munmap(this->cqRing, this->cqRingSize);
+        munmap(this->sqRing, this->sqRingSize);
+        this->sqRing = MAP_FAILED;
+        this->cqRing = MAP_FAILED;
+        close(this->ringFd);
+        this->ringFd = -1;
+        return;
+    }
+    sq = (unsigned char *) this->sqRing;
+    cq = (unsigned char *) this->cqRing;
+    this->sqTail = (unsigned int *) (sq + params.sq_off.tail);
+    this->sqMask = (unsigned int *) (sq + params.sq_off.ring_mask);
+    this->sqArray = (unsigned int *) (sq + params.sq_off.array);
+    this->cqHead = (unsigned int *) (cq + params.cq_off.head);
+    this->cqTail = (unsigned int *) (cq + params.cq_off.tail);
+    this->cqMask = (unsigned int *) (cq + params.cq_off.ring_mask);
+    this->cqes = (struct io_uring_cqe *) (cq + params.cq_off.cqes);
+    if (this->probeOperations() == false) this->closeRing();
+}
+
+/**
+ * @brief Destructor.
+ *
+ * Unregisters the file and the buffer, unmaps the queues and closes the io_uring instance.
+ */
+IoUring::~IoUring(){
+    if (this->ringFd < 0) return;
+    this->unregisterBuffer();
+    this->unregisterFile();
+    this->closeRing();
+}
+
+/**
+ * @brief Checks whether the running kernel supports the operations used by this class.
+ *
+ * `IORING_OP_READ` and `IORING_OP_WRITE` are only available since Linux 5.6, while io_uring itself exists since 5.1.
+ * The operations are queried with `IORING_REGISTER_PROBE` (also available since 5.6).
+ *
+ * @return `true` if `IORING_OP_READ`, `IORING_OP_READ_FIXED` and `IORING_OP_WRITE` are supported.
+ */
+bool IoUring::probeOperations(){
+    unsigned char storage[sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op)];
+    struct io_uring_probe *probe = (struct io_uring_probe *) storage;
+    const unsigned char opcodes[3] = {IORING_OP_READ, IORING_OP_READ_FIXED, IORING_OP_WRITE};
+    memset(storage, 0x00, sizeof(storage));
+    /* older kernels reject the probe itself, and they do not have IORING_OP_READ/IORING_OP_WRITE either */
+    if (syscall(__NR_io_uring_register, this->ringFd, IORING_REGISTER_PROBE, probe, 256) != 0) return false;
+    for (size_t i = 0; i < sizeof(opcodes); i++){
+        if (opcodes[i] > probe->last_op || (probe->ops[opcodes[i]].flags & IO_URING_OP_SUPPORTED) == 0) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Unmaps the queues and closes the io_uring instance.
+ */
+void IoUring::closeRing(){
+    munmap(this->sqes, this->sqesSize);
+    if (this->cqRing != this->sqRing) munmap(this->cqRing, this->cqRingSize);
+    munmap(this->sqRing, this->sqRingSize);
+    this->sqes = (struct io_uring_sqe *) MAP_FAILED;
+    this->sqRing = MAP_FAILED;
+    this->cqRing = MAP_FAILED;
+    close(this->ringFd);
+    this->ringFd = -1;
+}
+
+/**
+ * @brief Checks whether io_uring is supported by the running kernel.
+ *
+ * @return `true` if an io_uring instance can be created and supports the read and write operations.
+ */
+bool IoUring::isSupported(){
+    IoUring ring(1);
+    return ring.isReady();
+}
+
+/**
+ * @brief Checks whether the instance has been created successfully.
+ *
+ * @return `true` if the instance is ready to use.
+ */
+bool IoUring::isReady(){
+    return (this->ringFd >= 0);
+}
+
+/**
+ * @brief Registers the file descriptor as a fixed file.
+ *
+ * Any previously registered file is unregistered first.
+ *
+ * @param fd The file descriptor.
+ * @return `0` if successful.
+ * @return `1` if the registration fails.
+ */
+int IoUring::registerFile(int fd){
+    if (this->ringFd < 0) return 1;
+    this->unregisterFile();
+    if (syscall(__NR_io_uring_register, this->ringFd, IORING_REGISTER_FILES, &fd, 1) != 0) return 1;
+    this->isFileRegistered = true;
+    return 0;
+}
+
+/**
+ * @brief Unregisters the fixed file.
+ */
+void IoUring::unregisterFile(){
+    if (this->ringFd < 0 || this->isFileRegistered == false) return;
+    syscall(__NR_io_uring_register, this->ringFd, IORING_UNREGISTER_FILES, NULL, 0);
+    this->isFileRegistered = false;
+}
+
+/**
+ * @brief Registers a buffer for `IORING_OP_READ_FIXED` operations.
+ *
+ * Any previously registered buffer is unregistered first.
+ *
+ * @param buffer The buffer address.
+ * @param sz The buffer size.
+ * @return `0` if successful.
+ * @return `1` if the registration fails.
+ */
+int IoUring::registerBuffer(unsigned char *buffer, size_t sz){
+    struct iovec iov;
+    if (this->ringFd < 0) return 1;
+    this->unregisterBuffer();
+    iov.iov_base = buffer;
+    iov.iov_len = sz;
+    if (syscall(__NR_io_uring_register, this->ringFd, IORING_REGISTER_BUFFERS, &iov, 1) != 0) return 1;
+    this->bufferAddress = buffer;
+    this->bufferSize = sz;
+    return 0;
+}
+
+/**
+ * @brief Unregisters the registered buffer.
+ */
+void IoUring::unregisterBuffer(){
+    if (this->ringFd < 0 || this->bufferAddress == nullptr) return;
+    syscall(__NR_io_uring_register, this->ringFd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+    this->bufferAddress = nullptr;
+    this->bufferSize = 0;
+}
+
+/**
+ * @brief Submits one request and waits for its completion.
+ *
+ * @param opcode The io_uring operation code.
+ * @param buffer The data buffer.
+ * @param sz The size of the data buffer.
+ * @return The result of the operation (number of bytes), or `-1` with `errno` set if the operation fails.
+ */
+ssize_t IoUring::submit(unsigned char opcode, const void *buffer, size_t sz){
+    struct io_uring_sqe *sqe = nullptr;
+    unsigned int tail = 0;
+    unsigned int head = 0;
+    unsigned int index = 0;
+    int res = 0;
+    if (this->ringFd < 0 || this->isFileRegistered == false){
+        errno = EBADF;
+        return -1;
+    }
+    tail = *(this->sqTail);
+    index = tail & *(this->sqMask);
+    sqe = &(this->sqes[index]);
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    sqe->opcode = opcode;
+    sqe->flags = IOSQE_FIXED_FILE;
+    sqe->fd = 0;
+    sqe->off = static_cast<__u64>(-1);
+    sqe->addr = static_cast<__u64>(reinterpret_cast<unsigned long>(buffer));
+    sqe->len = static_cast<__u32>(sz);
+    sqe->buf_index = 0;
+    sqe->user_data = 1;
+    this->sqArray[index] = index;
+    __atomic_store_n(this->sqTail, tail + 1, __ATOMIC_RELEASE);
+    while (true){
+        /* the request is submitted only once, an empty submission queue is simply ignored */
+        if (syscall(__NR_io_uring_enter, this->ringFd, 1, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 && errno != EINTR){
+            return -1;
+        }
+        head = *(this->cqHead);
+        if (head != __atomic_load_n(this->cqTail, __ATOMIC_ACQUIRE)){
+            res = this->cqes[head & *(this->cqMask)].res;
+            __atomic_store_n(this->cqHead, head + 1, __ATOMIC_RELEASE);
+            break;
+        }
+    }
+    if (res < 0){
+        errno = -res;
+        return -1;
+    }
+    return static_cast<ssize_t>(res);
+}
+
+/**
+ * @brief Reads data from the registered file.
+ *
+ * If the destination is inside the registered buffer, the read is submitted as `IORING_OP_READ_FIXED`.
+ *
+ * @param buffer The destination buffer.
+ * @param sz The maximum number of bytes to read.
+ * @return The number of bytes read, or `-1` with `errno` set if the operation fails.
+ */
+ssize_t IoUring::read(unsigned char *buffer, size_t sz){
+    if (this->bufferAddress != nullptr && buffer >= this->bufferAddress && buffer + sz <= this->bufferAddress + this->bufferSize){
+        return this->submit(IORING_OP_READ_FIXED, buffer, sz);
+    }
+    return this->submit(IORING_OP_READ, buffer, sz);
+}
+
+/**
+ * @brief Writes data to the registered file.
+ *
+ * @param buffer Data to be written.
+ * @param sz Size of the data to be written.
+ * @return The number of bytes written, or `-1` with `errno` set if the operation fails.
+ */
+ssize_t IoUring::write(const unsigned char *buffer, size_t sz){
+    return this->submit(IORING_OP_WRITE, buffer, sz);
+}
+#endif
@@ -0,0 +1,199 @@
+/*
+ * $Id: ring-buffer.cpp,v 1.0.0 2025/01/06 09:12:40 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <string.h>
+#include "ring-buffer.hpp"
+
+/**
+ * @brief Default constructor.
+ *
+ * This constructor allocates the buffer storage with the default capacity (65536 bytes).
+ */
+RingBuffer::RingBuffer(){
+    this->storage.resize(65536);
+    this->head = 0;
+    this->tail = 0;
+}
+
+/**
+ * @brief Custom constructor.
+ *
+ * This constructor allocates the buffer storage with a specific capacity.
+ *
+ * @param capacity The capacity of the buffer in bytes.
+ */
+RingBuffer::RingBuffer(size_t capacity){
+    this->storage.resize(capacity);
+    this->head = 0;
+    this->tail = 0;
+}
+
+/**
+ * @brief Destructor.
+ *
+ * This destructor is responsible for releasing the buffer storage.
+ */
+RingBuffer::~RingBuffer(){
+    this->storage.clear();
+}
+
+/**
+ * @brief Sets the capacity of the buffer.
+ *
+ * This setter function re-allocates the buffer storage. Any data stored in the buffer is discarded.
+ *
+ * @param capacity The capacity of the buffer in bytes.
+ */
+void RingBuffer::setCapacity(size_t capacity){
+    std::vector <unsigned char>(capacity).swap(this->storage);
+    this->head = 0;
+    this->tail = 0;
+}
+
+/**
+ * @brief Gets the capacity of the buffer.
+ *
+ * @return The capacity of the buffer in bytes.
+ */
+size_t RingBuffer::getCapacity(){
+    return this->storage.size();
+}
+
+/**
+ * @brief Gets the number of unconsumed bytes.
+ *
+ * @return The number of bytes between the consume cursor and the write cursor.
+ */
+size_t RingBuffer::getSize(){
+    return this->tail - this->head;
+}
+
+/**
+ * @brief Gets the number of bytes that can still be written.
+ *
+ * @return The free space of the buffer in bytes (including the space that can be recovered by moving the unconsumed bytes to the front).
+ */
+size_t RingBuffer::getFreeSpace(){
+    return this->storage.size() - (this->tail - this->head);
+}
+
+/**
+ * @brief Gets the unconsumed data.
+ *
+ * This getter function returns the address of the oldest unconsumed byte. The unconsumed bytes are stored contiguously
+ * and the returned pointer is valid until the next `prepareWrite`, `write`, `setCapacity` or `clear` call.
+ *
+ * @return The address of the oldest unconsumed byte.
+ */
+const unsigned char *RingBuffer::getData(){
+    return this->storage.data() + this->head;
+}
+
+/**
+ * @brief Gets the buffer storage.
+ *
+ * This getter function returns the address of the first byte of the storage (not the oldest unconsumed byte). The address is
+ * stable until the next `setCapacity` call, so the storage can be registered for kernel-side direct writes.
+ *
+ * @return The address of the buffer storage.
+ */
+unsigned char *RingBuffer::getStorage(){
+    return this->storage.data();
+}
+
+/**
+ * @brief Prepares the buffer for a direct write operation.
+ *
+ * This function returns the address where the next received bytes can be stored directly (for example by the `read` syscall).
+ * If the write cursor has reached the end of the storage, the unconsumed bytes are moved to the front first.
+ * The written bytes must be committed with the `commitWrite` method.
+ *
+ * @param[out] available The number of bytes that can be stored at the returned address.
+ * @return The address of the write cursor.
+ */
+unsigned char *RingBuffer::prepareWrite(size_t &available){
+    if (this->tail == this->storage.size() && this->head > 0){
+        size_t sz = this->tail - this->head;
+        memmove(this->storage.data(), this->storage.data() + this->head, sz);
+        this->head = 0;
+        this->tail = sz;
+    }
+    available = this->storage.size() - this->tail;
+    return this->storage.data() + this->tail;
+}
+
+/**
+ * @brief Commits the bytes stored by a direct write operation.
+ *
+ * @param sz The number of bytes that have been stored at the address returned by the `prepareWrite` method.
+ */
+void RingBuffer::commitWrite(size_t sz){
+    if (sz > this->storage.size() - this->tail) sz = this->storage.size() - this->tail;
+    this->tail += sz;
+}
+
+/**
+ * @brief Writes data into the buffer.
+ *
+ * @param data Data to be written.
+ * @param sz Size of the data to be written.
+ * @return The number of bytes written (less than `sz` if the buffer is full).
+ */
+size_t RingBuffer::write(const unsigned char *data, size_t sz){
+    size_t written = 0;
+    size_t available = 0;
+    unsigned char *dst = nullptr;
+    while (written < sz){
+        dst = this->prepareWrite(available);
+        if (available == 0) break;
+        if (available > sz - written) available = sz - written;
+        memcpy(dst, data + written, available);
+        this->commitWrite(available);
+        written += available;
+    }
+    return written;
+}
+
+/**
+ * @brief Consumes the oldest bytes.
+ *
+ * This function moves the consume cursor forward. The consumed bytes are no longer accessible.
+ *
+ * @param sz The number of bytes to be consumed.
+ */
+void RingBuffer::consume(size_t sz){
+    if (sz >= this->tail - this->head){
+        this->head = 0;
+        this->tail = 0;
+        return;
+    }
+    this->head += sz;
+}
+
+/**
+ * @brief Discards all data stored in the buffer.
+ */
+void RingBuffer::clear(){
+    this->head = 0;
+    this->tail = 0;
+}
@@ -0,0 +1,454 @@
+/*
+ * $Id: serial-reactor.cpp,v 1.0.0 2025/01/09 10:21:05 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "serial-reactor.hpp"
+
+/**
+ * @brief Default constructor.
+ *
+ * Creates the `epoll` instance and the wake-up event of the reactor.
+ */
+SerialReactor::SerialReactor(){
+    struct epoll_event ev;
+    this->isRunning = false;
+    pthread_mutex_init(&(this->mtx), NULL);
+    this->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    this->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (this->epollFd >= 0 && this->eventFd >= 0){
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;
+        epoll_ctl(this->epollFd, EPOLL_CTL_ADD, this->eventFd, &ev);
+    }
+}
+
+/**
+ * @brief Destructor.
+ *
+ * Releases the `epoll` instance and all registered port entries. The registered `Serial` objects are not closed.
+ */
+SerialReactor::~SerialReactor(){
+    pthread_mutex_lock(&(this->mtx));
+    for (auto it = this->ports.begin(); it != this->ports.end(); it++){
+        it->first->setPollMode(false);
+        delete it->second;
+    }
+    this->ports.clear();
+    for (auto it = this->removedPorts.begin(); it != this->removedPorts.end(); it++){
+        delete *it;
+    }
+    this->removedPorts.clear();
+    if (this->eventFd >= 0) close(this->eventFd);
+    if (this->epollFd >= 0) close(this->epollFd);
+    pthread_mutex_unlock(&(this->mtx));
+    pthread_mutex_destroy(&(this->mtx));
+}
+
+/**
+ * @brief Registers a port to the epoll set.
+ *
+ * @param serial The pointer of the `Serial` object (must be opened).
+ * @param serialink The pointer of the `Serialink` object (or `nullptr` for raw data ports).
+ * @param func The pointer of the callback function.
+ * @param param The parameter of the callback function.
+ * @return `0` if successful.
+ * @return `1` if the port is not open (or it is a USB device without a file descriptor).
+ * @return `2` if the port is already registered.
+ * @return `3` if the `epoll` operation fails.
+ */
+int SerialReactor::addPort(Serial *serial, Serialink *serialink, const void *func, void *param){
+    struct epoll_event ev;
+    if (serial == nullptr) return 1;
+    int fd = serial->getFileDescriptor();
+    if (fd <= 0) return 1;
+    pthread_mutex_lock(&(this->mtx));
+    if (this->ports.find(serial) != this->ports.end()){
+        pthread_mutex_unlock(&(this->mtx));
+        return 2;
+    }
+    SerialReactorPort *port = new SerialReactorPort;
+    port->serial = serial;
+    port->serialink = serialink;
+    port->callback = func;
+    port->param = param;
+    port->drainCallback = nullptr;
+    port->drainParam = nullptr;
+    port->txOffset = 0;
+    port->isWaitingOutput = false;
+    port->isRemoved = false;
+    ev.events = EPOLLIN;
+    ev.data.ptr = port;
+    if (this->epollFd < 0 || epoll_ctl(this->epollFd, EPOLL_CTL_ADD, fd, &ev) != 0){
+        delete port;
+        pthread_mutex_unlock(&(this->mtx));
+        return 3;
+    }
+    if (serial->setPollMode(true) != 0){
+        epoll_ctl(this->epollFd, EPOLL_CTL_DEL, fd, NULL);
+        delete port;
+        pthread_mutex_unlock(&(this->mtx));
+        return 1;
+    }
+    this->ports[serial] = port;
+    pthread_mutex_unlock(&(this->mtx));
+    return 0;
+}
+
+/**
+ * @brief Registers a `Serial` port that delivers raw data.
+ *
+ * The port must be opened before it is registered. Its file descriptor is switched to non-blocking mode.
+ * Each time new bytes arrive, the callback is called with all received bytes. The bytes are also available with `Serial::getBuffer`.
+ *
+ * @param serial The pointer of the `Serial` object.
+ * @param func The callback function.
+ * @param param The parameter of the callback function.
+ * @return `0` if successful.
+ * @return `1` if the port is not open (or it is a USB device without a file descriptor).
+ * @return `2` if the port is already registered.
+ * @return `3` if the `epoll` operation fails.
+ */
+int SerialReactor::addPort(Serial *serial, void (*func)(Serial &, const unsigned char *, size_t, void *), void *param){
+    return this->addPort(serial, nullptr, (const void *) func, param);
+}
+
+/**
+ * @brief Registers a `Serialink` port that delivers completed frames.
+ *
+ * The port must be opened and its frame format must be configured before it is registered. Its file descriptor is switched to
+ * non-blocking mode. The callback is called once for each completed frame, with the same return code as `Serialink::readFramedData`
+ * (`0` for a valid frame or `4` for an invalid frame). The frame data can be accessed with `Serial::getBuffer` or `Serialink::getFormat`.
+ *
+ * @param serialink The pointer of the `Serialink` object.
+ * @param func The callback function.
+ * @param param The parameter of the callback function.
+ * @return `0` if successful.
+ * @return `1` if the port is not open (or it is a USB device without a file descriptor).
+ * @return `2` if the port is already registered.
+ * @return `3` if the `epoll` operation fails.
+ */
+int SerialReactor::addPort(Serialink *serialink, void (*func)(Serialink &, int, void *), void *param){
+    return this->addPort(serialink, serialink, (const void *) func, param);
+}
+
+/**
+ * @brief Unregisters a port.
+ *
+ * The file descriptor is switched back to blocking mode and any data still queued for writing is discarded.
+ * This method can be called from a callback.
+ *
+ * @param serial The pointer of the registered object.
+ * @return `0` if successful.
+ * @return `1` if the port is not registered.
+ */
+int SerialReactor::removePort(Serial *serial){
+    pthread_mutex_lock(&(this->mtx));
+    auto it = this->ports.find(serial);
+    if (it == this->ports.end()){
+        pthread_mutex_unlock(&(this->mtx));
+        return 1;
+    }
+    SerialReactorPort *port = it->second;
+    this->ports.erase(it);
+    epoll_ctl(this->epollFd, EPOLL_CTL_DEL, serial->getFileDescriptor(), NULL);
+    serial->setPollMode(false);
+    /* the entry may still be referenced by the events being processed, it is released by runOnce */
+    __atomic_store_n(&(port->isRemoved), true, __ATOMIC_RELEASE);
+    this->removedPorts.push_back(port);
+    pthread_mutex_unlock(&(this->mtx));
+    return 0;
+}
+
+/**
+ * @brief Gets the number of registered ports.
+ *
+ * @return The number of registered ports.
+ */
+size_t SerialReactor::getPortCount(){
+    pthread_mutex_lock(&(this->mtx));
+    size_t result = this->ports.size();
+    pthread_mutex_unlock(&(this->mtx));
+    return result;
+}
+
+/**
+ * @brief Reads all available bytes of a port into its receive buffer.
+ *
+ * @param port The registered port.
+ * @return The number of bytes received.
+ */
+size_t SerialReactor::receivePort(SerialReactorPort *port){
+    return port->serial->loadReceivedData();
+}
+
+/**
+ * @brief Delivers the received data (or completed frames) of a port to the registered callback.
+ *
+ * @param port The registered port.
+ */
+void SerialReactor::dispatchPort(SerialReactorPort *port){
+    Serial *serial = port->serial;
+    int ret = 0;
+    if (port->serialink == nullptr){
+        void (*callback)(Serial &, const unsigned char *, size_t, void *) = (void (*)(Serial &, const unsigned char *, size_t, void *)) port->callback;
+        if (serial->readData() != 0) return;
+        if (callback != nullptr){
+            ByteView data = serial->getBufferAsView();
+            callback(*serial, data.data(), data.size(), port->param);
+        }
+        serial->releaseData();
+        return;
+    }
+    void (*callback)(Serialink &, int, void *) = (void (*)(Serialink &, int, void *)) port->callback;
+    do {
+        ret = port->serialink->readFramedData();
+        if (ret == 1 || ret == 3 || serial->isInputBytesExhausted()) break;
+        /* an invalid format that does not consume any byte would be reported forever */
+        if (ret == 4 && serial->getDataSize() == 0) break;
+        if (callback != nullptr) callback(*(port->serialink), ret, port->param);
+    } while (__atomic_load_n(&(port->isRemoved), __ATOMIC_ACQUIRE) == false);
+}
+
+/**
+ * @brief Writes the queued data of a port until the queue is empty or the port would block.
+ *
+ * The caller must hold the `mtx` lock.
+ *
+ * @param port The registered port.
+ * @return `0` if the queue has been written completely.
+ * @return `1` if the port would block (the rest of the queue is kept).
+ * @return `2` if the data write operation fails (the queue is discarded).
+ */
+int SerialReactor::flushPort(SerialReactorPort *port){
+    size_t written = 0;
+    int ret = port->serial->writeAvailableData(port->txQueue.data() + port->txOffset, port->txQueue.size() - port->txOffset, written);
+    port->txOffset += written;
+    if (ret != 1){
+        port->txQueue.clear();
+        port->txOffset = 0;
+    }
+    return ret;
+}
+
+/**
+ * @brief Updates the epoll events of a port (`EPOLLIN` only or `EPOLLIN | EPOLLOUT`).
+ *
+ * The caller must hold the `mtx` lock.
+ *
+ * @param port The registered port.
+ * @param waitOutput `true` to wait until the port is writable.
+ */
+void SerialReactor::updatePortEvents(SerialReactorPort *port, bool waitOutput){
+    struct epoll_event ev;
+    if (port->isWaitingOutput == waitOutput) return;
+    ev.events = (waitOutput ? (EPOLLIN | EPOLLOUT) : EPOLLIN);
+    ev.data.ptr = port;
+    epoll_ctl(this->epollFd, EPOLL_CTL_MOD, port->serial->getFileDescriptor(), &ev);
+    port->isWaitingOutput = waitOutput;
+}
+
+/**
+ * @brief Queues data to be written to a registered port.
+ *
+ * If nothing is queued for the port, the data is written immediately (as much as the port accepts without blocking).
+ * The rest is written by the reactor thread when the port becomes writable. This method is thread safe.
+ *
+ * @param serial The pointer of the registered object.
+ * @param buffer Data to be written.
+ * @param sz Size of the data to be written.
+ * @return `0` if successful.
+ * @return `1` if the port is not registered.
+ * @return `2` if the data write operation fails.
+ */
+int SerialReactor::writeData(Serial *serial, const unsigned char *buffer, size_t sz){
+    int ret = 0;
+    pthread_mutex_lock(&(this->mtx));
+    auto it = this->ports.find(serial);
+    if (it == this->ports.end()){
+        pthread_mutex_unlock(&(this->mtx));
+        return 1;
+    }
+    SerialReactorPort *port = it->second;
+    port->txQueue.insert(port->txQueue.end(), buffer, buffer + sz);
+    if (port->isWaitingOutput == false){
+        ret = this->flushPort(port);
+        if (ret == 1){
+            this->updatePortEvents(port, true);
+            ret = 0;
+        }
+    }
+    pthread_mutex_unlock(&(this->mtx));
+    return ret;
+}
+
+/**
+ * @brief Gets the number of bytes that are queued for a registered port.
+ *
+ * This method is thread safe.
+ *
+ * @param serial The pointer of the registered object.
+ * @return The number of bytes that have not been written yet (`0` if the port is not registered).
+ */
+size_t SerialReactor::getQueuedSize(Serial *serial){
+    size_t result = 0;
+    pthread_mutex_lock(&(this->mtx));
+    auto it = this->ports.find(serial);
+    if (it != this->ports.end()){
+        result = it->second->txQueue.size() - it->second->txOffset;
+    }
+    pthread_mutex_unlock(&(this->mtx));
+    return result;
+}
+
+/**
+ * @brief Sets the drain callback of a registered port.
+ *
+ * The callback is called by the reactor thread each time the write queue of the port has been flushed completely after the port
+ * has been waiting for output space. It can be used to feed the next data into the port without keeping a long queue.
+ *
+ * @param serial The pointer of the registered object.
+ * @param func The callback function (or `nullptr` to remove it).
+ * @param param The parameter of the callback function.
+ * @return `0` if successful.
+ * @return `1` if the port is not registered.
+ */
+int SerialReactor::setDrainCallback(Serial *serial, void (*func)(Serial &, void *), void *param){
+    pthread_mutex_lock(&(this->mtx));
+    auto it = this->ports.find(serial);
+    if (it == this->ports.end()){
+        pthread_mutex_unlock(&(this->mtx));
+        return 1;
+    }
+    it->second->drainCallback = (const void *) func;
+    it->second->drainParam = param;
+    pthread_mutex_unlock(&(this->mtx));
+    return 0;
+}
+
+/**
+ * @brief Method overloading of `writeData` with input as `std::vector <unsigned char>`.
+ *
+ * @param serial The pointer of the registered object.
+ * @param buffer Data to be written.
+ * @return `0` if successful.
+ * @return `1` if the port is not registered.
+ * @return `2` if the data write operation fails.
+ */
+int SerialReactor::writeData(Serial *serial, const std::vector <unsigned char> &buffer){
+    return this->writeData(serial, buffer.data(), buffer.size());
+}
+
+/**
+ * @brief Waits for I/O events and processes them once.
+ *
+ * @param timeoutMs The maximum waiting time in milliseconds (`-1` waits forever).
+ * @return The number of processed events (or `-1` if the `epoll` operation fails).
+ */
+int SerialReactor::runOnce(int timeoutMs){
+    struct epoll_event events[64];
+    SerialReactorPort *port = nullptr;
+    uint64_t counter = 0;
+    size_t received = 0;
+    int n = epoll_wait(this->epollFd, events, 64, timeoutMs);
+    if (n < 0) return (errno == EINTR ? 0 : -1);
+    for (int i = 0; i < n; i++){
+        port = (SerialReactorPort *) events[i].data.ptr;
+        if (port == nullptr){
+            if (read(this->eventFd, &counter, sizeof(counter)) < 0) counter = 0;
+            continue;
+        }
+        if (__atomic_load_n(&(port->isRemoved), __ATOMIC_ACQUIRE)) continue;
+        if (events[i].events & EPOLLOUT){
+            void (*drainCallback)(Serial &, void *) = nullptr;
+            pthread_mutex_lock(&(this->mtx));
+            if (port->isRemoved == false && this->flushPort(port) != 1){
+                this->updatePortEvents(port, false);
+                drainCallback = (void (*)(Serial &, void *)) port->drainCallback;
+            }
+            pthread_mutex_unlock(&(this->mtx));
+            /* the callback may queue new data, so it is called without holding the lock */
+            if (drainCallback != nullptr) drainCallback(*(port->serial), port->drainParam);
+        }
+        if (__atomic_load_n(&(port->isRemoved), __ATOMIC_ACQUIRE)) continue;
+        if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)){
+            received = this->receivePort(port);
+            if (received > 0){
+                this->dispatchPort(port);
+            }
+            else if (events[i].events & (EPOLLHUP | EPOLLERR)){
+                /* the device has gone (or the pty has no slave), stop monitoring it */
+                this->removePort(port->serial);
+            }
+        }
+    }
+    pthread_mutex_lock(&(this->mtx));
+    for (auto it = this->removedPorts.begin(); it != this->removedPorts.end(); it++){
+        delete *it;
+    }
+    this->removedPorts.clear();
+    pthread_mutex_unlock(&(this->mtx));
+    return n;
+}
+
+/**
+ * @brief Runs the reactor loop.
+ *
+ * This method processes I/O events until the `stop` method is called (from a callback or another thread).
+ *
+ * @return `true` if the loop has been stopped by the `stop` method.
+ * @return `false` if the reactor could not be initialized.
+ */
+bool SerialReactor::begin(){
+    if (this->epollFd < 0 || this->eventFd < 0) return false;
+    pthread_mutex_lock(&(this->mtx));
+    this->isRunning = true;
+    pthread_mutex_unlock(&(this->mtx));
+    while (true){
+        pthread_mutex_lock(&(this->mtx));
+        if (this->isRunning == false){
+            pthread_mutex_unlock(&(this->mtx));
+            break;
+        }
+        pthread_mutex_unlock(&(this->mtx));
+        if (this->runOnce(-1) < 0) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Stops the reactor loop.
+ *
+ * This method is thread safe. The `begin` method returns after the current events have been processed.
+ */
+void SerialReactor::stop(){
+    uint64_t counter = 1;
+    pthread_mutex_lock(&(this->mtx));
+    this->isRunning = false;
+    pthread_mutex_unlock(&(this->mtx));
+    if (write(this->eventFd, &counter, sizeof(counter)) < 0) counter = 0;
+}
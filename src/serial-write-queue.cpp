@@ -0,0 +1,346 @@
+/*
+ * $Id: serial-write-queue.cpp,v 1.0.0 2025/01/24 09:52:18 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "serial-write-queue.hpp"
+
+/**
+ * @brief Custom constructor.
+ *
+ * Creates a write queue for a port. The high watermark is 64 KiB and the low watermark is 16 KiB.
+ *
+ * @param serial The port (not owned by the queue, it must stay valid while the queue is used).
+ */
+SerialWriteQueue::SerialWriteQueue(Serial &serial){
+    this->serial = &serial;
+    this->stub.next = nullptr;
+    this->stub.callbackFunc = nullptr;
+    this->stub.callbackParam = nullptr;
+    this->head = &(this->stub);
+    this->tail = &(this->stub);
+    this->queuedBytes = 0;
+    this->unfinishedBytes = 0;
+    this->highWatermark = 65536;
+    this->lowWatermark = 16384;
+    this->maxBatchSize = 65536;
+    this->isThrottled = false;
+    this->isWaiting = false;
+    this->isRunning = false;
+    this->drainFunc = nullptr;
+    this->drainParam = nullptr;
+    pthread_mutex_init(&(this->mtx), NULL);
+    pthread_cond_init(&(this->cond), NULL);
+    pthread_cond_init(&(this->drainCond), NULL);
+}
+
+/**
+ * @brief Destructor.
+ *
+ * Stops the writer thread (the queued data is written first). The callback of a write that is still being queued by another
+ * thread is called with `1`.
+ */
+SerialWriteQueue::~SerialWriteQueue(){
+    SerialWriteRequest *request = nullptr;
+    this->stop();
+    /* the requests that are still being appended when the queue is stopped are not written */
+    while ((request = this->pop()) != nullptr){
+        __atomic_sub_fetch(&(this->queuedBytes), request->data.size(), __ATOMIC_SEQ_CST);
+        __atomic_sub_fetch(&(this->unfinishedBytes), request->data.size(), __ATOMIC_SEQ_CST);
+        this->complete(request, 1);
+    }
+    pthread_cond_destroy(&(this->drainCond));
+    pthread_cond_destroy(&(this->cond));
+    pthread_mutex_destroy(&(this->mtx));
+}
+
+/**
+ * @brief Appends a request to the queue.
+ *
+ * This function can be called by several threads at the same time. It does not take a lock.
+ *
+ * @param request The request.
+ */
+void SerialWriteQueue::push(SerialWriteRequest *request){
+    __atomic_store_n(&(request->next), nullptr, __ATOMIC_RELAXED);
+    SerialWriteRequest *prev = __atomic_exchange_n(&(this->head), request, __ATOMIC_SEQ_CST);
+    /* until this store, the writer thread sees the queue as empty after `prev` */
+    __atomic_store_n(&(prev->next), request, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Takes the oldest request of the queue.
+ *
+ * This function must only be called by the writer thread.
+ *
+ * @return The request (or `nullptr` if the queue is empty, or the oldest request is still being appended).
+ */
+SerialWriteRequest *SerialWriteQueue::pop(){
+    SerialWriteRequest *request = this->tail;
+    SerialWriteRequest *next = __atomic_load_n(&(request->next), __ATOMIC_ACQUIRE);
+    if (request == &(this->stub)){
+        if (next == nullptr) return nullptr;
+        this->tail = next;
+        request = next;
+        next = __atomic_load_n(&(request->next), __ATOMIC_ACQUIRE);
+    }
+    if (next != nullptr){
+        this->tail = next;
+        return request;
+    }
+    if (request != __atomic_load_n(&(this->head), __ATOMIC_ACQUIRE)) return nullptr;
+    /* the last request is taken, the stub keeps the queue linked */
+    this->push(&(this->stub));
+    next = __atomic_load_n(&(request->next), __ATOMIC_ACQUIRE);
+    if (next == nullptr) return nullptr;
+    this->tail = next;
+    return request;
+}
+
+/**
+ * @brief Calls the callback of a request and releases the request.
+ *
+ * @param request The request (already taken from the queue).
+ * @param ret The return value of `Serial::writeData` (or `1` if the request has not been written).
+ */
+void SerialWriteQueue::complete(SerialWriteRequest *request, int ret){
+    if (request->callbackFunc != nullptr){
+        void (*callback)(SerialWriteQueue &, int, void *) = (void (*)(SerialWriteQueue &, int, void *))request->callbackFunc;
+        callback(*this, ret, request->callbackParam);
+    }
+    delete request;
+}
+
+/**
+ * @brief Writes the queued requests until the queue is empty.
+ *
+ * @return `true` if at least one request has been written.
+ */
+bool SerialWriteQueue::writeQueued(){
+    SerialWriteRequest *request = nullptr;
+    bool isWritten = false;
+    size_t queued = 0;
+    int ret = 0;
+    while (true){
+        this->batch.clear();
+        this->completed.clear();
+        while (this->batch.size() < this->maxBatchSize && (request = this->pop()) != nullptr){
+            this->batch.insert(this->batch.end(), request->data.begin(), request->data.end());
+            this->completed.push_back(request);
+        }
+        if (this->completed.empty()) return isWritten;
+        /* all queued writes are sent with one call */
+        ret = this->serial->writeData(this->batch);
+        queued = __atomic_sub_fetch(&(this->queuedBytes), this->batch.size(), __ATOMIC_SEQ_CST);
+        for (size_t i = 0; i < this->completed.size(); i++){
+            this->complete(this->completed[i], ret);
+        }
+        if (__atomic_load_n(&(this->isThrottled), __ATOMIC_SEQ_CST) && queued <= this->lowWatermark){
+            __atomic_store_n(&(this->isThrottled), false, __ATOMIC_SEQ_CST);
+            if (this->drainFunc != nullptr){
+                void (*drainCallback)(SerialWriteQueue &, void *) = (void (*)(SerialWriteQueue &, void *))this->drainFunc;
+                drainCallback(*this, this->drainParam);
+            }
+        }
+        /* flush() returns only when the callbacks of the written data have been called */
+        __atomic_sub_fetch(&(this->unfinishedBytes), this->batch.size(), __ATOMIC_SEQ_CST);
+        pthread_mutex_lock(&(this->mtx));
+        pthread_cond_broadcast(&(this->drainCond));
+        pthread_mutex_unlock(&(this->mtx));
+        isWritten = true;
+    }
+}
+
+/**
+ * @brief The routine of the writer thread.
+ *
+ * @param param The pointer of the `SerialWriteQueue` object.
+ * @return Always `nullptr`.
+ */
+void *SerialWriteQueue::writerRoutine(void *param){
+    SerialWriteQueue *queue = (SerialWriteQueue *) param;
+    pthread_mutex_lock(&(queue->mtx));
+    while (true){
+        if (__atomic_load_n(&(queue->head), __ATOMIC_SEQ_CST) == queue->tail){
+            if (__atomic_load_n(&(queue->isRunning), __ATOMIC_SEQ_CST) == false) break;
+            /* a writing thread only signals the condition when the flag is set */
+            __atomic_store_n(&(queue->isWaiting), true, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&(queue->head), __ATOMIC_SEQ_CST) == queue->tail){
+                pthread_cond_wait(&(queue->cond), &(queue->mtx));
+            }
+            __atomic_store_n(&(queue->isWaiting), false, __ATOMIC_SEQ_CST);
+            continue;
+        }
+        pthread_mutex_unlock(&(queue->mtx));
+        queue->writeQueued();
+        pthread_mutex_lock(&(queue->mtx));
+    }
+    pthread_mutex_unlock(&(queue->mtx));
+    return nullptr;
+}
+
+/**
+ * @brief Sets the watermarks of the queue.
+ *
+ * @param high The number of queued bytes from which the new writes are refused.
+ * @param low The number of queued bytes from which the writes are accepted again (it is limited to `high`).
+ */
+void SerialWriteQueue::setWatermarks(size_t high, size_t low){
+    this->highWatermark = high;
+    this->lowWatermark = (low < high ? low : high);
+}
+
+/**
+ * @brief Sets the drain callback.
+ *
+ * The callback is called by the writer thread when the queue has reached the high watermark and has been written down to the
+ * low watermark. The callback prototype is `void callback(SerialWriteQueue &queue, void *param)`.
+ *
+ * @param func The callback function (or `nullptr` to remove it).
+ * @param param The parameter of the callback function.
+ */
+void SerialWriteQueue::setDrainCallback(const void *func, void *param){
+    this->drainFunc = func;
+    this->drainParam = param;
+}
+
+/**
+ * @brief Starts the writer thread.
+ *
+ * @return 0 on success.
+ * @return 4 if the writer thread is already running or cannot be created.
+ */
+int SerialWriteQueue::start(){
+    if (__atomic_load_n(&(this->isRunning), __ATOMIC_SEQ_CST)) return 4;
+    __atomic_store_n(&(this->isRunning), true, __ATOMIC_SEQ_CST);
+    if (pthread_create(&(this->thread), NULL, SerialWriteQueue::writerRoutine, (void *) this) != 0){
+        __atomic_store_n(&(this->isRunning), false, __ATOMIC_SEQ_CST);
+        return 4;
+    }
+    return 0;
+}
+
+/**
+ * @brief Stops the writer thread.
+ *
+ * The queued data is written before the thread exits.
+ */
+void SerialWriteQueue::stop(){
+    if (__atomic_load_n(&(this->isRunning), __ATOMIC_SEQ_CST) == false) return;
+    pthread_mutex_lock(&(this->mtx));
+    __atomic_store_n(&(this->isRunning), false, __ATOMIC_SEQ_CST);
+    pthread_cond_signal(&(this->cond));
+    pthread_cond_broadcast(&(this->drainCond));
+    pthread_mutex_unlock(&(this->mtx));
+    pthread_join(this->thread, NULL);
+    /* a write that has been accepted while the thread was stopping */
+    this->writeQueued();
+}
+
+/**
+ * @brief Queues data to be written.
+ *
+ * The data is copied and the function returns without waiting for the port. The callback is called by the writer thread
+ * after the data has been written, with the return value of `Serial::writeData`. The callback prototype is
+ * `void callback(SerialWriteQueue &queue, int ret, void *param)`. This method is thread safe.
+ *
+ * @param buffer Data to be written.
+ * @param sz Size of the data to be written.
+ * @param func The callback function (or `nullptr`).
+ * @param param The parameter of the callback function.
+ * @return 0 if the data is queued.
+ * @return 1 if the writer thread is not running.
+ * @return 2 if the queue is above its watermark (the data is not queued).
+ * @return 4 if the data is empty.
+ */
+int SerialWriteQueue::writeData(const unsigned char *buffer, size_t sz, const void *func, void *param){
+    if (buffer == nullptr || sz == 0) return 4;
+    if (__atomic_load_n(&(this->isRunning), __ATOMIC_SEQ_CST) == false) return 1;
+    if (__atomic_load_n(&(this->isThrottled), __ATOMIC_SEQ_CST)) return 2;
+    SerialWriteRequest *request = new SerialWriteRequest;
+    request->data.assign(buffer, buffer + sz);
+    request->callbackFunc = func;
+    request->callbackParam = param;
+    __atomic_add_fetch(&(this->unfinishedBytes), sz, __ATOMIC_SEQ_CST);
+    if (__atomic_add_fetch(&(this->queuedBytes), sz, __ATOMIC_SEQ_CST) >= this->highWatermark){
+        __atomic_store_n(&(this->isThrottled), true, __ATOMIC_SEQ_CST);
+    }
+    this->push(request);
+    if (__atomic_load_n(&(this->isWaiting), __ATOMIC_SEQ_CST)){
+        pthread_mutex_lock(&(this->mtx));
+        pthread_cond_signal(&(this->cond));
+        pthread_mutex_unlock(&(this->mtx));
+    }
+    return 0;
+}
+
+/**
+ * @brief Method overloading of `writeData` with input as `ByteView`.
+ *
+ * @param buffer Data to be written.
+ * @param func The callback function (or `nullptr`).
+ * @param param The parameter of the callback function.
+ * @return 0 if the data is queued.
+ * @return 1 if the writer thread is not running.
+ * @return 2 if the queue is above its watermark (the data is not queued).
+ * @return 4 if the data is empty.
+ */
+int SerialWriteQueue::writeData(ByteView buffer, const void *func, void *param){
+    return this->writeData(buffer.data(), buffer.size(), func, param);
+}
+
+/**
+ * @brief Method overloading of `writeData` without callback.
+ *
+ * @param buffer Data to be written.
+ * @return 0 if the data is queued.
+ * @return 1 if the writer thread is not running.
+ * @return 2 if the queue is above its watermark (the data is not queued).
+ * @return 4 if the data is empty.
+ */
+int SerialWriteQueue::writeData(ByteView buffer){
+    return this->writeData(buffer.data(), buffer.size(), nullptr, nullptr);
+}
+
+/**
+ * @brief Waits until the queued data has been written and the callbacks of the written data have been called.
+ *
+ * @return 0 if the queue is empty.
+ * @return 1 if the writer thread is not running (and the queue is not empty).
+ */
+int SerialWriteQueue::flush(){
+    pthread_mutex_lock(&(this->mtx));
+    while (__atomic_load_n(&(this->unfinishedBytes), __ATOMIC_SEQ_CST) > 0 && __atomic_load_n(&(this->isRunning), __ATOMIC_SEQ_CST)){
+        pthread_cond_wait(&(this->drainCond), &(this->mtx));
+    }
+    int ret = (__atomic_load_n(&(this->unfinishedBytes), __ATOMIC_SEQ_CST) > 0 ? 1 : 0);
+    pthread_mutex_unlock(&(this->mtx));
+    return ret;
+}
+
+/**
+ * @brief Gets the number of bytes that have not been written yet.
+ *
+ * @return The number of queued bytes.
+ */
+size_t SerialWriteQueue::getQueuedSize(){
+    return __atomic_load_n(&(this->queuedBytes), __ATOMIC_SEQ_CST);
+}
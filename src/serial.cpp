@@ -32,6 +32,9 @@
 #include <time.h>
 #include <stdarg.h>
 #include <sys/time.h>
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+#include <poll.h>
+#endif
 #include "serial.hpp"
 
 /**
@@ -50,6 +53,9 @@ void Serial::setFileDescriptor(HANDLE fd)
     pthread_mutex_lock(&(this->wmtx));
     pthread_mutex_lock(&(this->mtx));
     this->fd = fd;
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    this->setupIOBackend();
+#endif
     pthread_mutex_unlock(&(this->mtx));
     pthread_mutex_unlock(&(this->wmtx));
 }
@@ -101,7 +107,7 @@ bool Serial::setupAttributes(){
     ttyAttr.c_lflag = 0; // no signaling chars, no echo, no canonical processing
     ttyAttr.c_oflag = 0; // no remapping, no delays
     ttyAttr.c_cc[VMIN]  = 0; // blocking mode
-    ttyAttr.c_cc[VTIME] = this->timeout; // per 100ms read timeout
+    ttyAttr.c_cc[VTIME] = (this->timeoutUs >= 0 ? 0 : this->timeout); // per 100ms read timeout (0: handled by ppoll)
     ttyAttr.c_iflag &= ~(IXON | IXOFF | IXANY); // shut off xon/xoff ctrl
     ttyAttr.c_cflag |= (CLOCAL | CREAD); // ignore modem controls, enable reading
     ttyAttr.c_cflag &= ~(PARENB | PARODD); // shut off parity
@@ -113,7 +119,7 @@ bool Serial::setupAttributes(){
 #else
     COMMTIMEOUTS timeouts = {0};
     timeouts.ReadIntervalTimeout = 50;
-    timeouts.ReadTotalTimeoutConstant = this->timeout;
+    timeouts.ReadTotalTimeoutConstant = (this->timeoutUs >= 0 ? static_cast<DWORD>(this->timeoutUs / 1000) : this->timeout);
     timeouts.ReadTotalTimeoutMultiplier = 50;
     timeouts.WriteTotalTimeoutConstant = this->timeout;
     timeouts.WriteTotalTimeoutMultiplier = 50;
@@ -155,6 +161,21 @@ Serial::Serial(){
     this->timeout = 10;
     this->keepAliveMs = 0;
     this->port = "/dev/ttyUSB0";
+    this->timeoutUs = -1;
+    this->readChunkSize = 4096;
+    this->ioBackend = IO_BACKEND_SYSCALL;
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    this->rxUring = nullptr;
+    this->txUring = nullptr;
+#endif
+    this->dataOffset = 0;
+    this->dataSize = 0;
+    this->retainData = false;
+    this->isPollMode = false;
+    this->isInputExhausted = false;
+    this->isResyncPending = false;
+    this->writeFunc = nullptr;
+    this->writeParam = nullptr;
     pthread_mutex_init(&(this->mtx), NULL);
     pthread_mutex_init(&(this->wmtx), NULL);
     this->usb = nullptr;
@@ -180,6 +201,21 @@ Serial::Serial(const char *port, speed_t baud, unsigned int timeout){
     this->timeout = timeout;
     this->keepAliveMs = 0;
     this->port = std::string(port);
+    this->timeoutUs = -1;
+    this->readChunkSize = 4096;
+    this->ioBackend = IO_BACKEND_SYSCALL;
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    this->rxUring = nullptr;
+    this->txUring = nullptr;
+#endif
+    this->dataOffset = 0;
+    this->dataSize = 0;
+    this->retainData = false;
+    this->isPollMode = false;
+    this->isInputExhausted = false;
+    this->isResyncPending = false;
+    this->writeFunc = nullptr;
+    this->writeParam = nullptr;
     pthread_mutex_init(&(this->mtx), NULL);
     pthread_mutex_init(&(this->wmtx), NULL);
     this->usb = nullptr;
@@ -205,6 +241,21 @@ Serial::Serial(const std::string port, speed_t baud, unsigned int timeout){
     this->timeout = timeout;
     this->keepAliveMs = 0;
     this->port = port;
+    this->timeoutUs = -1;
+    this->readChunkSize = 4096;
+    this->ioBackend = IO_BACKEND_SYSCALL;
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    this->rxUring = nullptr;
+    this->txUring = nullptr;
+#endif
+    this->dataOffset = 0;
+    this->dataSize = 0;
+    this->retainData = false;
+    this->isPollMode = false;
+    this->isInputExhausted = false;
+    this->isResyncPending = false;
+    this->writeFunc = nullptr;
+    this->writeParam = nullptr;
     pthread_mutex_init(&(this->mtx), NULL);
     pthread_mutex_init(&(this->wmtx), NULL);
     this->usb = nullptr;
@@ -230,6 +281,21 @@ Serial::Serial(const char *port, speed_t baud, unsigned int timeout, unsigned in
     this->timeout = timeout;
     this->keepAliveMs = keepAliveMs;
     this->port = std::string(port);
+    this->timeoutUs = -1;
+    this->readChunkSize = 4096;
+    this->ioBackend = IO_BACKEND_SYSCALL;
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    this->rxUring = nullptr;
+    this->txUring = nullptr;
+#endif
+    this->dataOffset = 0;
+    this->dataSize = 0;
+    this->retainData = false;
+    this->isPollMode = false;
+    this->isInputExhausted = false;
+    this->isResyncPending = false;
+    this->writeFunc = nullptr;
+    this->writeParam = nullptr;
     pthread_mutex_init(&(this->mtx), NULL);
     pthread_mutex_init(&(this->wmtx), NULL);
     this->usb = nullptr;
@@ -255,6 +321,21 @@ Serial::Serial(const std::string port, speed_t baud, unsigned int timeout, unsig
     this->timeout = timeout;
     this->keepAliveMs = keepAliveMs;
     this->port = port;
+    this->timeoutUs = -1;
+    this->readChunkSize = 4096;
+    this->ioBackend = IO_BACKEND_SYSCALL;
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    this->rxUring = nullptr;
+    this->txUring = nullptr;
+#endif
+    this->dataOffset = 0;
+    this->dataSize = 0;
+    this->retainData = false;
+    this->isPollMode = false;
+    this->isInputExhausted = false;
+    this->isResyncPending = false;
+    this->writeFunc = nullptr;
+    this->writeParam = nullptr;
     pthread_mutex_init(&(this->mtx), NULL);
     pthread_mutex_init(&(this->wmtx), NULL);
     this->usb = nullptr;
@@ -275,6 +356,21 @@ Serial::Serial(USBSerial *usb){
     this->timeout = 10;
     this->keepAliveMs = 0;
     this->port = "/dev/ttyUSB0";
+    this->timeoutUs = -1;
+    this->readChunkSize = 4096;
+    this->ioBackend = IO_BACKEND_SYSCALL;
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    this->rxUring = nullptr;
+    this->txUring = nullptr;
+#endif
+    this->dataOffset = 0;
+    this->dataSize = 0;
+    this->retainData = false;
+    this->isPollMode = false;
+    this->isInputExhausted = false;
+    this->isResyncPending = false;
+    this->writeFunc = nullptr;
+    this->writeParam = nullptr;
     pthread_mutex_init(&(this->mtx), NULL);
     pthread_mutex_init(&(this->wmtx), NULL);
 #ifdef __USE_USB_SERIAL__
@@ -294,6 +390,8 @@ Serial::~Serial(){
     pthread_mutex_lock(&(this->wmtx));
     pthread_mutex_lock(&(this->mtx));
 #if defined(PLATFORM_POSIX) || defined(__linux__)
+    if (this->rxUring != nullptr) delete (this->rxUring);
+    if (this->txUring != nullptr) delete (this->txUring);
     if (this->fd > 0){
         close(this->fd);
         this->fd = -1;
@@ -360,6 +458,25 @@ void Serial::setTimeout(unsigned int timeout){
     pthread_mutex_lock(&(this->wmtx));
     pthread_mutex_lock(&(this->mtx));
     this->timeout = timeout;
+    this->timeoutUs = -1;
+    pthread_mutex_unlock(&(this->mtx));
+    pthread_mutex_unlock(&(this->wmtx));
+}
+
+/**
+ * @brief Sets the communication timeout with microsecond resolution.
+ *
+ * This setter function configures the read timeout as a `std::chrono` duration (e.g. `std::chrono::milliseconds(5)`).
+ * In this mode, the port is configured with `VMIN = 0` and `VTIME = 0`, and the waiting time for the first byte is handled by `ppoll`
+ * with a monotonic deadline. Calling `setTimeout(unsigned int)` switches back to the `VTIME` based timeout (100 milliseconds units).
+ * The `VTIME` setting is applied when the port is opened.
+ *
+ * @param timeout The timeout duration.
+ */
+void Serial::setTimeout(std::chrono::microseconds timeout){
+    pthread_mutex_lock(&(this->wmtx));
+    pthread_mutex_lock(&(this->mtx));
+    this->timeoutUs = (timeout.count() < 0 ? 0 : static_cast<long long>(timeout.count()));
     pthread_mutex_unlock(&(this->mtx));
     pthread_mutex_unlock(&(this->wmtx));
 }
@@ -412,6 +529,19 @@ unsigned int Serial::getTimeout(){
     return this->timeout;
 }
 
+/**
+ * @brief Gets the communication timeout as a duration.
+ *
+ * This getter function retrieves the read timeout as a `std::chrono` duration. If the timeout is configured in units of 100 milliseconds,
+ * the value is converted to microseconds.
+ *
+ * @return The timeout duration in microseconds.
+ */
+std::chrono::microseconds Serial::getTimeoutDuration(){
+    if (this->timeoutUs >= 0) return std::chrono::microseconds(this->timeoutUs);
+    return std::chrono::microseconds(static_cast<long long>(this->timeout) * 100000LL);
+}
+
 /**
  * @brief Gets the keep-alive interval for communication.
  *
@@ -423,6 +553,101 @@ unsigned int Serial::getKeepAlive(){
     return this->keepAliveMs;
 }
 
+/**
+ * @brief Sets the size of the receive buffer.
+ *
+ * This setter function re-allocates the receive buffer. All received data that has not been read (including the remaining data) is discarded.
+ *
+ * @param sz The size of the receive buffer in bytes (default: 65536).
+ */
+void Serial::setReceiveBufferSize(size_t sz){
+    pthread_mutex_lock(&(this->mtx));
+    this->rxBuffer.setCapacity(sz);
+    this->dataOffset = 0;
+    this->dataSize = 0;
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    if (this->rxUring != nullptr){
+        /* a failed registration only disables IORING_OP_READ_FIXED, reads are still submitted through io_uring */
+        this->rxUring->registerBuffer(this->rxBuffer.getStorage(), this->rxBuffer.getCapacity());
+    }
+#endif
+    pthread_mutex_unlock(&(this->mtx));
+}
+
+/**
+ * @brief Gets the size of the receive buffer.
+ *
+ * This getter function retrieves the capacity of the receive buffer.
+ *
+ * @return The size of the receive buffer in bytes.
+ */
+size_t Serial::getReceiveBufferSize(){
+    return this->rxBuffer.getCapacity();
+}
+
+/**
+ * @brief Sets the maximum number of bytes requested by a single read operation.
+ *
+ * This setter function configures how many bytes are requested from the serial port on each `read` syscall. The bytes are read directly
+ * into the receive buffer. A larger chunk (e.g. the whole tty buffer of 4096 bytes or more) reduces the number of syscalls for bulk transfers.
+ *
+ * @param sz The read chunk size in bytes (default: 4096). A value of `0` is ignored.
+ */
+void Serial::setReadChunkSize(size_t sz){
+    if (sz == 0) return;
+    pthread_mutex_lock(&(this->mtx));
+    this->readChunkSize = sz;
+    pthread_mutex_unlock(&(this->mtx));
+}
+
+/**
+ * @brief Gets the maximum number of bytes requested by a single read operation.
+ *
+ * This getter function retrieves the configured read chunk size.
+ *
+ * @return The read chunk size in bytes.
+ */
+size_t Serial::getReadChunkSize(){
+    return this->readChunkSize;
+}
+
+/**
+ * @brief Sets the I/O backend used for reads and writes.
+ *
+ * This setter function selects how the serial data is transferred. With `IO_BACKEND_IO_URING`, reads and writes are submitted through `io_uring`
+ * with a fixed file descriptor, and reads are stored directly into the registered receive buffer. If the kernel lacks io_uring support
+ * (or the registration fails), the port keeps using the `read`/`write` syscalls. The backend can be changed at any time, before or after `openPort`.
+ *
+ * @param backend The I/O backend (default: `IO_BACKEND_SYSCALL`).
+ * @return `true` if the backend is selected.
+ * @return `false` if the backend is not supported (the `read`/`write` syscalls are used).
+ */
+bool Serial::setIOBackend(IO_BACKEND backend){
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    bool success = false;
+    pthread_mutex_lock(&(this->wmtx));
+    pthread_mutex_lock(&(this->mtx));
+    this->ioBackend = backend;
+    success = this->setupIOBackend();
+    pthread_mutex_unlock(&(this->mtx));
+    pthread_mutex_unlock(&(this->wmtx));
+    return success;
+#else
+    return (backend == IO_BACKEND_SYSCALL);
+#endif
+}
+
+/**
+ * @brief Gets the I/O backend used for reads and writes.
+ *
+ * This getter function retrieves the active I/O backend.
+ *
+ * @return The active I/O backend.
+ */
+IO_BACKEND Serial::getIOBackend(){
+    return this->ioBackend;
+}
+
 /**
  * @brief Opens the serial port for communication.
  *
@@ -468,6 +693,9 @@ int Serial::openPort(){
         pthread_mutex_unlock(&(this->wmtx));
         return 1;
     }
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+    this->setupIOBackend();
+#endif
     pthread_mutex_unlock(&(this->mtx));
     pthread_mutex_unlock(&(this->wmtx));
     return 0;
@@ -498,18 +726,190 @@ bool Serial::isInputBytesAvailable(){
 }
 #endif
 
+#if defined(PLATFORM_POSIX) || defined(__linux__)
 /**
- * @brief Performs a serial data read operation.
+ * @brief Waits until the output buffer has free space.
  *
- * This function reads data from the serial port without separating the successfully read data into the desired size and remaining data. The read serial data can be accessed using the `Serial::getBuffer` method.
+ * This function waits with `poll` until the file descriptor is writable. The maximum waiting time is the read timeout of the port.
+ * The caller must hold the `wmtx` lock.
  *
- * @param sz The number of bytes to read. A value of `0` means that the read operation is unlimited (up to the `keepAliveMs` timeout).
- * @param dontSplitRemainingData A flag to disable automatic data splitting based on the amount of data requested.
- * @return `0` if the operation is successful.
+ * @return `true` if the file descriptor is writable.
+ * @return `false` if the waiting time has elapsed (or an error occurs).
+ */
+bool Serial::waitOutputSpace(){
+    struct pollfd pfd;
+    int timeoutMs = (this->timeoutUs >= 0 ? static_cast<int>(this->timeoutUs / 1000LL) : static_cast<int>(this->timeout) * 100);
+    pfd.fd = this->fd;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+    while (true){
+        int ret = poll(&pfd, 1, timeoutMs);
+        if (ret < 0 && errno == EINTR) continue;
+        return (ret > 0 && (pfd.revents & POLLOUT));
+    }
+}
+
+/**
+ * @brief Sets up the selected I/O backend for the current file descriptor.
+ *
+ * This function (re-)registers the file descriptor and the receive buffer to the io_uring instances when the io_uring backend is selected.
+ * If the kernel does not support the io_uring read and write operations (Linux 5.6 or newer is required) or the registration fails,
+ * the instances are released and the port falls back to the `read`/`write` syscalls. The caller must hold both
+ * the `mtx` and the `wmtx` locks.
+ *
+ * @return `true` if the selected backend is active.
+ * @return `false` if the port falls back to the `read`/`write` syscalls.
+ */
+bool Serial::setupIOBackend(){
+    if (this->ioBackend == IO_BACKEND_IO_URING && this->usb == nullptr){
+        /* reads and writes use separate rings, so a blocking read never delays a write */
+        if (this->rxUring == nullptr) this->rxUring = new IoUring(4);
+        if (this->txUring == nullptr) this->txUring = new IoUring(4);
+        if (this->rxUring->isReady() && this->txUring->isReady()){
+            if (this->fd <= 0){
+                /* a registered file holds a reference to the port, so it must be released when the port is closed */
+                this->rxUring->unregisterFile();
+                this->txUring->unregisterFile();
+                return true;
+            }
+            if (this->rxUring->registerFile(this->fd) == 0 && this->txUring->registerFile(this->fd) == 0){
+                this->rxUring->registerBuffer(this->rxBuffer.getStorage(), this->rxBuffer.getCapacity());
+                return true;
+            }
+        }
+    }
+    if (this->rxUring != nullptr) delete (this->rxUring);
+    if (this->txUring != nullptr) delete (this->txUring);
+    this->rxUring = nullptr;
+    this->txUring = nullptr;
+    if (this->ioBackend == IO_BACKEND_SYSCALL) return true;
+    this->ioBackend = IO_BACKEND_SYSCALL;
+    return false;
+}
+#endif
+
+/**
+ * @brief Limits the read timeout.
+ *
+ * The waiting time for the first byte is reduced to `timeoutUs` if the current timeout is longer, so a caller with its own
+ * deadline (see `Serialink::readFrames`) does not wait past it.
+ *
+ * @param timeoutUs The maximum waiting time in microseconds.
+ * @return The previous timeout setting, to be passed to `restoreTimeout`.
+ */
+long long Serial::limitTimeout(long long timeoutUs){
+    pthread_mutex_lock(&(this->wmtx));
+    pthread_mutex_lock(&(this->mtx));
+    long long previous = this->timeoutUs;
+    long long currentUs = (this->timeoutUs >= 0 ? this->timeoutUs : static_cast<long long>(this->timeout) * 100000LL);
+    if (timeoutUs < currentUs) this->timeoutUs = (timeoutUs < 0 ? 0 : timeoutUs);
+    pthread_mutex_unlock(&(this->mtx));
+    pthread_mutex_unlock(&(this->wmtx));
+    return previous;
+}
+
+/**
+ * @brief Restores the read timeout saved by `limitTimeout`.
+ *
+ * @param timeoutUs The value returned by `limitTimeout`.
+ */
+void Serial::restoreTimeout(long long timeoutUs){
+    pthread_mutex_lock(&(this->wmtx));
+    pthread_mutex_lock(&(this->mtx));
+    this->timeoutUs = timeoutUs;
+    pthread_mutex_unlock(&(this->mtx));
+    pthread_mutex_unlock(&(this->wmtx));
+}
+
+/**
+ * @brief Sets the poll mode flag and returns the previous one.
+ *
+ * Unlike `setPollMode`, the file descriptor is not changed. With the flag set, the read operations only parse the bytes that
+ * have already been received.
+ *
+ * @param isPollMode The new value of the flag.
+ * @return The previous value of the flag.
+ */
+bool Serial::exchangePollMode(bool isPollMode){
+    pthread_mutex_lock(&(this->mtx));
+    bool previous = this->isPollMode;
+    this->isPollMode = isPollMode;
+    pthread_mutex_unlock(&(this->mtx));
+    return previous;
+}
+
+/**
+ * @brief Releases the data buffer.
+ *
+ * This function moves the data buffer out of the readable region. If `retainData` is `true`, the released bytes are kept in the receive buffer
+ * (the consume cursor is not moved), so the caller can still access all bytes that have been read since the flag was set.
+ * A pending resync of a rejected frame (see `Serialink::readFramedData`) is cancelled, because the bytes have been read.
+ */
+void Serial::releaseData(){
+    this->isResyncPending = false;
+    if (this->retainData){
+        this->dataOffset += this->dataSize;
+    }
+    else {
+        this->rxBuffer.consume(this->dataOffset + this->dataSize);
+        this->dataOffset = 0;
+    }
+    this->dataSize = 0;
+}
+
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+/**
+ * @brief Waits until input bytes are available.
+ *
+ * This function waits for incoming bytes with `ppoll` on the file descriptor until a deadline measured on the monotonic clock.
+ * The wait is event driven, so it returns as soon as the first byte arrives. The caller must hold the `mtx` lock.
+ *
+ * @param timeoutUs The maximum waiting time in microseconds.
+ * @return `true` if there are bytes available in the serial buffer.
+ * @return `false` if the waiting time has elapsed (or an error occurs).
+ */
+bool Serial::waitInputBytes(long long timeoutUs){
+    if (this->usb != nullptr) return true;
+    struct pollfd pfd;
+    struct timespec now;
+    struct timespec deadline;
+    struct timespec remaining;
+    long long remainingNs = 0;
+    int ret = 0;
+    pfd.fd = this->fd;
+    pfd.events = POLLIN;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += static_cast<time_t>(timeoutUs / 1000000LL);
+    deadline.tv_nsec += static_cast<long>((timeoutUs % 1000000LL) * 1000LL);
+    if (deadline.tv_nsec >= 1000000000L){
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        remainingNs = static_cast<long long>(deadline.tv_sec - now.tv_sec) * 1000000000LL + static_cast<long long>(deadline.tv_nsec - now.tv_nsec);
+        if (remainingNs < 0) remainingNs = 0;
+        remaining.tv_sec = static_cast<time_t>(remainingNs / 1000000000LL);
+        remaining.tv_nsec = static_cast<long>(remainingNs % 1000000000LL);
+        pfd.revents = 0;
+        ret = ppoll(&pfd, 1, &remaining, NULL);
+    } while (ret < 0 && errno == EINTR);
+    return (ret > 0 && (pfd.revents & POLLIN) != 0);
+}
+#endif
+
+/**
+ * @brief Receives serial data into the receive buffer.
+ *
+ * This function reads data from the serial port directly into the receive buffer, after the data that is already stored there.
+ *
+ * @param sz The number of bytes to receive. A value of `0` means that the read operation is unlimited (up to the `keepAliveMs` timeout).
+ * @param received The number of bytes that are already available for the caller. If it is greater than `0`, the function only waits for the `keepAliveMs` interval before reading.
+ * @return `0` if there are bytes available for the caller (`received` plus the received bytes).
  * @return `1` if the port is not open.
  * @return `2` if a timeout occurs.
  */
-int Serial::readData(size_t sz, bool dontSplitRemainingData){
+int Serial::receiveData(size_t sz, size_t received){
     pthread_mutex_lock(&(this->mtx));
 #if defined(PLATFORM_POSIX) || defined(__linux__)
     if (this->fd <= 0 && this->usb == nullptr){
@@ -520,65 +920,78 @@ int Serial::readData(size_t sz, bool dontSplitRemainingData){
 #else
     long unsigned int bytes = 0;
 #endif
-    int idx = 0;
-    unsigned char tmp[1024];
-    this->data.clear();
-    if (this->remainingData.size() > 0){
-        this->data.assign(this->remainingData.begin(), this->remainingData.end());
-        this->remainingData.clear();
+    unsigned char *buffer = nullptr;
+    size_t available = 0;
+    if (sz > 0 && received >= sz){
+        pthread_mutex_unlock(&(this->mtx));
+        return 0;
+    }
+    if (this->isPollMode){
+        /* the receive buffer is filled by the SerialReactor, never wait for the file descriptor */
+        pthread_mutex_unlock(&(this->mtx));
+        if (received > 0) return 0;
+        this->isInputExhausted = true;
+        return 2;
     }
     do {
 #if defined(PLATFORM_POSIX) || defined(__linux__)
-        if (this->data.size() > 0) {
+        if (received > 0) {
             if (this->keepAliveMs == 0) break;
-            pthread_mutex_unlock(&(this->mtx));
-            static struct timeval tvStart;
-            static struct timeval tvEnd;
-            static long diffTime = 0;
-            gettimeofday(&tvStart, NULL);
-            do {
-                if (this->isInputBytesAvailable() == true){
-                    break;
-                }
-                else {
-                    usleep(1000);
-                }
-                gettimeofday(&tvEnd, NULL);
-                diffTime = static_cast<long>((tvEnd.tv_sec - tvStart.tv_sec) * 1000) + static_cast<long>((tvEnd.tv_usec - tvStart.tv_usec) / 1000);
-            } while (diffTime < static_cast<long>(this->keepAliveMs));
-            if (this->isInputBytesAvailable() == false){
-                pthread_mutex_lock(&(this->mtx));
-                break;
-            }
-            pthread_mutex_lock(&(this->mtx));
+            if (this->waitInputBytes(static_cast<long long>(this->keepAliveMs) * 1000LL) == false) break;
+        }
+        else if (this->timeoutUs >= 0){
+            if (this->waitInputBytes(this->timeoutUs) == false) break;
+        }
+        buffer = this->rxBuffer.prepareWrite(available);
+        if (available == 0) break;
+        if (available > this->readChunkSize) available = this->readChunkSize;
+        if (this->rxUring != nullptr){
+            bytes = this->rxUring->read(buffer, available);
         }
-        if (this->usb == nullptr){
-            bytes = read(this->fd, (void *) tmp, sizeof(tmp));
+        else if (this->usb == nullptr){
+            bytes = read(this->fd, (void *) buffer, available);
         }
         else {
-            bytes = this->usb->readDevice(tmp, sizeof(tmp));
+            bytes = this->usb->readDevice(buffer, available);
         }
 #else
-        bool success = ReadFile(this->fd, tmp, sizeof(tmp), &bytes, NULL);
+        buffer = this->rxBuffer.prepareWrite(available);
+        if (available == 0) break;
+        if (available > this->readChunkSize) available = this->readChunkSize;
+        bool success = ReadFile(this->fd, buffer, available, &bytes, NULL);
         if (success == false){
             bytes = 0;
         }
 #endif
         if (bytes > 0){
-            for (idx = 0; idx < bytes; idx++){
-                this->data.push_back(tmp[idx]);
-            }
+            this->rxBuffer.commitWrite(static_cast<size_t>(bytes));
+            received += static_cast<size_t>(bytes);
         }
-    } while (bytes > 0 && (sz == 0 || this->data.size() < sz));
-    if (this->data.size() == 0){
-        pthread_mutex_unlock(&(this->mtx));
-        return 2;
-    }
-    if (dontSplitRemainingData == false && sz > 0 && this->data.size() > sz){
-        this->remainingData.assign(this->data.begin() + sz, this->data.end());
-        this->data.erase(this->data.begin() + sz, this->data.end());
-    }
+    } while (bytes > 0 && (sz == 0 || received < sz));
     pthread_mutex_unlock(&(this->mtx));
+    return (received > 0 ? 0 : 2);
+}
+
+/**
+ * @brief Performs a serial data read operation.
+ *
+ * This function reads data from the serial port without separating the successfully read data into the desired size and remaining data. The read serial data can be accessed using the `Serial::getBuffer` method.
+ *
+ * @param sz The number of bytes to read. A value of `0` means that the read operation is unlimited (up to the `keepAliveMs` timeout).
+ * @param dontSplitRemainingData A flag to disable automatic data splitting based on the amount of data requested.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if a timeout occurs.
+ */
+int Serial::readData(size_t sz, bool dontSplitRemainingData){
+    int ret = 0;
+    this->releaseData();
+    ret = this->receiveData(sz, this->rxBuffer.getSize() - this->dataOffset);
+    if (ret != 0) return ret;
+    this->dataSize = this->rxBuffer.getSize() - this->dataOffset;
+    if (dontSplitRemainingData == false && sz > 0 && this->dataSize > sz){
+        this->dataSize = sz;
+    }
     return 0;
 }
 
@@ -623,48 +1036,43 @@ int Serial::readData(){
 int Serial::readStartBytes(const unsigned char *startBytes, size_t sz){
     size_t i = 0;
     size_t idxCheck = 0;
+    size_t available = 0;
+    const unsigned char *buffer = nullptr;
     bool found = false;
+    bool isPending = false;
     int ret = 0;
-    std::vector <unsigned char> tmp;
-    bool isRcvFirstBytes = false;
+    this->releaseData();
+    isPending = (this->rxBuffer.getSize() > this->dataOffset);
     do {
-        if (this->remainingData.size() > 0){
-            this->data.assign(this->remainingData.begin(), this->remainingData.end());
-            this->remainingData.clear();
+        if (isPending == true){
+            isPending = false;
             ret = 0;
         }
         else {
-            ret = this->readData(sz, true);
+            if ((this->rxBuffer.getFreeSpace() == 0 || this->isPollMode) && this->retainData == false && idxCheck > 0){
+                /* the receive buffer is full (or filled by the SerialReactor), discard the bytes that have been checked */
+                this->rxBuffer.consume(this->dataOffset + idxCheck);
+                this->dataOffset = 0;
+                idxCheck = 0;
+            }
+            ret = this->receiveData(sz, 0);
         }
         if (!ret){
-            if (isRcvFirstBytes == false){
-                isRcvFirstBytes = true;
-            }
-            else if (tmp.size() > sz){
-                idxCheck = tmp.size() + 1 - sz;
-            }
-            tmp.insert(tmp.end(), this->data.begin(), this->data.end());
-            if (this->remainingData.size() > 0){
-                tmp.insert(tmp.end(), this->remainingData.begin(), this->remainingData.end());
-                this->remainingData.clear();
-            }
-            if (tmp.size() >= sz){
-                for (i = idxCheck; i <= tmp.size() - sz; i++){
-                    if (memcmp(tmp.data() + i, startBytes, sz) == 0){
-                        found = true;
-                        break;
-                    }
-                }
+            buffer = this->rxBuffer.getData() + this->dataOffset;
+            available = this->rxBuffer.getSize() - this->dataOffset;
+            if (available >= sz){
+                found = ByteSearch::find(buffer + idxCheck, available - idxCheck, startBytes, sz, i);
+                if (found == true) i += idxCheck;
+                else idxCheck = available - sz + 1;
             }
         }
     } while(found == false && ret == 0);
     if (found == true){
-        this->data.clear();
-        this->data.assign(tmp.begin() + i, tmp.begin() + i + sz);
-        if (tmp.size() > i + sz) this->remainingData.assign(tmp.begin() + i + sz, tmp.end());
+        this->dataOffset += i;
+        this->dataSize = sz;
     }
     else {
-        this->data.assign(tmp.begin(), tmp.end());
+        this->dataSize = this->rxBuffer.getSize() - this->dataOffset;
     }
     return ret;
 }
@@ -711,6 +1119,65 @@ int Serial::readStartBytes(const std::string startBytes){
     return this->readStartBytes((const unsigned char *) startBytes.c_str(), startBytes.length());
 }
 
+/**
+ * @brief Reads serial data until one of several start bytes is found.
+ *
+ * This overloaded function is used when a port carries several protocols with different start bytes. All start bytes
+ * are searched in one pass over the received data (see `ByteSearchSet::find`), and the first one found in the stream is
+ * returned. Any serial data read before the start bytes are found is automatically discarded. The matched start bytes can be
+ * accessed using the `Serial::getBuffer` method.
+ *
+ * @param startBytes The set of start bytes to be detected.
+ * @param[out] index The index (in `startBytes`) of the start bytes that have been found.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if a timeout occurs.
+ * @return `3` if the set is empty.
+ */
+int Serial::readStartBytes(const ByteSearchSet &startBytes, size_t &index){
+    size_t i = 0;
+    size_t idxCheck = 0;
+    size_t checked = 0;
+    size_t available = 0;
+    const unsigned char *buffer = nullptr;
+    bool found = false;
+    bool isPending = false;
+    int ret = 0;
+    if (startBytes.getCount() == 0) return 3;
+    this->releaseData();
+    isPending = (this->rxBuffer.getSize() > this->dataOffset);
+    do {
+        if (isPending == true){
+            isPending = false;
+            ret = 0;
+        }
+        else {
+            if ((this->rxBuffer.getFreeSpace() == 0 || this->isPollMode) && this->retainData == false && idxCheck > 0){
+                /* the receive buffer is full (or filled by the SerialReactor), discard the bytes that have been checked */
+                this->rxBuffer.consume(this->dataOffset + idxCheck);
+                this->dataOffset = 0;
+                idxCheck = 0;
+            }
+            ret = this->receiveData(1, 0);
+        }
+        if (!ret){
+            buffer = this->rxBuffer.getData() + this->dataOffset;
+            available = this->rxBuffer.getSize() - this->dataOffset;
+            found = startBytes.find(buffer + idxCheck, available - idxCheck, i, index, checked);
+            if (found == true) i += idxCheck;
+            else idxCheck += checked;
+        }
+    } while(found == false && ret == 0);
+    if (found == true){
+        this->dataOffset += i;
+        this->dataSize = startBytes.get(index).size();
+    }
+    else {
+        this->dataSize = this->rxBuffer.getSize() - this->dataOffset;
+    }
+    return ret;
+}
+
 /**
  * @brief Performs a serial data read operation until the specified stop bytes are detected.
  *
@@ -725,56 +1192,37 @@ int Serial::readStartBytes(const std::string startBytes){
 int Serial::readUntilStopBytes(const unsigned char *stopBytes, size_t sz){
     size_t i = 0;
     size_t idxCheck = 0;
+    size_t available = 0;
+    const unsigned char *buffer = nullptr;
     bool found = false;
+    bool isPending = false;
     int ret = 0;
-    std::vector <unsigned char> tmp;
-    bool isRcvFirstBytes = false;
+    this->releaseData();
+    isPending = (this->rxBuffer.getSize() > this->dataOffset);
     do {
-        if (this->remainingData.size() > 0){
-            this->data.assign(this->remainingData.begin(), this->remainingData.end());
-            this->remainingData.clear();
+        if (isPending == true){
+            isPending = false;
             ret = 0;
         }
         else {
-            ret = this->readData(sz, true);
+            ret = this->receiveData(sz, 0);
         }
         if (!ret){
-            if (isRcvFirstBytes == false){
-                isRcvFirstBytes = true;
-            }
-            else if (tmp.size() > sz){
-                idxCheck = tmp.size() + 1 - sz;
-            }
-            tmp.insert(tmp.end(), this->data.begin(), this->data.end());
-            if (this->remainingData.size() > 0){
-                tmp.insert(tmp.end(), this->remainingData.begin(), this->remainingData.end());
-                this->remainingData.clear();
-            }
-            if (tmp.size() >= sz){
-                for (i = idxCheck; i <= tmp.size() - sz; i++){
-                    if (memcmp(tmp.data() + i, stopBytes, sz) == 0){
-                        found = true;
-                        break;
-                    }
-                }
+            buffer = this->rxBuffer.getData() + this->dataOffset;
+            available = this->rxBuffer.getSize() - this->dataOffset;
+            if (available >= sz){
+                found = ByteSearch::find(buffer + idxCheck, available - idxCheck, stopBytes, sz, i);
+                if (found == true) i += idxCheck;
+                else idxCheck = available - sz + 1;
             }
         }
     } while(found == false && ret == 0);
-    if (tmp.size() < sz){
-        this->data.assign(tmp.begin(), tmp.end());
+    if (found == false){
+        this->dataSize = this->rxBuffer.getSize() - this->dataOffset;
         return 2;
     }
-    if (this->data.size() != tmp.size()){
-        this->data.clear();
-        this->data.assign(tmp.begin(), tmp.begin() + i + sz);
-        if (tmp.size() > i + sz) this->remainingData.assign(tmp.begin() + i + sz, tmp.end());
-        return 0;
-    }
-    if (this->data.size() > i + sz){
-        this->remainingData.assign(this->data.begin() + i + sz, this->data.end());
-        this->data.erase(this->data.begin() + i + sz, this->data.end());
-    }
-    return ret;
+    this->dataSize = i + sz;
+    return 0;
 }
 
 /**
@@ -832,51 +1280,41 @@ int Serial::readUntilStopBytes(const std::string stopBytes){
  * @return `3` if data is read but does not match the specified stop bytes.
  */
 int Serial::readStopBytes(const unsigned char *stopBytes, size_t sz){
+    size_t available = 0;
     bool found = false;
+    bool isPending = false;
     int ret = 0;
-    std::vector <unsigned char> tmp;
+    this->releaseData();
+    isPending = (this->rxBuffer.getSize() > this->dataOffset);
     do {
-        if (this->remainingData.size() > 0){
-            this->data.assign(this->remainingData.begin(), this->remainingData.end());
-            this->remainingData.clear();
+        if (isPending == true){
+            isPending = false;
             ret = 0;
         }
         else {
-            ret = this->readData(sz - tmp.size(), true);
+            ret = this->receiveData(sz - available, 0);
         }
         if (!ret){
-            tmp.insert(tmp.end(), this->data.begin(), this->data.end());
-            if (this->remainingData.size() > 0){
-                tmp.insert(tmp.end(), this->remainingData.begin(), this->remainingData.end());
-                this->remainingData.clear();
-            }
-            if (tmp.size() >= sz){
-                if (memcmp(tmp.data(), stopBytes, sz) == 0){
+            available = this->rxBuffer.getSize() - this->dataOffset;
+            if (available >= sz){
+                if (memcmp(this->rxBuffer.getData() + this->dataOffset, stopBytes, sz) == 0){
                     found = true;
                 }
                 break;
             }
         }
     } while(ret == 0);
-    if (tmp.size() < sz){
-        this->data.assign(tmp.begin(), tmp.end());
+    available = this->rxBuffer.getSize() - this->dataOffset;
+    if (available < sz){
+        this->dataSize = available;
         return 2;
     }
     if (found == false){
-        this->data.assign(tmp.begin(), tmp.end());
+        this->dataSize = available;
         return 3;
     }
-    if (this->data.size() != tmp.size()){
-        this->data.clear();
-        this->data.assign(tmp.begin(), tmp.begin() + sz);
-        if (tmp.size() > sz) this->remainingData.assign(tmp.begin() + sz, tmp.end());
-        return 0;
-    }
-    if (this->data.size() > sz){
-        this->remainingData.assign(this->data.begin() + sz, this->data.end());
-        this->data.erase(this->data.begin() + sz, this->data.end());
-    }
-    return ret;
+    this->dataSize = sz;
+    return 0;
 }
 
 /**
@@ -935,50 +1373,39 @@ int Serial::readStopBytes(const std::string stopBytes){
  * @return `2` if a timeout occurs.
  */
 int Serial::readNBytes(size_t sz){
-    size_t i = 0;
-    std::vector <unsigned char> tmp;
+    size_t available = 0;
     int ret = 0;
     int tryTimes = 0;
     bool isRcvFirstBytes = false;
+    bool isPending = false;
+    this->releaseData();
+    isPending = (this->rxBuffer.getSize() > this->dataOffset);
     do {
-        if (this->remainingData.size() > 0){
-            this->data.assign(this->remainingData.begin(), this->remainingData.end());
-            this->remainingData.clear();
+        if (isPending == true){
+            isPending = false;
             ret = 0;
         }
         else {
-            ret = this->readData(sz, true);
+            ret = this->receiveData(sz - available, 0);
         }
         if (!ret){
             if (isRcvFirstBytes == false){
                 tryTimes = 3;
                 isRcvFirstBytes = true;
             }
-            tmp.insert(tmp.end(), this->data.begin(), this->data.end());
-            if (this->remainingData.size() > 0){
-                tmp.insert(tmp.end(), this->remainingData.begin(), this->remainingData.end());
-                this->remainingData.clear();
-            }
-            if (tmp.size() >= sz) break;
+            available = this->rxBuffer.getSize() - this->dataOffset;
+            if (available >= sz) break;
         }
         else if (isRcvFirstBytes == true) {
             tryTimes--;
         }
     } while(tryTimes > 0);
-    if (tmp.size() < sz){
-        this->data.assign(tmp.begin(), tmp.end());
+    available = this->rxBuffer.getSize() - this->dataOffset;
+    if (available < sz){
+        this->dataSize = available;
         return 2;
     }
-    if (this->data.size() != tmp.size()){
-        this->data.clear();
-        this->data.assign(tmp.begin(), tmp.begin() + sz);
-        if (tmp.size() > sz) this->remainingData.assign(tmp.begin() + sz, tmp.end());
-        return 0;
-    }
-    if (this->data.size() > sz){
-        this->remainingData.assign(this->data.begin() + sz, this->data.end());
-        this->data.erase(this->data.begin() + sz, this->data.end());
-    }
+    this->dataSize = sz;
     return 0;
 }
 
@@ -990,7 +1417,7 @@ int Serial::readNBytes(size_t sz){
  * @return The size of the serial data in bytes.
  */
 size_t Serial::getDataSize(){
-    return this->data.size();
+    return this->dataSize;
 }
 
 /**
@@ -1004,14 +1431,8 @@ size_t Serial::getDataSize(){
  */
 size_t Serial::getBuffer(unsigned char *buffer, size_t maxBufferSz){
     pthread_mutex_lock(&(this->mtx));
-    size_t result = (this->data.size() < maxBufferSz ? this->data.size() : maxBufferSz);
-    size_t sz = result;
-    for (auto i = this->data.begin(); i != this->data.end(); i++){
-        if (result == 0) break;
-        *buffer = *i;
-        buffer++;
-        result--;
-    }
+    size_t sz = (this->dataSize < maxBufferSz ? this->dataSize : maxBufferSz);
+    if (sz > 0) memcpy(buffer, this->rxBuffer.getData() + this->dataOffset, sz);
     pthread_mutex_unlock(&(this->mtx));
     return sz;
 }
@@ -1027,8 +1448,8 @@ size_t Serial::getBuffer(unsigned char *buffer, size_t maxBufferSz){
  * @return The size of the serial data read.
  */
 size_t Serial::getBuffer(std::vector <unsigned char> &buffer){
-    buffer.clear();
-    buffer.assign(this->data.begin(), this->data.end());
+    const unsigned char *data = this->rxBuffer.getData() + this->dataOffset;
+    buffer.assign(data, data + this->dataSize);
     return buffer.size();
 }
 
@@ -1040,9 +1461,20 @@ size_t Serial::getBuffer(std::vector <unsigned char> &buffer){
  * @return A `std::vector<unsigned char>` containing the serial data that has been successfully read.
  */
 std::vector <unsigned char> Serial::getBufferAsVector(){
-    std::vector <unsigned char> tmp;
-    tmp.assign(this->data.begin(), this->data.end());
-    return tmp;
+    const unsigned char *data = this->rxBuffer.getData() + this->dataOffset;
+    return std::vector <unsigned char>(data, data + this->dataSize);
+}
+
+/**
+ * @brief Retrieves the read data buffer as a view.
+ *
+ * This method returns a view of all the data that has been successfully read by the `read` method, without copying it.
+ * The view points into the receive buffer and is valid until the next read operation.
+ *
+ * @return A `ByteView` of the serial data that has been successfully read.
+ */
+ByteView Serial::getBufferAsView(){
+    return ByteView(this->rxBuffer.getData() + this->dataOffset, this->dataSize);
 }
 
 /**
@@ -1053,7 +1485,7 @@ std::vector <unsigned char> Serial::getBufferAsVector(){
  * @return The size of the remaining data in bytes.
  */
 size_t Serial::getRemainingDataSize(){
-    return this->remainingData.size();
+    return this->rxBuffer.getSize() - this->dataOffset - this->dataSize;
 }
 
 /**
@@ -1067,14 +1499,9 @@ size_t Serial::getRemainingDataSize(){
  */
 size_t Serial::getRemainingBuffer(unsigned char *buffer, size_t maxBufferSz){
     pthread_mutex_lock(&(this->mtx));
-    size_t result = (this->remainingData.size() < maxBufferSz ? this->remainingData.size() : maxBufferSz);
-    size_t sz = result;
-    for (auto i = this->remainingData.begin(); i != this->remainingData.end(); i++){
-        if (result == 0) break;
-        *buffer = *i;
-        buffer++;
-        result--;
-    }
+    size_t remaining = this->rxBuffer.getSize() - this->dataOffset - this->dataSize;
+    size_t sz = (remaining < maxBufferSz ? remaining : maxBufferSz);
+    if (sz > 0) memcpy(buffer, this->rxBuffer.getData() + this->dataOffset + this->dataSize, sz);
     pthread_mutex_unlock(&(this->mtx));
     return sz;
 }
@@ -1088,8 +1515,8 @@ size_t Serial::getRemainingBuffer(unsigned char *buffer, size_t maxBufferSz){
  * @return The size of the remaining serial data read.
  */
 size_t Serial::getRemainingBuffer(std::vector <unsigned char> &buffer){
-    buffer.clear();
-    buffer.assign(this->remainingData.begin(), this->remainingData.end());
+    const unsigned char *data = this->rxBuffer.getData() + this->dataOffset + this->dataSize;
+    buffer.assign(data, this->rxBuffer.getData() + this->rxBuffer.getSize());
     return buffer.size();
 }
 
@@ -1101,9 +1528,20 @@ size_t Serial::getRemainingBuffer(std::vector <unsigned char> &buffer){
  * @return std::vector<unsigned char> containing the remaining serial data that has been successfully read.
  */
 std::vector <unsigned char> Serial::getRemainingBufferAsVector(){
-    std::vector <unsigned char> tmp;
-    tmp.assign(this->remainingData.begin(), this->remainingData.end());
-    return tmp;
+    const unsigned char *data = this->rxBuffer.getData() + this->dataOffset + this->dataSize;
+    return std::vector <unsigned char>(data, this->rxBuffer.getData() + this->rxBuffer.getSize());
+}
+
+/**
+ * @brief Retrieves remaining serial data that has been successfully read but is outside the main data buffer, returning it as a view.
+ *
+ * This method returns a view of all remaining serial data without copying it. The view points into the receive buffer
+ * and is valid until the next read operation.
+ *
+ * @return A `ByteView` of the remaining serial data that has been successfully read.
+ */
+ByteView Serial::getRemainingBufferAsView(){
+    return ByteView(this->rxBuffer.getData() + this->dataOffset + this->dataSize, this->getRemainingDataSize());
 }
 
 /**
@@ -1119,6 +1557,12 @@ std::vector <unsigned char> Serial::getRemainingBufferAsVector(){
  */
 int Serial::writeData(const unsigned char *buffer, size_t sz){
     pthread_mutex_lock(&(this->wmtx));
+    if (this->writeFunc != nullptr){
+        int (*handler)(Serial &, const unsigned char *, size_t, void *) = (int (*)(Serial &, const unsigned char *, size_t, void *)) this->writeFunc;
+        void *param = this->writeParam;
+        pthread_mutex_unlock(&(this->wmtx));
+        return handler(*this, buffer, sz, param);
+    }
     size_t total = 0;
 #if defined(PLATFORM_POSIX) || defined(__linux__)
     if (this->fd <= 0 && this->usb == nullptr){
@@ -1131,7 +1575,10 @@ int Serial::writeData(const unsigned char *buffer, size_t sz){
 #endif
     while (total < sz){
 #if defined(PLATFORM_POSIX) || defined(__linux__)
-        if (this->usb == nullptr){
+        if (this->txUring != nullptr){
+            bytes = this->txUring->write(buffer + total, sz - total);
+        }
+        else if (this->usb == nullptr){
             bytes = write(this->fd, (void *) (buffer + total), sz - total);
         }
         else {
@@ -1146,6 +1593,15 @@ int Serial::writeData(const unsigned char *buffer, size_t sz){
         if (bytes > 0){
             total += bytes;
         }
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+        else if (bytes < 0 && this->usb == nullptr && errno == EINTR){
+            continue;
+        }
+        else if (bytes < 0 && this->usb == nullptr && (errno == EAGAIN || errno == EWOULDBLOCK) && this->waitOutputSpace()){
+            /* the file descriptor is in non-blocking mode (e.g. registered to a SerialReactor) */
+            continue;
+        }
+#endif
         else {
             pthread_mutex_unlock(&(this->wmtx));
             return 2;
@@ -1179,7 +1635,7 @@ int Serial::writeData(const char *buffer){
  * @return 1 if the port is not open.
  * @return 2 if the data write operation fails.
  */
-int Serial::writeData(const std::vector <unsigned char> buffer){
+int Serial::writeData(const std::vector <unsigned char> &buffer){
     return this->writeData(buffer.data(), buffer.size());
 }
 
@@ -1193,10 +1649,165 @@ int Serial::writeData(const std::vector <unsigned char> buffer){
  * @return 1 if the port is not open.
  * @return 2 if the data write operation fails.
  */
-int Serial::writeData(const std::string buffer){
+int Serial::writeData(const std::string &buffer){
     return this->writeData((const unsigned char *) buffer.c_str(), buffer.length());
 }
 
+/**
+ * @brief Method overloading of `writeData` with input as `ByteView`.
+ *
+ * This method writes the specified data to the serial port. This overload allows a view (for example a view of the
+ * received data) to be written without copying it.
+ *
+ * @param buffer Data to be written.
+ * @return 0 if the operation is successful.
+ * @return 1 if the port is not open.
+ * @return 2 if the data write operation fails.
+ */
+int Serial::writeData(ByteView buffer){
+    return this->writeData(buffer.data(), buffer.size());
+}
+
+/**
+ * @brief Returns the data buffer to the receive buffer.
+ *
+ * The next read operation returns the same bytes again (in poll mode, without waiting for the port).
+ */
+void Serial::unreadData(){
+    pthread_mutex_lock(&(this->mtx));
+    this->dataSize = 0;
+    pthread_mutex_unlock(&(this->mtx));
+}
+
+/**
+ * @brief Sets a function that takes over the write operations of the port.
+ *
+ * Every `writeData` call is handed to the function instead of being written to the port. `VirtualSerialProxy` uses it to queue
+ * the writes of a Pass Through function into its `SerialReactor`, so the reactor thread never waits for a full port. The function
+ * prototype is `int handler(Serial &serial, const unsigned char *buffer, size_t sz, void *param)`, and its return value is
+ * returned by `writeData`.
+ *
+ * @param func The handler function (or `nullptr` to write to the port again).
+ * @param param The parameter of the handler function.
+ */
+void Serial::setWriteHandler(const void *func, void *param){
+    pthread_mutex_lock(&(this->wmtx));
+    this->writeFunc = func;
+    this->writeParam = param;
+    pthread_mutex_unlock(&(this->wmtx));
+}
+
+#if defined(PLATFORM_POSIX) || defined(__linux__)
+/**
+ * @brief Switches the port to (or from) poll mode.
+ *
+ * In poll mode, the file descriptor is non-blocking and the receive buffer is filled by `loadReceivedData` (called by the `SerialReactor`
+ * that polls the port), so the read operations never wait for the port.
+ *
+ * @param isPollMode `true` to enable the poll mode.
+ * @return `0` if successful.
+ * @return `1` if the port is not open (or it is a USB device without a file descriptor).
+ */
+int Serial::setPollMode(bool isPollMode){
+    int flags = 0;
+    if (isPollMode && (this->fd <= 0 || this->usb != nullptr)) return 1;
+    if (this->fd > 0 && this->usb == nullptr){
+        flags = fcntl(this->fd, F_GETFL, 0);
+        if (flags >= 0) fcntl(this->fd, F_SETFL, (isPollMode ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK)));
+    }
+    pthread_mutex_lock(&(this->mtx));
+    this->isPollMode = isPollMode;
+    pthread_mutex_unlock(&(this->mtx));
+    return 0;
+}
+
+/**
+ * @brief Loads the bytes available on the file descriptor into the receive buffer.
+ *
+ * This function reads without waiting (the port must be in poll mode). If the receive buffer is full, the buffered bytes are dropped first,
+ * because a frame larger than the receive buffer can never be completed.
+ *
+ * @return The number of loaded bytes.
+ */
+size_t Serial::loadReceivedData(){
+    unsigned char *buffer = nullptr;
+    size_t available = 0;
+    size_t total = 0;
+    ssize_t bytes = 0;
+    pthread_mutex_lock(&(this->mtx));
+    this->rxBuffer.prepareWrite(available);
+    if (available == 0){
+        /* a frame larger than the receive buffer can never be completed, drop it */
+        this->rxBuffer.clear();
+        this->dataOffset = 0;
+        this->dataSize = 0;
+    }
+    while (true){
+        buffer = this->rxBuffer.prepareWrite(available);
+        if (available == 0) break;
+        if (available > this->readChunkSize) available = this->readChunkSize;
+        bytes = read(this->fd, (void *) buffer, available);
+        if (bytes > 0){
+            this->rxBuffer.commitWrite(static_cast<size_t>(bytes));
+            total += static_cast<size_t>(bytes);
+            if (static_cast<size_t>(bytes) < available) break;
+        }
+        else if (bytes < 0 && errno == EINTR){
+            continue;
+        }
+        else {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&(this->mtx));
+    return total;
+}
+
+/**
+ * @brief Writes data as far as the port accepts it without blocking.
+ *
+ * The port must be in poll mode. The `wmtx` lock is held during the write, so the data is not interleaved with another write.
+ *
+ * @param buffer Data to be written.
+ * @param sz Size of the data to be written.
+ * @param written The number of bytes that have been written.
+ * @return `0` if all data has been written.
+ * @return `1` if the port would block (only `written` bytes have been written).
+ * @return `2` if the data write operation fails.
+ */
+int Serial::writeAvailableData(const unsigned char *buffer, size_t sz, size_t &written){
+    ssize_t bytes = 0;
+    int ret = 0;
+    written = 0;
+    pthread_mutex_lock(&(this->wmtx));
+    while (written < sz){
+        bytes = write(this->fd, (void *) (buffer + written), sz - written);
+        if (bytes > 0){
+            written += static_cast<size_t>(bytes);
+        }
+        else if (bytes < 0 && errno == EINTR){
+            continue;
+        }
+        else {
+            ret = ((bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) ? 1 : 2);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&(this->wmtx));
+    return ret;
+}
+
+/**
+ * @brief Checks whether the last read operation in poll mode has used up the loaded bytes.
+ *
+ * @return `true` if the read operation has found no more bytes in the receive buffer.
+ * @return `false` otherwise.
+ */
+bool Serial::isInputBytesExhausted(){
+    return this->isInputExhausted;
+}
+#endif
+
 /**
  * @brief Closes the serial communication port.
  *
@@ -1211,6 +1822,7 @@ void Serial::closePort(){
     if (this->usb == nullptr){
         if (this->fd > 0) close(this->fd);
         this->fd = -1;
+        this->setupIOBackend();
     }
     else {
         this->usb->closeDevice();
@@ -23,6 +23,7 @@
 
 #include <iostream>
 #include <string.h>
+#include <time.h>
 #include "serialink.hpp"
 
 /**
@@ -34,6 +35,11 @@ Serialink::Serialink(){
     this->usb = nullptr;
     this->isFormatValid = true;
     this->frameFormat = nullptr;
+    this->formatIndex = 0;
+    this->formatGeneration = 0;
+    this->isFrameReceived = false;
+    this->resyncSize = 0;
+    this->resetResyncStats();
 }
 
 /**
@@ -51,6 +57,11 @@ Serialink::Serialink(USBSerial *usb){
 #endif
     this->isFormatValid = true;
     this->frameFormat = nullptr;
+    this->formatIndex = 0;
+    this->formatGeneration = 0;
+    this->isFrameReceived = false;
+    this->resyncSize = 0;
+    this->resetResyncStats();
 }
 
 /**
@@ -59,16 +70,18 @@ Serialink::Serialink(USBSerial *usb){
  * Releases any allocated memory.
  */
 Serialink::~Serialink(){
-    if (this->frameFormat != nullptr){
-        delete this->frameFormat;
-        this->frameFormat = nullptr;
+    for (auto &format : this->formats){
+        delete format.frame;
     }
+    this->formats.clear();
+    this->frameFormat = nullptr;
 }
 
 /**
  * @brief Retrieves the memory address of the frame format.
  *
- * This function returns the address of the `frameFormat` data member.
+ * This function returns the address of the `frameFormat` data member. If several frame formats are set up (see `Serialink::addFormat`),
+ * this is the format of the last frame that has been read (the first format until then).
  *
  * @return The memory address of the `frameFormat`.
  */
@@ -76,6 +89,278 @@ DataFrame *Serialink::getFormat(){
     return this->frameFormat;
 }
 
+/**
+ * @brief Overloaded method of __getFormat__.
+ *
+ * @param index The index of the frame format (`0` for the format set with the assignment operator).
+ * @return The memory address of the frame format (or `nullptr` if the index is out of range).
+ */
+DataFrame *Serialink::getFormat(size_t index){
+    if (index >= this->formats.size()) return nullptr;
+    return this->formats[index].frame;
+}
+
+/**
+ * @brief Adds an alternative frame format.
+ *
+ * This function is used when a port carries several protocols. The new format and the format set with the assignment operator
+ * must begin with start bytes. `readFramedData` then searches the start bytes of all formats in one pass and reads the rest of
+ * the frame with the format whose start bytes are found first in the stream. If several formats have the same start bytes, the
+ * one with the lowest index is used.
+ *
+ * @param obj The first frame of the frame format.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up (the assignment operator must be used first).
+ * @return 4 if one of the formats does not begin with start bytes.
+ */
+int Serialink::addFormat(const DataFrame &obj){
+    SerialinkFormat format;
+    DataFrame &ncObj = const_cast<DataFrame&>(obj);
+    std::vector <unsigned char> ref;
+    if (this->formats.empty()) return 3;
+    if (ncObj.getType() != DataFrame::FRAME_TYPE_START_BYTES ||
+        ncObj.getReference(ref) == 0 ||
+        this->formats.front().fieldTable.front().kind != SERIALINK_FIELD_START_BYTES
+    ){
+        return 4;
+    }
+    format.frame = Serialink::createFormat(obj);
+    this->formats.push_back(format);
+    this->compileFormat();
+    return 0;
+}
+
+/**
+ * @brief Binds the size of a frame to the value of another frame.
+ *
+ * This function replaces a post-execution function that calls `DataFrame::setSize`. When the source frame has been
+ * received, its first `width` bytes are decoded as an unsigned integer (`value`) and the size of the target frame is set to
+ * `value * scale + offset`. The rest of the frame (until a frame of unknown size) is then received with one read. A
+ * value that gives a negative size or a size larger than the receive buffer makes the frame invalid. A size of 0 gives
+ * an empty target frame.
+ *
+ * Both frames must belong to the same frame format (see `Serialink::getFormat`), and the source frame must have a fixed size and
+ * come before the target frame. The bindings are removed when the frame format is replaced with the assignment operator.
+ *
+ * @param target The frame whose size is set.
+ * @param source The frame that holds the length.
+ * @param width The number of bytes of the length (1 to 8, not larger than the size of the source frame).
+ * @param endian The byte order of the length.
+ * @param offset The value added to the scaled length.
+ * @param scale The multiplier of the length.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the binding is invalid.
+ */
+int Serialink::bindLength(DataFrame *target, DataFrame *source, size_t width, SERIALINK_ENDIAN endian, long long offset, unsigned long long scale){
+    SerialinkLength binding;
+    binding.source = source;
+    binding.target = target;
+    binding.width = width;
+    binding.endian = endian;
+    binding.offset = offset;
+    binding.scale = scale;
+    return this->addLengthBinding(binding);
+}
+
+/**
+ * @brief Overloaded method of __bindLength__ with frame types.
+ *
+ * The frames are the first frames of the specific types in the frame format returned by `Serialink::getFormat`.
+ *
+ * @param target The type of the frame whose size is set.
+ * @param source The type of the frame that holds the length.
+ * @param width The number of bytes of the length (1 to 8, not larger than the size of the source frame).
+ * @param endian The byte order of the length.
+ * @param offset The value added to the scaled length.
+ * @param scale The multiplier of the length.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the binding is invalid.
+ */
+int Serialink::bindLength(DataFrame::FRAME_TYPE_t target, DataFrame::FRAME_TYPE_t source, size_t width, SERIALINK_ENDIAN endian, long long offset, unsigned long long scale){
+    if (this->frameFormat == nullptr) return 3;
+    return this->bindLength((*this)[target], (*this)[source], width, endian, offset, scale);
+}
+
+/**
+ * @brief Binds the size of a frame to a lookup table.
+ *
+ * The first `width` bytes of the source frame (for example a command) are decoded as an unsigned integer and the size of the target
+ * frame is taken from the table. A value that is not in the table makes the frame invalid.
+ *
+ * @param target The frame whose size is set.
+ * @param source The frame that holds the key.
+ * @param table The size of the target frame for each key.
+ * @param width The number of bytes of the key (1 to 8, not larger than the size of the source frame).
+ * @param endian The byte order of the key.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the binding is invalid.
+ */
+int Serialink::bindLength(DataFrame *target, DataFrame *source, const std::map <unsigned long long, size_t> &table, size_t width, SERIALINK_ENDIAN endian){
+    SerialinkLength binding;
+    if (table.empty()) return 4;
+    binding.source = source;
+    binding.target = target;
+    binding.width = width;
+    binding.endian = endian;
+    binding.offset = 0;
+    binding.scale = 1;
+    binding.table = table;
+    return this->addLengthBinding(binding);
+}
+
+/**
+ * @brief Overloaded method of __bindLength__ with frame types and a lookup table.
+ *
+ * @param target The type of the frame whose size is set.
+ * @param source The type of the frame that holds the key.
+ * @param table The size of the target frame for each key.
+ * @param width The number of bytes of the key (1 to 8, not larger than the size of the source frame).
+ * @param endian The byte order of the key.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the binding is invalid.
+ */
+int Serialink::bindLength(DataFrame::FRAME_TYPE_t target, DataFrame::FRAME_TYPE_t source, const std::map <unsigned long long, size_t> &table, size_t width, SERIALINK_ENDIAN endian){
+    if (this->frameFormat == nullptr) return 3;
+    return this->bindLength((*this)[target], (*this)[source], table, width, endian);
+}
+
+/**
+ * @brief Sets up the checksum of a validator frame.
+ *
+ * This function replaces a post-execution function that calculates a checksum. The checksum of the received bytes from the begin frame
+ * to the end frame (inclusive) is updated with `Checksum` as each frame is received, and compared with the validator bytes when the validator
+ * frame has been received, so the frame data is not read again. A different checksum makes the frame invalid (`readFramedData` returns 4).
+ * `writeFramedData` fills the validator frame with the checksum of the frame data.
+ *
+ * All frames must belong to the same frame format (see `Serialink::getFormat`), the begin frame must not come after the end frame,
+ * the end frame must come before the validator frame, and the size of the validator frame must be the size of the checksum.
+ * The setup is removed when the frame format is replaced with the assignment operator.
+ *
+ * @param validator The validator frame.
+ * @param type The checksum algorithm.
+ * @param begin The first frame of the checked data.
+ * @param end The last frame of the checked data.
+ * @param endian The byte order of the checksum in the validator frame.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the setup is invalid.
+ */
+int Serialink::setChecksum(DataFrame *validator, CHECKSUM_TYPE type, DataFrame *begin, DataFrame *end, SERIALINK_ENDIAN endian){
+    SerialinkChecksum checksum;
+    size_t validatorIdx = 0;
+    size_t beginIdx = 0;
+    size_t endIdx = 0;
+    bool isValidatorFound = false;
+    bool isBeginFound = false;
+    bool isEndFound = false;
+    if (this->formats.empty()) return 3;
+    if (validator == nullptr || begin == nullptr || end == nullptr) return 4;
+    if (Checksum::getSize(type) == 0 || validator->getSize() != Checksum::getSize(type)) return 4;
+    /* the format may have been extended through getFormat() */
+    this->compileFormat();
+    for (auto &format : this->formats){
+        isValidatorFound = false;
+        isBeginFound = false;
+        isEndFound = false;
+        for (size_t i = 0; i < format.fieldTable.size(); i++){
+            if (format.fieldTable[i].frame == validator){
+                validatorIdx = i;
+                isValidatorFound = true;
+            }
+            if (format.fieldTable[i].frame == begin){
+                beginIdx = i;
+                isBeginFound = true;
+            }
+            if (format.fieldTable[i].frame == end){
+                endIdx = i;
+                isEndFound = true;
+            }
+        }
+        if (isValidatorFound == false && isBeginFound == false && isEndFound == false) continue;
+        if (isValidatorFound == false || isBeginFound == false || isEndFound == false) return 4;
+        if (beginIdx > endIdx || endIdx >= validatorIdx || format.fieldTable[validatorIdx].kind != SERIALINK_FIELD_CONTENT) return 4;
+        for (auto item = format.checksums.begin(); item != format.checksums.end(); ++item){
+            if (item->validator == validator){
+                format.checksums.erase(item);
+                break;
+            }
+        }
+        checksum.validator = validator;
+        checksum.begin = begin;
+        checksum.end = end;
+        checksum.type = type;
+        checksum.endian = endian;
+        checksum.beginField = beginIdx;
+        checksum.endField = endIdx;
+        checksum.state = Checksum::init(type);
+        format.checksums.push_back(checksum);
+        this->compileFormat();
+        return 0;
+    }
+    return 4;
+}
+
+/**
+ * @brief Overloaded method of __setChecksum__ with frame types.
+ *
+ * The validator frame is the first `DataFrame::FRAME_TYPE_VALIDATOR` frame, and the begin and end frames are the first frames of
+ * the specific types in the frame format returned by `Serialink::getFormat`.
+ *
+ * @param type The checksum algorithm.
+ * @param begin The type of the first frame of the checked data.
+ * @param end The type of the last frame of the checked data.
+ * @param endian The byte order of the checksum in the validator frame.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the setup is invalid.
+ */
+int Serialink::setChecksum(CHECKSUM_TYPE type, DataFrame::FRAME_TYPE_t begin, DataFrame::FRAME_TYPE_t end, SERIALINK_ENDIAN endian){
+    if (this->frameFormat == nullptr) return 3;
+    return this->setChecksum((*this)[DataFrame::FRAME_TYPE_VALIDATOR], type, (*this)[begin], (*this)[end], endian);
+}
+
+/**
+ * @brief Gets the number of frame formats.
+ *
+ * @return The number of frame formats.
+ */
+size_t Serialink::getFormatCount(){
+    return this->formats.size();
+}
+
+/**
+ * @brief Gets the index of the frame format of the last frame that has been read.
+ *
+ * @return The index of the frame format (see `Serialink::getFormat(size_t)`).
+ */
+size_t Serialink::getFormatIndex(){
+    return this->formatIndex;
+}
+
+/**
+ * @brief Gets the resynchronisation counters.
+ *
+ * The counters are updated by `Serialink::readFramedData` when a frame is rejected (return code 4) or is not completed
+ * before the timeout. The next read restarts at the next start bytes found in the rejected bytes, so a valid frame that
+ * begins inside a damaged frame is not lost.
+ *
+ * @return The resynchronisation counters.
+ */
+SerialinkResyncStats Serialink::getResyncStats(){
+    return this->resyncStats;
+}
+
+/**
+ * @brief Resets the resynchronisation counters.
+ */
+void Serialink::resetResyncStats(){
+    memset(&(this->resyncStats), 0x00, sizeof(this->resyncStats));
+}
+
 /**
  * @brief Stops reading framed serial data.
  *
@@ -87,11 +372,356 @@ void Serialink::trigInvDataIndicator(){
     this->isFormatValid = false;
 }
 
+/**
+ * @brief Compiles all frame formats of this object into their field tables.
+ *
+ * The length bindings and the checksums of each format are attached to their fields. If there are several frame formats,
+ * the start bytes of all of them are also collected into `startBytesSet`.
+ */
+void Serialink::compileFormat(){
+    this->startBytesSet.clear();
+    this->isFrameReceived = false;
+    for (auto &format : this->formats){
+        Serialink::compileFormat(format.frame, format.fieldTable, format.fieldReferences);
+        /* the fields of each frame type, in order of occurrence, so operator[] does not walk the frame format */
+        format.typeIndex.clear();
+        for (size_t i = 0; i < format.fieldTable.size(); i++){
+            size_t type = static_cast<size_t>(format.fieldTable[i].frame->getType());
+            if (type >= format.typeIndex.size()) format.typeIndex.resize(type + 1);
+            format.typeIndex[type].push_back(i);
+        }
+        for (size_t i = 0; i < format.lengths.size(); i++){
+            for (auto &field : format.fieldTable){
+                if (field.frame == format.lengths[i].source && field.lengthBinding == 0) field.lengthBinding = i + 1;
+                if (field.frame == format.lengths[i].target) field.isLengthTarget = true;
+            }
+        }
+        for (size_t i = 0; i < format.checksums.size(); i++){
+            for (size_t j = 0; j < format.fieldTable.size(); j++){
+                if (format.fieldTable[j].frame == format.checksums[i].begin) format.checksums[i].beginField = j;
+                if (format.fieldTable[j].frame == format.checksums[i].end) format.checksums[i].endField = j;
+                if (format.fieldTable[j].frame == format.checksums[i].validator) format.fieldTable[j].checksumBinding = i + 1;
+            }
+        }
+        if (this->formats.size() > 1){
+            this->startBytesSet.add(format.fieldReferences.data() + format.fieldTable.front().referenceOffset, format.fieldTable.front().referenceSize);
+        }
+    }
+}
+
+/**
+ * @brief Gets the compiled frame format that is used by `frameFormat`.
+ *
+ * The format is compiled again first if it has been extended through `getFormat()`.
+ *
+ * @return The frame format (or `nullptr` if the frame format is not set up).
+ */
+SerialinkFormat *Serialink::getCurrentFormat(){
+    if (this->formats.empty()) return nullptr;
+    SerialinkFormat *format = &(this->formats[this->formatIndex]);
+    if (format->fieldTable.empty() || format->fieldTable.back().frame->getNext() != nullptr){
+        /* the format has been extended through getFormat() */
+        this->compileFormat();
+    }
+    return format;
+}
+
+/**
+ * @brief Creates a copy of a frame format.
+ *
+ * @param obj The first frame of the frame format.
+ * @return The first frame of the copy.
+ */
+DataFrame *Serialink::createFormat(const DataFrame &obj){
+    DataFrame &ncObj = const_cast<DataFrame&>(obj);
+    std::vector <unsigned char> ref;
+    ncObj.getReference(ref);
+    DataFrame *format = new DataFrame(
+     static_cast<DataFrame::FRAME_TYPE_t>(ncObj.getType()),
+      ncObj.getSize(),
+      ref.data(),
+      ncObj.getExecuteFunction(),
+      ncObj.getExecuteFunctionParam(),
+      ncObj.getPostExecuteFunction(),
+      ncObj.getPostExecuteFunctionParam()
+    );
+    if (format != nullptr){
+        if (ncObj.getNext() != nullptr)
+            *format += *(ncObj.getNext());
+    }
+    return format;
+}
+
+/**
+ * @brief Compiles a frame format into a field table.
+ *
+ * This function walks the `format` list once and stores, for each frame, the field kind (start bytes, stop bytes,
+ * content or invalid), the location of its reference bytes in `fieldReferences` and whether the next frame is a stop bytes
+ * frame. The type and the reference bytes of a `DataFrame` cannot change after it is created, so the parser does not
+ * need to inspect them again. The field size and the callbacks are still read from the frame while parsing, because they
+ * can be changed by the callbacks (for example a length field that sets the size of the data field).
+ *
+ * @param format The first frame of the frame format.
+ * @param[out] fieldTable The compiled field table.
+ * @param[out] fieldReferences The reference bytes of all fields.
+ */
+void Serialink::compileFormat(DataFrame *format, std::vector <SerialinkField> &fieldTable, std::vector <unsigned char> &fieldReferences){
+    DataFrame *tmp = format;
+    SerialinkField field;
+    std::vector <unsigned char> ref;
+    fieldTable.clear();
+    fieldReferences.clear();
+    while (tmp != nullptr){
+        field.frame = tmp;
+        field.kind = SERIALINK_FIELD_INVALID;
+        field.referenceOffset = fieldReferences.size();
+        field.referenceSize = 0;
+        if (tmp->getReference(ref) > 0) field.referenceSize = ref.size();
+        field.isStopBytesNext = false;
+        field.lengthBinding = 0;
+        field.isLengthTarget = false;
+        field.checksumBinding = 0;
+        field.bufferOffset = 0;
+        field.bufferSize = 0;
+        switch (tmp->getType()){
+            case DataFrame::FRAME_TYPE_START_BYTES:
+                if (field.referenceSize > 0) field.kind = SERIALINK_FIELD_START_BYTES;
+                break;
+            case DataFrame::FRAME_TYPE_STOP_BYTES:
+                if (field.referenceSize > 0) field.kind = SERIALINK_FIELD_STOP_BYTES;
+                break;
+            case DataFrame::FRAME_TYPE_CONTENT_LENGTH:
+            case DataFrame::FRAME_TYPE_COMMAND:
+            case DataFrame::FRAME_TYPE_SN:
+            case DataFrame::FRAME_TYPE_RFU:
+            case DataFrame::FRAME_TYPE_BLOCK_NUMBER:
+            case DataFrame::FRAME_TYPE_DATA:
+            case DataFrame::FRAME_TYPE_DATA_1:
+            case DataFrame::FRAME_TYPE_DATA_2:
+            case DataFrame::FRAME_TYPE_DATA_3:
+            case DataFrame::FRAME_TYPE_DATA_4:
+            case DataFrame::FRAME_TYPE_DATA_5:
+            case DataFrame::FRAME_TYPE_DATA_6:
+            case DataFrame::FRAME_TYPE_DATA_7:
+            case DataFrame::FRAME_TYPE_DATA_8:
+            case DataFrame::FRAME_TYPE_DATA_9:
+            case DataFrame::FRAME_TYPE_VALIDATOR:
+                field.kind = SERIALINK_FIELD_CONTENT;
+                break;
+            default:
+                break;
+        }
+        if (field.referenceSize > 0){
+            fieldReferences.insert(fieldReferences.end(), ref.begin(), ref.end());
+        }
+        if (fieldTable.empty() == false && field.kind == SERIALINK_FIELD_STOP_BYTES){
+            fieldTable.back().isStopBytesNext = true;
+        }
+        fieldTable.push_back(field);
+        tmp = tmp->getNext();
+    }
+}
+
+/**
+ * @brief Stores a length binding in the frame format that contains both frames.
+ *
+ * @param binding The length binding.
+ * @return 0 on success.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if the binding is invalid.
+ */
+int Serialink::addLengthBinding(const SerialinkLength &binding){
+    size_t sourceIdx = 0;
+    size_t targetIdx = 0;
+    bool isSourceFound = false;
+    bool isTargetFound = false;
+    if (this->formats.empty()) return 3;
+    if (binding.source == nullptr || binding.target == nullptr || binding.source == binding.target) return 4;
+    if (binding.width == 0 || binding.width > 8 || binding.width > binding.source->getSize()) return 4;
+    /* the format may have been extended through getFormat() */
+    this->compileFormat();
+    for (auto &format : this->formats){
+        isSourceFound = false;
+        isTargetFound = false;
+        for (size_t i = 0; i < format.fieldTable.size(); i++){
+            if (format.fieldTable[i].frame == binding.source){
+                sourceIdx = i;
+                isSourceFound = true;
+            }
+            else if (format.fieldTable[i].frame == binding.target){
+                targetIdx = i;
+                isTargetFound = true;
+            }
+        }
+        if (isSourceFound == false && isTargetFound == false) continue;
+        if (isSourceFound == false || isTargetFound == false || sourceIdx > targetIdx) return 4;
+        if (format.fieldTable[sourceIdx].kind != SERIALINK_FIELD_CONTENT || format.fieldTable[targetIdx].kind != SERIALINK_FIELD_CONTENT) return 4;
+        for (auto item = format.lengths.begin(); item != format.lengths.end(); ++item){
+            if (item->target == binding.target){
+                format.lengths.erase(item);
+                break;
+            }
+        }
+        format.lengths.push_back(binding);
+        this->compileFormat();
+        return 0;
+    }
+    return 4;
+}
+
+/**
+ * @brief Sets the size of the target frame of a length binding.
+ *
+ * @param binding The length binding.
+ * @param data The received bytes of the source frame.
+ * @return `true` if the size has been set.
+ * @return `false` if the value is not valid (not found in the lookup table or out of range).
+ */
+bool Serialink::applyLengthBinding(const SerialinkLength &binding, const unsigned char *data){
+    unsigned long long value = 0;
+    long long length = 0;
+    for (size_t i = 0; i < binding.width; i++){
+        if (binding.endian == SERIALINK_ENDIAN_BIG){
+            value = (value << 8) | data[i];
+        }
+        else {
+            value |= static_cast<unsigned long long>(data[i]) << (8 * i);
+        }
+    }
+    if (binding.table.empty() == false){
+        auto item = binding.table.find(value);
+        if (item == binding.table.end()) return false;
+        binding.target->setSize(item->second);
+        return true;
+    }
+    if (binding.scale > 0 && value > static_cast<unsigned long long>(this->rxBuffer.getCapacity()) / binding.scale) return false;
+    length = static_cast<long long>(value * binding.scale) + binding.offset;
+    if (length < 0 || static_cast<unsigned long long>(length) > static_cast<unsigned long long>(this->rxBuffer.getCapacity())) return false;
+    binding.target->setSize(static_cast<size_t>(length));
+    return true;
+}
+
+/**
+ * @brief Gets the number of bytes that can be read at once after a field.
+ *
+ * The sizes of the following fields are summed until a field with an unknown size (data read until the stop bytes, start
+ * bytes) or a field with an execute function (which may change its own size). A field with a post-execution function
+ * is the last one that is summed, because the function may change the size of the next fields.
+ *
+ * @param format The frame format.
+ * @param idx The index of the last field that has been read.
+ * @return The number of bytes of the following fields.
+ */
+size_t Serialink::getKnownSize(const SerialinkFormat &format, size_t idx){
+    size_t total = 0;
+    const SerialinkField *field = nullptr;
+    for (size_t i = idx + 1; i < format.fieldTable.size(); i++){
+        field = &(format.fieldTable[i]);
+        if (field->frame->getExecuteFunction() != nullptr) break;
+        if (field->kind == SERIALINK_FIELD_STOP_BYTES){
+            total += field->referenceSize;
+        }
+        else if (field->kind == SERIALINK_FIELD_CONTENT && (field->frame->getSize() > 0 || field->isLengthTarget)){
+            total += field->frame->getSize();
+        }
+        else {
+            break;
+        }
+        if (field->frame->getPostExecuteFunction() != nullptr || field->lengthBinding > 0) break;
+    }
+    return total;
+}
+
+/**
+ * @brief Updates the running checksums of a frame format with the received bytes of a field.
+ *
+ * The running checksum is restarted at its begin field and updated until its end field. At the validator field, the result is compared
+ * with the received checksum, so the frame data is not read again.
+ *
+ * @param format The frame format.
+ * @param idx The index of the field.
+ * @param data The received bytes of the field.
+ * @param sz The number of received bytes.
+ * @return `true` if the field is not a validator or the checksum is valid.
+ * @return `false` if the checksum is not valid.
+ */
+bool Serialink::updateChecksums(SerialinkFormat &format, size_t idx, const unsigned char *data, size_t sz){
+    unsigned char expected[4];
+    size_t width = 0;
+    for (auto &checksum : format.checksums){
+        if (idx == checksum.beginField) checksum.state = Checksum::init(checksum.type);
+        if (idx >= checksum.beginField && idx <= checksum.endField){
+            checksum.state = Checksum::update(checksum.type, checksum.state, data, sz);
+        }
+    }
+    if (format.fieldTable[idx].checksumBinding == 0) return true;
+    const SerialinkChecksum &checksum = format.checksums[format.fieldTable[idx].checksumBinding - 1];
+    width = Serialink::encodeChecksum(checksum, Checksum::finish(checksum.type, checksum.state), expected);
+    if (sz != width) return true;
+    return memcmp(expected, data, width) == 0;
+}
+
+/**
+ * @brief Converts a checksum into the bytes of a validator frame.
+ *
+ * @param checksum The checksum setup.
+ * @param value The checksum.
+ * @param[out] buffer The checksum bytes (at least 4 bytes).
+ * @return The number of checksum bytes.
+ */
+size_t Serialink::encodeChecksum(const SerialinkChecksum &checksum, unsigned int value, unsigned char *buffer){
+    size_t sz = Checksum::getSize(checksum.type);
+    for (size_t i = 0; i < sz; i++){
+        if (checksum.endian == SERIALINK_ENDIAN_BIG){
+            buffer[i] = static_cast<unsigned char>(value >> (8 * (sz - 1 - i)));
+        }
+        else {
+            buffer[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+    return sz;
+}
+
+/**
+ * @brief Finds the next start bytes candidate in the receive buffer after a rejected frame.
+ *
+ * The received bytes from `begin` are searched once for the start bytes of the frame formats. If no start bytes are found,
+ * the last bytes that may be the beginning of the start bytes are kept.
+ *
+ * @param begin The offset (from the oldest buffered byte) where the search begins.
+ * @param[out] isFound `true` if the start bytes are found.
+ * @return The offset of the next candidate (the bytes before it can be discarded).
+ */
+size_t Serialink::findResyncOffset(size_t begin, bool &isFound){
+    const unsigned char *buffer = this->rxBuffer.getData();
+    size_t available = this->rxBuffer.getSize();
+    size_t position = 0;
+    size_t index = 0;
+    size_t checked = 0;
+    isFound = false;
+    if (begin >= available) return available;
+    if (this->formats.size() > 1){
+        isFound = this->startBytesSet.find(buffer + begin, available - begin, position, index, checked);
+        return begin + (isFound ? position : checked);
+    }
+    const SerialinkField &field = this->formats[this->formatIndex].fieldTable[0];
+    if (field.kind != SERIALINK_FIELD_START_BYTES) return begin;
+    const unsigned char *reference = this->formats[this->formatIndex].fieldReferences.data() + field.referenceOffset;
+    isFound = ByteSearch::find(buffer + begin, available - begin, reference, field.referenceSize, position);
+    if (isFound) return begin + position;
+    /* the last bytes may be the beginning of the start bytes */
+    if (available - begin < field.referenceSize) return begin;
+    return available - field.referenceSize + 1;
+}
+
 /**
  * @brief Performs serial data read operations with a custom frame format.
  *
  * This function executes serial data reading operations using a specific frame format.
- * The read serial data can be retrieved using the `__Serial::getBuffer__` method.
+ * The read serial data can be retrieved using the `__Serial::getBuffer__` method. If several frame formats
+ * are set up, the format is selected by the start bytes that are found first (see `Serialink::addFormat`).
+ * After an invalid or incomplete frame, the next read continues from the next start bytes found after the first
+ * byte of that frame (see `Serialink::getResyncStats`).
  *
  * @return 0 on success.
  * @return 1 if the port is not open.
@@ -100,83 +730,148 @@ void Serialink::trigInvDataIndicator(){
  * @return 4 if the frame data format is invalid.
  */
 int Serialink::readFramedData(){
-    if (this->frameFormat == nullptr) return 3;
-    DataFrame *tmp = this->frameFormat;
-    std::vector <unsigned char> vecUC;
+    if (this->formats.empty()) return 3;
+    for (auto &format : this->formats){
+        if (format.fieldTable.empty() || format.fieldTable.back().frame->getNext() != nullptr){
+            /* the format has been extended through getFormat() */
+            this->compileFormat();
+            break;
+        }
+    }
+    DataFrame *tmp = nullptr;
+    const SerialinkField *field = nullptr;
+    const unsigned char *reference = nullptr;
+    SerialinkFormat *format = &(this->formats[this->formats.size() > 1 ? 0 : this->formatIndex]);
+    size_t idx = 0;
+    size_t fieldCount = format->fieldTable.size();
     int ret = 0;
+    size_t frameOffset = 0;
+    size_t frameSize = 0;
+    size_t knownSize = 0;
+    size_t resyncOffset = 0;
+    bool isFrameStarted = false;
+    bool isFound = false;
     void (*callback)(DataFrame &, void *) = nullptr;
     this->isFormatValid = true;
-    while (tmp != nullptr){
-        if (tmp->getExecuteFunction() != nullptr){
+    this->isFrameReceived = false;
+    this->retainData = false;
+    this->isInputExhausted = false;
+    if (this->isResyncPending){
+        /* the previous frame has been rejected, skip straight to the next start bytes candidate */
+        this->dataSize = this->resyncSize;
+    }
+    this->resyncSize = 0;
+    this->releaseData();
+    while (idx < fieldCount){
+        field = &(format->fieldTable[idx]);
+        tmp = field->frame;
+        if (idx == 0 && this->formats.size() > 1){
+            /* several protocols on the same port, the format is selected by the start bytes found first */
+            if (this->readStartBytes(this->startBytesSet, this->formatIndex)){
+                ret = 2;
+                break;
+            }
+            format = &(this->formats[this->formatIndex]);
+            fieldCount = format->fieldTable.size();
+            field = &(format->fieldTable[idx]);
+            tmp = field->frame;
+            this->frameFormat = tmp;
+            if (tmp->getExecuteFunction() != nullptr){
+                callback = (void (*)(DataFrame &, void *))tmp->getExecuteFunction();
+                callback(*tmp, tmp->getExecuteFunctionParam());
+            }
+        }
+        else if (tmp->getExecuteFunction() != nullptr){
             callback = (void (*)(DataFrame &, void *))tmp->getExecuteFunction();
             callback(*tmp, tmp->getExecuteFunctionParam());
         }
-        if (tmp->getType() == DataFrame::FRAME_TYPE_START_BYTES && tmp->getReference(vecUC) > 0){
-            if (this->readStartBytes(vecUC.data(), vecUC.size())){
+        reference = format->fieldReferences.data() + field->referenceOffset;
+        if (field->kind == SERIALINK_FIELD_START_BYTES){
+            /* with several formats, the first start bytes have already been read */
+            if ((idx > 0 || this->formats.size() == 1) && this->readStartBytes(reference, field->referenceSize)){
                 ret = 2;
                 break;
             }
+            format->fieldTable[idx].bufferOffset = this->dataOffset;
+            format->fieldTable[idx].bufferSize = this->dataSize;
+            Serialink::updateChecksums(*format, idx, this->rxBuffer.getData() + this->dataOffset, this->dataSize);
         }
-        else if (tmp->getType() == DataFrame::FRAME_TYPE_STOP_BYTES && tmp->getReference(vecUC) > 0){
-            if (this->readStopBytes(vecUC.data(), vecUC.size())){
+        else if (field->kind == SERIALINK_FIELD_STOP_BYTES){
+            if (this->readStopBytes(reference, field->referenceSize)){
                 ret = 2;
                 break;
             }
+            format->fieldTable[idx].bufferOffset = this->dataOffset;
+            format->fieldTable[idx].bufferSize = this->dataSize;
+            Serialink::updateChecksums(*format, idx, this->rxBuffer.getData() + this->dataOffset, this->dataSize);
         }
-        else if (tmp->getType() == DataFrame::FRAME_TYPE_CONTENT_LENGTH ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_COMMAND ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_SN ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_RFU ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_BLOCK_NUMBER ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_DATA ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_DATA_1 ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_DATA_2 ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_DATA_3 ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_DATA_4 ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_DATA_5 ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_DATA_6 ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_DATA_7 ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_DATA_8 ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_DATA_9 ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_VALIDATOR
-        ){
+        else if (field->kind == SERIALINK_FIELD_CONTENT){
             if (tmp->getSize() > 0){
                 if (this->readNBytes(tmp->getSize()) == 0){
-                    if (this->getBuffer(vecUC) > 0){
-                        tmp->setData(vecUC);
+                    if (this->dataSize > 0){
+                        tmp->setData(this->rxBuffer.getData() + this->dataOffset, this->dataSize);
                     }
                     else {
                         ret = 2;
                         break;
                     }
                 }
-            }
-            else if (tmp->getNext() != nullptr) {
-                if (tmp->getNext()->getType() == DataFrame::FRAME_TYPE_STOP_BYTES &&
-                    tmp->getNext()->getReference(vecUC) > 0
-                ){
-                    if (this->readUntilStopBytes(vecUC.data(), vecUC.size()) == 0){
-                        if (this->getBuffer(vecUC) > 0){
-                            size_t sz = vecUC.size() - tmp->getNext()->getSize();
-                            tmp->setData(vecUC.data(), sz);
-                            if (tmp->getPostExecuteFunction() != nullptr){
-                                callback = (void (*)(DataFrame &, void *))tmp->getPostExecuteFunction();
-                                callback(*tmp, tmp->getPostExecuteFunctionParam());
-                            }
-                            tmp = tmp->getNext();
-                            if (tmp->getExecuteFunction() != nullptr){
-                                callback = (void (*)(DataFrame &, void *))tmp->getExecuteFunction();
-                                callback(*tmp, tmp->getExecuteFunctionParam());
-                            }
+                else if (this->isPollMode){
+                    ret = 2;
+                    break;
+                }
+                format->fieldTable[idx].bufferOffset = this->dataOffset;
+                format->fieldTable[idx].bufferSize = this->dataSize;
+                if (Serialink::updateChecksums(*format, idx, this->rxBuffer.getData() + this->dataOffset, this->dataSize) == false){
+                    ret = 4;
+                    break;
+                }
+                if (field->lengthBinding > 0 && this->dataSize == tmp->getSize()){
+                    /* the length of the next fields is declared by this field */
+                    for (size_t i = field->lengthBinding - 1; i < format->lengths.size(); i++){
+                        if (format->lengths[i].source == tmp &&
+                            this->applyLengthBinding(format->lengths[i], this->rxBuffer.getData() + this->dataOffset) == false
+                        ){
+                            ret = 4;
+                            break;
                         }
                     }
-                    else {
-                        ret = 2;
-                        break;
+                    if (ret != 0) break;
+                }
+            }
+            else if (field->isLengthTarget){
+                /* the declared length is zero */
+                tmp->setData(this->rxBuffer.getData() + this->dataOffset, 0);
+                format->fieldTable[idx].bufferOffset = this->dataOffset;
+                format->fieldTable[idx].bufferSize = 0;
+            }
+            else if (field->isStopBytesNext){
+                field = &(format->fieldTable[idx + 1]);
+                reference = format->fieldReferences.data() + field->referenceOffset;
+                if (this->readUntilStopBytes(reference, field->referenceSize) == 0){
+                    if (this->dataSize > 0){
+                        size_t sz = this->dataSize - field->referenceSize;
+                        tmp->setData(this->rxBuffer.getData() + this->dataOffset, sz);
+                        format->fieldTable[idx].bufferOffset = this->dataOffset;
+                        format->fieldTable[idx].bufferSize = sz;
+                        format->fieldTable[idx + 1].bufferOffset = this->dataOffset + sz;
+                        format->fieldTable[idx + 1].bufferSize = field->referenceSize;
+                        Serialink::updateChecksums(*format, idx, this->rxBuffer.getData() + this->dataOffset, sz);
+                        Serialink::updateChecksums(*format, idx + 1, this->rxBuffer.getData() + this->dataOffset + sz, field->referenceSize);
+                        if (tmp->getPostExecuteFunction() != nullptr){
+                            callback = (void (*)(DataFrame &, void *))tmp->getPostExecuteFunction();
+                            callback(*tmp, tmp->getPostExecuteFunctionParam());
+                        }
+                        idx++;
+                        tmp = field->frame;
+                        if (tmp->getExecuteFunction() != nullptr){
+                            callback = (void (*)(DataFrame &, void *))tmp->getExecuteFunction();
+                            callback(*tmp, tmp->getExecuteFunctionParam());
+                        }
                     }
                 }
                 else {
-                    ret = 4;
+                    ret = 2;
                     break;
                 }
             }
@@ -197,46 +892,169 @@ int Serialink::readFramedData(){
             ret = 4;
             break;
         }
-        tmp = tmp->getNext();
-        this->data.clear();
+        if (this->retainData == false){
+            /* keep the received frame bytes in the receive buffer until the frame is complete */
+            frameOffset = this->dataOffset;
+            this->retainData = true;
+        }
+        this->releaseData();
+        knownSize = Serialink::getKnownSize(*format, idx);
+        if (knownSize > 0){
+            /* the size of the next fields is known, receive them with one read */
+            if (this->readNBytes(knownSize)){
+                /* the fields before the one that ran out of bytes have been received completely */
+                for (idx++; idx < fieldCount; idx++){
+                    field = &(format->fieldTable[idx]);
+                    knownSize = (field->kind == SERIALINK_FIELD_STOP_BYTES ? field->referenceSize : field->frame->getSize());
+                    if (this->dataSize < knownSize) break;
+                    this->dataOffset += knownSize;
+                    this->dataSize -= knownSize;
+                }
+                ret = 2;
+                break;
+            }
+            this->dataSize = 0;
+        }
+        idx++;
+    }
+    tmp = (idx < fieldCount ? format->fieldTable[idx].frame : nullptr);
+    isFrameStarted = this->retainData;
+    this->retainData = false;
+    if (ret != 0 && this->isInputExhausted){
+        /* the frame is not complete yet (SerialReactor), keep all received bytes for the next attempt */
+        this->dataOffset = 0;
+        this->dataSize = 0;
+        return 2;
+    }
+    if (ret == 4) this->resyncStats.invalidFrames++;
+    if (ret != 0 && isFrameStarted){
+        /* the received bytes are searched once, a valid frame may begin inside the rejected one */
+        if (ret != 4) this->resyncStats.incompleteFrames++;
+        resyncOffset = this->findResyncOffset(frameOffset + 1, isFound);
+        if (isFound) this->resyncStats.resyncs++;
+        this->resyncStats.discardedBytes += resyncOffset - frameOffset;
     }
     if (ret == 0){
-        this->frameFormat->getAllData(this->data);
+        frameSize = this->dataOffset - frameOffset;
+        /* the fields are located relative to the first frame byte, which is moved to the beginning of the receive buffer */
+        for (auto &item : format->fieldTable){
+            item.bufferOffset -= frameOffset;
+        }
+        this->isFrameReceived = true;
     }
-    else if (ret != 4 && this->frameFormat != tmp && tmp->getType() == DataFrame::FRAME_TYPE_STOP_BYTES){
-        DataFrame *fail = tmp;
-        std::vector <unsigned char> dataFail;
-        tmp = this->frameFormat;
-        while (tmp != fail && tmp != nullptr){
-            tmp->getData(vecUC);
-            if (vecUC.size() > 0) dataFail.insert(dataFail.end(), vecUC.begin(), vecUC.end());
-            tmp = tmp->getNext();
-        }
-        if (this->data.size() > 0) this->remainingData.insert(this->remainingData.begin(), this->data.begin(), this->data.end());
-        this->data.clear();
-        if (!dataFail.empty()){
-            if (dataFail.size() > 1) this->remainingData.insert(this->remainingData.begin(), dataFail.begin() + 1, dataFail.end());
-            if (dataFail.size() > 1) this->data.insert(this->data.begin(), dataFail.begin(), dataFail.begin() + 1);
+    else if (ret != 4 && idx > 0 && format->fieldTable[idx].kind == SERIALINK_FIELD_STOP_BYTES){
+        /* keep the bytes after the first frame byte as remaining data, so they can be checked as the next frame */
+        frameSize = this->dataOffset - frameOffset;
+        if (frameSize > 1){
+            frameSize = 1;
+        }
+        else {
+            frameOffset += frameSize;
+            frameSize = 0;
         }
     }
     else if (tmp != nullptr){
-        DataFrame *fail = tmp;
-        std::vector <unsigned char> dataFail;
-        tmp = this->frameFormat;
-        while (tmp != fail && tmp != nullptr){
-            tmp->getData(vecUC);
-            if (vecUC.size() > 0) dataFail.insert(dataFail.end(), vecUC.begin(), vecUC.end());
-            tmp = tmp->getNext();
-        }
-        if (dataFail.size() > 0) this->data.insert(this->data.begin(), dataFail.begin(), dataFail.end());
+        frameSize = this->dataOffset + this->dataSize - frameOffset;
     }
+    this->rxBuffer.consume(frameOffset);
+    this->dataOffset = 0;
+    this->dataSize = frameSize;
+    if (resyncOffset > 0){
+        this->resyncSize = resyncOffset - frameOffset;
+        this->isResyncPending = true;
+    }
+    return ret;
+}
+
+/**
+ * @brief Reads a burst of frames.
+ *
+ * The first frame is read as with `Serialink::readFramedData` (waiting for the data with the port timeout). The next
+ * frames are parsed only from the bytes that have already been received, so the burst ends without waiting for a timeout
+ * when the received bytes are exhausted. A frame that is not complete yet is kept for the next read, and invalid frames are
+ * skipped (see `Serialink::getResyncStats`).
+ *
+ * The frames are delivered into `arena`, which is cleared first but keeps its allocation, so a burst does not allocate once
+ * the arena has grown to the burst size. The bytes of the frames are stored one after another in `arena.data`. For each
+ * frame, `arena.frames` holds the index of its frame format, its location in `arena.data` and the range of its fields in
+ * `arena.fields`, which holds the location of each field in `arena.data`.
+ *
+ * @param max The maximum number of frames.
+ * @param deadlineMs The maximum time for the burst in milliseconds (0 for no limit). It limits the wait for the first frame and
+ *        it is checked after each frame.
+ * @param[out] arena The received frames.
+ * @return 0 if at least one frame is received.
+ * @return 1 if the port is not open.
+ * @return 2 if a timeout occurs before the first frame.
+ * @return 3 if the frame format is not set up.
+ * @return 4 if only invalid frames are received (or `max` is 0).
+ */
+int Serialink::readFrames(size_t max, unsigned int deadlineMs, SerialinkFrameArena &arena){
+    struct timespec tsStart;
+    struct timespec tsNow;
+    SerialinkFrameDescriptor frame;
+    SerialinkFieldDescriptor descriptor;
+    const SerialinkFormat *format = nullptr;
+    bool isPollMode = false;
+    bool isFirstRead = true;
+    bool isInvalid = false;
+    long long timeoutUs = -1;
+    long long elapsedMs = 0;
+    int ret = 0;
+    arena.data.clear();
+    arena.frames.clear();
+    arena.fields.clear();
+    if (this->formats.empty()) return 3;
+    if (max == 0) return 4;
+    clock_gettime(CLOCK_MONOTONIC, &tsStart);
+    while (arena.frames.size() < max){
+        /* the wait for the first frame must not exceed the deadline */
+        if (isFirstRead && deadlineMs > 0) timeoutUs = this->limitTimeout(static_cast<long long>(deadlineMs) * 1000LL);
+        ret = this->readFramedData();
+        if (isFirstRead){
+            if (deadlineMs > 0) this->restoreTimeout(timeoutUs);
+            /* only the first read may wait for the port, the rest of the burst is already in the receive buffer */
+            isPollMode = this->exchangePollMode(true);
+            isFirstRead = false;
+        }
+        if (ret == 4){
+            isInvalid = true;
+        }
+        else if (ret != 0){
+            break;
+        }
+        else {
+            format = &(this->formats[this->formatIndex]);
+            frame.format = this->formatIndex;
+            frame.offset = arena.data.size();
+            frame.size = this->dataSize;
+            frame.firstField = arena.fields.size();
+            frame.fieldCount = format->fieldTable.size();
+            arena.data.insert(arena.data.end(), this->rxBuffer.getData() + this->dataOffset, this->rxBuffer.getData() + this->dataOffset + this->dataSize);
+            for (auto &field : format->fieldTable){
+                descriptor.offset = frame.offset + field.bufferOffset;
+                descriptor.size = field.bufferSize;
+                arena.fields.push_back(descriptor);
+            }
+            arena.frames.push_back(frame);
+        }
+        if (deadlineMs > 0){
+            clock_gettime(CLOCK_MONOTONIC, &tsNow);
+            elapsedMs = static_cast<long long>(tsNow.tv_sec - tsStart.tv_sec) * 1000LL + (tsNow.tv_nsec - tsStart.tv_nsec) / 1000000LL;
+            if (elapsedMs >= static_cast<long long>(deadlineMs)) break;
+        }
+    }
+    this->exchangePollMode(isPollMode);
+    if (arena.frames.empty() == false) return 0;
+    if (isInvalid) return 4;
     return ret;
 }
 
 /**
  * @brief Performs serial data write operations with a custom frame format.
  *
- * This function executes serial data write operations using a specific frame format.
+ * This function executes serial data write operations using a specific frame format. The validator frames set up with
+ * `Serialink::setChecksum` are filled with the checksum of the frame data before writing.
  *
  * @return 0 on success.
  * @return 1 if the port is not open.
@@ -244,9 +1062,30 @@ int Serialink::readFramedData(){
  * @return 3 if there is no data to write.
  */
 int Serialink::writeFramedData(){
-    std::vector <unsigned char> buffer;
-    if (this->frameFormat->getAllData(buffer) > 0){
-        return this->writeData(buffer);
+    /* one buffer per thread keeps its capacity between frames, and concurrent writers do not share it */
+    static thread_local std::vector <unsigned char> txBuffer;
+    unsigned char checksumBytes[4];
+    unsigned int state = 0;
+    size_t sz = 0;
+    if (this->frameFormat == nullptr) return 3;
+    for (auto &format : this->formats){
+        if (format.frame != this->frameFormat) continue;
+        if (format.checksums.size() > 0 && (format.fieldTable.empty() || format.fieldTable.back().frame->getNext() != nullptr)){
+            /* the format has been extended through getFormat() */
+            this->compileFormat();
+        }
+        for (auto &checksum : format.checksums){
+            state = Checksum::init(checksum.type);
+            for (size_t i = checksum.beginField; i <= checksum.endField; i++){
+                format.fieldTable[i].frame->getData(txBuffer);
+                state = Checksum::update(checksum.type, state, txBuffer.data(), txBuffer.size());
+            }
+            sz = Serialink::encodeChecksum(checksum, Checksum::finish(checksum.type, state), checksumBytes);
+            checksum.validator->setData(checksumBytes, sz);
+        }
+    }
+    if (this->frameFormat->getAllData(txBuffer) > 0){
+        return this->writeData(txBuffer);
     }
     return 3;
 }
@@ -283,32 +1122,202 @@ std::vector <unsigned char> Serialink::getSpecificBufferAsVector(const DataFrame
     return this->frameFormat->getSpecificDataAsVector(begin, end);
 }
 
-Serialink& Serialink::operator=(const DataFrame &obj){
-    if (this->frameFormat != nullptr){
-        delete this->frameFormat;
-        this->frameFormat = nullptr;
+/**
+ * @brief Retrieves a view of the received frame data within a specified range.
+ *
+ * This method returns a view of the bytes of the last frame received by `Serialink::readFramedData`, from the first
+ * byte of `begin` to the last byte of `end`, without copying them. The view points into the receive buffer and is
+ * valid until the next read operation. This version is suitable for data with unique Frame Formats in each frame
+ * (no duplicate Frame Types).
+ *
+ * @param begin Reference to the starting point of the view.
+ * @param end Reference to the ending point of the view.
+ * @return A view of the data, or an empty view if no frame has been received or the range is not part of the received frame.
+ */
+ByteView Serialink::getSpecificBufferAsView(DataFrame::FRAME_TYPE_t begin, DataFrame::FRAME_TYPE_t end){
+    DataFrame *tmpBegin = (*this)[begin];
+    DataFrame *tmpEnd = (*this)[end];
+    return this->getSpecificBufferAsView(tmpBegin, tmpEnd);
+}
+
+/**
+ * @brief Overloaded method of __getSpecificBufferAsView__.
+ *
+ * This method performs the same operation as the other overload but is designed to handle cases where duplicate
+ * Frame Formats exist within the Framed Data.
+ *
+ * @param begin Pointer to the starting point of the view.
+ * @param end Pointer to the ending point of the view.
+ * @return A view of the data, or an empty view if no frame has been received or the range is not part of the received frame.
+ */
+ByteView Serialink::getSpecificBufferAsView(const DataFrame *begin, const DataFrame *end){
+    size_t beginField = 0;
+    size_t endField = 0;
+    bool isBeginFound = false;
+    bool isEndFound = false;
+    if (this->isFrameReceived == false || begin == nullptr || end == nullptr) return ByteView();
+    const std::vector <SerialinkField> &fieldTable = this->formats[this->formatIndex].fieldTable;
+    for (size_t i = 0; i < fieldTable.size() && isEndFound == false; i++){
+        if (fieldTable[i].frame == begin && isBeginFound == false){
+            beginField = i;
+            isBeginFound = true;
+        }
+        if (fieldTable[i].frame == end && isBeginFound){
+            endField = i;
+            isEndFound = true;
+        }
     }
-    DataFrame &ncObj = const_cast<DataFrame&>(obj);
-    std::vector <unsigned char> ref;
-    ncObj.getReference(ref);
-    this->frameFormat = new DataFrame(
-     static_cast<DataFrame::FRAME_TYPE_t>(ncObj.getType()),
-      ncObj.getSize(),
-      ref.data(),
-      ncObj.getExecuteFunction(),
-      ncObj.getExecuteFunctionParam(),
-      ncObj.getPostExecuteFunction(),
-      ncObj.getPostExecuteFunctionParam()
+    if (isEndFound == false) return ByteView();
+    return ByteView(
+        this->rxBuffer.getData() + fieldTable[beginField].bufferOffset,
+        fieldTable[endField].bufferOffset + fieldTable[endField].bufferSize - fieldTable[beginField].bufferOffset
     );
-    if (this->frameFormat != nullptr){
-        if (ncObj.getNext() != nullptr)
-            *(this->frameFormat) += *(ncObj.getNext());
+}
+
+/**
+ * @brief Retrieves a view of one field of the received frame.
+ *
+ * This is the zero-copy counterpart of `DataFrame::getDataAsVector` for received frames. The view points into the
+ * receive buffer and is valid until the next read operation.
+ *
+ * @param type The frame type of the field (the first field with this type).
+ * @return A view of the field data, or an empty view if no frame has been received or the field is not part of the received frame.
+ */
+ByteView Serialink::getFieldAsView(DataFrame::FRAME_TYPE_t type){
+    DataFrame *tmp = (*this)[type];
+    return this->getSpecificBufferAsView(tmp, tmp);
+}
+
+/**
+ * @brief Overloaded method of __getFieldAsView__.
+ *
+ * This method is designed to handle cases where duplicate Frame Formats exist within the Framed Data.
+ *
+ * @param frame Pointer to the field.
+ * @return A view of the field data, or an empty view if no frame has been received or the field is not part of the received frame.
+ */
+ByteView Serialink::getFieldAsView(const DataFrame *frame){
+    return this->getSpecificBufferAsView(frame, frame);
+}
+
+/**
+ * @brief Overloaded method of __getFieldAsView__ with a field handle.
+ *
+ * @param handle The handle of the field (see `Serialink::getHandle`).
+ * @return A view of the field data, or an empty view if no frame has been received or the field is not part of the received frame.
+ */
+ByteView Serialink::getFieldAsView(SerialinkHandle handle){
+    if (this->isFrameReceived == false || handle.format != this->formatIndex || handle.field == 0) return ByteView();
+    if (handle.generation != this->formatGeneration) return ByteView();
+    const std::vector <SerialinkField> &fieldTable = this->formats[this->formatIndex].fieldTable;
+    if (handle.field > fieldTable.size()) return ByteView();
+    return ByteView(this->rxBuffer.getData() + fieldTable[handle.field - 1].bufferOffset, fieldTable[handle.field - 1].bufferSize);
+}
+
+/**
+ * @brief Gets a handle of a field.
+ *
+ * A handle is the position of a field in its frame format. It stays valid when frames are appended with `operator+=` or
+ * `Serialink::addFormat`, and becomes invalid when the frame format is replaced with the assignment operator. Callbacks can
+ * look a field up once, store the handle and access the field with `Serialink::getField` or `Serialink::getFieldAsView`
+ * without walking the frame format for every frame.
+ *
+ * @param type The frame type of the field (the first field with this type in the current frame format).
+ * @return The handle (`field` is 0 if the field is not found).
+ */
+SerialinkHandle Serialink::getHandle(DataFrame::FRAME_TYPE_t type){
+    return this->getHandle(std::pair <DataFrame::FRAME_TYPE_t, int>(type, 0));
+}
+
+/**
+ * @brief Overloaded method of __getHandle__ for a frame format with duplicate frame types.
+ *
+ * @param params The frame type and the occurrence of the field (0 for the first field with this type).
+ * @return The handle (`field` is 0 if the field is not found).
+ */
+SerialinkHandle Serialink::getHandle(std::pair <DataFrame::FRAME_TYPE_t, int> params){
+    SerialinkHandle handle = {this->formatIndex, 0, this->formatGeneration};
+    const SerialinkFormat *format = this->getCurrentFormat();
+    size_t type = static_cast<size_t>(params.first);
+    if (format == nullptr || params.second < 0 || type >= format->typeIndex.size()) return handle;
+    if (static_cast<size_t>(params.second) < format->typeIndex[type].size()){
+        handle.field = format->typeIndex[type][params.second] + 1;
     }
+    return handle;
+}
+
+/**
+ * @brief Overloaded method of __getHandle__ for a field of any frame format.
+ *
+ * @param frame Pointer to the field (see `Serialink::getFormat`).
+ * @return The handle (`field` is 0 if the field is not found).
+ */
+SerialinkHandle Serialink::getHandle(const DataFrame *frame){
+    SerialinkHandle handle = {this->formatIndex, 0, this->formatGeneration};
+    if (this->getCurrentFormat() == nullptr || frame == nullptr) return handle;
+    for (size_t i = 0; i < this->formats.size(); i++){
+        for (size_t j = 0; j < this->formats[i].fieldTable.size(); j++){
+            if (this->formats[i].fieldTable[j].frame == frame){
+                handle.format = i;
+                handle.field = j + 1;
+                return handle;
+            }
+        }
+    }
+    return handle;
+}
+
+/**
+ * @brief Overloaded method of __getHandle__ for a field of a specific frame format.
+ *
+ * This is used for the frames of a burst (see `Serialink::readFrames`), which may belong to any frame format.
+ *
+ * @param format The index of the frame format (see `Serialink::getFormat(size_t)`).
+ * @param type The frame type of the field (the first field with this type in the frame format).
+ * @return The handle (`field` is 0 if the field is not found).
+ */
+SerialinkHandle Serialink::getHandle(size_t format, DataFrame::FRAME_TYPE_t type){
+    SerialinkHandle handle = {format, 0, this->formatGeneration};
+    size_t idx = static_cast<size_t>(type);
+    if (format >= this->formats.size() || idx >= this->formats[format].typeIndex.size()) return handle;
+    if (this->formats[format].typeIndex[idx].empty() == false){
+        handle.field = this->formats[format].typeIndex[idx].front() + 1;
+    }
+    return handle;
+}
+
+/**
+ * @brief Gets a field with its handle.
+ *
+ * @param handle The handle of the field (see `Serialink::getHandle`).
+ * @return The field (or `nullptr` if the handle is not valid).
+ */
+DataFrame *Serialink::getField(SerialinkHandle handle){
+    if (handle.format >= this->formats.size() || handle.field == 0) return nullptr;
+    /* the handle has been taken from a frame format that has been replaced since */
+    if (handle.generation != this->formatGeneration) return nullptr;
+    if (handle.field > this->formats[handle.format].fieldTable.size()) return nullptr;
+    return this->formats[handle.format].fieldTable[handle.field - 1].frame;
+}
+
+Serialink& Serialink::operator=(const DataFrame &obj){
+    SerialinkFormat format;
+    for (auto &item : this->formats){
+        delete item.frame;
+    }
+    this->formats.clear();
+    format.frame = Serialink::createFormat(obj);
+    this->formats.push_back(format);
+    this->formatIndex = 0;
+    this->formatGeneration++;
+    this->frameFormat = format.frame;
+    this->compileFormat();
     return *this;
 }
 
 Serialink& Serialink::operator+=(const DataFrame &obj){
-    *(this->frameFormat) += obj;
+    *(this->formats.front().frame) += obj;
+    this->compileFormat();
     return *this;
 }
 
@@ -318,38 +1327,16 @@ Serialink& Serialink::operator+(const DataFrame &obj){
 }
 
 DataFrame* Serialink::operator[](int idx){
-    int i = 0;
-    DataFrame *tmp = this->frameFormat;
-    if (tmp == nullptr || i < 0) return nullptr;
-    while(tmp != nullptr){
-        if(i == idx) return tmp;
-        i++;
-        tmp = tmp->getNext();
-    }
-    return nullptr;
+    const SerialinkFormat *format = this->getCurrentFormat();
+    if (format == nullptr || idx < 0 || static_cast<size_t>(idx) >= format->fieldTable.size()) return nullptr;
+    return format->fieldTable[idx].frame;
 }
 
 DataFrame* Serialink::operator[](DataFrame::FRAME_TYPE_t type){
-    DataFrame *tmp = this->frameFormat;
-    if (tmp == nullptr) return nullptr;
-    while(tmp != nullptr){
-        if(tmp->getType() == type) return tmp;
-        tmp = tmp->getNext();
-    }
-    return nullptr;
+    return this->getField(this->getHandle(type));
 }
 
 DataFrame* Serialink::operator[](std::pair <DataFrame::FRAME_TYPE_t, int> params){
-    int i = 0;
-    DataFrame *tmp = this->frameFormat;
-    if (tmp == nullptr || i < 0) return nullptr;
-    while(tmp != nullptr){
-        if (tmp->getType() == params.first){
-            if(i == params.second) return tmp;
-            i++;
-        }
-        tmp = tmp->getNext();
-    }
-    return nullptr;
+    return this->getField(this->getHandle(params));
 }
 
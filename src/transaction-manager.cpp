@@ -0,0 +1,226 @@
+/*
+ * $Id: transaction-manager.cpp,v 1.0.0 2025/01/22 10:41:06 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <string.h>
+#include "transaction-manager.hpp"
+
+static bool isDeadlinePassed(const struct timespec &deadline, const struct timespec &now){
+    if (now.tv_sec != deadline.tv_sec) return (now.tv_sec > deadline.tv_sec);
+    return (now.tv_nsec >= deadline.tv_nsec);
+}
+
+/**
+ * @brief Custom constructor.
+ *
+ * Creates a transaction manager for a port. The frame format of the port must be set up with the format of the responses.
+ * The key field is `DataFrame::FRAME_TYPE_SN` and the window is 4 requests.
+ *
+ * @param link The port (not owned by the manager, it must stay valid while the manager is used).
+ */
+TransactionManager::TransactionManager(Serialink &link){
+    this->link = &link;
+    this->keyType = DataFrame::FRAME_TYPE_SN;
+    this->window = 4;
+}
+
+/**
+ * @brief Sets the field of the responses that identifies the request.
+ *
+ * @param type The frame type of the key field (the first field with this type).
+ */
+void TransactionManager::setKeyField(DataFrame::FRAME_TYPE_t type){
+    this->keyType = type;
+}
+
+/**
+ * @brief Sets the maximum number of requests in flight.
+ *
+ * @param window The number of requests (a window of 1 is the stop-and-wait mode).
+ */
+void TransactionManager::setWindow(size_t window){
+    this->window = (window > 0 ? window : 1);
+}
+
+/**
+ * @brief Calls the callback of a completed transaction.
+ *
+ * @param transaction The transaction (already removed from the queue or the window).
+ * @param ret The status of the transaction.
+ */
+void TransactionManager::complete(const SerialinkTransaction &transaction, int ret){
+    if (transaction.callbackFunc == nullptr) return;
+    void (*callback)(TransactionManager &, int, Serialink &, void *) = (void (*)(TransactionManager &, int, Serialink &, void *))transaction.callbackFunc;
+    callback(*this, ret, *(this->link), transaction.callbackParam);
+}
+
+/**
+ * @brief Writes the queued requests while the window is not full.
+ *
+ * A request whose deadline has passed in the queue is completed with status `2`, and a request that cannot be written is
+ * completed with the status of `Serial::writeData`.
+ */
+void TransactionManager::sendQueued(){
+    struct timespec now;
+    int ret = 0;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    while (this->inFlight.size() < this->window && this->queue.empty() == false){
+        SerialinkTransaction transaction = this->queue.front();
+        this->queue.pop_front();
+        if (isDeadlinePassed(transaction.deadline, now)){
+            this->complete(transaction, 2);
+            continue;
+        }
+        ret = this->link->writeData(ByteView(transaction.request.data(), transaction.request.size()));
+        if (ret != 0){
+            this->complete(transaction, ret);
+            continue;
+        }
+        this->inFlight.push_back(transaction);
+    }
+}
+
+/**
+ * @brief Completes the requests in flight whose deadline has passed with status `2`.
+ */
+void TransactionManager::expire(){
+    struct timespec now;
+    size_t i = 0;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    while (i < this->inFlight.size()){
+        if (isDeadlinePassed(this->inFlight[i].deadline, now) == false){
+            i++;
+            continue;
+        }
+        /* the callback may submit a new request, so the transaction is removed first */
+        SerialinkTransaction transaction = this->inFlight[i];
+        this->inFlight.erase(this->inFlight.begin() + i);
+        this->complete(transaction, 2);
+    }
+}
+
+/**
+ * @brief Submits a request.
+ *
+ * The request is written at once if the window is not full, otherwise it is queued. The callback is called by
+ * `TransactionManager::process` with:
+ * - `0` when the response is received. The fields of the response can be read from the port (for example with
+ *   `Serialink::getFieldAsView`) inside the callback.
+ * - `2` when the deadline passes before the response is received.
+ * - `1` or `2` when the queued request cannot be written.
+ *
+ * The callback prototype is `void callback(TransactionManager &manager, int ret, Serialink &link, void *param)`. A new request
+ * can be submitted from the callback.
+ *
+ * @param request The encoded request frame (for example from `FrameEncoder::encode`).
+ * @param key The value of the key field of the expected response.
+ * @param timeoutMs The time limit of the transaction in milliseconds, counted from the submission.
+ * @param func The callback function.
+ * @param param The parameter of the callback function.
+ * @return 0 on success.
+ * @return 1 if the port is not open.
+ * @return 2 if the request cannot be written.
+ * @return 4 if the request or the key is empty.
+ */
+int TransactionManager::submit(ByteView request, ByteView key, unsigned int timeoutMs, const void *func, void *param){
+    SerialinkTransaction transaction;
+    int ret = 0;
+    if (request.empty() || key.empty()) return 4;
+    transaction.request.assign(request.begin(), request.end());
+    transaction.key.assign(key.begin(), key.end());
+    clock_gettime(CLOCK_MONOTONIC, &(transaction.deadline));
+    transaction.deadline.tv_sec += timeoutMs / 1000;
+    transaction.deadline.tv_nsec += static_cast<long>(timeoutMs % 1000) * 1000000L;
+    if (transaction.deadline.tv_nsec >= 1000000000L){
+        transaction.deadline.tv_sec++;
+        transaction.deadline.tv_nsec -= 1000000000L;
+    }
+    transaction.callbackFunc = func;
+    transaction.callbackParam = param;
+    if (this->inFlight.size() >= this->window || this->queue.empty() == false){
+        this->queue.push_back(transaction);
+        return 0;
+    }
+    ret = this->link->writeData(request);
+    if (ret != 0) return ret;
+    this->inFlight.push_back(transaction);
+    return 0;
+}
+
+/**
+ * @brief Reads one response and completes the transactions.
+ *
+ * The expired transactions are completed, the queued requests are written while the window is not full, and one frame is
+ * read with `Serialink::readFramedData` (waiting at most the port timeout). A response that does not match any request in
+ * flight is ignored.
+ *
+ * @return 0 if a frame is received.
+ * @return 2 if a timeout occurs.
+ * @return 3 if there is no pending transaction.
+ * @return 4 if the received frame is invalid.
+ */
+int TransactionManager::process(){
+    ByteView key;
+    int ret = 0;
+    this->expire();
+    this->sendQueued();
+    if (this->inFlight.empty()){
+        return (this->queue.empty() ? 3 : 0);
+    }
+    ret = this->link->readFramedData();
+    if (ret == 0){
+        key = this->link->getFieldAsView(this->keyType);
+        for (size_t i = 0; i < this->inFlight.size(); i++){
+            if (this->inFlight[i].key.size() != key.size() ||
+                memcmp(this->inFlight[i].key.data(), key.data(), key.size()) != 0
+            ){
+                continue;
+            }
+            /* the callback may submit a new request, so the transaction is removed first */
+            SerialinkTransaction transaction = this->inFlight[i];
+            this->inFlight.erase(this->inFlight.begin() + i);
+            this->complete(transaction, 0);
+            break;
+        }
+    }
+    this->expire();
+    this->sendQueued();
+    return ret;
+}
+
+/**
+ * @brief Gets the number of requests that have been written and wait for their response.
+ *
+ * @return The number of requests in flight.
+ */
+size_t TransactionManager::getInFlightCount(){
+    return this->inFlight.size();
+}
+
+/**
+ * @brief Gets the number of pending transactions (in flight and queued).
+ *
+ * @return The number of pending transactions.
+ */
+size_t TransactionManager::getPendingCount(){
+    return this->inFlight.size() + this->queue.size();
+}
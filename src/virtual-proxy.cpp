@@ -27,8 +27,18 @@
 #include <termios.h>
 #include <pty.h>
 #include <cstring>
+#include <time.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include "virtual-proxy.hpp"
 
+static unsigned long long getElapsedUs(const struct timespec &tsStart){
+  struct timespec tsNow;
+  clock_gettime(CLOCK_MONOTONIC, &tsNow);
+  return static_cast<unsigned long long>((tsNow.tv_sec - tsStart.tv_sec) * 1000000LL + (tsNow.tv_nsec - tsStart.tv_nsec) / 1000LL);
+}
+
 /**
  * @brief Default constructor.
  *
@@ -45,8 +55,17 @@ VirtualSerialProxy::VirtualSerialProxy(){
   this->symlinkPort = "";
   this->pty = new VirtualSerial(this->workingBaudrate, 10, 10);
   this->dev = new Serial(this->physicalPort, this->workingBaudrate, 10, 10);
+  this->reactor = new SerialReactor();
   this->passthroughFunc = nullptr;
   this->passthroughParam = nullptr;
+  this->isSpliceMode = false;
+  this->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  this->arbitration = PROXY_ARBITRATION_FIRST_COME;
+  this->clientQueueLimit = 65536;
+  this->sequence = 0;
+  this->createClient(this->pty, 0);
+  pthread_mutex_init(&(this->mtx), NULL);
+  this->resetStats();
 }
 
 /**
@@ -64,8 +83,17 @@ VirtualSerialProxy::VirtualSerialProxy(const char *physicalPort, speed_t baud){
   this->symlinkPort = "";
   this->pty = new VirtualSerial(this->workingBaudrate, 10, 10);
   this->dev = new Serial(this->physicalPort, this->workingBaudrate, 10, 10);
+  this->reactor = new SerialReactor();
   this->passthroughFunc = nullptr;
   this->passthroughParam = nullptr;
+  this->isSpliceMode = false;
+  this->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  this->arbitration = PROXY_ARBITRATION_FIRST_COME;
+  this->clientQueueLimit = 65536;
+  this->sequence = 0;
+  this->createClient(this->pty, 0);
+  pthread_mutex_init(&(this->mtx), NULL);
+  this->resetStats();
 }
 
 /**
@@ -84,8 +112,17 @@ VirtualSerialProxy::VirtualSerialProxy(const char *physicalPort, const char *sym
   this->symlinkPort = std::string(symlinkPort);
   this->pty = new VirtualSerial(this->workingBaudrate, 10, 10);
   this->dev = new Serial(this->physicalPort, this->workingBaudrate, 10, 10);
+  this->reactor = new SerialReactor();
   this->passthroughFunc = nullptr;
   this->passthroughParam = nullptr;
+  this->isSpliceMode = false;
+  this->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  this->arbitration = PROXY_ARBITRATION_FIRST_COME;
+  this->clientQueueLimit = 65536;
+  this->sequence = 0;
+  this->createClient(this->pty, 0);
+  pthread_mutex_init(&(this->mtx), NULL);
+  this->resetStats();
 }
 
 /**
@@ -94,8 +131,15 @@ VirtualSerialProxy::VirtualSerialProxy(const char *physicalPort, const char *sym
  * Releases all allocated memory and closes the master port of the virtual serial port.
  */
 VirtualSerialProxy::~VirtualSerialProxy(){
+  delete this->reactor;
+  for (size_t i = 0; i < this->clients.size(); i++){
+    if (this->clients[i]->pty != this->pty) delete this->clients[i]->pty;
+    delete this->clients[i];
+  }
   delete this->pty;
   delete this->dev;
+  if (this->eventFd >= 0) close(this->eventFd);
+  pthread_mutex_destroy(&(this->mtx));
 }
 
 /**
@@ -124,12 +168,14 @@ void VirtualSerialProxy::setSymlinkPort(const std::string port){
 /**
  * @brief Sets the baud rate for communication.
  *
- * This setter function configures the baud rate used for serial communication.
+ * This setter function configures the baud rate used for serial communication, on the device and every client pty.
  *
  * @param baud The baud rate (e.g., `B9600` for 9600 bps).
  */
 void VirtualSerialProxy::setBaudrate(speed_t baud){
-  this->pty->setBaudrate(baud);
+  for (size_t i = 0; i < this->clients.size(); i++){
+    this->clients[i]->pty->setBaudrate(baud);
+  }
   this->dev->setBaudrate(baud);
   this->workingBaudrate = baud;
 }
@@ -137,12 +183,15 @@ void VirtualSerialProxy::setBaudrate(speed_t baud){
 /**
  * @brief Sets the communication timeout.
  *
- * This setter function configures the timeout for serial communication. The timeout value is specified in units of 100 milliseconds.
+ * This setter function configures the timeout for serial communication, on the device and every client pty. The timeout value is specified
+ * in units of 100 milliseconds.
  *
  * @param timeout The timeout value (e.g., `10` for a 1-second timeout).
  */
 void VirtualSerialProxy::setTimeout(unsigned int timeout){
-  this->pty->setTimeout(timeout);
+  for (size_t i = 0; i < this->clients.size(); i++){
+    this->clients[i]->pty->setTimeout(timeout);
+  }
   this->dev->setTimeout(timeout);
 }
 
@@ -150,11 +199,14 @@ void VirtualSerialProxy::setTimeout(unsigned int timeout){
  * @brief Sets the keep-alive interval for communication.
  *
  * This setter function configures the maximum wait time for receiving the next byte of serial data after the initial byte has been received. This helps maintain the connection by ensuring timely data reception.
+ * The interval is applied to the device and every client pty.
  *
  * @param keepAliveMs The keep-alive interval in milliseconds.
  */
 void VirtualSerialProxy::setKeepAlive(unsigned int keepAliveMs){
-  this->pty->setKeepAlive(keepAliveMs);
+  for (size_t i = 0; i < this->clients.size(); i++){
+    this->clients[i]->pty->setKeepAlive(keepAliveMs);
+  }
   this->dev->setKeepAlive(keepAliveMs);
 }
 
@@ -180,6 +232,17 @@ std::string VirtualSerialProxy::getSymlinkPort(){
   return this->symlinkPort;
 }
 
+/**
+ * @brief Gets the name of pseudo serial port.
+ *
+ * This getter function retrieves the name of the pseudo serial port (slave) that is used by the application.
+ *
+ * @return The name of pseudo serial port (e.g., "/dev/pts/3").
+ */
+std::string VirtualSerialProxy::getVirtualPortName(){
+  return this->pty->getVirtualPortName();
+}
+
 /**
  * @brief Gets the baud rate for serial communication.
  *
@@ -217,7 +280,10 @@ unsigned int VirtualSerialProxy::getKeepAlive(){
  * @brief Sets the Pass Through function.
  *
  * This method allows you to specify a callback function that will be used for handling data operations
- * (reading and writing) on the virtual serial poxy. (Mandatory before call the `begin` method).
+ * (reading and writing) on the virtual serial poxy. The function is called from the proxy loop each time the source has received
+ * data, so `Serial::readData` on the source returns the received bytes immediately. If no function is set, the data is forwarded as is.
+ * The function is only used while the proxy has a single client (see `addClient`). Its writes to the destination are queued into
+ * the proxy loop, so `Serial::writeData` returns without waiting for the port.
  *
  * @param func Pass Through function that has 3 parameters. First `Serial &` is source and the second `Serial &` is destination. `void *` is a pointer that will connect directly to `void *param`.
  * @param param Pointer to the parameter for the callback function.
@@ -245,6 +311,522 @@ void *VirtualSerialProxy::getPassThroughParam(){
   return this->passthroughParam;
 }
 
+/**
+ * @brief Adds a client pty.
+ *
+ * This method creates one more pty that shares the physical port (must be called before the `begin` method). The data received from the
+ * device is broadcast to every client. The default client (created by the constructor) has the index `0` and the priority `0`.
+ * The new pty uses the current baud rate, timeout and keep-alive interval, and follows the later changes of these settings.
+ *
+ * @param priority The priority of the client, used by `PROXY_ARBITRATION_PRIORITY` (a higher value is served first).
+ * @return The index of the new client.
+ */
+size_t VirtualSerialProxy::addClient(int priority){
+  VirtualSerial *pty = new VirtualSerial(this->workingBaudrate, 10, 10);
+  /* the new client uses the same settings as the default client */
+  pty->setTimeout(this->pty->getTimeout());
+  pty->setKeepAlive(this->pty->getKeepAlive());
+  this->createClient(pty, priority);
+  return this->clients.size() - 1;
+}
+
+/**
+ * @brief Gets the number of clients.
+ *
+ * @return The number of client ptys.
+ */
+size_t VirtualSerialProxy::getClientCount(){
+  return this->clients.size();
+}
+
+/**
+ * @brief Sets the priority of a client.
+ *
+ * @param index The index of the client.
+ * @param priority The priority of the client (a higher value is served first).
+ */
+void VirtualSerialProxy::setClientPriority(size_t index, int priority){
+  if (index >= this->clients.size()) return;
+  this->clients[index]->priority = priority;
+}
+
+/**
+ * @brief Gets the name of pseudo serial port of a client.
+ *
+ * @param index The index of the client.
+ * @return The name of pseudo serial port (or an empty string if the index is invalid).
+ */
+std::string VirtualSerialProxy::getVirtualPortName(size_t index){
+  if (index >= this->clients.size()) return std::string("");
+  return this->clients[index]->pty->getVirtualPortName();
+}
+
+/**
+ * @brief Gets the number of bytes dropped for a client.
+ *
+ * The bytes are dropped when the queue of the client (in either direction) exceeds the client queue limit.
+ *
+ * @param index The index of the client.
+ * @return The number of dropped bytes.
+ */
+unsigned long long VirtualSerialProxy::getDroppedBytes(size_t index){
+  unsigned long long dropped = 0;
+  if (index >= this->clients.size()) return 0;
+  pthread_mutex_lock(&(this->mtx));
+  dropped = this->clients[index]->dropped;
+  pthread_mutex_unlock(&(this->mtx));
+  return dropped;
+}
+
+/**
+ * @brief Sets the policy used to arbitrate the client writes into the device.
+ *
+ * - `PROXY_ARBITRATION_FIRST_COME`: every received chunk is forwarded in arrival order (chunks of different clients may interleave).
+ * - `PROXY_ARBITRATION_FRAME_ATOMIC`: only complete frames are forwarded, in the order they are completed, so frames never interleave.
+ * - `PROXY_ARBITRATION_PRIORITY`: complete frames are forwarded, the client with the highest priority is served first.
+ *
+ * @param policy The arbitration policy (default: `PROXY_ARBITRATION_FIRST_COME`).
+ */
+void VirtualSerialProxy::setArbitration(PROXY_ARBITRATION policy){
+  this->arbitration = policy;
+}
+
+/**
+ * @brief Gets the arbitration policy.
+ *
+ * @return The arbitration policy.
+ */
+PROXY_ARBITRATION VirtualSerialProxy::getArbitration(){
+  return this->arbitration;
+}
+
+/**
+ * @brief Sets the frame delimiter.
+ *
+ * This setter function configures the bytes that end a frame written by a client (e.g. "\r\n"). It is used by the frame-atomic and
+ * priority policies. If no delimiter is set, each received chunk is handled as a complete frame.
+ *
+ * @param delimiter The frame delimiter.
+ */
+void VirtualSerialProxy::setFrameDelimiter(const std::vector <unsigned char> &delimiter){
+  this->frameDelimiter = delimiter;
+}
+
+/**
+ * @brief Sets the maximum number of bytes queued per client.
+ *
+ * This setter function limits the data waiting for a slow client (device to client) and the data of a client waiting for the device
+ * (client to device). The data that exceeds the limit is dropped and counted.
+ *
+ * @param sz The queue limit in bytes (default: 65536).
+ */
+void VirtualSerialProxy::setClientQueueLimit(size_t sz){
+  this->clientQueueLimit = sz;
+}
+
+/**
+ * @brief Sets the splice mode.
+ *
+ * This setter function enables the zero-copy fast path. When the splice mode is enabled and no Pass Through function is set, the `begin`
+ * method forwards the data with `splice` through an internal pipe instead of reading it into the receive buffers. If the kernel cannot
+ * splice the ports (or the proxy has more than one client), the proxy uses the normal forwarding loop.
+ *
+ * @param enable `true` to enable the splice mode (default: `false`).
+ */
+void VirtualSerialProxy::setSpliceMode(bool enable){
+  this->isSpliceMode = enable;
+}
+
+/**
+ * @brief Gets the splice mode.
+ *
+ * @return `true` if the splice mode is enabled.
+ */
+bool VirtualSerialProxy::getSpliceMode(){
+  return this->isSpliceMode;
+}
+
+/**
+ * @brief Gets the statistics of a forwarding direction.
+ *
+ * This getter function retrieves the number of forwarded bytes and chunks, the forwarding latency (from the moment the chunk is received
+ * until it has been written or queued to the destination) and the elapsed time since the proxy has been started (or the statistics have been reset).
+ *
+ * @param direction The forwarding direction.
+ * @return The statistics of the direction.
+ */
+VirtualSerialProxyStats VirtualSerialProxy::getStats(PROXY_DIRECTION direction){
+  pthread_mutex_lock(&(this->mtx));
+  VirtualSerialProxyStats result = this->stats[direction];
+  result.elapsedSec = static_cast<double>(getElapsedUs(this->tsStart)) / 1000000.0;
+  pthread_mutex_unlock(&(this->mtx));
+  return result;
+}
+
+/**
+ * @brief Resets the statistics of both directions.
+ */
+void VirtualSerialProxy::resetStats(){
+  pthread_mutex_lock(&(this->mtx));
+  memset(this->stats, 0x00, sizeof(this->stats));
+  clock_gettime(CLOCK_MONOTONIC, &(this->tsStart));
+  pthread_mutex_unlock(&(this->mtx));
+}
+
+/**
+ * @brief Write handler of both ports while a Pass Through function is used.
+ *
+ * The data written by the Pass Through function is queued into the reactor instead of blocking the proxy loop.
+ *
+ * @param serial The destination port.
+ * @param buffer Data to be written.
+ * @param sz Size of the data to be written.
+ * @param param The pointer of the `VirtualSerialProxy` object.
+ * @return 0 if the data is queued.
+ * @return 1 if the port is not registered.
+ * @return 2 if the data write operation fails.
+ */
+int VirtualSerialProxy::queueWrite(Serial &serial, const unsigned char *buffer, size_t sz, void *param){
+  VirtualSerialProxy *proxy = (VirtualSerialProxy *) param;
+  return proxy->reactor->writeData(&serial, buffer, sz);
+}
+
+/**
+ * @brief Forwards the received data to the other port.
+ *
+ * This function is the data callback of both ports registered to the reactor. The received data is handed to the Pass Through
+ * function (if any) or queued for the other port without blocking. The statistics of the direction are updated.
+ *
+ * @param src The port where the data has been received.
+ * @param data The received data.
+ * @param sz The size of the received data.
+ * @param param The pointer of the `VirtualSerialProxy` object.
+ */
+void VirtualSerialProxy::forwardData(Serial &src, const unsigned char *data, size_t sz, void *param){
+  VirtualSerialProxy *proxy = (VirtualSerialProxy *) param;
+  VirtualSerialProxyClient *client = nullptr;
+  struct timespec tsReceived;
+  clock_gettime(CLOCK_MONOTONIC, &tsReceived);
+  if (proxy->passthroughFunc != nullptr && proxy->clients.size() == 1){
+    void (*callback)(Serial &, Serial &, void *) = (void (*)(Serial &, Serial &, void *)) proxy->passthroughFunc;
+    Serial *dest = (&src == proxy->dev ? (Serial *) proxy->pty : proxy->dev);
+    /* hand the received bytes back to the source, so the next readData returns them without waiting */
+    src.unreadData();
+    callback(src, *dest, proxy->passthroughParam);
+    proxy->updateStats((&src == proxy->dev ? PROXY_DIRECTION_DEVICE_TO_PTY : PROXY_DIRECTION_PTY_TO_DEVICE), sz, getElapsedUs(tsReceived));
+    return;
+  }
+  if (&src == proxy->dev){
+    /* broadcast, every client has its own bounded queue */
+    for (size_t i = 0; i < proxy->clients.size(); i++){
+      client = proxy->clients[i];
+      if (proxy->reactor->getQueuedSize(client->pty) + sz > proxy->clientQueueLimit){
+        proxy->dropClientData(client, PROXY_DIRECTION_DEVICE_TO_PTY, sz);
+        continue;
+      }
+      proxy->reactor->writeData(client->pty, data, sz);
+    }
+    proxy->updateStats(PROXY_DIRECTION_DEVICE_TO_PTY, sz, getElapsedUs(tsReceived));
+    return;
+  }
+  for (size_t i = 0; i < proxy->clients.size(); i++){
+    if ((Serial *) proxy->clients[i]->pty == &src){
+      client = proxy->clients[i];
+      break;
+    }
+  }
+  if (client == nullptr) return;
+  proxy->queueClientData(client, data, sz);
+  proxy->pumpDevice();
+}
+
+/**
+ * @brief Creates a client entry.
+ *
+ * @param pty The pty of the client.
+ * @param priority The priority of the client.
+ */
+void VirtualSerialProxy::createClient(VirtualSerial *pty, int priority){
+  VirtualSerialProxyClient *client = new VirtualSerialProxyClient;
+  client->pty = pty;
+  client->priority = priority;
+  client->holdFd = -1;
+  client->queuedSize = 0;
+  client->dropped = 0;
+  client->isResyncing = false;
+  this->clients.push_back(client);
+}
+
+/**
+ * @brief Counts the bytes dropped for a client.
+ *
+ * @param client The client entry.
+ * @param direction The forwarding direction of the dropped bytes.
+ * @param sz The number of dropped bytes.
+ */
+void VirtualSerialProxy::dropClientData(VirtualSerialProxyClient *client, PROXY_DIRECTION direction, size_t sz){
+  pthread_mutex_lock(&(this->mtx));
+  client->dropped += sz;
+  this->stats[direction].dropped += sz;
+  pthread_mutex_unlock(&(this->mtx));
+}
+
+/**
+ * @brief Queues the data written by a client for the device.
+ *
+ * The data is split into units according to the arbitration policy (received chunks or complete frames). When a frame
+ * does not fit within the client queue limit, its bytes are dropped up to the next delimiter.
+ *
+ * @param client The client entry.
+ * @param data The received data.
+ * @param sz The size of the received data.
+ */
+void VirtualSerialProxy::queueClientData(VirtualSerialProxyClient *client, const unsigned char *data, size_t sz){
+  VirtualSerialProxyFrame frame;
+  size_t start = 0;
+  size_t idx = 0;
+  bool isFramed = (this->arbitration != PROXY_ARBITRATION_FIRST_COME && !this->frameDelimiter.empty());
+  if (isFramed && client->queuedSize + client->pending.size() + sz > this->clientQueueLimit && !client->pending.empty()){
+    /* the incomplete frame cannot grow anymore, the client resyncs at the next delimiter */
+    this->dropClientData(client, PROXY_DIRECTION_PTY_TO_DEVICE, client->pending.size());
+    client->pending.clear();
+    client->isResyncing = true;
+  }
+  if (client->queuedSize + client->pending.size() + sz > this->clientQueueLimit){
+    this->dropClientData(client, PROXY_DIRECTION_PTY_TO_DEVICE, sz);
+    if (isFramed) client->isResyncing = true;
+    return;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &(frame.tsQueued));
+  if (!isFramed){
+    frame.sequence = this->sequence++;
+    frame.data.assign(data, data + sz);
+    client->queuedSize += sz;
+    client->frames.push_back(frame);
+    return;
+  }
+  client->pending.insert(client->pending.end(), data, data + sz);
+  /* the delimiter may have been split between two chunks, so the search starts before the new bytes */
+  idx = (client->pending.size() - sz >= this->frameDelimiter.size() ? client->pending.size() - sz - this->frameDelimiter.size() + 1 : 0);
+  if (client->isResyncing){
+    while (idx + this->frameDelimiter.size() <= client->pending.size() &&
+           memcmp(client->pending.data() + idx, this->frameDelimiter.data(), this->frameDelimiter.size()) != 0)
+    {
+      idx++;
+    }
+    if (idx + this->frameDelimiter.size() > client->pending.size()){
+      /* keep the bytes that may start a delimiter split between two chunks */
+      start = (client->pending.size() >= this->frameDelimiter.size() ? client->pending.size() - this->frameDelimiter.size() + 1 : 0);
+      this->dropClientData(client, PROXY_DIRECTION_PTY_TO_DEVICE, start);
+      client->pending.erase(client->pending.begin(), client->pending.begin() + start);
+      return;
+    }
+    idx += this->frameDelimiter.size();
+    start = idx;
+    this->dropClientData(client, PROXY_DIRECTION_PTY_TO_DEVICE, start);
+    client->isResyncing = false;
+  }
+  while (idx + this->frameDelimiter.size() <= client->pending.size()){
+    if (memcmp(client->pending.data() + idx, this->frameDelimiter.data(), this->frameDelimiter.size()) != 0){
+      idx++;
+      continue;
+    }
+    idx += this->frameDelimiter.size();
+    frame.sequence = this->sequence++;
+    frame.data.assign(client->pending.begin() + start, client->pending.begin() + idx);
+    client->queuedSize += frame.data.size();
+    client->frames.push_back(frame);
+    start = idx;
+  }
+  if (start > 0) client->pending.erase(client->pending.begin(), client->pending.begin() + start);
+}
+
+/**
+ * @brief Writes the queued client units into the device while the device has no pending output.
+ *
+ * The next unit is selected according to the arbitration policy.
+ */
+void VirtualSerialProxy::pumpDevice(){
+  VirtualSerialProxyClient *selected = nullptr;
+  VirtualSerialProxyClient *client = nullptr;
+  while (this->reactor->getQueuedSize(this->dev) == 0){
+    selected = nullptr;
+    for (size_t i = 0; i < this->clients.size(); i++){
+      client = this->clients[i];
+      if (client->frames.empty()) continue;
+      if (selected == nullptr ||
+          (this->arbitration == PROXY_ARBITRATION_PRIORITY && client->priority > selected->priority) ||
+          ((this->arbitration != PROXY_ARBITRATION_PRIORITY || client->priority == selected->priority) &&
+           client->frames.front().sequence < selected->frames.front().sequence))
+      {
+        selected = client;
+      }
+    }
+    if (selected == nullptr) break;
+    VirtualSerialProxyFrame &frame = selected->frames.front();
+    if (this->reactor->writeData(this->dev, frame.data) == 2){
+      /* the device has failed, the unit is lost */
+      pthread_mutex_lock(&(this->mtx));
+      this->stats[PROXY_DIRECTION_PTY_TO_DEVICE].dropped += frame.data.size();
+      pthread_mutex_unlock(&(this->mtx));
+    }
+    else {
+      this->updateStats(PROXY_DIRECTION_PTY_TO_DEVICE, frame.data.size(), getElapsedUs(frame.tsQueued));
+    }
+    selected->queuedSize -= frame.data.size();
+    selected->frames.pop_front();
+  }
+}
+
+/**
+ * @brief Drain callback of the device port.
+ *
+ * @param serial The device port.
+ * @param param The pointer of the `VirtualSerialProxy` object.
+ */
+void VirtualSerialProxy::drainDevice(Serial &serial, void *param){
+  VirtualSerialProxy *proxy = (VirtualSerialProxy *) param;
+  (void) serial;
+  proxy->pumpDevice();
+}
+
+/**
+ * @brief Updates the statistics of a forwarding direction.
+ *
+ * @param direction The forwarding direction.
+ * @param sz The number of forwarded bytes.
+ * @param latencyUs The forwarding latency in microseconds.
+ */
+void VirtualSerialProxy::updateStats(PROXY_DIRECTION direction, size_t sz, unsigned long long latencyUs){
+  pthread_mutex_lock(&(this->mtx));
+  this->stats[direction].bytes += sz;
+  this->stats[direction].chunks++;
+  this->stats[direction].totalLatencyUs += latencyUs;
+  if (latencyUs > this->stats[direction].maxLatencyUs) this->stats[direction].maxLatencyUs = latencyUs;
+  pthread_mutex_unlock(&(this->mtx));
+}
+
+/**
+ * @brief Forwards the data in both directions with `splice`.
+ *
+ * Each direction has its own pipe. The bytes are moved from the source into the pipe and from the pipe into the destination
+ * without being copied to user space. Both file descriptors are switched to non-blocking mode while the loop is running.
+ *
+ * @return `0` if the loop has been stopped by the `stop` method.
+ * @return `1` if a port has been disconnected or an I/O error occurs.
+ * @return `2` if `splice` is not supported for the ports (nothing has been forwarded).
+ */
+int VirtualSerialProxy::spliceLoop(){
+  /* direction 0 : device -> pty, direction 1 : pty -> device */
+  int fds[2] = {this->dev->getFileDescriptor(), this->pty->getFileDescriptor()};
+  int pipes[2][2] = {{-1, -1}, {-1, -1}};
+  int flags[2] = {0, 0};
+  size_t pending[2] = {0, 0};
+  size_t capacity[2] = {0, 0};
+  unsigned int interest[2] = {0, 0};
+  struct epoll_event ev;
+  struct epoll_event events[4];
+  struct timespec tsWakeup;
+  bool isSpliced = false;
+  uint64_t counter = 0;
+  ssize_t bytes = 0;
+  int epollFd = -1;
+  int result = 1;
+  int n = 0;
+  if (fds[0] <= 0 || fds[1] <= 0 || this->eventFd < 0) return 1;
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (epollFd < 0) return 1;
+  for (int i = 0; i < 2; i++){
+    if (pipe2(pipes[i], O_NONBLOCK | O_CLOEXEC) != 0){
+      result = 1;
+      goto cleanup;
+    }
+    fcntl(pipes[i][1], F_SETPIPE_SZ, 65536);
+    capacity[i] = static_cast<size_t>(fcntl(pipes[i][1], F_GETPIPE_SZ));
+    flags[i] = fcntl(fds[i], F_GETFL, 0);
+    fcntl(fds[i], F_SETFL, flags[i] | O_NONBLOCK);
+    ev.events = EPOLLIN;
+    ev.data.u32 = static_cast<uint32_t>(i);
+    interest[i] = EPOLLIN;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, fds[i], &ev);
+  }
+  /* discard a stop request that has been left by a previous run */
+  if (read(this->eventFd, &counter, sizeof(counter)) < 0) counter = 0;
+  ev.events = EPOLLIN;
+  ev.data.u32 = 2;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, this->eventFd, &ev);
+  while (true){
+    /* wait for input only while the pipe has room, and for output only while the pipe holds data */
+    for (int i = 0; i < 2; i++){
+      unsigned int wanted = (pending[i] < capacity[i] ? static_cast<unsigned int>(EPOLLIN) : 0U) |
+                            (pending[1 - i] > 0 ? static_cast<unsigned int>(EPOLLOUT) : 0U);
+      if (wanted != interest[i]){
+        ev.events = wanted;
+        ev.data.u32 = static_cast<uint32_t>(i);
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, fds[i], &ev);
+        interest[i] = wanted;
+      }
+    }
+    n = epoll_wait(epollFd, events, 4, -1);
+    if (n < 0){
+      if (errno == EINTR) continue;
+      result = 1;
+      break;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &tsWakeup);
+    for (int i = 0; i < n; i++){
+      if (events[i].data.u32 == 2){
+        result = 0;
+        goto cleanup;
+      }
+    }
+    for (int d = 0; d < 2; d++){
+      while (pending[d] < capacity[d]){
+        bytes = splice(fds[d], NULL, pipes[d][1], NULL, capacity[d] - pending[d], SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (bytes > 0){
+          pending[d] += static_cast<size_t>(bytes);
+          isSpliced = true;
+        }
+        else if (bytes < 0 && errno == EINTR){
+          continue;
+        }
+        else if (bytes < 0 && errno == EAGAIN){
+          break;
+        }
+        else {
+          result = ((bytes < 0 && isSpliced == false && (errno == EINVAL || errno == ENOSYS)) ? 2 : 1);
+          goto cleanup;
+        }
+      }
+      while (pending[d] > 0){
+        bytes = splice(pipes[d][0], NULL, fds[1 - d], NULL, pending[d], SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (bytes > 0){
+          pending[d] -= static_cast<size_t>(bytes);
+          this->updateStats((d == 0 ? PROXY_DIRECTION_DEVICE_TO_PTY : PROXY_DIRECTION_PTY_TO_DEVICE), static_cast<size_t>(bytes), getElapsedUs(tsWakeup));
+        }
+        else if (bytes < 0 && errno == EINTR){
+          continue;
+        }
+        else if (bytes < 0 && errno == EAGAIN){
+          break;
+        }
+        else {
+          result = ((bytes < 0 && isSpliced == false && (errno == EINVAL || errno == ENOSYS)) ? 2 : 1);
+          goto cleanup;
+        }
+      }
+    }
+  }
+cleanup:
+  for (int i = 0; i < 2; i++){
+    if (pipes[i][0] >= 0) close(pipes[i][0]);
+    if (pipes[i][1] >= 0) close(pipes[i][1]);
+    if (interest[i] != 0) fcntl(fds[i], F_SETFL, flags[i]);
+  }
+  close(epollFd);
+  return result;
+}
+
 /**
  * @brief Method to start the proxy.
  *
@@ -252,8 +834,9 @@ void *VirtualSerialProxy::getPassThroughParam(){
  * @return `true` if the Pass Through function has been successfully executed.
  */
 bool VirtualSerialProxy::begin(){
-  if (this->passthroughFunc == nullptr) return false;
-  void (*callback)(Serial &, Serial &, void *) = (void (*)(Serial &, Serial &, void *))this->passthroughFunc;
+  bool success = false;
+  bool isReactorMode = true;
+  struct termios tty;
   if (this->dev->openPort() != 0){
     std::cout << "Failed to open " << this->dev->getPort() << std::endl;
     return false;
@@ -269,34 +852,70 @@ bool VirtualSerialProxy::begin(){
   else {
     this->pty->setPort(this->pty->getVirtualPortName());
   }
-  fd_set readfds;
-  int max = 0;
-  int ret = 0;
-  struct timeval tv;
-  while (true) {
-    tv.tv_sec = 1;
-    tv.tv_usec = 500000;
-    FD_ZERO(&readfds);
-    if (this->dev->getFileDescriptor() > 0) FD_SET(this->dev->getFileDescriptor(), &readfds);
-    if (this->pty->getFileDescriptor() > 0) FD_SET(this->pty->getFileDescriptor(), &readfds);
-    max = (this->dev->getFileDescriptor() > this->pty->getFileDescriptor() ? this->dev->getFileDescriptor() : this->pty->getFileDescriptor());
-    if (max > 0){
-      ret = select(max + 1 , &readfds , NULL , NULL , &tv);
-      if (ret >= 0){
-        if (FD_ISSET(this->dev->getFileDescriptor(), &readfds)){
-          callback(*(this->dev), *(this->pty), this->passthroughParam);
-        }
-        else if (FD_ISSET(this->pty->getFileDescriptor(), &readfds)){
-          callback(*(this->pty), *(this->dev), this->passthroughParam);
-        }
-      }
-      else {
-        usleep(125000);
+  for (size_t i = 0; i < this->clients.size(); i++){
+    VirtualSerialProxyClient *client = this->clients[i];
+    if (client->pty != this->pty) client->pty->setPort(client->pty->getVirtualPortName());
+    client->pending.clear();
+    client->frames.clear();
+    client->queuedSize = 0;
+    client->isResyncing = false;
+    /* keep the slave side open, so the master does not report a hang-up while no application is connected */
+    client->holdFd = open(client->pty->getVirtualPortName().c_str(), O_RDWR | O_NOCTTY);
+    if (client->holdFd >= 0 && tcgetattr(client->holdFd, &tty) == 0){
+      cfmakeraw(&tty);
+      tcsetattr(client->holdFd, TCSANOW, &tty);
+    }
+  }
+  this->resetStats();
+  if (this->isSpliceMode && this->passthroughFunc == nullptr && this->clients.size() == 1){
+    int ret = this->spliceLoop();
+    if (ret != 2){
+      success = (ret == 0);
+      isReactorMode = false;
+    }
+    else {
+      std::cout << "splice is not supported, using the normal forwarding loop" << std::endl;
+    }
+  }
+  if (isReactorMode){
+    bool isRegistered = (this->reactor->addPort(this->dev, &VirtualSerialProxy::forwardData, (void *) this) == 0);
+    if (isRegistered) this->reactor->setDrainCallback(this->dev, &VirtualSerialProxy::drainDevice, (void *) this);
+    for (size_t i = 0; i < this->clients.size() && isRegistered; i++){
+      isRegistered = (this->reactor->addPort((Serial *) this->clients[i]->pty, &VirtualSerialProxy::forwardData, (void *) this) == 0);
+    }
+    if (isRegistered){
+      if (this->passthroughFunc != nullptr && this->clients.size() == 1){
+        /* the Pass Through function runs on the proxy loop, so its writes must not wait for the port */
+        this->dev->setWriteHandler((const void *) &VirtualSerialProxy::queueWrite, (void *) this);
+        this->pty->setWriteHandler((const void *) &VirtualSerialProxy::queueWrite, (void *) this);
       }
+      success = this->reactor->begin();
+      this->dev->setWriteHandler(nullptr, nullptr);
+      this->pty->setWriteHandler(nullptr, nullptr);
     }
     else {
-      usleep(250000);
+      std::cout << "Failed to start the proxy loop" << std::endl;
     }
+    this->reactor->removePort(this->dev);
+    for (size_t i = 0; i < this->clients.size(); i++){
+      this->reactor->removePort((Serial *) this->clients[i]->pty);
+    }
+  }
+  for (size_t i = 0; i < this->clients.size(); i++){
+    if (this->clients[i]->holdFd >= 0) close(this->clients[i]->holdFd);
+    this->clients[i]->holdFd = -1;
   }
-  return true;
-}
\ No newline at end of file
+  this->dev->closePort();
+  return success;
+}
+
+/**
+ * @brief Stops the proxy.
+ *
+ * This method is thread safe. The `begin` method returns after the current events have been processed.
+ */
+void VirtualSerialProxy::stop(){
+  uint64_t counter = 1;
+  this->reactor->stop();
+  if (write(this->eventFd, &counter, sizeof(counter)) < 0) counter = 0;
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <string.h>
+#include <unistd.h>
+#include "command-router.hpp"
+#include "virtuser.hpp"
+
+typedef struct _RouterTestContext {
+    pthread_mutex_t mtx;
+    std::vector <std::string> calls;
+    unsigned int delayMs;
+} RouterTestContext;
+
+static void routerHandler(CommandRouter &router, const CommandRouterFrame &frame, void *param){
+    RouterTestContext *ctx = (RouterTestContext *) param;
+    ByteView data = router.getField(frame, DataFrame::FRAME_TYPE_DATA);
+    if (ctx->delayMs > 0) usleep(ctx->delayMs * 1000);
+    pthread_mutex_lock(&(ctx->mtx));
+    ctx->calls.push_back(std::to_string(frame.command) + ":" + std::string(data.begin(), data.end()));
+    pthread_mutex_unlock(&(ctx->mtx));
+}
+
+static void routerDefaultHandler(CommandRouter &router, const CommandRouterFrame &frame, void *param){
+    RouterTestContext *ctx = (RouterTestContext *) param;
+    (void) router;
+    pthread_mutex_lock(&(ctx->mtx));
+    ctx->calls.push_back("default:" + std::to_string(frame.command));
+    pthread_mutex_unlock(&(ctx->mtx));
+}
+
+class SerialinkCommandRouterTest:public::testing::Test {
+protected:
+    VirtualSerial master;
+    Serialink slave;
+    RouterTestContext ctx;
+    SerialinkCommandRouterTest() : master(B115200, 10, 50) {}
+    void SetUp() override {
+        pthread_mutex_init(&(ctx.mtx), NULL);
+        ctx.delayMs = 0;
+        slave.setPort(master.getVirtualPortName());
+        slave.setBaudrate(B115200);
+        slave.setTimeout(25);
+        slave.setKeepAlive(100);
+    }
+
+    void TearDown() override {
+        // tidak ada kebutuhan post-set
+    }
+};
+
+TEST_F(SerialinkCommandRouterTest, TableAndMapCommands) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "\x02");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 2);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "\x03");
+    slave = startBytes + cmdBytes + dataBytes + stopBytes;
+    Serialink unformatted;
+    CommandRouter router(slave);
+    ASSERT_EQ(CommandRouter(unformatted).dispatch(8), 3);
+    ASSERT_EQ(router.setHandler(5, (const void *) &routerHandler, &ctx), 0);
+    ASSERT_EQ(router.setHandler(0x0102, (const void *) &routerHandler, &ctx), 0);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(master.writeData(std::string("\x02\x00\x05" "ab\x03\x02\x01\x02" "cd\x03\x02\x00\x09" "ef\x03", 18)), 0);
+    ASSERT_EQ(router.dispatch(8), 0);
+    /* the command without handler is dropped */
+    ASSERT_EQ(ctx.calls, std::vector <std::string>({"5:ab", "258:cd"}));
+    ASSERT_EQ(router.getStats(9).frames, 1);
+    ASSERT_EQ(router.getStats(9).dropped, 1);
+    router.setDefaultHandler((const void *) &routerDefaultHandler, &ctx);
+    ASSERT_EQ(master.writeData(std::string("\x02\x00\x09" "gh\x03\x02\x01\x02" "ij\x03", 12)), 0);
+    ASSERT_EQ(router.dispatch(8), 0);
+    ASSERT_EQ(ctx.calls, std::vector <std::string>({"5:ab", "258:cd", "default:9", "258:ij"}));
+    ASSERT_EQ(router.getStats(5).frames, 1);
+    ASSERT_EQ(router.getStats(0x0102).frames, 2);
+    ASSERT_EQ(router.getStats(0x0102).dropped, 0);
+    ASSERT_GT(router.getStats(0x0102).elapsedSec, 0.0);
+    ASSERT_EQ(router.getStats().frames, 5);
+    ASSERT_EQ(router.getStats().dropped, 1);
+    router.resetStats();
+    ASSERT_EQ(router.getStats(0x0102).frames, 0);
+    ASSERT_EQ(router.dispatch(8), 2);
+}
+
+TEST_F(SerialinkCommandRouterTest, OrderedWorkerPool) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "\x02");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "\x03");
+    slave = startBytes + cmdBytes + dataBytes + stopBytes;
+    CommandRouter router(slave);
+    std::string burst;
+    for (int i = 0; i < 6; i++){
+        burst += std::string("\x02") + (i % 2 == 0 ? "A" : "B") + std::to_string(i) + "\x03";
+    }
+    ctx.delayMs = 20;
+    ASSERT_EQ(router.setHandler('A', (const void *) &routerHandler, &ctx), 0);
+    ASSERT_EQ(router.setHandler('B', (const void *) &routerHandler, &ctx), 0);
+    ASSERT_EQ(router.start(0, 4, true), 4);
+    ASSERT_EQ(router.start(3, 0, true), 4);
+    ASSERT_EQ(router.start(3, 4, true), 0);
+    ASSERT_EQ(router.start(3, 4, true), 4);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(master.writeData(burst), 0);
+    /* the reader does not wait for the handlers, the frames beyond the queue limit are dropped */
+    ASSERT_EQ(router.dispatch(8), 0);
+    ASSERT_LE(router.getQueuedCount(), 4);
+    router.stop();
+    ASSERT_EQ(router.getQueuedCount(), 0);
+    ASSERT_EQ(router.getStats().frames, 6);
+    ASSERT_GE(router.getStats().dropped, 1);
+    ASSERT_EQ(ctx.calls.size() + router.getStats().dropped, 6);
+    /* the handled frames keep the order of the port */
+    for (size_t i = 1; i < ctx.calls.size(); i++){
+        ASSERT_LT(ctx.calls[i - 1].substr(3), ctx.calls[i].substr(3));
+    }
+    ASSERT_GE(router.getStats('A').maxLatencyUs, 20000);
+    ASSERT_EQ(router.getStats('A').frames + router.getStats('B').frames, 6);
+}
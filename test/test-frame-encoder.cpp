@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <string.h>
+#include "frame-encoder.hpp"
+#include "virtuser.hpp"
+
+extern void callbackEcho(VirtualSerial &ser, void *param);
+
+static std::vector <unsigned char> toVector(ByteView view){
+    return std::vector <unsigned char>(view.begin(), view.end());
+}
+
+class SerialinkFrameEncoderTest:public::testing::Test {
+protected:
+    VirtualSerial master;
+    SerialinkFrameEncoderTest() : master(B115200, 10, 50) {}
+    void SetUp() override {
+        master.setCallback((const void *) &callbackEcho, nullptr);
+    }
+
+    void TearDown() override {
+        // tidak ada kebutuhan post-set
+    }
+};
+
+TEST_F(SerialinkFrameEncoderTest, FormatNotSetUp) {
+    FrameEncoder encoder;
+    ASSERT_EQ(encoder.setField(DataFrame::FRAME_TYPE_DATA, (const unsigned char *) "abc", 3), 3);
+    ASSERT_EQ(encoder.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE), 3);
+    ASSERT_EQ(encoder.encode().size(), 0);
+    ASSERT_EQ(encoder.appendToBatch(), 3);
+}
+
+TEST_F(SerialinkFrameEncoderTest, PatchFieldsAndChecksum) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame crcBytes(DataFrame::FRAME_TYPE_VALIDATOR, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    FrameEncoder encoder(startBytes + cmdBytes + dataBytes + crcBytes + stopBytes);
+    /* the validator is inside the range, or does not have the checksum size */
+    ASSERT_EQ(encoder.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_STOP_BYTES, SERIALINK_ENDIAN_LITTLE), 4);
+    ASSERT_EQ(encoder.setChecksum(CHECKSUM_TYPE_CRC32, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE), 4);
+    ASSERT_EQ(encoder.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_START_BYTES, SERIALINK_ENDIAN_LITTLE), 4);
+    ASSERT_EQ(encoder.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE), 0);
+    /* the constant parts are rendered once */
+    ASSERT_EQ(toVector(encoder.encode()), std::vector <unsigned char>({'1', '2', '3', '4', 0x00, 0x9A, 0x32, '9', '0', '-', '='}));
+    ASSERT_EQ(encoder.setField(DataFrame::FRAME_TYPE_COMMAND, (const unsigned char *) "56", 2), 4);
+    ASSERT_EQ(encoder.setField(DataFrame::FRAME_TYPE_START_BYTES, (const unsigned char *) "abcd", 4), 4);
+    ASSERT_EQ(encoder.setField(DataFrame::FRAME_TYPE_SN, (const unsigned char *) "5", 1), 4);
+    ASSERT_EQ(encoder.setField(DataFrame::FRAME_TYPE_COMMAND, (const unsigned char *) "5", 1), 0);
+    ASSERT_EQ(encoder.setField(DataFrame::FRAME_TYPE_DATA, (const unsigned char *) "678", 3), 0);
+    /* CRC16/XMODEM of "12345678" is 0x9015 */
+    ASSERT_EQ(toVector(encoder.encode()), std::vector <unsigned char>({'1', '2', '3', '4', '5', '6', '7', '8', 0x15, 0x90, '9', '0', '-', '='}));
+    /* the data field shrinks and grows in place */
+    ASSERT_EQ(encoder.setField(DataFrame::FRAME_TYPE_DATA, (const unsigned char *) "6", 1), 0);
+    ASSERT_EQ(encoder.encode().size(), 12);
+    ASSERT_EQ(encoder.setField(DataFrame::FRAME_TYPE_DATA, ByteView((const unsigned char *) "678", 3)), 0);
+    ASSERT_EQ(toVector(encoder.encode()), std::vector <unsigned char>({'1', '2', '3', '4', '5', '6', '7', '8', 0x15, 0x90, '9', '0', '-', '='}));
+}
+
+TEST_F(SerialinkFrameEncoderTest, DuplicateFieldsAndConstantData) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "\x02");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, "AB");
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "\x03");
+    FrameEncoder encoder(startBytes + cmdBytes + dataBytes + dataBytes + stopBytes);
+    ASSERT_EQ(toVector(encoder.encode()), std::vector <unsigned char>({0x02, 'A', 'B', 0x00, 0x00, 0x00, 0x00, 0x03}));
+    ASSERT_EQ(encoder.setField(std::pair <DataFrame::FRAME_TYPE_t, int>(DataFrame::FRAME_TYPE_DATA, 1), (const unsigned char *) "cd", 2), 0);
+    ASSERT_EQ(encoder.setField(std::pair <DataFrame::FRAME_TYPE_t, int>(DataFrame::FRAME_TYPE_DATA, 2), (const unsigned char *) "ef", 2), 4);
+    ASSERT_EQ(toVector(encoder.encode()), std::vector <unsigned char>({0x02, 'A', 'B', 0x00, 0x00, 'c', 'd', 0x03}));
+}
+
+TEST_F(SerialinkFrameEncoderTest, BatchRoundTrip) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame crcBytes(DataFrame::FRAME_TYPE_VALIDATOR, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    DataFrame format = startBytes + cmdBytes + dataBytes + crcBytes + stopBytes;
+    FrameEncoder encoder(format);
+    Serialink slave;
+    ASSERT_EQ(encoder.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE), 0);
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    slave = format;
+    ASSERT_EQ(slave.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_COMMAND, {{0x35, 3}, {0x36, 2}}, 1, SERIALINK_ENDIAN_BIG), 0);
+    ASSERT_EQ(slave.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE), 0);
+    encoder.setField(DataFrame::FRAME_TYPE_COMMAND, (const unsigned char *) "5", 1);
+    encoder.setField(DataFrame::FRAME_TYPE_DATA, (const unsigned char *) "678", 3);
+    ASSERT_EQ(encoder.appendToBatch(), 0);
+    encoder.setField(DataFrame::FRAME_TYPE_COMMAND, (const unsigned char *) "6", 1);
+    encoder.setField(DataFrame::FRAME_TYPE_DATA, (const unsigned char *) "ab", 2);
+    ASSERT_EQ(encoder.appendToBatch(), 0);
+    encoder.setField(DataFrame::FRAME_TYPE_DATA, (const unsigned char *) "cd", 2);
+    ASSERT_EQ(encoder.appendToBatch(), 0);
+    ASSERT_EQ(encoder.getBatch().size(), 14 + 13 + 13);
+    ASSERT_EQ(slave.openPort(), 0);
+    /* the three frames are sent with one write */
+    ASSERT_EQ(slave.writeData(encoder.getBatch()), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'6', '7', '8'}));
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'a', 'b'}));
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'c', 'd'}));
+    encoder.clearBatch();
+    ASSERT_EQ(encoder.getBatch().size(), 0);
+    ASSERT_NE(slave.readFramedData(), 0);
+}
+
+TEST_F(SerialinkFrameEncoderTest, LengthBinding) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "\x02");
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH, 2);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "\x03");
+    DataFrame format = startBytes + lengthBytes + dataBytes + stopBytes;
+    FrameEncoder encoder(format);
+    Serialink slave;
+    /* the source must be a fixed-size field before the target, wide enough for the length */
+    ASSERT_EQ(encoder.bindLength(DataFrame::FRAME_TYPE_CONTENT_LENGTH, DataFrame::FRAME_TYPE_DATA, 1, SERIALINK_ENDIAN_BIG, 0, 1), 4);
+    ASSERT_EQ(encoder.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_CONTENT_LENGTH, 3, SERIALINK_ENDIAN_BIG, 0, 1), 4);
+    ASSERT_EQ(encoder.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_CONTENT_LENGTH, 2, SERIALINK_ENDIAN_BIG, 0, 0), 4);
+    /* the current (empty) data field cannot be declared with a negative length */
+    ASSERT_EQ(encoder.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_CONTENT_LENGTH, 2, SERIALINK_ENDIAN_BIG, 2, 1), 4);
+    /* the length includes the stop byte */
+    ASSERT_EQ(encoder.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_CONTENT_LENGTH, 2, SERIALINK_ENDIAN_BIG, -1, 1), 0);
+    ASSERT_EQ(toVector(encoder.encode()), std::vector <unsigned char>({0x02, 0x00, 0x01, 0x03}));
+    ASSERT_EQ(encoder.setField(DataFrame::FRAME_TYPE_DATA, (const unsigned char *) "abc", 3), 0);
+    ASSERT_EQ(toVector(encoder.encode()), std::vector <unsigned char>({0x02, 0x00, 0x04, 'a', 'b', 'c', 0x03}));
+    /* the length of the received frame matches the data */
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    slave = format;
+    ASSERT_EQ(slave.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_CONTENT_LENGTH, 2, SERIALINK_ENDIAN_BIG, -1, 1), 0);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(encoder.appendToBatch(), 0);
+    ASSERT_EQ(encoder.setField(DataFrame::FRAME_TYPE_DATA, (const unsigned char *) "de", 2), 0);
+    ASSERT_EQ(encoder.appendToBatch(), 0);
+    ASSERT_EQ(slave.writeData(encoder.getBatch()), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'a', 'b', 'c'}));
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'d', 'e'}));
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <string.h>
+#include "frame-layout.hpp"
+#include "virtuser.hpp"
+
+extern void callbackEcho(VirtualSerial &ser, void *param);
+
+using namespace FrameLayout;
+
+typedef StartBytes <'1', '2', '3', '4'> TableStart;
+typedef Data <LenTable <Cmd <1>, LenEntry <0x35, 3>, LenEntry <0x36, 2> > > TableData;
+typedef Frame <
+    TableStart,
+    Cmd <1>,
+    TableData,
+    Crc <CHECKSUM_TYPE_CRC16_XMODEM, TableStart, TableData, SERIALINK_ENDIAN_LITTLE>,
+    StopBytes <'9', '0', '-', '='>
+> TableProtocol;
+
+typedef Data <LenFrom <ContentLength <2>, SERIALINK_ENDIAN_LITTLE, -1, 1> > LengthData;
+typedef Field <DataFrame::FRAME_TYPE_DATA_1, UntilStop> LengthText;
+typedef Frame <
+    StartBytes <0x02>,
+    ContentLength <2>,
+    LengthData,
+    LengthText,
+    StopBytes <0x03>
+> LengthProtocol;
+
+static std::vector <unsigned char> toVector(ByteView view){
+    return std::vector <unsigned char>(view.begin(), view.end());
+}
+
+class SerialinkFrameLayoutTest:public::testing::Test {
+protected:
+    VirtualSerial master;
+    SerialinkFrameLayoutTest() : master(B115200, 10, 50) {}
+    void SetUp() override {
+        master.setCallback((const void *) &callbackEcho, nullptr);
+    }
+
+    void TearDown() override {
+        // tidak ada kebutuhan post-set
+    }
+};
+
+TEST_F(SerialinkFrameLayoutTest, LengthTableAndChecksum) {
+    ByteView frame;
+    std::vector <unsigned char> corrupt;
+    FramedSerial <TableProtocol> slave(master.getVirtualPortName(), B115200, 25);
+    slave.setKeepAlive(1000);
+    ASSERT_EQ(slave.get<TableData>().size(), 0);
+    slave.set<Cmd <1> >((const unsigned char *) "5", 1);
+    slave.set<TableData>((const unsigned char *) "678", 3);
+    ASSERT_EQ(slave.encodeFrame(frame), 0);
+    /* CRC16/XMODEM of "12345678" is 0x9015 */
+    ASSERT_EQ(toVector(frame), std::vector <unsigned char>({'1', '2', '3', '4', '5', '6', '7', '8', 0x15, 0x90, '9', '0', '-', '='}));
+    corrupt = toVector(frame);
+    corrupt[6] = 'x';
+    /* the command declares 3 bytes */
+    slave.set<TableData>((const unsigned char *) "78", 2);
+    ASSERT_EQ(slave.encodeFrame(frame), 4);
+    ASSERT_EQ(slave.openPort(), 0);
+    slave.set<TableData>((const unsigned char *) "678", 3);
+    ASSERT_EQ(slave.writeFrame(), 0);
+    ASSERT_EQ(slave.writeData(corrupt), 0);
+    slave.set<Cmd <1> >((const unsigned char *) "6", 1);
+    slave.set<TableData>((const unsigned char *) "7z", 2);
+    ASSERT_EQ(slave.writeFrame(), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFrame(), 0);
+    ASSERT_EQ(toVector(slave.get<Cmd <1> >()), std::vector <unsigned char>({'5'}));
+    ASSERT_EQ(toVector(slave.get<TableData>()), std::vector <unsigned char>({'6', '7', '8'}));
+    ASSERT_EQ(slave.getDataSize(), 14);
+    ASSERT_EQ(slave.readFrame(), 4);
+    ASSERT_EQ(slave.get<TableData>().size(), 0);
+    ASSERT_EQ(slave.readFrame(), 0);
+    ASSERT_EQ(toVector(slave.get<TableData>()), std::vector <unsigned char>({'7', 'z'}));
+    ASSERT_EQ(slave.readFrame(), 2);
+}
+
+TEST_F(SerialinkFrameLayoutTest, LengthFieldAndUntilStopBytes) {
+    ByteView frame;
+    std::vector <unsigned char> encoded;
+    FramedSerial <LengthProtocol> slave;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    slave.set<LengthData>((const unsigned char *) "abc", 3);
+    slave.set<LengthText>((const unsigned char *) "hello", 5);
+    /* the content length is filled in: 3 bytes + 1 */
+    ASSERT_EQ(slave.encodeFrame(frame), 0);
+    encoded = toVector(frame);
+    ASSERT_EQ(encoded, std::vector <unsigned char>({0x02, 0x04, 0x00, 'a', 'b', 'c', 'h', 'e', 'l', 'l', 'o', 0x03}));
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(slave.writeData("xx"), 0);
+    ASSERT_EQ(slave.writeFrame(), 0);
+    slave.set<LengthData>(ByteView());
+    slave.set<LengthText>((const unsigned char *) "\x02", 1);
+    ASSERT_EQ(slave.writeFrame(), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFrame(), 0);
+    ASSERT_EQ(toVector(slave.get<LengthData>()), std::vector <unsigned char>({'a', 'b', 'c'}));
+    ASSERT_EQ(toVector(slave.get<LengthText>()), std::vector <unsigned char>({'h', 'e', 'l', 'l', 'o'}));
+    ASSERT_EQ(toVector(slave.get<StopBytes <0x03> >()), std::vector <unsigned char>({0x03}));
+    ASSERT_EQ(slave.getBufferAsVector(), encoded);
+    /* an empty data field, and a text that contains the start byte */
+    ASSERT_EQ(slave.readFrame(), 0);
+    ASSERT_EQ(slave.get<LengthData>().size(), 0);
+    ASSERT_EQ(toVector(slave.get<LengthText>()), std::vector <unsigned char>({0x02}));
+    ASSERT_EQ(slave.getBufferAsVector(), std::vector <unsigned char>({0x02, 0x01, 0x00, 0x02, 0x03}));
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <string.h>
+#include "frame-parser.hpp"
+
+typedef struct _ParserTestContext {
+    std::vector <std::vector <unsigned char> > frames;
+    std::vector <std::vector <unsigned char> > data;
+    std::vector <int> results;
+} ParserTestContext;
+
+static void parserFrame(FrameParser &parser, int ret, const unsigned char *frame, size_t sz, void *param){
+    ParserTestContext *ctx = (ParserTestContext *) param;
+    ctx->results.push_back(ret);
+    ctx->frames.push_back(std::vector <unsigned char>(frame, frame + sz));
+    if (ret == 0 && parser[DataFrame::FRAME_TYPE_DATA] != nullptr){
+        ctx->data.push_back(parser[DataFrame::FRAME_TYPE_DATA]->getDataAsVector());
+    }
+}
+
+static void parserLengthByCommand(DataFrame &frame, void *ptr){
+    unsigned char cmd = 0x00;
+    FrameParser *parser = (FrameParser *) ptr;
+    DataFrame *target = frame.getNext();
+    frame.getData(&cmd, 1);
+    if (cmd == 'a') target->setSize(2);
+    else if (cmd == 'b') target->setSize(4);
+    else parser->trigInvDataIndicator();
+}
+
+class SerialinkFrameParserTest:public::testing::Test {
+protected:
+    ParserTestContext ctx;
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+        // tidak ada kebutuhan post-set
+    }
+};
+
+TEST_F(SerialinkFrameParserTest, FormatNotSetUp) {
+    FrameParser parser;
+    ASSERT_EQ(parser.getFormat(), nullptr);
+    ASSERT_EQ(parser.feed((const unsigned char *) "1234", 4), 3);
+}
+
+TEST_F(SerialinkFrameParserTest, FeedByteByByte) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    FrameParser parser(startBytes + dataBytes + stopBytes);
+    const char *stream = "xx1234hello90-=yy1234world90-=12";
+    parser.setCallback(&parserFrame, &ctx);
+    for (size_t i = 0; i < strlen(stream); i++){
+        ASSERT_EQ(parser.feed((const unsigned char *) stream + i, 1), 0);
+    }
+    ASSERT_EQ(ctx.results.size(), 2);
+    ASSERT_EQ(ctx.results[0], 0);
+    ASSERT_EQ(ctx.results[1], 0);
+    ASSERT_EQ(ctx.frames[0], std::vector <unsigned char>({'1', '2', '3', '4', 'h', 'e', 'l', 'l', 'o', '9', '0', '-', '='}));
+    ASSERT_EQ(ctx.data[0], std::vector <unsigned char>({'h', 'e', 'l', 'l', 'o'}));
+    ASSERT_EQ(ctx.data[1], std::vector <unsigned char>({'w', 'o', 'r', 'l', 'd'}));
+    ASSERT_EQ(parser.getPendingSize(), 2);
+    parser.reset();
+    ASSERT_EQ(parser.getPendingSize(), 0);
+}
+
+TEST_F(SerialinkFrameParserTest, RejectAndResync) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "12");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "9");
+    FrameParser parser;
+    parser = startBytes + cmdBytes + stopBytes;
+    parser.setCallback(&parserFrame, &ctx);
+    /* the first frame has a wrong stop byte, the second frame starts inside the rejected one */
+    ASSERT_EQ(parser.feed(std::vector <unsigned char>({'1', '2', '1', '2', 'x', '9'})), 0);
+    ASSERT_EQ(ctx.results.size(), 2);
+    ASSERT_EQ(ctx.results[0], 4);
+    ASSERT_EQ(ctx.frames[0], std::vector <unsigned char>({'1', '2', '1', '2'}));
+    ASSERT_EQ(ctx.results[1], 0);
+    ASSERT_EQ(ctx.frames[1], std::vector <unsigned char>({'1', '2', 'x', '9'}));
+    ASSERT_EQ(parser[DataFrame::FRAME_TYPE_COMMAND]->getDataAsVector(), std::vector <unsigned char>({'x'}));
+    ASSERT_EQ(parser.getPendingSize(), 0);
+}
+
+TEST_F(SerialinkFrameParserTest, LengthByCallback) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    FrameParser parser;
+    cmdBytes.setPostExecuteFunction((const void *) &parserLengthByCommand, &parser);
+    parser = startBytes + cmdBytes + dataBytes + stopBytes;
+    parser.setCallback(&parserFrame, &ctx);
+    ASSERT_EQ(parser.feed((const unsigned char *) "1234aXY90", 9), 0);
+    ASSERT_EQ(ctx.results.size(), 0);
+    ASSERT_EQ(parser.feed((const unsigned char *) "-=1234bWXYZ90-=1234c", 20), 0);
+    ASSERT_EQ(ctx.results.size(), 3);
+    ASSERT_EQ(ctx.results[0], 0);
+    ASSERT_EQ(ctx.data[0], std::vector <unsigned char>({'X', 'Y'}));
+    ASSERT_EQ(ctx.results[1], 0);
+    ASSERT_EQ(ctx.data[1], std::vector <unsigned char>({'W', 'X', 'Y', 'Z'}));
+    ASSERT_EQ(ctx.results[2], 4);
+    ASSERT_EQ(ctx.frames[2], std::vector <unsigned char>({'1', '2', '3', '4', 'c'}));
+}
+
+TEST_F(SerialinkFrameParserTest, NoSerialinkBindings) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame fixedBytes(DataFrame::FRAME_TYPE_DATA, 5);
+    DataFrame crcBytes(DataFrame::FRAME_TYPE_VALIDATOR, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    FrameParser parser(startBytes + fixedBytes + crcBytes + stopBytes);
+    FrameParser lengthParser(startBytes + lengthBytes + dataBytes + crcBytes + stopBytes);
+    parser.setCallback(&parserFrame, &ctx);
+    lengthParser.setCallback(&parserFrame, &ctx);
+    /* the validator is not checked, a frame with a wrong checksum is delivered as a valid frame */
+    ASSERT_EQ(parser.feed((const unsigned char *) "1234hello\x00\x00" "90-=", 15), 0);
+    ASSERT_EQ(ctx.results.size(), 1);
+    ASSERT_EQ(ctx.results[0], 0);
+    ASSERT_EQ(ctx.data[0], std::vector <unsigned char>({'h', 'e', 'l', 'l', 'o'}));
+    /* without a post-execution function, the size of the data cannot be taken from the length field */
+    ASSERT_EQ(lengthParser.feed((const unsigned char *) "1234\x02hi\x00\x00" "90-=", 12), 0);
+    ASSERT_EQ(ctx.results.size(), 2);
+    ASSERT_EQ(ctx.results[1], 4);
+}
+
+TEST_F(SerialinkFrameParserTest, FrameLargerThanCapacity) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "<");
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, ">");
+    FrameParser parser(startBytes + dataBytes + stopBytes);
+    std::vector <unsigned char> stream(1, '<');
+    parser.setCapacity(64);
+    parser.setCallback(&parserFrame, &ctx);
+    stream.insert(stream.end(), 100, 'a');
+    stream.insert(stream.end(), {'>', '<', 'o', 'k', '>'});
+    ASSERT_EQ(parser.feed(stream), 0);
+    ASSERT_EQ(ctx.results.size(), 2);
+    ASSERT_EQ(ctx.results[0], 4);
+    ASSERT_EQ(ctx.frames[0].size(), 64);
+    ASSERT_EQ(ctx.results[1], 0);
+    ASSERT_EQ(ctx.data[0], std::vector <unsigned char>({'o', 'k'}));
+}
@@ -276,6 +276,46 @@ TEST_F(SerialinkFramedDataTest, OperatorOverloading_7) {
     ASSERT_EQ(memcmp(tmp.data(), (const unsigned char *) "QWERASDF", 8), 0);
 }
 
+TEST_F(SerialinkFramedDataTest, OperatorOverloading_fieldHandle) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, "5");
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, "678");
+    DataFrame cmdBytes1(DataFrame::FRAME_TYPE_COMMAND, "Q");
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    ASSERT_EQ(slave[0], nullptr);
+    ASSERT_EQ(slave.getHandle(DataFrame::FRAME_TYPE_COMMAND).field, 0);
+    slave = startBytes + cmdBytes + dataBytes + cmdBytes1;
+    SerialinkHandle cmd = slave.getHandle(DataFrame::FRAME_TYPE_COMMAND);
+    SerialinkHandle cmd1 = slave.getHandle({DataFrame::FRAME_TYPE_COMMAND, 1});
+    ASSERT_EQ(cmd.field, 2);
+    ASSERT_EQ(cmd1.field, 4);
+    ASSERT_EQ(slave.getField(cmd), slave[1]);
+    ASSERT_EQ(slave.getField(cmd1), (slave[{DataFrame::FRAME_TYPE_COMMAND, 1}]));
+    ASSERT_EQ(slave.getField(cmd1)->getDataAsVector(), std::vector <unsigned char>({'Q'}));
+    ASSERT_EQ((slave[{DataFrame::FRAME_TYPE_COMMAND, 2}]), nullptr);
+    ASSERT_EQ((slave[{DataFrame::FRAME_TYPE_COMMAND, -1}]), nullptr);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_STOP_BYTES], nullptr);
+    ASSERT_EQ(slave[4], nullptr);
+    ASSERT_EQ(slave[-1], nullptr);
+    /* the handles stay valid when the frame format is extended */
+    slave += stopBytes;
+    ASSERT_EQ(slave.getField(cmd1)->getDataAsVector(), std::vector <unsigned char>({'Q'}));
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_STOP_BYTES], slave[4]);
+    ASSERT_EQ(slave.getHandle(slave[4]).field, 5);
+    *(slave.getFormat()) += stopBytes;
+    ASSERT_EQ(slave[5], (slave[{DataFrame::FRAME_TYPE_STOP_BYTES, 1}]));
+    ASSERT_NE(slave[5], nullptr);
+    /* the handles are not valid after the frame format is replaced */
+    slave = startBytes + dataBytes;
+    ASSERT_EQ(slave.getField(cmd1), nullptr);
+    ASSERT_EQ(slave.getHandle(DataFrame::FRAME_TYPE_COMMAND).field, 0);
+    ASSERT_EQ(slave.getHandle(DataFrame::FRAME_TYPE_DATA).field, 2);
+    /* not even when the new frame format has a field at the same position */
+    slave = startBytes + cmdBytes1 + dataBytes + cmdBytes;
+    ASSERT_EQ(slave.getField(cmd1), nullptr);
+    ASSERT_EQ(slave.getField(slave.getHandle({DataFrame::FRAME_TYPE_COMMAND, 1}))->getDataAsVector(), std::vector <unsigned char>({'5'}));
+}
+
 /* Read Test */
 
 TEST_F(SerialinkFramedDataTest, WriteTest_1) {
@@ -640,6 +680,353 @@ TEST_F(SerialinkFramedDataTest, ReadTest_withUnknownDataSz_1) {
     ASSERT_EQ(memcmp(tmp.data(), (unsigned char *) "qwertyuiopplkjhgfdsaZxcvbh76redcvbnm,mvdswertyuioiuhgfcxvbnm", 60), 0);
 }
 
+TEST_F(SerialinkFramedDataTest, ReadTest_formatChangedBetweenReads) {
+    unsigned char buffer[64];
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    slave = startBytes + dataBytes;
+    *(slave.getFormat()) += stopBytes;
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(slave.writeData("1234abc90-=1234x90-="), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 11);
+    ASSERT_EQ(memcmp(buffer, (const unsigned char *) "1234abc90-=", 11), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'a', 'b', 'c'}));
+    slave = startBytes + cmdBytes + stopBytes;
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 9);
+    ASSERT_EQ(memcmp(buffer, (const unsigned char *) "1234x90-=", 9), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_COMMAND]->getDataAsVector(), std::vector <unsigned char>({'x'}));
+}
+
+TEST_F(SerialinkFramedDataTest, ReadTest_severalFormats) {
+    std::vector <unsigned char> tmp;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    DataFrame stxBytes(DataFrame::FRAME_TYPE_START_BYTES, "\x02");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame etxBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "\x03");
+    DataFrame nmeaBytes(DataFrame::FRAME_TYPE_START_BYTES, "$GP");
+    DataFrame sentenceBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame crlfBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "\r\n");
+    ASSERT_EQ(slave.addFormat(nmeaBytes + sentenceBytes + crlfBytes), 3);
+    slave = stxBytes + cmdBytes + etxBytes;
+    ASSERT_EQ(slave.addFormat(cmdBytes + etxBytes), 4);
+    ASSERT_EQ(slave.addFormat(nmeaBytes + sentenceBytes + crlfBytes), 0);
+    ASSERT_EQ(slave.getFormatCount(), 2);
+    ASSERT_EQ(slave.getFormat(2), nullptr);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(slave.writeData("xx$GPGGA,1\r\n\x02" "A\x03$GPRMC\r\n"), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave.getFormatIndex(), 1);
+    ASSERT_EQ(slave.getFormat(), slave.getFormat(1));
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'G', 'G', 'A', ',', '1'}));
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave.getFormatIndex(), 0);
+    ASSERT_EQ(slave.getFormat(), slave.getFormat(0));
+    ASSERT_EQ(slave.getBuffer(tmp), 3);
+    ASSERT_EQ(tmp, std::vector <unsigned char>({0x02, 'A', 0x03}));
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave.getFormatIndex(), 1);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'R', 'M', 'C'}));
+}
+
+TEST_F(SerialinkFramedDataTest, ReadTest_lengthBinding) {
+    std::vector <unsigned char> tmp;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "<");
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH, 2);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, ">");
+    ASSERT_EQ(slave.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_CONTENT_LENGTH, 2, SERIALINK_ENDIAN_LITTLE, -1, 1), 3);
+    slave = startBytes + lengthBytes + dataBytes + stopBytes;
+    ASSERT_EQ(slave.bindLength(DataFrame::FRAME_TYPE_CONTENT_LENGTH, DataFrame::FRAME_TYPE_DATA, 2, SERIALINK_ENDIAN_LITTLE, -1, 1), 4);
+    ASSERT_EQ(slave.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_CONTENT_LENGTH, 3, SERIALINK_ENDIAN_LITTLE, -1, 1), 4);
+    ASSERT_EQ(slave.bindLength(&dataBytes, slave[DataFrame::FRAME_TYPE_CONTENT_LENGTH], 2, SERIALINK_ENDIAN_LITTLE, -1, 1), 4);
+    /* the length includes the stop byte */
+    ASSERT_EQ(slave.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_CONTENT_LENGTH, 2, SERIALINK_ENDIAN_LITTLE, -1, 1), 0);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(slave.writeData(std::vector <unsigned char>({'<', 0x04, 0x00, 'a', 'b', 'c', '>', '<', 0x01, 0x00, '>', '<', 0x00, 0x00, '>', '<', 0x00, 0x02, 'a', 'b', 'c', 'd', '>'})), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'a', 'b', 'c'}));
+    ASSERT_EQ(slave.getBuffer(tmp), 7);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getSize(), 0);
+    ASSERT_EQ(slave.getBuffer(tmp), 4);
+    /* a negative length is an invalid frame */
+    ASSERT_EQ(slave.readFramedData(), 4);
+    /* big endian with a scale */
+    ASSERT_EQ(slave.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_CONTENT_LENGTH, 2, SERIALINK_ENDIAN_BIG, 0, 2), 0);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'a', 'b', 'c', 'd'}));
+}
+
+TEST_F(SerialinkFramedDataTest, ReadTest_lengthTable) {
+    std::vector <unsigned char> tmp;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame validatorBytes(DataFrame::FRAME_TYPE_VALIDATOR, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    slave = startBytes + cmdBytes + dataBytes + validatorBytes + stopBytes;
+    ASSERT_EQ(slave.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_COMMAND, std::map <unsigned long long, size_t>(), 1, SERIALINK_ENDIAN_BIG), 4);
+    ASSERT_EQ(slave.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_COMMAND, {{0x35, 3}, {0x36, 2}}, 1, SERIALINK_ENDIAN_BIG), 0);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(slave.writeData("12345678xy90-=123467zxy90-=12347xy90-=1234578xyy90-="), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'6', '7', '8'}));
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'7', 'z'}));
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_VALIDATOR]->getDataAsVector(), std::vector <unsigned char>({'x', 'y'}));
+    /* 0x37 is not in the table */
+    ASSERT_EQ(slave.readFramedData(), 4);
+    ASSERT_EQ(slave.getBuffer(tmp), 5);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'7', '8', 'x'}));
+}
+
+TEST_F(SerialinkFramedDataTest, ReadTest_checksum) {
+    std::vector <unsigned char> tmp;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, "5");
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, "678");
+    DataFrame validatorBytes(DataFrame::FRAME_TYPE_VALIDATOR, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    ASSERT_EQ(slave.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE), 3);
+    slave = startBytes + cmdBytes + dataBytes + validatorBytes + stopBytes;
+    ASSERT_EQ(slave.setChecksum(CHECKSUM_TYPE_CRC32, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE), 4);
+    ASSERT_EQ(slave.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_COMMAND, SERIALINK_ENDIAN_LITTLE), 4);
+    ASSERT_EQ(slave.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_STOP_BYTES, SERIALINK_ENDIAN_LITTLE), 4);
+    ASSERT_EQ(slave.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE), 0);
+    ASSERT_EQ(slave.openPort(), 0);
+    /* the validator frame is filled by writeFramedData */
+    ASSERT_EQ(slave.writeFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_VALIDATOR]->getDataAsVector(), std::vector <unsigned char>({0x15, 0x90}));
+    ASSERT_EQ(slave.writeData((const unsigned char *) "12345678\x15\x91" "90-=", 14), 0);
+    ASSERT_EQ(master.begin(), true);
+    slave[DataFrame::FRAME_TYPE_VALIDATOR]->setData(std::vector <unsigned char>({0x00, 0x00}));
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_VALIDATOR]->getDataAsVector(), std::vector <unsigned char>({0x15, 0x90}));
+    ASSERT_EQ(slave.readFramedData(), 4);
+    ASSERT_EQ(slave.getBuffer(tmp), 10);
+}
+
+TEST_F(SerialinkFramedDataTest, ReadTest_checksumUntilStopBytes) {
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    DataFrame stxBytes(DataFrame::FRAME_TYPE_START_BYTES, "\x02");
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame etxBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "\x03");
+    DataFrame lrcBytes(DataFrame::FRAME_TYPE_VALIDATOR, 1);
+    slave = stxBytes + dataBytes + etxBytes + lrcBytes;
+    ASSERT_EQ(slave.setChecksum(CHECKSUM_TYPE_LRC, DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_STOP_BYTES, SERIALINK_ENDIAN_BIG), 0);
+    ASSERT_EQ(slave.openPort(), 0);
+    /* LRC of "AB\x03" is 0x7A, the second frame has a wrong LRC */
+    ASSERT_EQ(slave.writeData((const unsigned char *) "\x02" "AB\x03\x7A\x02" "AB\x03\x7B\x02" "ABC\x03\x37", 16), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'A', 'B'}));
+    ASSERT_EQ(slave.readFramedData(), 4);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'A', 'B', 'C'}));
+}
+
+TEST_F(SerialinkFramedDataTest, ReadTest_bufferViews) {
+    ByteView view;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    slave = startBytes + cmdBytes + dataBytes + stopBytes;
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(slave.writeData(std::string("xx1234ahello90-=1234bhi90-=")), 0);
+    ASSERT_EQ(master.begin(), true);
+    /* nothing has been received yet */
+    ASSERT_EQ(slave.getFieldAsView(DataFrame::FRAME_TYPE_DATA).size(), 0);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    view = slave.getFieldAsView(DataFrame::FRAME_TYPE_DATA);
+    ASSERT_EQ(std::vector <unsigned char>(view.begin(), view.end()), std::vector <unsigned char>({'h', 'e', 'l', 'l', 'o'}));
+    view = slave.getFieldAsView(slave[DataFrame::FRAME_TYPE_COMMAND]);
+    ASSERT_EQ(std::vector <unsigned char>(view.begin(), view.end()), std::vector <unsigned char>({'a'}));
+    view = slave.getSpecificBufferAsView(DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_STOP_BYTES);
+    ASSERT_EQ(std::vector <unsigned char>(view.begin(), view.end()), slave.getBufferAsVector());
+    ASSERT_EQ(view.data(), slave.getBufferAsView().data());
+    view = slave.getRemainingBufferAsView();
+    ASSERT_EQ(std::vector <unsigned char>(view.begin(), view.end()), slave.getRemainingBufferAsVector());
+    /* the range is reversed or not part of the frame format */
+    ASSERT_EQ(slave.getSpecificBufferAsView(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_COMMAND).size(), 0);
+    ASSERT_EQ(slave.getFieldAsView(DataFrame::FRAME_TYPE_VALIDATOR).size(), 0);
+    view = slave.getFieldAsView(slave.getHandle(DataFrame::FRAME_TYPE_DATA));
+    ASSERT_EQ(std::vector <unsigned char>(view.begin(), view.end()), std::vector <unsigned char>({'h', 'e', 'l', 'l', 'o'}));
+    ASSERT_EQ(slave.writeData(slave.getFieldAsView(DataFrame::FRAME_TYPE_DATA)), 0);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    view = slave.getFieldAsView(DataFrame::FRAME_TYPE_DATA);
+    ASSERT_EQ(std::vector <unsigned char>(view.begin(), view.end()), std::vector <unsigned char>({'h', 'i'}));
+    ASSERT_EQ(slave.readFramedData(), 2);
+    ASSERT_EQ(slave.getFieldAsView(DataFrame::FRAME_TYPE_DATA).size(), 0);
+}
+
+TEST_F(SerialinkFramedDataTest, ReadTest_readFrames) {
+    SerialinkFrameArena arena;
+    const SerialinkFieldDescriptor *fields = nullptr;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    ASSERT_EQ(slave.readFrames(4, 0, arena), 3);
+    slave = startBytes + cmdBytes + dataBytes + stopBytes;
+    ASSERT_EQ(slave.readFrames(0, 0, arena), 4);
+    ASSERT_EQ(slave.openPort(), 0);
+    /* a burst of three frames, the last one is not complete */
+    ASSERT_EQ(slave.writeData(std::string("xx1234ahello90-=1234bhi90-=1234cxyz90-=1234d")), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFrames(2, 1000, arena), 0);
+    ASSERT_EQ(arena.frames.size(), 2);
+    ASSERT_EQ(arena.fields.size(), 8);
+    ASSERT_EQ(std::string(arena.data.begin(), arena.data.end()), std::string("1234ahello90-=1234bhi90-="));
+    ASSERT_EQ(arena.frames[1].format, 0);
+    ASSERT_EQ(arena.frames[1].offset, 14);
+    ASSERT_EQ(arena.frames[1].size, 11);
+    ASSERT_EQ(arena.frames[1].firstField, 4);
+    ASSERT_EQ(arena.frames[1].fieldCount, 4);
+    fields = arena.fields.data() + arena.frames[1].firstField;
+    ASSERT_EQ(std::string(arena.data.begin() + fields[1].offset, arena.data.begin() + fields[1].offset + fields[1].size), "b");
+    ASSERT_EQ(std::string(arena.data.begin() + fields[2].offset, arena.data.begin() + fields[2].offset + fields[2].size), "hi");
+    ASSERT_EQ(fields[3].offset, 21);
+    ASSERT_EQ(fields[3].size, 4);
+    /* the burst ends at the incomplete frame without waiting for the timeout */
+    ASSERT_EQ(slave.readFrames(8, 0, arena), 0);
+    ASSERT_EQ(arena.frames.size(), 1);
+    ASSERT_EQ(std::string(arena.data.begin(), arena.data.end()), std::string("1234cxyz90-="));
+    ASSERT_EQ(slave.readFrames(8, 0, arena), 2);
+    ASSERT_EQ(arena.frames.size(), 0);
+    /* the deadline also limits the wait for the first frame, the port timeout is kept */
+    struct timeval tvStart, tvEnd;
+    gettimeofday(&tvStart, NULL);
+    ASSERT_EQ(slave.readFrames(8, 300, arena), 2);
+    gettimeofday(&tvEnd, NULL);
+    long diffTime = (tvEnd.tv_sec - tvStart.tv_sec) * 1000 + (tvEnd.tv_usec - tvStart.tv_usec) / 1000;
+    ASSERT_EQ(diffTime >= 250 && diffTime <= 500, true);
+    ASSERT_EQ(slave.getTimeout(), 25);
+    ASSERT_EQ(slave.getTimeoutDuration().count(), 2500000);
+}
+
+TEST_F(SerialinkFramedDataTest, ReadTest_resyncAfterInvalidFrame) {
+    SerialinkResyncStats stats;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame crcBytes(DataFrame::FRAME_TYPE_VALIDATOR, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    slave = startBytes + cmdBytes + dataBytes + crcBytes + stopBytes;
+    ASSERT_EQ(slave.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_COMMAND, {{0x35, 3}, {0x36, 2}}, 1, SERIALINK_ENDIAN_BIG), 0);
+    ASSERT_EQ(slave.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE), 0);
+    ASSERT_EQ(slave.openPort(), 0);
+    /* a truncated frame that contains the beginning of a valid frame, then a frame that is not completed */
+    ASSERT_EQ(slave.writeData(std::string("1234512" "12345678\x15\x90" "90-=" "12346ab")), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFramedData(), 4);
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'6', '7', '8'}));
+    ASSERT_EQ(slave.readFramedData(), 2);
+    stats = slave.getResyncStats();
+    ASSERT_EQ(stats.invalidFrames, 1);
+    ASSERT_EQ(stats.incompleteFrames, 1);
+    ASSERT_EQ(stats.resyncs, 1);
+    /* "1234512" before the valid frame, and "1234" of the incomplete frame (the last 3 bytes may begin new start bytes) */
+    ASSERT_EQ(stats.discardedBytes, 11);
+    slave.resetResyncStats();
+    stats = slave.getResyncStats();
+    ASSERT_EQ(stats.invalidFrames + stats.incompleteFrames + stats.resyncs + stats.discardedBytes, 0);
+}
+
+TEST_F(SerialinkFramedDataTest, ReadTest_shortBatchedRead) {
+    unsigned char buffer[16];
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(5);
+    slave.setKeepAlive(100);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, 3);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    slave = startBytes + cmdBytes + dataBytes + stopBytes;
+    ASSERT_EQ(slave.openPort(), 0);
+    /* the command, data and stop bytes are received with one read, which ends inside the stop bytes */
+    ASSERT_EQ(slave.writeData(std::string("1234xabc90")), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFramedData(), 2);
+    /* the stop bytes ran out, so only the first frame byte is kept as with a field by field read */
+    ASSERT_EQ(slave.getDataSize(), 1);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 1);
+    ASSERT_EQ(buffer[0], '1');
+    ASSERT_EQ(slave.getResyncStats().incompleteFrames, 1);
+}
+
+TEST_F(SerialinkFramedDataTest, ReadTest_resyncCancelledByRead) {
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(1000);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame crcBytes(DataFrame::FRAME_TYPE_VALIDATOR, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    slave = startBytes + cmdBytes + dataBytes + crcBytes + stopBytes;
+    ASSERT_EQ(slave.bindLength(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_COMMAND, {{0x35, 3}, {0x36, 2}}, 1, SERIALINK_ENDIAN_BIG), 0);
+    ASSERT_EQ(slave.setChecksum(CHECKSUM_TYPE_CRC16_XMODEM, DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA, SERIALINK_ENDIAN_LITTLE), 0);
+    ASSERT_EQ(slave.openPort(), 0);
+    /* a rejected frame with a start bytes candidate inside, read by the application with a Serial read */
+    ASSERT_EQ(slave.writeData(std::string("1234512123" "4xxxxxx123" "45678\x15\x90" "90-=" "12345678\x15\x90" "90-=")), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readFramedData(), 4);
+    ASSERT_EQ(slave.getDataSize(), 10);
+    ASSERT_EQ(slave.readNBytes(10), 0);
+    ASSERT_EQ(slave.getBufferAsVector(), std::vector <unsigned char>({'4', 'x', 'x', 'x', 'x', 'x', 'x', '1', '2', '3'}));
+    /* the bytes read by the application are not searched again */
+    ASSERT_EQ(slave.readFramedData(), 0);
+    ASSERT_EQ(slave[DataFrame::FRAME_TYPE_DATA]->getDataAsVector(), std::vector <unsigned char>({'6', '7', '8'}));
+    ASSERT_EQ(slave.readFramedData(), 2);
+}
+
 TEST_F(SerialinkFramedDataTest, ReadTest_withUnknownDataSz_2) {
     unsigned char buffer[16];
     struct timeval tvStart, tvEnd;
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include <pthread.h>
+#include "virtual-proxy.hpp"
+
+static void *proxyThread(void *ptr){
+    VirtualSerialProxy *proxy = (VirtualSerialProxy *) ptr;
+    proxy->begin();
+    return NULL;
+}
+
+static void passthroughCopy(Serial &src, Serial &dest, void *param){
+    int *counter = (int *) param;
+    if (src.readData() == 0){
+        dest.writeData(src.getBufferAsVector());
+        (*counter)++;
+    }
+}
+
+static void *deviceWriterThread(void *ptr){
+    Serial *serial = (Serial *) ptr;
+    std::vector <unsigned char> block(1024, 0x5A);
+    for (int i = 0; i < 1024; i++){
+        if (serial->writeData(block) != 0) break;
+    }
+    return NULL;
+}
+
+class SerialinkProxyTest:public::testing::Test {
+protected:
+    VirtualSerial device;
+    Serial client;
+    SerialinkProxyTest() : device(B115200, 10, 0) {}
+    void SetUp() override {
+        client.setBaudrate(B115200);
+        client.setTimeout(10);
+        client.setKeepAlive(20);
+    }
+
+    void TearDown() override {
+        // tidak ada kebutuhan post-set
+    }
+};
+
+TEST_F(SerialinkProxyTest, FullDuplex_forwarding) {
+    unsigned char buffer[16];
+    pthread_t thread;
+    VirtualSerialProxy proxy(device.getVirtualPortName().c_str(), B115200);
+    device.setKeepAlive(20);
+    pthread_create(&thread, NULL, proxyThread, (void *) &proxy);
+    usleep(100000);
+    client.setPort(proxy.getVirtualPortName());
+    ASSERT_EQ(client.openPort(), 0);
+    ASSERT_EQ(device.writeData("device-to-app"), 0);
+    ASSERT_EQ(client.writeData("app-to-device"), 0);
+    ASSERT_EQ(client.readNBytes(13), 0);
+    ASSERT_EQ(client.getBuffer(buffer, sizeof(buffer)), 13);
+    ASSERT_EQ(memcmp(buffer, "device-to-app", 13), 0);
+    ASSERT_EQ(device.readNBytes(13), 0);
+    ASSERT_EQ(device.getBuffer(buffer, sizeof(buffer)), 13);
+    ASSERT_EQ(memcmp(buffer, "app-to-device", 13), 0);
+    proxy.stop();
+    pthread_join(thread, NULL);
+    VirtualSerialProxyStats stats = proxy.getStats(PROXY_DIRECTION_DEVICE_TO_PTY);
+    ASSERT_EQ(stats.bytes, 13);
+    ASSERT_GE(stats.chunks, 1);
+    stats = proxy.getStats(PROXY_DIRECTION_PTY_TO_DEVICE);
+    ASSERT_EQ(stats.bytes, 13);
+    ASSERT_GE(stats.chunks, 1);
+}
+
+TEST_F(SerialinkProxyTest, PassThrough_legacyCallback) {
+    unsigned char buffer[16];
+    pthread_t thread;
+    int counter = 0;
+    VirtualSerialProxy proxy(device.getVirtualPortName().c_str(), B115200);
+    proxy.setPassThrough(&passthroughCopy, (void *) &counter);
+    pthread_create(&thread, NULL, proxyThread, (void *) &proxy);
+    usleep(100000);
+    client.setPort(proxy.getVirtualPortName());
+    ASSERT_EQ(client.openPort(), 0);
+    ASSERT_EQ(client.writeData("ping"), 0);
+    ASSERT_EQ(device.readNBytes(4), 0);
+    ASSERT_EQ(device.getBuffer(buffer, sizeof(buffer)), 4);
+    ASSERT_EQ(memcmp(buffer, "ping", 4), 0);
+    ASSERT_EQ(device.writeData("pong"), 0);
+    ASSERT_EQ(client.readNBytes(4), 0);
+    ASSERT_EQ(client.getBuffer(buffer, sizeof(buffer)), 4);
+    ASSERT_EQ(memcmp(buffer, "pong", 4), 0);
+    proxy.stop();
+    pthread_join(thread, NULL);
+    ASSERT_GE(counter, 2);
+}
+
+TEST_F(SerialinkProxyTest, SpliceMode_forwarding) {
+    unsigned char buffer[16];
+    pthread_t thread;
+    VirtualSerialProxy proxy(device.getVirtualPortName().c_str(), B115200);
+    ASSERT_EQ(proxy.getSpliceMode(), false);
+    proxy.setSpliceMode(true);
+    ASSERT_EQ(proxy.getSpliceMode(), true);
+    pthread_create(&thread, NULL, proxyThread, (void *) &proxy);
+    usleep(100000);
+    client.setPort(proxy.getVirtualPortName());
+    ASSERT_EQ(client.openPort(), 0);
+    ASSERT_EQ(device.writeData("device-to-app"), 0);
+    ASSERT_EQ(client.writeData("app-to-device"), 0);
+    ASSERT_EQ(client.readNBytes(13), 0);
+    ASSERT_EQ(client.getBuffer(buffer, sizeof(buffer)), 13);
+    ASSERT_EQ(memcmp(buffer, "device-to-app", 13), 0);
+    ASSERT_EQ(device.readNBytes(13), 0);
+    ASSERT_EQ(device.getBuffer(buffer, sizeof(buffer)), 13);
+    ASSERT_EQ(memcmp(buffer, "app-to-device", 13), 0);
+    proxy.stop();
+    pthread_join(thread, NULL);
+    ASSERT_EQ(proxy.getStats(PROXY_DIRECTION_DEVICE_TO_PTY).bytes, 13);
+    ASSERT_EQ(proxy.getStats(PROXY_DIRECTION_PTY_TO_DEVICE).bytes, 13);
+}
+
+TEST_F(SerialinkProxyTest, FanOut_broadcastAndFrameAtomic) {
+    unsigned char buffer[16];
+    pthread_t thread;
+    Serial second;
+    VirtualSerialProxy proxy(device.getVirtualPortName().c_str(), B115200);
+    ASSERT_EQ(proxy.addClient(0), 1);
+    ASSERT_EQ(proxy.getClientCount(), 2);
+    proxy.setArbitration(PROXY_ARBITRATION_FRAME_ATOMIC);
+    ASSERT_EQ(proxy.getArbitration(), PROXY_ARBITRATION_FRAME_ATOMIC);
+    proxy.setFrameDelimiter(std::vector <unsigned char>({'\r', '\n'}));
+    pthread_create(&thread, NULL, proxyThread, (void *) &proxy);
+    usleep(100000);
+    client.setPort(proxy.getVirtualPortName(0));
+    second.setPort(proxy.getVirtualPortName(1));
+    second.setBaudrate(B115200);
+    second.setTimeout(10);
+    ASSERT_EQ(client.openPort(), 0);
+    ASSERT_EQ(second.openPort(), 0);
+    ASSERT_EQ(device.writeData("status\r\n"), 0);
+    ASSERT_EQ(client.readNBytes(8), 0);
+    ASSERT_EQ(client.getBuffer(buffer, sizeof(buffer)), 8);
+    ASSERT_EQ(memcmp(buffer, "status\r\n", 8), 0);
+    ASSERT_EQ(second.readNBytes(8), 0);
+    ASSERT_EQ(second.getBuffer(buffer, sizeof(buffer)), 8);
+    ASSERT_EQ(memcmp(buffer, "status\r\n", 8), 0);
+    ASSERT_EQ(client.writeData("AAA"), 0);
+    usleep(20000);
+    ASSERT_EQ(second.writeData("BBB\r\n"), 0);
+    usleep(20000);
+    ASSERT_EQ(client.writeData("A\r\n"), 0);
+    ASSERT_EQ(device.readNBytes(11), 0);
+    ASSERT_EQ(device.getBuffer(buffer, sizeof(buffer)), 11);
+    ASSERT_EQ(memcmp(buffer, "BBB\r\nAAAA\r\n", 11), 0);
+    proxy.stop();
+    pthread_join(thread, NULL);
+}
+
+TEST_F(SerialinkProxyTest, FrameAtomic_resyncAfterLimit) {
+    unsigned char buffer[16];
+    pthread_t thread;
+    VirtualSerialProxy proxy(device.getVirtualPortName().c_str(), B115200);
+    proxy.setArbitration(PROXY_ARBITRATION_FRAME_ATOMIC);
+    proxy.setFrameDelimiter(std::vector <unsigned char>({'\r', '\n'}));
+    proxy.setClientQueueLimit(8);
+    pthread_create(&thread, NULL, proxyThread, (void *) &proxy);
+    usleep(100000);
+    client.setPort(proxy.getVirtualPortName(0));
+    ASSERT_EQ(client.openPort(), 0);
+    /* the incomplete frame exceeds the limit, the bytes up to the next delimiter are dropped */
+    ASSERT_EQ(client.writeData("012345"), 0);
+    usleep(20000);
+    ASSERT_EQ(client.writeData("6789"), 0);
+    usleep(20000);
+    ASSERT_EQ(client.writeData("\r\nOK\r\n"), 0);
+    ASSERT_EQ(device.readNBytes(4), 0);
+    ASSERT_EQ(device.getBuffer(buffer, sizeof(buffer)), 4);
+    ASSERT_EQ(memcmp(buffer, "OK\r\n", 4), 0);
+    ASSERT_EQ(proxy.getDroppedBytes(0), 12);
+    proxy.stop();
+    pthread_join(thread, NULL);
+}
+
+TEST_F(SerialinkProxyTest, FanOut_slowReader) {
+    pthread_t thread, writer;
+    Serial second;
+    size_t received = 0;
+    VirtualSerialProxy proxy(device.getVirtualPortName().c_str(), B115200);
+    ASSERT_EQ(proxy.addClient(0), 1);
+    proxy.setClientQueueLimit(65536);
+    pthread_create(&thread, NULL, proxyThread, (void *) &proxy);
+    usleep(100000);
+    client.setPort(proxy.getVirtualPortName(0));
+    second.setPort(proxy.getVirtualPortName(1));
+    ASSERT_EQ(client.openPort(), 0);
+    ASSERT_EQ(second.openPort(), 0);
+    client.setKeepAlive(0);
+    pthread_create(&writer, NULL, deviceWriterThread, (void *) &device);
+    while (received < 1024 * 1024){
+        if (client.readData() != 0) break;
+        received += client.getDataSize();
+    }
+    pthread_join(writer, NULL);
+    ASSERT_EQ(received, 1024 * 1024);
+    ASSERT_EQ(proxy.getDroppedBytes(0), 0);
+    ASSERT_GT(proxy.getDroppedBytes(1), 0);
+    proxy.stop();
+    pthread_join(thread, NULL);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <unistd.h>
+#include <string.h>
+#include "serial-reactor.hpp"
+#include "virtuser.hpp"
+
+extern void setupLengthByCommand(DataFrame &frame, void *ptr);
+
+typedef struct _ReactorTestContext {
+    SerialReactor *reactor;
+    std::vector <std::vector <unsigned char> > received;
+    std::vector <int> results;
+} ReactorTestContext;
+
+static void reactorEcho(Serial &serial, const unsigned char *data, size_t sz, void *param){
+    ReactorTestContext *ctx = (ReactorTestContext *) param;
+    ctx->received.push_back(std::vector <unsigned char>(data, data + sz));
+    ctx->reactor->writeData(&serial, data, sz);
+}
+
+static void reactorFrame(Serialink &serial, int ret, void *param){
+    ReactorTestContext *ctx = (ReactorTestContext *) param;
+    ctx->results.push_back(ret);
+    ctx->received.push_back(serial.getBufferAsVector());
+}
+
+class SerialinkReactorTest:public::testing::Test {
+protected:
+    SerialReactor reactor;
+    VirtualSerial master;
+    ReactorTestContext ctx;
+    SerialinkReactorTest() : master(B115200, 10, 0) {}
+    void SetUp() override {
+        ctx.reactor = &reactor;
+    }
+
+    void TearDown() override {
+        // tidak ada kebutuhan post-set
+    }
+};
+
+TEST_F(SerialinkReactorTest, RawData_echo) {
+    unsigned char buffer[8];
+    Serial slave(master.getVirtualPortName(), B115200, 10);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(reactor.addPort(&master, &reactorEcho, &ctx), 0);
+    ASSERT_EQ(reactor.addPort(&master, &reactorEcho, &ctx), 2);
+    ASSERT_EQ(reactor.getPortCount(), 1);
+    ASSERT_EQ(slave.writeData("hello"), 0);
+    while (ctx.received.empty()){
+        ASSERT_GE(reactor.runOnce(1000), 1);
+    }
+    ASSERT_EQ(ctx.received[0].size(), 5);
+    ASSERT_EQ(memcmp(ctx.received[0].data(), "hello", 5), 0);
+    ASSERT_EQ(slave.readNBytes(5), 0);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 5);
+    ASSERT_EQ(memcmp(buffer, "hello", 5), 0);
+    ASSERT_EQ(reactor.removePort(&master), 0);
+    ASSERT_EQ(reactor.removePort(&master), 1);
+    ASSERT_EQ(reactor.getPortCount(), 0);
+    ASSERT_EQ(reactor.writeData(&master, (const unsigned char *) "x", 1), 1);
+}
+
+TEST_F(SerialinkReactorTest, FramedData_splitAndMerged) {
+    Serialink link;
+    link.setPort(master.getVirtualPortName());
+    link.setBaudrate(B115200);
+    link.setTimeout(10);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, "5");
+    cmdBytes.setPostExecuteFunction((const void *) &setupLengthByCommand, &link);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, "678");
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    link = startBytes + cmdBytes + dataBytes + stopBytes;
+    ASSERT_EQ(link.openPort(), 0);
+    ASSERT_EQ(reactor.addPort(&link, &reactorFrame, &ctx), 0);
+    ASSERT_EQ(master.writeData("xx12345"), 0);
+    ASSERT_GE(reactor.runOnce(1000), 1);
+    ASSERT_EQ(ctx.results.size(), 0);
+    ASSERT_EQ(master.writeData("67890-=1234567890-="), 0);
+    while (ctx.results.size() < 2){
+        ASSERT_GE(reactor.runOnce(1000), 1);
+    }
+    ASSERT_EQ(ctx.results.size(), 2);
+    for (size_t i = 0; i < 2; i++){
+        ASSERT_EQ(ctx.results[i], 0);
+        ASSERT_EQ(ctx.received[i].size(), 12);
+        ASSERT_EQ(memcmp(ctx.received[i].data(), "1234567890-=", 12), 0);
+    }
+    ASSERT_EQ(reactor.removePort(&link), 0);
+}
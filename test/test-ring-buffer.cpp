@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <string.h>
+#include "ring-buffer.hpp"
+#include "virtuser.hpp"
+
+class RingBufferSerial : public Serial {
+  public:
+    void setRetainData(bool retainData){
+        this->retainData = retainData;
+    }
+
+    std::string getReceived(){
+        return std::string((const char *) this->rxBuffer.getData(), this->rxBuffer.getSize());
+    }
+};
+
+class SerialinkRingBufferTest:public::testing::Test {
+protected:
+    RingBuffer buffer;
+    SerialinkRingBufferTest() : buffer(8) {}
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+        // tidak ada kebutuhan post-set
+    }
+
+    std::string getData(){
+        return std::string((const char *) this->buffer.getData(), this->buffer.getSize());
+    }
+};
+
+TEST_F(SerialinkRingBufferTest, WriteAndConsume) {
+    ASSERT_EQ(buffer.getCapacity(), 8);
+    ASSERT_EQ(buffer.getSize(), 0);
+    ASSERT_EQ(buffer.getFreeSpace(), 8);
+    ASSERT_EQ(buffer.write((const unsigned char *) "abcde", 5), 5);
+    ASSERT_EQ(this->getData(), "abcde");
+    buffer.consume(2);
+    ASSERT_EQ(this->getData(), "cde");
+    ASSERT_EQ(buffer.getFreeSpace(), 5);
+    /* the cursors are reset when everything is consumed */
+    buffer.consume(10);
+    ASSERT_EQ(buffer.getSize(), 0);
+    ASSERT_EQ(buffer.getData(), buffer.getStorage());
+    ASSERT_EQ(buffer.write((const unsigned char *) "xy", 2), 2);
+    buffer.clear();
+    ASSERT_EQ(buffer.getSize(), 0);
+    ASSERT_EQ(buffer.getFreeSpace(), 8);
+}
+
+TEST_F(SerialinkRingBufferTest, WrapAround) {
+    ASSERT_EQ(buffer.write((const unsigned char *) "abcdef", 6), 6);
+    buffer.consume(4);
+    /* the write reaches the end of the storage, the rest is stored after moving "ef" to the front */
+    ASSERT_EQ(buffer.write((const unsigned char *) "ghijk", 5), 5);
+    ASSERT_EQ(this->getData(), "efghijk");
+    ASSERT_EQ(buffer.getData(), buffer.getStorage());
+    buffer.consume(3);
+    ASSERT_EQ(buffer.write((const unsigned char *) "lmnopq", 6), 4);
+    ASSERT_EQ(this->getData(), "hijklmno");
+    ASSERT_EQ(buffer.getFreeSpace(), 0);
+}
+
+TEST_F(SerialinkRingBufferTest, PrepareWriteCompaction) {
+    size_t available = 0;
+    unsigned char *dst = buffer.prepareWrite(available);
+    ASSERT_EQ(dst, buffer.getStorage());
+    ASSERT_EQ(available, 8);
+    memcpy(dst, "abcdefgh", 8);
+    buffer.commitWrite(8);
+    buffer.consume(5);
+    ASSERT_EQ(buffer.getData(), buffer.getStorage() + 5);
+    /* the write cursor has reached the end of the storage, the unconsumed bytes are moved to the front */
+    dst = buffer.prepareWrite(available);
+    ASSERT_EQ(buffer.getData(), buffer.getStorage());
+    ASSERT_EQ(this->getData(), "fgh");
+    ASSERT_EQ(dst, buffer.getStorage() + 3);
+    ASSERT_EQ(available, 5);
+    /* a second call does not move the data again */
+    ASSERT_EQ(buffer.prepareWrite(available), dst);
+    ASSERT_EQ(available, 5);
+}
+
+TEST_F(SerialinkRingBufferTest, ReserveBeyondCapacity) {
+    size_t available = 0;
+    ASSERT_EQ(buffer.write((const unsigned char *) "0123456789", 10), 8);
+    ASSERT_EQ(this->getData(), "01234567");
+    buffer.prepareWrite(available);
+    ASSERT_EQ(available, 0);
+    ASSERT_EQ(buffer.write((const unsigned char *) "x", 1), 0);
+    buffer.consume(6);
+    /* a commit larger than the reserved space is limited to the reserved space */
+    buffer.prepareWrite(available);
+    ASSERT_EQ(available, 6);
+    buffer.commitWrite(100);
+    ASSERT_EQ(buffer.getSize(), 8);
+    ASSERT_EQ(buffer.getFreeSpace(), 0);
+    /* a new capacity discards the data */
+    buffer.setCapacity(16);
+    ASSERT_EQ(buffer.getCapacity(), 16);
+    ASSERT_EQ(buffer.getSize(), 0);
+    ASSERT_EQ(buffer.write((const unsigned char *) "0123456789", 10), 10);
+}
+
+TEST_F(SerialinkRingBufferTest, RetainAndReleaseWindows) {
+    VirtualSerial master(B115200, 10, 50);
+    RingBufferSerial slave;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(10);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(master.writeData("abcdef"), 0);
+    ASSERT_EQ(slave.readNBytes(6), 0);
+    ASSERT_EQ(slave.getReceived(), "abcdef");
+    ASSERT_EQ(master.writeData("ghij"), 0);
+    /* while the data is retained, a read moves the window but keeps the released bytes in the receive buffer */
+    slave.setRetainData(true);
+    ASSERT_EQ(slave.readNBytes(2), 0);
+    ASSERT_EQ(std::string((const char *) slave.getBufferAsView().data(), slave.getDataSize()), "gh");
+    ASSERT_EQ(slave.getReceived().substr(0, 8), "abcdefgh");
+    ASSERT_EQ(slave.readNBytes(2), 0);
+    ASSERT_EQ(std::string((const char *) slave.getBufferAsView().data(), slave.getDataSize()), "ij");
+    ASSERT_EQ(slave.getReceived(), "abcdefghij");
+    /* the retained bytes are consumed with the next release after the flag is cleared */
+    slave.setRetainData(false);
+    slave.releaseData();
+    ASSERT_EQ(slave.getReceived(), "");
+    ASSERT_EQ(slave.getDataSize(), 0);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <string.h>
+#include <unistd.h>
+#include "serial-write-queue.hpp"
+#include "virtuser.hpp"
+
+#define WRITE_QUEUE_THREADS 4
+#define WRITE_QUEUE_MESSAGES 200
+
+typedef struct _WriteQueueTestContext {
+    SerialWriteQueue *queue;
+    int id;
+    int completed;
+    int failed;
+    int drained;
+    bool isEntered;
+} WriteQueueTestContext;
+
+static void writeDone(SerialWriteQueue &queue, int ret, void *param){
+    WriteQueueTestContext *ctx = (WriteQueueTestContext *) param;
+    (void) queue;
+    if (ret == 0) __atomic_add_fetch(&(ctx->completed), 1, __ATOMIC_SEQ_CST);
+    else __atomic_add_fetch(&(ctx->failed), 1, __ATOMIC_SEQ_CST);
+}
+
+static void writeDoneWithDelay(SerialWriteQueue &queue, int ret, void *param){
+    WriteQueueTestContext *ctx = (WriteQueueTestContext *) param;
+    (void) queue;
+    (void) ret;
+    __atomic_store_n(&(ctx->isEntered), true, __ATOMIC_SEQ_CST);
+    usleep(100000);
+}
+
+static void queueDrained(SerialWriteQueue &queue, void *param){
+    WriteQueueTestContext *ctx = (WriteQueueTestContext *) param;
+    (void) queue;
+    __atomic_add_fetch(&(ctx->drained), 1, __ATOMIC_SEQ_CST);
+}
+
+static void *writeQueueThread(void *param){
+    WriteQueueTestContext *ctx = (WriteQueueTestContext *) param;
+    char message[8];
+    for (int i = 0; i < WRITE_QUEUE_MESSAGES; i++){
+        snprintf(message, sizeof(message), "%c%03d;", 'A' + ctx->id, i);
+        while (ctx->queue->writeData((const unsigned char *) message, 5, (const void *) &writeDone, ctx) == 2){
+            usleep(100);
+        }
+    }
+    return NULL;
+}
+
+class SerialinkWriteQueueTest:public::testing::Test {
+protected:
+    VirtualSerial master;
+    Serial slave;
+    SerialinkWriteQueueTest() : master(B115200, 10, 50) {}
+    void SetUp() override {
+        slave.setPort(master.getVirtualPortName());
+        slave.setBaudrate(B115200);
+        slave.setTimeout(25);
+    }
+
+    void TearDown() override {
+        // tidak ada kebutuhan post-set
+    }
+
+    std::string readMaster(size_t sz){
+        std::vector <unsigned char> chunk;
+        std::string received;
+        while (received.size() < sz && master.readData() == 0){
+            master.getBuffer(chunk);
+            received.append(chunk.begin(), chunk.end());
+        }
+        return received;
+    }
+};
+
+TEST_F(SerialinkWriteQueueTest, NotRunning) {
+    SerialWriteQueue queue(slave);
+    ASSERT_EQ(queue.writeData(ByteView((const unsigned char *) "abc", 3)), 1);
+    ASSERT_EQ(queue.start(), 0);
+    ASSERT_EQ(queue.start(), 4);
+    ASSERT_EQ(queue.writeData(ByteView()), 4);
+    queue.stop();
+    ASSERT_EQ(queue.writeData(ByteView((const unsigned char *) "abc", 3)), 1);
+    ASSERT_EQ(queue.flush(), 0);
+}
+
+TEST_F(SerialinkWriteQueueTest, MultipleWriters) {
+    SerialWriteQueue queue(slave);
+    WriteQueueTestContext ctx[WRITE_QUEUE_THREADS];
+    pthread_t thread[WRITE_QUEUE_THREADS];
+    std::string received;
+    int next[WRITE_QUEUE_THREADS] = {0};
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(queue.start(), 0);
+    for (int i = 0; i < WRITE_QUEUE_THREADS; i++){
+        memset(&(ctx[i]), 0x00, sizeof(ctx[i]));
+        ctx[i].queue = &queue;
+        ctx[i].id = i;
+        pthread_create(&thread[i], NULL, writeQueueThread, (void *) &(ctx[i]));
+    }
+    received = this->readMaster(WRITE_QUEUE_THREADS * WRITE_QUEUE_MESSAGES * 5);
+    for (int i = 0; i < WRITE_QUEUE_THREADS; i++){
+        pthread_join(thread[i], NULL);
+    }
+    ASSERT_EQ(queue.flush(), 0);
+    ASSERT_EQ(queue.getQueuedSize(), 0);
+    ASSERT_EQ(received.size(), WRITE_QUEUE_THREADS * WRITE_QUEUE_MESSAGES * 5);
+    /* the messages are not split, and the messages of each thread keep their order */
+    for (size_t i = 0; i < received.size(); i += 5){
+        int id = received[i] - 'A';
+        ASSERT_GE(id, 0);
+        ASSERT_LT(id, WRITE_QUEUE_THREADS);
+        ASSERT_EQ(atoi(received.substr(i + 1, 3).c_str()), next[id]);
+        ASSERT_EQ(received[i + 4], ';');
+        next[id]++;
+    }
+    for (int i = 0; i < WRITE_QUEUE_THREADS; i++){
+        ASSERT_EQ(__atomic_load_n(&(ctx[i].completed), __ATOMIC_SEQ_CST), WRITE_QUEUE_MESSAGES);
+        ASSERT_EQ(__atomic_load_n(&(ctx[i].failed), __ATOMIC_SEQ_CST), 0);
+    }
+}
+
+TEST_F(SerialinkWriteQueueTest, Watermarks) {
+    SerialWriteQueue queue(slave);
+    WriteQueueTestContext ctx;
+    std::string block(600, 'x');
+    memset(&ctx, 0x00, sizeof(ctx));
+    queue.setWatermarks(1024, 256);
+    queue.setDrainCallback((const void *) &queueDrained, &ctx);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(queue.start(), 0);
+    /* the writer thread is held in the callback of the first write */
+    ASSERT_EQ(queue.writeData(ByteView((const unsigned char *) "first", 5), (const void *) &writeDoneWithDelay, &ctx), 0);
+    while (__atomic_load_n(&(ctx.isEntered), __ATOMIC_SEQ_CST) == false){
+        usleep(1000);
+    }
+    ASSERT_EQ(queue.writeData(ByteView((const unsigned char *) block.data(), block.size())), 0);
+    ASSERT_EQ(queue.getQueuedSize(), 600);
+    ASSERT_EQ(queue.writeData(ByteView((const unsigned char *) block.data(), block.size())), 0);
+    ASSERT_EQ(queue.writeData(ByteView((const unsigned char *) "late", 4)), 2);
+    ASSERT_EQ(queue.flush(), 0);
+    ASSERT_EQ(__atomic_load_n(&(ctx.drained), __ATOMIC_SEQ_CST), 1);
+    ASSERT_EQ(queue.writeData(ByteView((const unsigned char *) "last", 4), (const void *) &writeDone, &ctx), 0);
+    ASSERT_EQ(queue.flush(), 0);
+    ASSERT_EQ(__atomic_load_n(&(ctx.completed), __ATOMIC_SEQ_CST), 1);
+    ASSERT_EQ(this->readMaster(5 + 1200 + 4), std::string("first") + block + block + "last");
+}
@@ -4,6 +4,8 @@
 #include <iostream>
 #include <unistd.h>
 #include <pthread.h>
+#include "byte-search.hpp"
+#include "checksum.hpp"
 #include "serial.hpp"
 #include "virtuser.hpp"
 
@@ -190,6 +192,36 @@ TEST_F(SerialinkSimpleTest, normalWriteAndRead_unknown_n_bytes) {
     ASSERT_EQ(tmp.size(), 0);
 }
 
+TEST_F(SerialinkSimpleTest, normalWriteAndRead_io_uring_backend) {
+    unsigned char buffer[8];
+    struct timeval tvStart, tvEnd;
+    int diffTime = 0;
+    if (IoUring::isSupported() == false) GTEST_SKIP();
+    ASSERT_EQ(slave.getIOBackend(), IO_BACKEND_SYSCALL);
+    ASSERT_EQ(slave.setIOBackend(IO_BACKEND_IO_URING), true);
+    ASSERT_EQ(slave.getIOBackend(), IO_BACKEND_IO_URING);
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(std::chrono::milliseconds(20));
+    slave.setKeepAlive(50);
+    ASSERT_EQ(slave.openPort(), 0);
+    gettimeofday(&tvStart, NULL);
+    ASSERT_EQ(slave.readData(), 2);
+    gettimeofday(&tvEnd, NULL);
+    diffTime = (tvEnd.tv_sec - tvStart.tv_sec) * 1000 + (tvEnd.tv_usec - tvStart.tv_usec) / 1000;
+    ASSERT_EQ(diffTime >= 20 && diffTime <= 45, true);
+    ASSERT_EQ(slave.writeData((const unsigned char *) "\r\n\r\n", 4), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readData(), 0);
+    ASSERT_EQ(slave.getDataSize(), 4);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 4);
+    ASSERT_EQ(memcmp(buffer, (const unsigned char *) "\r\n\r\n", 4), 0);
+    slave.closePort();
+    ASSERT_EQ(slave.getIOBackend(), IO_BACKEND_IO_URING);
+    ASSERT_EQ(slave.setIOBackend(IO_BACKEND_SYSCALL), true);
+    ASSERT_EQ(slave.getIOBackend(), IO_BACKEND_SYSCALL);
+}
+
 TEST_F(SerialinkSimpleTest, normalWriteAndRead_known_n_bytes) {
     unsigned char buffer[8];
     std::vector <unsigned char> tmp;
@@ -265,6 +297,33 @@ TEST_F(SerialinkSimpleTest, normalWriteAndRead_known_n_bytes_with_remaining_data
     ASSERT_EQ(memcmp(tmp.data(), (const unsigned char *) "abc", 3), 0);
 }
 
+TEST_F(SerialinkSimpleTest, normalWriteAndRead_read_chunk_size) {
+    unsigned char buffer[8];
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(0);
+    ASSERT_EQ(slave.getReadChunkSize(), 4096);
+    slave.setReadChunkSize(4);
+    ASSERT_EQ(slave.getReadChunkSize(), 4);
+    /* an invalid size is ignored */
+    slave.setReadChunkSize(0);
+    ASSERT_EQ(slave.getReadChunkSize(), 4);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(master.writeData("abcdefghij"), 0);
+    usleep(20000);
+    /* without keep alive, a read operation requests one chunk */
+    ASSERT_EQ(slave.readData(), 0);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 4);
+    ASSERT_EQ(memcmp(buffer, (const unsigned char *) "abcd", 4), 0);
+    ASSERT_EQ(slave.readData(), 0);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 4);
+    ASSERT_EQ(memcmp(buffer, (const unsigned char *) "efgh", 4), 0);
+    ASSERT_EQ(slave.readData(), 0);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 2);
+    ASSERT_EQ(memcmp(buffer, (const unsigned char *) "ij", 2), 0);
+}
+
 TEST_F(SerialinkSimpleTest, normalWriteAndRead_with_delayed_bytes) {
     unsigned char buffer[8];
     pthread_t thread;
@@ -302,6 +361,46 @@ TEST_F(SerialinkSimpleTest, normalWriteAndRead_with_delayed_bytes) {
     ASSERT_EQ(tmp.size(), 0);
 }
 
+void *readDataThread(void *ptr){
+    Serial *ser = (Serial *) ptr;
+    ser->readData();
+    return NULL;
+}
+
+TEST_F(SerialinkSimpleTest, normalWriteAndRead_with_delayed_bytes_parallel) {
+    unsigned char buffer[8];
+    pthread_t thread[3];
+    VirtualSerial master2(B115200, 10, 50);
+    Serial slave2(master2.getVirtualPortName(), B115200, 25, 50);
+    struct timeval tvStart, tvEnd;
+    int diffTime = 0;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(50);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(slave2.openPort(), 0);
+    gettimeofday(&tvStart, NULL);
+    ASSERT_EQ(slave.writeData((const unsigned char *) "\r\n\r\n", 4), 0);
+    ASSERT_EQ(slave2.writeData((const unsigned char *) "ABCD", 4), 0);
+    pthread_create(&thread[0], NULL, callbackEchoWithDelay, (void *) &master);
+    pthread_create(&thread[1], NULL, callbackEchoWithDelay, (void *) &master2);
+    pthread_create(&thread[2], NULL, readDataThread, (void *) &slave2);
+    ASSERT_EQ(slave.readData(), 0);
+    pthread_join(thread[2], NULL);
+    gettimeofday(&tvEnd, NULL);
+    diffTime = (tvEnd.tv_sec - tvStart.tv_sec) * 1000 + (tvEnd.tv_usec - tvStart.tv_usec) / 1000;
+    ASSERT_EQ(diffTime >= 120 && diffTime <= 220, true);
+    ASSERT_EQ(slave.getDataSize(), 4);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 4);
+    ASSERT_EQ(memcmp(buffer, (const unsigned char *) "\r\n\r\n", 4), 0);
+    ASSERT_EQ(slave2.getDataSize(), 4);
+    ASSERT_EQ(slave2.getBuffer(buffer, sizeof(buffer)), 4);
+    ASSERT_EQ(memcmp(buffer, (const unsigned char *) "ABCD", 4), 0);
+    pthread_join(thread[0], NULL);
+    pthread_join(thread[1], NULL);
+}
+
 TEST_F(SerialinkSimpleTest, normalWriteAndRead_startBytes) {
     unsigned char buffer[8];
     pthread_t thread;
@@ -342,6 +441,187 @@ TEST_F(SerialinkSimpleTest, normalWriteAndRead_startBytes) {
     ASSERT_EQ(memcmp(tmp.data(), (const unsigned char *) "567890", 6), 0);
 }
 
+static void *writeNoiseThread(void *ptr){
+    Serial *ser = (Serial *) ptr;
+    std::vector <unsigned char> noise(4096);
+    for (size_t i = 0; i < noise.size(); i++) noise[i] = (unsigned char) ('0' + (i % 3));
+    for (int i = 0; i < 64; i++){
+        if (ser->writeData(noise) != 0) break;
+    }
+    ser->writeData("01201234567890");
+    return NULL;
+}
+
+TEST_F(SerialinkSimpleTest, byteSearch_engines) {
+    std::vector <unsigned char> data(4096);
+    size_t position = 0;
+    size_t expected = 0;
+    bool found = false;
+    const BYTE_SEARCH_ENGINE engines[] = {BYTE_SEARCH_ENGINE_SCALAR, BYTE_SEARCH_ENGINE_SSE2, BYTE_SEARCH_ENGINE_AVX2};
+    srand(7);
+    for (size_t i = 0; i < data.size(); i++) data[i] = (unsigned char) (rand() % 4);
+    for (size_t patternSz = 1; patternSz <= 6; patternSz++){
+        for (size_t sz = 0; sz < 300; sz += 7){
+            const unsigned char *pattern = data.data() + 3000 + patternSz;
+            found = false;
+            for (expected = 0; sz >= patternSz && expected <= sz - patternSz; expected++){
+                if (memcmp(data.data() + expected, pattern, patternSz) == 0){
+                    found = true;
+                    break;
+                }
+            }
+            for (auto engine : engines){
+                ASSERT_EQ(ByteSearch::find(engine, data.data(), sz, pattern, patternSz, position), found);
+                if (found) ASSERT_EQ(position, expected);
+            }
+        }
+    }
+    ASSERT_EQ(ByteSearch::find(data.data(), data.size(), data.data(), 0, position), false);
+}
+
+static unsigned int checksumBitwise(CHECKSUM_TYPE type, const unsigned char *data, size_t sz){
+    unsigned int crc = 0;
+    unsigned int poly = 0;
+    bool isReflected = true;
+    switch (type){
+        case CHECKSUM_TYPE_CRC16_CCITT: crc = 0xFFFF; poly = 0x1021; isReflected = false; break;
+        case CHECKSUM_TYPE_CRC16_XMODEM: crc = 0x0000; poly = 0x1021; isReflected = false; break;
+        case CHECKSUM_TYPE_CRC16_MODBUS: crc = 0xFFFF; poly = 0xA001; break;
+        case CHECKSUM_TYPE_CRC32: crc = 0xFFFFFFFF; poly = 0xEDB88320; break;
+        case CHECKSUM_TYPE_CRC32C: crc = 0xFFFFFFFF; poly = 0x82F63B78; break;
+        default: return 0;
+    }
+    for (size_t i = 0; i < sz; i++){
+        if (isReflected){
+            crc ^= data[i];
+            for (int j = 0; j < 8; j++) crc = (crc & 1) ? ((crc >> 1) ^ poly) : (crc >> 1);
+        }
+        else {
+            crc ^= (unsigned int) data[i] << 8;
+            for (int j = 0; j < 8; j++) crc = ((crc & 0x8000) ? ((crc << 1) ^ poly) : (crc << 1)) & 0xFFFF;
+        }
+    }
+    if (type == CHECKSUM_TYPE_CRC32 || type == CHECKSUM_TYPE_CRC32C) crc = ~crc;
+    return crc;
+}
+
+TEST_F(SerialinkSimpleTest, byteSearchSet_partialMatch) {
+    ByteSearchSet patterns;
+    size_t position = 0;
+    size_t index = 0;
+    size_t checked = 0;
+    ASSERT_EQ(patterns.add((const unsigned char *) "$GP", 3), 0);
+    ASSERT_EQ(patterns.add((const unsigned char *) "$G", 2), 1);
+    ASSERT_EQ(patterns.add((const unsigned char *) "ABCD", 4), 2);
+    ASSERT_EQ(patterns.add((const unsigned char *) "C", 1), 3);
+    /* a partial match does not hide a full match at the same offset or later */
+    ASSERT_EQ(patterns.find((const unsigned char *) "xx$G", 4, position, index, checked), true);
+    ASSERT_EQ(position, 2);
+    ASSERT_EQ(index, 1);
+    ASSERT_EQ(patterns.find((const unsigned char *) "xABC", 4, position, index, checked), true);
+    ASSERT_EQ(position, 3);
+    ASSERT_EQ(index, 3);
+    /* without a full match, the search can continue from the first partial match */
+    ASSERT_EQ(patterns.find((const unsigned char *) "xxAB", 4, position, index, checked), false);
+    ASSERT_EQ(checked, 2);
+    ASSERT_EQ(patterns.find((const unsigned char *) "xxyz", 4, position, index, checked), false);
+    ASSERT_EQ(checked, 4);
+}
+
+TEST_F(SerialinkSimpleTest, checksum_engines) {
+    std::vector <unsigned char> data(4096);
+    const unsigned char *check = (const unsigned char *) "123456789";
+    const CHECKSUM_ENGINE engines[] = {CHECKSUM_ENGINE_TABLE, CHECKSUM_ENGINE_SSE42, CHECKSUM_ENGINE_PCLMUL};
+    const CHECKSUM_TYPE crcTypes[] = {CHECKSUM_TYPE_CRC16_CCITT, CHECKSUM_TYPE_CRC16_MODBUS, CHECKSUM_TYPE_CRC16_XMODEM, CHECKSUM_TYPE_CRC32, CHECKSUM_TYPE_CRC32C};
+    ASSERT_EQ(Checksum::calculate(CHECKSUM_TYPE_CRC16_CCITT, check, 9), 0x29B1);
+    ASSERT_EQ(Checksum::calculate(CHECKSUM_TYPE_CRC16_MODBUS, check, 9), 0x4B37);
+    ASSERT_EQ(Checksum::calculate(CHECKSUM_TYPE_CRC16_XMODEM, check, 9), 0x31C3);
+    ASSERT_EQ(Checksum::calculate(CHECKSUM_TYPE_CRC32, check, 9), 0xCBF43926);
+    ASSERT_EQ(Checksum::calculate(CHECKSUM_TYPE_CRC32C, check, 9), 0xE3069283);
+    ASSERT_EQ(Checksum::calculate(CHECKSUM_TYPE_LRC, check, 9), 0x23);
+    ASSERT_EQ(Checksum::calculate(CHECKSUM_TYPE_XOR, check, 9), 0x31);
+    ASSERT_EQ(Checksum::calculate(CHECKSUM_TYPE_FLETCHER16, (const unsigned char *) "abcde", 5), 0xC8F0);
+    ASSERT_EQ(Checksum::getSize(CHECKSUM_TYPE_CRC32C), 4);
+    srand(11);
+    for (size_t i = 0; i < data.size(); i++) data[i] = (unsigned char) (rand() & 0xFF);
+    for (size_t sz = 0; sz < 1200; sz += 13){
+        for (size_t offset = 0; offset < 3; offset++){
+            for (auto type : crcTypes){
+                unsigned int expected = checksumBitwise(type, data.data() + offset, sz);
+                for (auto engine : engines){
+                    ASSERT_EQ(Checksum::calculate(engine, type, data.data() + offset, sz), expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(SerialinkSimpleTest, checksum_incremental) {
+    std::vector <unsigned char> data(3000);
+    unsigned int state = 0;
+    size_t offset = 0;
+    size_t chunk = 0;
+    srand(13);
+    for (size_t i = 0; i < data.size(); i++) data[i] = (unsigned char) (rand() & 0xFF);
+    for (int t = CHECKSUM_TYPE_CRC16_CCITT; t <= CHECKSUM_TYPE_FLETCHER16; t++){
+        CHECKSUM_TYPE type = (CHECKSUM_TYPE) t;
+        state = Checksum::init(type);
+        for (offset = 0; offset < data.size(); offset += chunk){
+            chunk = (size_t) (rand() % 200);
+            if (chunk > data.size() - offset) chunk = data.size() - offset;
+            state = Checksum::update(type, state, data.data() + offset, chunk);
+        }
+        ASSERT_EQ(Checksum::finish(type, state), Checksum::calculate(type, data.data(), data.size()));
+    }
+}
+
+TEST_F(SerialinkSimpleTest, normalWriteAndRead_startBytes_afterNoise) {
+    unsigned char buffer[8];
+    pthread_t thread;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    ASSERT_EQ(slave.openPort(), 0);
+    master.setTimeout(25);
+    pthread_create(&thread, nullptr, writeNoiseThread, &slave);
+    ASSERT_EQ(master.readStartBytes("1234"), 0);
+    pthread_join(thread, nullptr);
+    ASSERT_EQ(master.getBuffer(buffer, sizeof(buffer)), 4);
+    ASSERT_EQ(memcmp(buffer, "1234", 4), 0);
+    ASSERT_EQ(master.readNBytes(6), 0);
+    ASSERT_EQ(master.getBuffer(buffer, sizeof(buffer)), 6);
+    ASSERT_EQ(memcmp(buffer, "567890", 6), 0);
+}
+
+TEST_F(SerialinkSimpleTest, normalWriteAndRead_startBytesSet) {
+    unsigned char buffer[8];
+    ByteSearchSet startBytes;
+    size_t index = 0;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(25);
+    slave.setKeepAlive(50);
+    ASSERT_EQ(slave.readStartBytes(startBytes, index), 3);
+    ASSERT_EQ(startBytes.add((const unsigned char *) "\x02", 1), 0);
+    ASSERT_EQ(startBytes.add(std::vector <unsigned char>({'$', 'G', 'P'})), 1);
+    ASSERT_EQ(startBytes.add((const unsigned char *) "$G", 2), 2);
+    ASSERT_EQ(startBytes.getCount(), 3);
+    ASSERT_EQ(slave.openPort(), 0);
+    ASSERT_EQ(slave.writeData("qw$Ge$GPGGA\x02zz"), 0);
+    ASSERT_EQ(master.begin(), true);
+    ASSERT_EQ(slave.readStartBytes(startBytes, index), 0);
+    ASSERT_EQ(index, 2);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 2);
+    ASSERT_EQ(memcmp(buffer, "$G", 2), 0);
+    ASSERT_EQ(slave.readStartBytes(startBytes, index), 0);
+    ASSERT_EQ(index, 1);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 3);
+    ASSERT_EQ(memcmp(buffer, "$GP", 3), 0);
+    ASSERT_EQ(slave.readStartBytes(startBytes, index), 0);
+    ASSERT_EQ(index, 0);
+    ASSERT_EQ(slave.getRemainingDataSize(), 2);
+}
+
 TEST_F(SerialinkSimpleTest, normalWriteAndRead_startBytes_ov1) {
     unsigned char buffer[8];
     pthread_t thread;
@@ -1071,6 +1351,27 @@ TEST_F(SerialinkSimpleTest, negativeWriteAndRead_no_input_bytes_available) {
     ASSERT_EQ(tmp.size(), 0);
 }
 
+TEST_F(SerialinkSimpleTest, negativeWriteAndRead_no_input_bytes_available_chrono_timeout) {
+    unsigned char buffer[8];
+    struct timeval tvStart, tvEnd;
+    int diffTime = 0;
+    slave.setPort(master.getVirtualPortName());
+    slave.setBaudrate(B115200);
+    slave.setTimeout(std::chrono::milliseconds(20));
+    ASSERT_EQ(slave.getTimeoutDuration().count(), 20000);
+    ASSERT_EQ(slave.openPort(), 0);
+    gettimeofday(&tvStart, NULL);
+    ASSERT_EQ(slave.readData(), 2);
+    gettimeofday(&tvEnd, NULL);
+    diffTime = (tvEnd.tv_sec - tvStart.tv_sec) * 1000 + (tvEnd.tv_usec - tvStart.tv_usec) / 1000;
+    ASSERT_EQ(diffTime >= 20 && diffTime <= 45, true);
+    ASSERT_EQ(slave.getDataSize(), 0);
+    ASSERT_EQ(slave.getBuffer(buffer, sizeof(buffer)), 0);
+    slave.setTimeout(25);
+    ASSERT_EQ(slave.getTimeout(), 25);
+    ASSERT_EQ(slave.getTimeoutDuration().count(), 2500000);
+}
+
 TEST_F(SerialinkSimpleTest, negativeWriteAndRead_startBytes_noData_1) {
     unsigned char buffer[8];
     pthread_t thread;
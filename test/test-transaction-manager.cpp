@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <string.h>
+#include "transaction-manager.hpp"
+#include "virtuser.hpp"
+
+typedef struct _TransactionTestContext {
+    std::vector <std::string> keys;
+    std::vector <int> results;
+    std::vector <std::string> data;
+} TransactionTestContext;
+
+typedef struct _TransactionTestParam {
+    TransactionTestContext *ctx;
+    std::string key;
+} TransactionTestParam;
+
+static void transactionDone(TransactionManager &manager, int ret, Serialink &link, void *param){
+    TransactionTestParam *transaction = (TransactionTestParam *) param;
+    ByteView data;
+    (void) manager;
+    transaction->ctx->keys.push_back(transaction->key);
+    transaction->ctx->results.push_back(ret);
+    if (ret == 0){
+        data = link.getFieldAsView(DataFrame::FRAME_TYPE_DATA);
+        transaction->ctx->data.push_back(std::string(data.begin(), data.end()));
+    }
+}
+
+class SerialinkTransactionTest:public::testing::Test {
+protected:
+    VirtualSerial master;
+    Serialink slave;
+    TransactionTestContext ctx;
+    SerialinkTransactionTest() : master(B115200, 10, 50) {}
+    void SetUp() override {
+        DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "\x02");
+        DataFrame snBytes(DataFrame::FRAME_TYPE_SN, 1);
+        DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+        DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "\x03");
+        slave.setPort(master.getVirtualPortName());
+        slave.setBaudrate(B115200);
+        slave.setTimeout(25);
+        slave.setKeepAlive(100);
+        slave = startBytes + snBytes + dataBytes + stopBytes;
+    }
+
+    void TearDown() override {
+        // tidak ada kebutuhan post-set
+    }
+};
+
+TEST_F(SerialinkTransactionTest, InvalidRequest) {
+    TransactionManager manager(slave);
+    ASSERT_EQ(manager.process(), 3);
+    ASSERT_EQ(manager.submit(ByteView(), ByteView((const unsigned char *) "A", 1), 100, (const void *) &transactionDone, nullptr), 4);
+    ASSERT_EQ(manager.submit(ByteView((const unsigned char *) "\x02" "A\x03", 3), ByteView(), 100, (const void *) &transactionDone, nullptr), 4);
+    /* the port is not open */
+    ASSERT_EQ(manager.submit(ByteView((const unsigned char *) "\x02" "A\x03", 3), ByteView((const unsigned char *) "A", 1), 100, (const void *) &transactionDone, nullptr), 1);
+    ASSERT_EQ(manager.getPendingCount(), 0);
+}
+
+TEST_F(SerialinkTransactionTest, PipelinedOutOfOrder) {
+    TransactionManager manager(slave);
+    TransactionTestParam params[3] = {{&ctx, "A"}, {&ctx, "B"}, {&ctx, "C"}};
+    manager.setWindow(2);
+    ASSERT_EQ(slave.openPort(), 0);
+    for (int i = 0; i < 3; i++){
+        std::string request = std::string("\x02") + params[i].key + "req\x03";
+        ASSERT_EQ(manager.submit(ByteView((const unsigned char *) request.data(), request.size()), ByteView((const unsigned char *) params[i].key.data(), 1), (i == 2 ? 300 : 2000), (const void *) &transactionDone, &params[i]), 0);
+    }
+    ASSERT_EQ(manager.getInFlightCount(), 2);
+    ASSERT_EQ(manager.getPendingCount(), 3);
+    /* the responses come out of order, with a response that does not belong to any request */
+    ASSERT_EQ(master.writeData(std::string("\x02" "Bok\x03\x02" "Zxx\x03\x02" "Ahi\x03")), 0);
+    ASSERT_EQ(manager.process(), 0);
+    ASSERT_EQ(manager.getInFlightCount(), 2);
+    ASSERT_EQ(manager.getPendingCount(), 2);
+    ASSERT_EQ(manager.process(), 0);
+    ASSERT_EQ(manager.getPendingCount(), 2);
+    ASSERT_EQ(manager.process(), 0);
+    ASSERT_EQ(manager.getPendingCount(), 1);
+    /* there is no response for the last request */
+    while (manager.getPendingCount() > 0){
+        ASSERT_EQ(manager.process(), 2);
+    }
+    ASSERT_EQ(manager.process(), 3);
+    ASSERT_EQ(ctx.keys, std::vector <std::string>({"B", "A", "C"}));
+    ASSERT_EQ(ctx.results, std::vector <int>({0, 0, 2}));
+    ASSERT_EQ(ctx.data, std::vector <std::string>({"ok", "hi"}));
+}